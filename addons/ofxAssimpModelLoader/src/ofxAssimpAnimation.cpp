@@ -23,6 +23,11 @@ ofxAssimpAnimation::ofxAssimpAnimation(shared_ptr<const aiScene> scene, aiAnimat
     if(animation != NULL) {
         durationInSeconds = animation->mDuration;
         durationInMilliSeconds = durationInSeconds * 1000;
+
+        channelNodes.resize(animation->mNumChannels);
+        for(unsigned int i=0; i<animation->mNumChannels; i++) {
+            channelNodes[i] = scene->mRootNode->FindNode(animation->mChannels[i]->mNodeName);
+        }
     }
 }
 
@@ -66,7 +71,10 @@ void ofxAssimpAnimation::update() {
 void ofxAssimpAnimation::updateAnimationNodes() {
 	for(unsigned int i=0; i<animation->mNumChannels; i++) {
         const aiNodeAnim * channel = animation->mChannels[i];
-        aiNode * targetNode = scene->mRootNode->FindNode(channel->mNodeName);
+        aiNode * targetNode = channelNodes[i];
+        if(targetNode == NULL) {
+            continue;
+        }
         
         aiVector3D presentPosition(0, 0, 0);
         if(channel->mNumPositionKeys > 0) {
@@ -11,6 +11,12 @@
 
 class aiMesh;
 
+// a bone that moves a vertex and how much it does
+struct ofxAssimpBoneInfluence {
+    unsigned int bone;
+    float weight;
+};
+
 class ofxAssimpMeshHelper {
 
 public:
@@ -37,6 +43,13 @@ public:
     vector<aiVector3D> animatedPos;
     vector<aiVector3D> animatedNorm;
 
+    // skinning data cached at load time, the influences of vertex i are
+    // boneInfluences[influenceOffsets[i]] to boneInfluences[influenceOffsets[i+1]]
+    vector<ofxAssimpBoneInfluence> boneInfluences;
+    vector<unsigned int> influenceOffsets;
+    vector<int> boneNodes; // index of the node of each bone in the loader's node list, -1 if it has none
+    vector<float> boneMatrices; // column major 4x4 matrix per bone, updated every frame
+
     ofMesh cachedMesh;
     bool validCache;
     
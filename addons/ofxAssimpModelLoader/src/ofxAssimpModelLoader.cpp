@@ -1,11 +1,174 @@
 #include "ofxAssimpModelLoader.h"
 #include "ofxAssimpUtils.h"
+#include "ofxAssimpSceneCache.h"
 
-#include "assimp.h"
+#include "assimp.hpp"
 #include "aiScene.h"
 #include "aiConfig.h"
 #include "aiPostProcess.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define OFX_ASSIMP_SSE
+	#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define OFX_ASSIMP_NEON
+	#include <arm_neon.h>
+#endif
+
+//-------------------------------------------
+// every import uses its own Assimp::Importer so loads in different threads
+// don't share the import properties or the last error. The importer owns
+// the scene and is deleted with it, optimizeScene() post processes the
+// scene through it
+class ofxAssimpImporterDeleter{
+public:
+	ofxAssimpImporterDeleter(Assimp::Importer * importer)
+	:importer(importer){}
+
+	void operator()(const aiScene *){
+		delete importer;
+	}
+
+	Assimp::Importer * importer;
+};
+
+static Assimp::Importer * createImporter(){
+	Assimp::Importer * importer = new Assimp::Importer;
+	// only ever give us triangles.
+	importer->SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE | aiPrimitiveType_POINT);
+	importer->SetPropertyInteger(AI_CONFIG_PP_PTV_NORMALIZE, true);
+	return importer;
+}
+
+// takes the scene imported by importer or deletes it and returns NULL
+// with the error if the import failed
+static shared_ptr<const aiScene> takeImportedScene(Assimp::Importer * importer, string & error){
+	const aiScene * scene = importer->GetScene();
+	if(!scene){
+		error = importer->GetErrorString();
+		delete importer;
+		return shared_ptr<const aiScene>();
+	}
+	return shared_ptr<const aiScene>(scene, ofxAssimpImporterDeleter(importer));
+}
+
+//-------------------------------------------
+// linear blend skinning of the vertices in [begin, end): blends the column
+// major matrices of the bones of each vertex by their weights and
+// transforms the vertex and its normal by the result. The normals use the
+// 3x3 part of the blended matrix only.
+static void skinVertices(ofxAssimpMeshHelper & helper, size_t begin, size_t end){
+	const aiMesh * mesh = helper.mesh;
+	const float * matrices = &helper.boneMatrices[0];
+	const ofxAssimpBoneInfluence * influences = helper.boneInfluences.empty() ? NULL : &helper.boneInfluences[0];
+	const unsigned int * offsets = &helper.influenceOffsets[0];
+	bool normals = mesh->HasNormals();
+
+	for(size_t v = begin; v < end; v++){
+		const aiVector3D & p = mesh->mVertices[v];
+		float * pos = &helper.animatedPos[v].x;
+#if defined(OFX_ASSIMP_SSE)
+		__m128 c0 = _mm_setzero_ps(), c1 = c0, c2 = c0, c3 = c0;
+		for(unsigned int i = offsets[v]; i < offsets[v+1]; i++){
+			const float * m = matrices + influences[i].bone * 16;
+			__m128 w = _mm_set1_ps(influences[i].weight);
+			c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(m)));
+			c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(m + 4)));
+			c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(m + 8)));
+			c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(m + 12)));
+		}
+		__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p.x)), _mm_mul_ps(c1, _mm_set1_ps(p.y))),
+							  _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p.z)), c3));
+		_mm_storel_pi((__m64*)pos, r);
+		_mm_store_ss(pos + 2, _mm_movehl_ps(r, r));
+		if(normals){
+			const aiVector3D & n = mesh->mNormals[v];
+			float * norm = &helper.animatedNorm[v].x;
+			r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(n.x)), _mm_mul_ps(c1, _mm_set1_ps(n.y))),
+						   _mm_mul_ps(c2, _mm_set1_ps(n.z)));
+			_mm_storel_pi((__m64*)norm, r);
+			_mm_store_ss(norm + 2, _mm_movehl_ps(r, r));
+		}
+#elif defined(OFX_ASSIMP_NEON)
+		float32x4_t c0 = vdupq_n_f32(0), c1 = c0, c2 = c0, c3 = c0;
+		for(unsigned int i = offsets[v]; i < offsets[v+1]; i++){
+			const float * m = matrices + influences[i].bone * 16;
+			float w = influences[i].weight;
+			c0 = vmlaq_n_f32(c0, vld1q_f32(m), w);
+			c1 = vmlaq_n_f32(c1, vld1q_f32(m + 4), w);
+			c2 = vmlaq_n_f32(c2, vld1q_f32(m + 8), w);
+			c3 = vmlaq_n_f32(c3, vld1q_f32(m + 12), w);
+		}
+		float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c0, p.x), c1, p.y), c2, p.z);
+		vst1_f32(pos, vget_low_f32(r));
+		vst1q_lane_f32(pos + 2, r, 2);
+		if(normals){
+			const aiVector3D & n = mesh->mNormals[v];
+			float * norm = &helper.animatedNorm[v].x;
+			r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c0, n.x), c1, n.y), c2, n.z);
+			vst1_f32(norm, vget_low_f32(r));
+			vst1q_lane_f32(norm + 2, r, 2);
+		}
+#else
+		float c[16] = {0};
+		for(unsigned int i = offsets[v]; i < offsets[v+1]; i++){
+			const float * m = matrices + influences[i].bone * 16;
+			float w = influences[i].weight;
+			for(int j = 0; j < 16; j++){
+				c[j] += w * m[j];
+			}
+		}
+		pos[0] = c[0] * p.x + c[4] * p.y + c[8] * p.z + c[12];
+		pos[1] = c[1] * p.x + c[5] * p.y + c[9] * p.z + c[13];
+		pos[2] = c[2] * p.x + c[6] * p.y + c[10] * p.z + c[14];
+		if(normals){
+			const aiVector3D & n = mesh->mNormals[v];
+			float * norm = &helper.animatedNorm[v].x;
+			norm[0] = c[0] * n.x + c[4] * n.y + c[8] * n.z;
+			norm[1] = c[1] * n.x + c[5] * n.y + c[9] * n.z;
+			norm[2] = c[2] * n.x + c[6] * n.y + c[10] * n.z;
+		}
+#endif
+	}
+}
+
+//-------------------------------------------
+class ofxAssimpSkinningJob: public ofParallelJob{
+public:
+	ofxAssimpSkinningJob(ofxAssimpMeshHelper & helper)
+	:helper(helper){}
+
+	void run(size_t begin, size_t end){
+		skinVertices(helper, begin, end);
+	}
+
+private:
+	ofxAssimpMeshHelper & helper;
+};
+
+//-------------------------------------------
+// imports the scene and prepares everything but the GL resources in a
+// thread of the pool into a loader only the task uses, finishAsyncLoad()
+// moves it to the model in the main thread, see loadModelAsync()
+class ofxAssimpModelLoader::LoadTask{
+public:
+	LoadTask(shared_ptr<ofxAssimpModelLoader> loaded, unsigned int flags)
+	:loaded(loaded)
+	,flags(flags){}
+
+	shared_ptr<ofxAssimpModelLoader> operator()(){
+		loaded->scene = loaded->importScene(flags);
+		if(loaded->scene){
+			loaded->prepareScene();
+		}
+		return loaded;
+	}
+
+private:
+	shared_ptr<ofxAssimpModelLoader> loaded;
+	unsigned int flags;
+};
+
 ofxAssimpModelLoader::ofxAssimpModelLoader(){
 	clear();
 }
@@ -17,6 +180,11 @@ ofxAssimpModelLoader::~ofxAssimpModelLoader(){
 //------------------------------------------
 bool ofxAssimpModelLoader::loadModel(string modelName, bool optimize){
     
+    // drops the load in progress
+    if(isLoading()){
+        clear();
+    }
+
     file.open(modelName, ofFile::ReadOnly, true); // Since it may be a binary file we should read it in binary -Ed
     if(!file.exists()) {
         ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): model does not exist: \"" << modelName << "\"";
@@ -34,18 +202,54 @@ bool ofxAssimpModelLoader::loadModel(string modelName, bool optimize){
     unsigned int flags = initImportProperties(optimize);
     
     // loads scene from file
-    scene = shared_ptr<const aiScene>(aiImportFile(file.getAbsolutePath().c_str(), flags),aiReleaseImport);
+    scene = importScene(flags);
     
     bool bOk = processScene();
     return bOk;
 }
 
+//------------------------------------------
+bool ofxAssimpModelLoader::loadModelAsync(string modelName, bool optimize){
+
+    // drops the load in progress
+    if(isLoading()){
+        clear();
+    }
+
+    file.open(modelName, ofFile::ReadOnly, true);
+    if(!file.exists()) {
+        ofLogVerbose("ofxAssimpModelLoader") << "loadModelAsync(): model does not exist: \"" << modelName << "\"";
+        return false;
+    }
+
+    ofLogVerbose("ofxAssimpModelLoader") << "loadModelAsync(): loading \"" << file.getFileName()
+		<< "\" from \"" << file.getEnclosingDirectory() << "\"";
+
+    if(scene != NULL){
+        clear();
+    }
+
+    normalizeFactor = ofGetWidth() / 2.0;
+
+    unsigned int flags = initImportProperties(optimize);
+    shared_ptr<ofxAssimpModelLoader> loaded(new ofxAssimpModelLoader);
+    loaded->file = file;
+    loaded->sceneCacheFolder = sceneCacheFolder;
+    asyncLoad = ofAsync(LoadTask(loaded, flags));
+    return true;
+}
+
+//------------------------------------------
+bool ofxAssimpModelLoader::isLoading(){
+    return asyncLoad.isValid();
+}
+
 
 bool ofxAssimpModelLoader::loadModel(ofBuffer & buffer, bool optimize, const char * extension){
     
     ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): loading from memory buffer \"." << extension << "\"";
     
-    if(scene != NULL){
+    if(scene != NULL || isLoading()){
         clear();
     }
     
@@ -53,18 +257,17 @@ bool ofxAssimpModelLoader::loadModel(ofBuffer & buffer, bool optimize, const cha
     unsigned int flags = initImportProperties(optimize);
     
     // loads scene from memory buffer - note this will not work for multipart files (obj, md3, etc)
-    scene = shared_ptr<const aiScene>(aiImportFileFromMemory(buffer.getData(), buffer.size(), flags, extension),aiReleaseImport);
+    Assimp::Importer * importer = createImporter();
+    importer->ReadFileFromMemory(buffer.getData(), buffer.size(), flags, extension);
+    scene = takeImportedScene(importer, loadError);
     
     bool bOk = processScene();
     return bOk;
 }
 
+// the properties are set on the importer of each load by createImporter()
 unsigned int ofxAssimpModelLoader::initImportProperties(bool optimize) {
     
-    // only ever give us triangles.
-    aiSetImportPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_LINE | aiPrimitiveType_POINT );
-    aiSetImportPropertyInteger(AI_CONFIG_PP_PTV_NORMALIZE, true);
-    
     // aiProcess_FlipUVs is for VAR code. Not needed otherwise. Not sure why.
     unsigned int flags = aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_Triangulate | aiProcess_FlipUVs;
     if(optimize) flags |=  aiProcess_ImproveCacheLocality | aiProcess_OptimizeGraph |
@@ -74,27 +277,39 @@ unsigned int ofxAssimpModelLoader::initImportProperties(bool optimize) {
     return flags;
 }
 
+// imports the model file, or maps the scene cached the last time it was
+// imported with the same flags. sets loadError if it fails
+shared_ptr<const aiScene> ofxAssimpModelLoader::importScene(unsigned int flags) {
+    string path = file.getAbsolutePath();
+    string cachePath;
+    if(!sceneCacheFolder.empty()){
+        cachePath = ofxAssimpGetSceneCachePath(sceneCacheFolder, path, flags);
+        shared_ptr<const aiScene> cached = ofxAssimpLoadSceneCache(cachePath);
+        if(cached){
+            ofLogVerbose("ofxAssimpModelLoader") << "importScene(): loaded scene from cache \"" << cachePath << "\"";
+            return cached;
+        }
+    }
+
+    Assimp::Importer * importer = createImporter();
+    importer->ReadFile(path.c_str(), flags);
+    shared_ptr<const aiScene> imported = takeImportedScene(importer, loadError);
+    if(imported && !cachePath.empty()){
+        ofxAssimpSaveSceneCache(*imported, cachePath);
+    }
+    return imported;
+}
+
 bool ofxAssimpModelLoader::processScene() {
     
     normalizeFactor = ofGetWidth() / 2.0;
     
     if(scene){
-        calculateDimensions();
-        loadGLResources();
-        update();
-        
-        if(getAnimationCount())
-            ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): scene has " << getAnimationCount() << "animations";
-        else {
-            ofLogVerbose("ofxAssimpModelLoader") << "loadMode(): no animations";
-        }
-        
-        ofAddListener(ofEvents().exit,this,&ofxAssimpModelLoader::onAppExit);
-        
-        
+        prepareScene();
+        finishScene();
         return true;
     }else{
-        ofLogError("ofxAssimpModelLoader") << "loadModel(): " + (string) aiGetErrorString();
+        ofLogError("ofxAssimpModelLoader") << "loadModel(): " << loadError;
         clear();
         return false;
     }
@@ -102,6 +317,58 @@ bool ofxAssimpModelLoader::processScene() {
     return false;
 }
 
+//-------------------------------------------
+void ofxAssimpModelLoader::prepareScene(){
+    calculateBoundingBox();
+    loadMeshes();
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::finishScene(){
+    calculateNormalizedScale();
+    loadGLResources();
+    update();
+
+    if(getAnimationCount())
+        ofLogVerbose("ofxAssimpModelLoader") << "loadModel(): scene has " << getAnimationCount() << "animations";
+    else {
+        ofLogVerbose("ofxAssimpModelLoader") << "loadMode(): no animations";
+    }
+
+    ofAddListener(ofEvents().exit,this,&ofxAssimpModelLoader::onAppExit);
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::finishAsyncLoad(){
+    shared_ptr<ofxAssimpModelLoader> loaded;
+    try{
+        loaded = asyncLoad.get();
+    }catch(std::exception & e){
+        loadError = e.what();
+    }
+    asyncLoad = ofFuture<shared_ptr<ofxAssimpModelLoader> >();
+
+    if(loaded && loaded->scene){
+        scene = loaded->scene;
+        scene_min = loaded->scene_min;
+        scene_max = loaded->scene_max;
+        scene_center = loaded->scene_center;
+        modelMeshes.swap(loaded->modelMeshes);
+        textures.swap(loaded->textures);
+        texturePixels.swap(loaded->texturePixels);
+        animations.swap(loaded->animations);
+        nodes.swap(loaded->nodes);
+        nodeParents.swap(loaded->nodeParents);
+        nodeTransforms.swap(loaded->nodeTransforms);
+        finishScene();
+    }else{
+        if(loaded) loadError = loaded->loadError;
+        ofLogError("ofxAssimpModelLoader") << "loadModelAsync(): " << loadError;
+        clear();
+        scene.reset();
+    }
+}
+
 // automatic destruction on app exit makes the app crash because of some bug in assimp
 // this is a hack to clear every object on the exit callback of the application
 // FIXME: review when there's an update of assimp
@@ -113,7 +380,7 @@ void ofxAssimpModelLoader::onAppExit(ofEventArgs & args){
 
 //-------------------------------------------
 void ofxAssimpModelLoader::createEmptyModel(){
-	if(scene){
+	if(scene || isLoading()){
 		clear();
 		scene.reset();
 	}
@@ -127,6 +394,12 @@ void ofxAssimpModelLoader::setNormalizationFactor(float factor){
 //-------------------------------------------
 void ofxAssimpModelLoader::calculateDimensions(){
 	if(!scene) return;
+	calculateBoundingBox();
+	calculateNormalizedScale();
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::calculateBoundingBox(){
 	ofLogVerbose("ofxAssimpModelLoader") << "calculateDimensions(): inited scene with "
 		<< scene->mNumMeshes << " meshes & " << scene->mNumAnimations << " animations";
 
@@ -134,7 +407,10 @@ void ofxAssimpModelLoader::calculateDimensions(){
 	scene_center.x = (scene_min.x + scene_max.x) / 2.0f;
 	scene_center.y = (scene_min.y + scene_max.y) / 2.0f;
 	scene_center.z = (scene_min.z + scene_max.z) / 2.0f;
+}
 
+//-------------------------------------------
+void ofxAssimpModelLoader::calculateNormalizedScale(){
 	// optional normalized scaling
 	normalizedScale = scene_max.x-scene_min.x;
 	normalizedScale = MAX(scene_max.y - scene_min.y,normalizedScale);
@@ -166,22 +442,30 @@ void ofxAssimpModelLoader::createLightsFromAiModel(){
 }
 
 void ofxAssimpModelLoader::optimizeScene(){
-	aiApplyPostProcessing(scene.get(),aiProcess_ImproveCacheLocality | aiProcess_OptimizeGraph |
+	if(ofxAssimpIsCachedScene(scene)){
+		ofLogWarning("ofxAssimpModelLoader") << "optimizeScene(): scenes from the cache can't be optimized, load the model with optimize = true instead";
+		return;
+	}
+	ofxAssimpImporterDeleter * owner = std::get_deleter<ofxAssimpImporterDeleter>(scene);
+	if(!owner){
+		return;
+	}
+	owner->importer->ApplyPostProcessing(aiProcess_ImproveCacheLocality | aiProcess_OptimizeGraph |
 			aiProcess_OptimizeMeshes | aiProcess_JoinIdenticalVertices |
 			aiProcess_RemoveRedundantMaterials);
+	cacheSkeleton();
 }
 
 //-------------------------------------------
-void ofxAssimpModelLoader::loadGLResources(){
+void ofxAssimpModelLoader::loadMeshes(){
 
-	ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): starting";
+	ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): starting";
 
     // create new mesh helpers for each mesh, will populate their data later.
     modelMeshes.resize(scene->mNumMeshes,ofxAssimpMeshHelper());
 
-    // create OpenGL buffers and populate them based on each meshes pertinant info.
     for (unsigned int i = 0; i < scene->mNumMeshes; ++i){
-        ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): loading mesh " << i;
+        ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): loading mesh " << i;
         // current mesh we are introspecting
         aiMesh* mesh = scene->mMeshes[i];
 
@@ -239,48 +523,50 @@ void ofxAssimpModelLoader::loadGLResources(){
 
         // TODO: handle other aiTextureTypes
         if(AI_SUCCESS == mtl->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath)){
-            ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): loading image from \"" << texPath.data << "\"";
+            ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): loading image from \"" << texPath.data << "\"";
             string modelFolder = file.getEnclosingDirectory();
             string relTexPath = ofFilePath::getEnclosingDirectory(texPath.data,false);
             string texFile = ofFilePath::getFileName(texPath.data);
             string realPath = modelFolder + relTexPath  + texFile;
             
             if(ofFile::doesFileExist(realPath) == false) {
-                ofLogError("ofxAssimpModelLoader") << "loadGLResource(): texture doesn't exist: \""
+                ofLogError("ofxAssimpModelLoader") << "loadMeshes(): texture doesn't exist: \""
 					<< file.getFileName() + "\" in \"" << realPath << "\"";
             }
             
-            ofxAssimpTexture assimpTexture;
             bool bTextureAlreadyExists = false;
             for(int j=0; j<textures.size(); j++) {
-                assimpTexture = textures[j];
-                if(assimpTexture.getTexturePath() == realPath) {
+                if(textures[j].getTexturePath() == realPath) {
+                    meshHelper.assimpTexture = textures[j];
                     bTextureAlreadyExists = true;
                     break;
                 }
             }
             if(bTextureAlreadyExists) {
-                meshHelper.assimpTexture = assimpTexture;
-                ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): texture already loaded: \""
+                ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): texture already loaded: \""
 					<< file.getFileName() + "\" from \"" << realPath << "\"";
             } else {
-                ofTexture texture;
-                bool bTextureLoadedOk = ofLoadImage(texture, realPath);
+                // only the pixels are decoded here, loadGLResources uploads
+                // them and gives the meshes their texture
+                ofPixels pixels;
+                bool bTextureLoadedOk = ofLoadImage(pixels, realPath);
                 if(bTextureLoadedOk) {
-                    textures.push_back(ofxAssimpTexture(texture, realPath));
-                    assimpTexture = textures.back();
-                    meshHelper.assimpTexture = assimpTexture;
-                    ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): texture loaded, dimensions: "
-						<< texture.getWidth() << "x" << texture.getHeight();
+                    textures.push_back(ofxAssimpTexture(ofTexture(), realPath));
+                    meshHelper.assimpTexture = textures.back();
+                    ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): texture loaded, dimensions: "
+						<< pixels.getWidth() << "x" << pixels.getHeight();
+                    texturePixels.push_back(std::move(pixels));
                 } else {
-                    ofLogError("ofxAssimpModelLoader") << "loadGLResource(): couldn't load texture: \""
+                    ofLogError("ofxAssimpModelLoader") << "loadMeshes(): couldn't load texture: \""
 						<< file.getFileName() + "\" from \"" << realPath << "\"";
                 }
             }
         }
 
+        // the texture coordinates are converted to the ones of the texture
+        // by loadGLResources once it's allocated
         meshHelper.mesh = mesh;
-        aiMeshToOfMesh(mesh, meshHelper.cachedMesh, &meshHelper);
+        aiMeshToOfMesh(mesh, meshHelper.cachedMesh);
         meshHelper.cachedMesh.setMode(OF_PRIMITIVE_TRIANGLES);
         meshHelper.validCache = true;
         meshHelper.hasChanged = false;
@@ -290,6 +576,60 @@ void ofxAssimpModelLoader::loadGLResources(){
         	meshHelper.animatedNorm.resize(mesh->mNumVertices);
         }
 
+        meshHelper.indices.resize(mesh->mNumFaces * 3);
+        int j=0;
+        for (unsigned int x = 0; x < mesh->mNumFaces; ++x){
+			for (unsigned int a = 0; a < mesh->mFaces[x].mNumIndices; ++a){
+				meshHelper.indices[j++]=mesh->mFaces[x].mIndices[a];
+			}
+		}
+    }
+    
+    cacheSkeleton();
+
+    int numOfAnimations = scene->mNumAnimations;
+    for(int i=0; i<numOfAnimations; i++) {
+        aiAnimation * animation = scene->mAnimations[i];
+        animations.push_back(ofxAssimpAnimation(scene, animation));
+    }
+
+    ofLogVerbose("ofxAssimpModelLoader") << "loadMeshes(): finished";
+}
+
+//-------------------------------------------
+void ofxAssimpModelLoader::loadGLResources(){
+
+	ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): starting";
+
+    // the meshes copy their texture once it's allocated so they share it
+    for(unsigned int i = 0; i < texturePixels.size(); i++){
+        ofPixels & pixels = texturePixels[i];
+        ofTexture & texture = textures[i].getTextureRef();
+        texture.allocate(pixels.getWidth(), pixels.getHeight(), ofGetGlInternalFormat(pixels));
+        texture.loadData(pixels);
+    }
+    texturePixels.clear();
+
+    // create OpenGL buffers and populate them based on each meshes pertinant info.
+    for (unsigned int i = 0; i < modelMeshes.size(); ++i){
+        ofLogVerbose("ofxAssimpModelLoader") << "loadGLResources(): loading mesh " << i;
+        ofxAssimpMeshHelper & meshHelper = modelMeshes[i];
+        aiMesh* mesh = meshHelper.mesh;
+
+        string texturePath = meshHelper.assimpTexture.getTexturePath();
+        for(unsigned int j = 0; j < textures.size() && !texturePath.empty(); j++) {
+            if(textures[j].getTexturePath() == texturePath) {
+                meshHelper.assimpTexture = textures[j];
+                break;
+            }
+        }
+        if(meshHelper.hasTexture() && meshHelper.cachedMesh.hasTexCoords()){
+            ofTexture & tex = meshHelper.getTextureRef();
+            vector<ofVec2f> & texCoords = meshHelper.cachedMesh.getTexCoords();
+            for(unsigned int j = 0; j < texCoords.size(); j++){
+                texCoords[j] = tex.getCoordFromPercent(texCoords[j].x, texCoords[j].y);
+            }
+        }
 
         int usage;
         if(getAnimationCount()){
@@ -318,24 +658,10 @@ void ofxAssimpModelLoader::loadGLResources(){
         	meshHelper.vbo.setTexCoordData(meshHelper.cachedMesh.getTexCoordsPointer()[0].getPtr(),mesh->mNumVertices,GL_STATIC_DRAW,sizeof(ofVec2f));
         }
 
-        meshHelper.indices.resize(mesh->mNumFaces * 3);
-        int j=0;
-        for (unsigned int x = 0; x < mesh->mNumFaces; ++x){
-			for (unsigned int a = 0; a < mesh->mFaces[x].mNumIndices; ++a){
-				meshHelper.indices[j++]=mesh->mFaces[x].mIndices[a];
-			}
-		}
-
         meshHelper.vbo.setIndexData(&meshHelper.indices[0],meshHelper.indices.size(),GL_STATIC_DRAW);
 
         //modelMeshes.push_back(meshHelper);
     }
-    
-    int numOfAnimations = scene->mNumAnimations;
-    for(int i=0; i<numOfAnimations; i++) {
-        aiAnimation * animation = scene->mAnimations[i];
-        animations.push_back(ofxAssimpAnimation(scene, animation));
-    }
 
     ofLogVerbose("ofxAssimpModelLoader") << "loadGLResource(): finished";
 }
@@ -345,9 +671,19 @@ void ofxAssimpModelLoader::clear(){
 
     ofLogVerbose("ofxAssimpModelLoader") << "clear(): deleting GL resources";
 
+    // a load in progress fills its own loader, dropping the future
+    // discards it once it finishes
+    if(asyncLoad.isValid()){
+        asyncLoad = ofFuture<shared_ptr<ofxAssimpModelLoader> >();
+        scene.reset();
+    }
+
     // clear out everything.
     modelMeshes.clear();
     animations.clear();
+    nodes.clear();
+    nodeParents.clear();
+    nodeTransforms.clear();
     pos.set(0,0,0);
     scale.set(1,1,1);
     rotAngle.clear();
@@ -360,20 +696,89 @@ void ofxAssimpModelLoader::clear(){
     bUsingNormals = true;
     bUsingTextures = true;
     bUsingColors = true;
+    bParallelSkinning = true;
 
     currentAnimation = -1;
 
     textures.clear();
+    texturePixels.clear();
 
     updateModelMatrix();
     ofRemoveListener(ofEvents().exit,this,&ofxAssimpModelLoader::onAppExit);
 }
 
+//-------------------------------------------
+void ofxAssimpModelLoader::cacheSkeleton(){
+    nodes.clear();
+    nodeParents.clear();
+    if(!scene || !scene->mRootNode){
+        nodeTransforms.clear();
+        return;
+    }
+
+    // a node is added before its children so one pass in order computes
+    // every global transform from its parent's
+    map<const aiNode*, int> nodeIndices;
+    vector<aiNode*> stack(1, scene->mRootNode);
+    while(!stack.empty()){
+        aiNode * node = stack.back();
+        stack.pop_back();
+        nodeIndices[node] = nodes.size();
+        nodes.push_back(node);
+        nodeParents.push_back(node->mParent ? nodeIndices[node->mParent] : -1);
+        for(int i = (int)node->mNumChildren - 1; i >= 0; i--){
+            stack.push_back(node->mChildren[i]);
+        }
+    }
+    nodeTransforms.resize(nodes.size());
+
+    for(unsigned int i = 0; i < modelMeshes.size(); i++){
+        ofxAssimpMeshHelper & helper = modelMeshes[i];
+        const aiMesh * mesh = helper.mesh;
+
+        helper.boneNodes.assign(mesh->mNumBones, -1);
+        helper.boneMatrices.assign(mesh->mNumBones * 16, 0);
+        helper.influenceOffsets.assign(mesh->mNumVertices + 1, 0);
+        for(unsigned int a = 0; a < mesh->mNumBones; a++){
+            const aiBone * bone = mesh->mBones[a];
+            aiNode * node = scene->mRootNode->FindNode(bone->mName);
+            if(node){
+                helper.boneNodes[a] = nodeIndices[node];
+            }
+            for(unsigned int b = 0; b < bone->mNumWeights; b++){
+                helper.influenceOffsets[bone->mWeights[b].mVertexId + 1]++;
+            }
+        }
+
+        // group the weights by vertex so each vertex is skinned in one go
+        for(unsigned int v = 0; v < mesh->mNumVertices; v++){
+            helper.influenceOffsets[v + 1] += helper.influenceOffsets[v];
+        }
+        helper.boneInfluences.resize(helper.influenceOffsets.back());
+        vector<unsigned int> next(helper.influenceOffsets.begin(), helper.influenceOffsets.end() - 1);
+        for(unsigned int a = 0; a < mesh->mNumBones; a++){
+            const aiBone * bone = mesh->mBones[a];
+            for(unsigned int b = 0; b < bone->mNumWeights; b++){
+                ofxAssimpBoneInfluence & influence = helper.boneInfluences[next[bone->mWeights[b].mVertexId]++];
+                influence.bone = a;
+                influence.weight = bone->mWeights[b].mWeight;
+            }
+        }
+    }
+}
+
 //------------------------------------------- update.
 void ofxAssimpModelLoader::update() {
+	if(isLoading()){
+		// finishing the load updates the model for the first time
+		if(asyncLoad.isReady()){
+			finishAsyncLoad();
+		}
+		return;
+	}
 	if(!scene) return;
     updateAnimations();
-    updateMeshes(scene->mRootNode, ofMatrix4x4());
+    updateNodes();
     if(hasAnimations() == false) {
         return;
     }
@@ -387,84 +792,72 @@ void ofxAssimpModelLoader::updateAnimations() {
     }
 }
 
-void ofxAssimpModelLoader::updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix) {
-    
-    aiMatrix4x4 m = node->mTransformation;
-    m.Transpose();
-	ofMatrix4x4 matrix(m.a1, m.a2, m.a3, m.a4,
-                       m.b1, m.b2, m.b3, m.b4,
-                       m.c1, m.c2, m.c3, m.c4,
-                       m.d1, m.d2, m.d3, m.d4);
-    matrix *= parentMatrix;
-    
-    for(unsigned int i=0; i<node->mNumMeshes; i++) {
-        int meshIndex = node->mMeshes[i];
-        ofxAssimpMeshHelper & mesh = modelMeshes[meshIndex];
-        mesh.matrix = matrix;
-    }
-    
-    for(unsigned int i=0; i<node->mNumChildren; i++) {
-        updateMeshes(node->mChildren[i], matrix);
+void ofxAssimpModelLoader::updateNodes() {
+    for(unsigned int i=0; i<nodes.size(); i++) {
+        const aiNode * node = nodes[i];
+        if(nodeParents[i] < 0) {
+            nodeTransforms[i] = node->mTransformation;
+        } else {
+            nodeTransforms[i] = nodeTransforms[nodeParents[i]] * node->mTransformation;
+        }
+
+        if(node->mNumMeshes) {
+            aiMatrix4x4 m = nodeTransforms[i];
+            m.Transpose();
+            ofMatrix4x4 matrix(m.a1, m.a2, m.a3, m.a4,
+                               m.b1, m.b2, m.b3, m.b4,
+                               m.c1, m.c2, m.c3, m.c4,
+                               m.d1, m.d2, m.d3, m.d4);
+            for(unsigned int j=0; j<node->mNumMeshes; j++) {
+                modelMeshes[node->mMeshes[j]].matrix = matrix;
+            }
+        }
     }
 }
 
 void ofxAssimpModelLoader::updateBones() {
     // update mesh position for the animation
 	for(unsigned int i=0; i<modelMeshes.size(); ++i) {
-		// current mesh we are introspecting
-		const aiMesh* mesh = modelMeshes[i].mesh;
-        
-		// calculate bone matrices
-		vector<aiMatrix4x4> boneMatrices(mesh->mNumBones);
-		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-            
-			// find the corresponding node by again looking recursively through the node hierarchy for the same name
-			aiNode* node = scene->mRootNode->FindNode(bone->mName);
-            
-			// start with the mesh-to-bone matrix
-			boneMatrices[a] = bone->mOffsetMatrix;
-			// and now append all node transformations down the parent chain until we're back at mesh coordinates again
-			const aiNode* tempNode = node;
-			while(tempNode) {
-				// check your matrix multiplication order here!!!
-				boneMatrices[a] = tempNode->mTransformation * boneMatrices[a];
-				// boneMatrices[a] = boneMatrices[a] * tempNode->mTransformation;
-				tempNode = tempNode->mParent;
-			}
-			modelMeshes[i].hasChanged = true;
-			modelMeshes[i].validCache = false;
-		}
-        
-		modelMeshes[i].animatedPos.assign(modelMeshes[i].animatedPos.size(),0);
-		if(mesh->HasNormals()){
-			modelMeshes[i].animatedNorm.assign(modelMeshes[i].animatedNorm.size(),0);
+		ofxAssimpMeshHelper & helper = modelMeshes[i];
+		const aiMesh* mesh = helper.mesh;
+		if(mesh->mNumBones == 0) {
+			continue;
 		}
-		// loop through all vertex weights of all bones
+
+		// bone matrices, from mesh to bone space and then down the parent chain
+		// of the bone's node back to mesh coordinates
 		for(unsigned int a=0; a<mesh->mNumBones; ++a) {
-			const aiBone* bone = mesh->mBones[a];
-			const aiMatrix4x4& posTrafo = boneMatrices[a];
-            
-			for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-				const aiVertexWeight& weight = bone->mWeights[b];
-                
-				size_t vertexId = weight.mVertexId;
-				const aiVector3D& srcPos = mesh->mVertices[vertexId];
-                
-				modelMeshes[i].animatedPos[vertexId] += weight.mWeight * (posTrafo * srcPos);
-			}
-			if(mesh->HasNormals()){
-				// 3x3 matrix, contains the bone matrix without the translation, only with rotation and possibly scaling
-				aiMatrix3x3 normTrafo = aiMatrix3x3( posTrafo);
-				for(unsigned int b=0; b<bone->mNumWeights; ++b) {
-					const aiVertexWeight& weight = bone->mWeights[b];
-					size_t vertexId = weight.mVertexId;
-                    
-					const aiVector3D& srcNorm = mesh->mNormals[vertexId];
-					modelMeshes[i].animatedNorm[vertexId] += weight.mWeight * (normTrafo * srcNorm);
-				}
+			aiMatrix4x4 m = mesh->mBones[a]->mOffsetMatrix;
+			if(helper.boneNodes[a] >= 0) {
+				m = nodeTransforms[helper.boneNodes[a]] * m;
 			}
+			float * column = &helper.boneMatrices[a * 16];
+			column[0] = m.a1; column[1] = m.b1; column[2] = m.c1; column[3] = 0;
+			column[4] = m.a2; column[5] = m.b2; column[6] = m.c2; column[7] = 0;
+			column[8] = m.a3; column[9] = m.b3; column[10] = m.c3; column[11] = 0;
+			column[12] = m.a4; column[13] = m.b4; column[14] = m.c4; column[15] = 0;
 		}
+
+		skinMesh(helper);
+		helper.hasChanged = true;
+		helper.validCache = false;
+	}
+}
+
+void ofxAssimpModelLoader::skinMesh(ofxAssimpMeshHelper & helper) {
+	// split big meshes in one range per thread, small ones aren't worth
+	// the synchronization
+	static const size_t minRangeSize = 4096;
+	size_t numVertices = helper.mesh->mNumVertices;
+	size_t numRanges = 1;
+	if(bParallelSkinning) {
+		numRanges = MIN(ofGetThreadPool().getNumThreads() + 1, numVertices / minRangeSize);
+	}
+	if(numRanges > 1) {
+		ofxAssimpSkinningJob job(helper);
+		ofParallelFor(job, 0, numVertices, (numVertices + numRanges - 1) / numRanges);
+	} else {
+		skinVertices(helper, 0, numVertices);
 	}
 }
 
@@ -705,7 +1098,7 @@ void ofxAssimpModelLoader::drawVertices(){
 
 //-------------------------------------------
 void ofxAssimpModelLoader::draw(ofPolyRenderMode renderType) {
-    if(scene == NULL) {
+    if(isLoading() || scene == NULL) {
         return;
     }
     
@@ -976,6 +1369,26 @@ const aiScene* ofxAssimpModelLoader::getAssimpScene(){
 	return scene.get();
 }
 
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::enableSceneCache(string folder){
+	sceneCacheFolder = folder;
+}
+
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::disableSceneCache(){
+	sceneCacheFolder = "";
+}
+
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::enableParallelSkinning(){
+	bParallelSkinning = true;
+}
+
+//--------------------------------------------------------------
+void ofxAssimpModelLoader::disableParallelSkinning(){
+	bParallelSkinning = false;
+}
+
 //--------------------------------------------------------------
 void ofxAssimpModelLoader::enableTextures(){
 	bUsingTextures = true;
@@ -30,6 +30,22 @@ class ofxAssimpModelLoader{
 
         bool loadModel(string modelName, bool optimize=false);
         bool loadModel(ofBuffer & buffer, bool optimize=false, const char * extension="");
+
+        // imports the model, its meshes and its textures in a thread of
+        // ofGetThreadPool() and creates the GL resources from the update()
+        // after that's done. The model stays empty until isLoading()
+        // returns false, clear() or another load drops the pending one.
+        bool loadModelAsync(string modelName, bool optimize=false);
+        bool isLoading();
+
+        // keeps a binary copy of every imported scene in folder, relative
+        // to the data folder, that is memory mapped instead of importing
+        // the model again the next time it's loaded from a file. disabled
+        // by default. the cache is keyed on the model file and the import
+        // flags only: changing the files it references, like the .mtl of
+        // an .obj, doesn't invalidate it, delete the folder when they change
+        void enableSceneCache(string folder = "assimpCache");
+        void disableSceneCache();
         void createEmptyModel();
         void createLightsFromAiModel();
         void optimizeScene();
@@ -84,6 +100,11 @@ class ofxAssimpModelLoader{
     	void drawFaces();
     	void drawVertices();
 
+    	// skinning of big meshes is split over the threads of ofGetThreadPool(),
+    	// enabled by default
+    	void enableParallelSkinning();
+    	void disableParallelSkinning();
+
     	void enableTextures();
     	void disableTextures();
     	void enableNormals();
@@ -114,16 +135,35 @@ class ofxAssimpModelLoader{
          
     protected:
     
+		class LoadTask;
+
 		void onAppExit(ofEventArgs & args);
         void updateAnimations();
-        void updateMeshes(aiNode * node, ofMatrix4x4 parentMatrix);
+        void updateNodes();
         void updateBones();
+        void skinMesh(ofxAssimpMeshHelper & mesh);
+
+        // caches the node hierarchy and the nodes and weights of every bone
+        void cacheSkeleton();
         void updateModelMatrix();
     
         // ai scene setup
         unsigned int initImportProperties(bool optimize);
+        shared_ptr<const aiScene> importScene(unsigned int flags);
         bool processScene();
 
+        // everything that doesn't need the GL context, can run in a thread
+        void prepareScene();
+        // the rest, in the main thread
+        void finishScene();
+        void finishAsyncLoad();
+
+        void calculateBoundingBox();
+        void calculateNormalizedScale();
+
+        // materials, textures pixels and mesh data
+        void loadMeshes();
+
         // Initial VBO creation, etc
         void loadGLResources();
     
@@ -151,6 +191,7 @@ class ofxAssimpModelLoader{
 
         vector<ofLight> lights;
         vector<ofxAssimpTexture> textures;
+        vector<ofPixels> texturePixels; // decoded by loadMeshes, uploaded to textures by loadGLResources
         vector<ofxAssimpMeshHelper> modelMeshes;
         vector<ofxAssimpAnimation> animations;
         int currentAnimation; // DEPRECATED - to be removed with deprecated animation functions.
@@ -159,8 +200,19 @@ class ofxAssimpModelLoader{
         bool bUsingNormals;
         bool bUsingColors;
         bool bUsingMaterials;
+        bool bParallelSkinning;
         float normalizeFactor;
 
+        // scene nodes in depth first order so parents come before their
+        // children, with the index of their parent and their global transform
+        vector<aiNode*> nodes;
+        vector<int> nodeParents;
+        vector<aiMatrix4x4> nodeTransforms;
+
+        string sceneCacheFolder;
+        ofFuture<shared_ptr<ofxAssimpModelLoader> > asyncLoad;
+        string loadError;
+
         // the main Asset Import scene that does the magic.
         shared_ptr<const aiScene> scene;
 };
@@ -0,0 +1,759 @@
+//
+//  ofxAssimpSceneCache.cpp
+//
+
+#include "ofxAssimpSceneCache.h"
+
+#include "aiScene.h"
+
+// bump when the layout of the files or the import properties set by
+// ofxAssimpModelLoader change, so files written before are ignored
+static const uint32_t cacheVersion = 1;
+static const char cacheMagic[8] = {'o','f','x','A','s','s','m','p'};
+
+// vertex data stored for a mesh, one bit per color and texture coordinate set
+enum{
+	normalsChannel = 1,
+	tangentsChannel = 2,
+	colorsChannel = 4,
+	texCoordsChannel = colorsChannel << AI_MAX_NUMBER_OF_COLOR_SETS
+};
+
+//--------------------------------------------------------------
+// reads 8 bytes at a time so hashing a model takes a small fraction of
+// the time importing it does
+static uint64_t hashData(const char * data, size_t size, uint64_t hash){
+	const uint64_t k0 = 0x9E3779B97F4A7C15ULL;
+	const uint64_t k1 = 0xC2B2AE3D27D4EB4FULL;
+	size_t i = 0;
+	for(; i + 8 <= size; i += 8){
+		uint64_t word;
+		memcpy(&word, data + i, 8);
+		hash ^= word * k0;
+		hash = ((hash << 31) | (hash >> 33)) * k1;
+	}
+	for(; i < size; i++){
+		hash ^= (unsigned char)data[i] * k0;
+		hash = ((hash << 31) | (hash >> 33)) * k1;
+	}
+	return hash;
+}
+
+//--------------------------------------------------------------
+// everything is padded to 4 bytes so the arrays in a mapped file can be
+// used in place
+static void writeData(ostream & out, const void * data, size_t size){
+	static const char padding[4] = {0, 0, 0, 0};
+	out.write((const char*)data, size);
+	out.write(padding, (4 - size % 4) % 4);
+}
+
+static void writeUInt(ostream & out, uint32_t value){
+	writeData(out, &value, sizeof(value));
+}
+
+static void writeFloat(ostream & out, float value){
+	writeData(out, &value, sizeof(value));
+}
+
+static void writeDouble(ostream & out, double value){
+	writeData(out, &value, sizeof(value));
+}
+
+static void writeString(ostream & out, const aiString & str){
+	writeUInt(out, str.length);
+	writeData(out, str.data, str.length);
+}
+
+//--------------------------------------------------------------
+// reads a cache file in order, the file is invalid once a read goes past
+// its end or finds a value out of range
+class ofxAssimpSceneReader{
+public:
+	ofxAssimpSceneReader(char * data, size_t size)
+	:pos(data)
+	,end(data + size)
+	,valid(true){}
+
+	// returns the next size bytes of the file, NULL if size is 0
+	char * read(uint64_t size){
+		uint64_t padded = (size + 3) & ~uint64_t(3);
+		if(!valid || padded > uint64_t(end - pos)){
+			valid = false;
+			return NULL;
+		}
+		if(size == 0){
+			return NULL;
+		}
+		char * data = pos;
+		pos += padded;
+		return data;
+	}
+
+	template<typename T>
+	T * readArray(uint64_t count){
+		if(count > uint64_t(end - pos) / sizeof(T)){
+			valid = false;
+			return NULL;
+		}
+		return (T*)read(count * sizeof(T));
+	}
+
+	void readInto(void * dst, size_t size){
+		char * data = read(size);
+		if(data){
+			memcpy(dst, data, size);
+		}
+	}
+
+	uint32_t readUInt(){
+		uint32_t value = 0;
+		readInto(&value, sizeof(value));
+		return value;
+	}
+
+	float readFloat(){
+		float value = 0;
+		readInto(&value, sizeof(value));
+		return value;
+	}
+
+	double readDouble(){
+		double value = 0;
+		readInto(&value, sizeof(value));
+		return value;
+	}
+
+	// number of elements of at least minSize bytes that follow
+	uint32_t readCount(size_t minSize){
+		uint32_t count = readUInt();
+		if(count > size_t(end - pos) / minSize){
+			valid = false;
+			return 0;
+		}
+		return count;
+	}
+
+	void readString(aiString & str){
+		uint32_t length = readUInt();
+		if(length >= MAXLEN){
+			valid = false;
+			return;
+		}
+		readInto(str.data, length);
+		str.data[length] = 0;
+		str.length = length;
+	}
+
+	// checks an index read from the file
+	void check(bool inRange){
+		valid = valid && inRange;
+	}
+
+	bool isValid() const{
+		return valid;
+	}
+
+	bool isAtEnd() const{
+		return pos == end;
+	}
+
+private:
+	char * pos;
+	char * end;
+	bool valid;
+};
+
+//--------------------------------------------------------------
+// deletes a scene read from a cache file. The arrays that point into the
+// mapped file are detached first so the scene doesn't delete them.
+class ofxAssimpCachedSceneDeleter{
+public:
+	ofxAssimpCachedSceneDeleter(shared_ptr<ofBuffer> file)
+	:file(file){}
+
+	void operator()(aiScene * scene){
+		for(unsigned int i = 0; scene->mMeshes && i < scene->mNumMeshes; i++){
+			aiMesh * mesh = scene->mMeshes[i];
+			if(!mesh){
+				continue;
+			}
+			release(mesh->mVertices);
+			release(mesh->mNormals);
+			release(mesh->mTangents);
+			release(mesh->mBitangents);
+			for(unsigned int j = 0; j < AI_MAX_NUMBER_OF_COLOR_SETS; j++){
+				release(mesh->mColors[j]);
+			}
+			for(unsigned int j = 0; j < AI_MAX_NUMBER_OF_TEXTURECOORDS; j++){
+				release(mesh->mTextureCoords[j]);
+			}
+			for(unsigned int j = 0; mesh->mFaces && j < mesh->mNumFaces; j++){
+				release(mesh->mFaces[j].mIndices);
+			}
+			for(unsigned int j = 0; mesh->mBones && j < mesh->mNumBones; j++){
+				if(mesh->mBones[j]){
+					release(mesh->mBones[j]->mWeights);
+				}
+			}
+		}
+		for(unsigned int i = 0; scene->mTextures && i < scene->mNumTextures; i++){
+			if(scene->mTextures[i]){
+				release(scene->mTextures[i]->pcData);
+			}
+		}
+		delete scene;
+	}
+
+private:
+	template<typename T>
+	void release(T *& data){
+		const char * begin = file->getData();
+		if((const char*)data >= begin && (const char*)data <= begin + file->size()){
+			data = NULL;
+		}
+	}
+
+	shared_ptr<ofBuffer> file;
+};
+
+//--------------------------------------------------------------
+static void writeMaterial(ostream & out, const aiMaterial * material){
+	writeUInt(out, material->mNumProperties);
+	for(unsigned int i = 0; i < material->mNumProperties; i++){
+		const aiMaterialProperty * property = material->mProperties[i];
+		writeString(out, property->mKey);
+		writeUInt(out, property->mSemantic);
+		writeUInt(out, property->mIndex);
+		writeUInt(out, property->mType);
+		writeUInt(out, property->mDataLength);
+		writeData(out, property->mData, property->mDataLength);
+	}
+}
+
+static aiMaterial * readMaterial(ofxAssimpSceneReader & reader){
+	// properties are deleted by ~aiMaterial like the ones assimp creates
+	aiMaterial * material = new aiMaterial;
+	material->mNumAllocated = reader.readCount(20);
+	material->mNumProperties = 0;
+	material->mProperties = new aiMaterialProperty*[material->mNumAllocated];
+	for(unsigned int i = 0; i < material->mNumAllocated && reader.isValid(); i++){
+		aiMaterialProperty * property = new aiMaterialProperty;
+		material->mProperties[material->mNumProperties++] = property;
+		reader.readString(property->mKey);
+		property->mSemantic = reader.readUInt();
+		property->mIndex = reader.readUInt();
+		property->mType = (aiPropertyTypeInfo)reader.readUInt();
+		property->mDataLength = reader.readUInt();
+		char * data = reader.read(property->mDataLength);
+		if(data){
+			property->mData = new char[property->mDataLength];
+			memcpy(property->mData, data, property->mDataLength);
+		}
+	}
+	return material;
+}
+
+//--------------------------------------------------------------
+static void writeMesh(ostream & out, const aiMesh * mesh){
+	unsigned int channels = 0;
+	if(mesh->HasNormals()){
+		channels |= normalsChannel;
+	}
+	if(mesh->HasTangentsAndBitangents()){
+		channels |= tangentsChannel;
+	}
+	for(unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; i++){
+		if(mesh->HasVertexColors(i)){
+			channels |= colorsChannel << i;
+		}
+	}
+	for(unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; i++){
+		if(mesh->HasTextureCoords(i)){
+			channels |= texCoordsChannel << i;
+		}
+	}
+
+	writeString(out, mesh->mName);
+	writeUInt(out, mesh->mPrimitiveTypes);
+	writeUInt(out, mesh->mMaterialIndex);
+	writeUInt(out, mesh->mNumVertices);
+	writeUInt(out, mesh->mNumFaces);
+	writeUInt(out, channels);
+
+	size_t vertexBytes = mesh->mNumVertices * sizeof(aiVector3D);
+	writeData(out, mesh->mVertices, vertexBytes);
+	if(channels & normalsChannel){
+		writeData(out, mesh->mNormals, vertexBytes);
+	}
+	if(channels & tangentsChannel){
+		writeData(out, mesh->mTangents, vertexBytes);
+		writeData(out, mesh->mBitangents, vertexBytes);
+	}
+	for(unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; i++){
+		if(channels & (colorsChannel << i)){
+			writeData(out, mesh->mColors[i], mesh->mNumVertices * sizeof(aiColor4D));
+		}
+	}
+	for(unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; i++){
+		if(channels & (texCoordsChannel << i)){
+			writeUInt(out, mesh->mNumUVComponents[i]);
+			writeData(out, mesh->mTextureCoords[i], vertexBytes);
+		}
+	}
+
+	// the size of every face and then all the indices, so they can be
+	// pointed to in place
+	vector<uint32_t> faceSizes(mesh->mNumFaces);
+	for(unsigned int i = 0; i < mesh->mNumFaces; i++){
+		faceSizes[i] = mesh->mFaces[i].mNumIndices;
+	}
+	writeData(out, faceSizes.empty() ? NULL : &faceSizes[0], faceSizes.size() * sizeof(uint32_t));
+	for(unsigned int i = 0; i < mesh->mNumFaces; i++){
+		writeData(out, mesh->mFaces[i].mIndices, mesh->mFaces[i].mNumIndices * sizeof(unsigned int));
+	}
+
+	writeUInt(out, mesh->mNumBones);
+	for(unsigned int i = 0; i < mesh->mNumBones; i++){
+		const aiBone * bone = mesh->mBones[i];
+		writeString(out, bone->mName);
+		writeData(out, &bone->mOffsetMatrix, sizeof(bone->mOffsetMatrix));
+		writeUInt(out, bone->mNumWeights);
+		writeData(out, bone->mWeights, bone->mNumWeights * sizeof(aiVertexWeight));
+	}
+}
+
+static aiMesh * readMesh(ofxAssimpSceneReader & reader, unsigned int numMaterials){
+	aiMesh * mesh = new aiMesh;
+	reader.readString(mesh->mName);
+	mesh->mPrimitiveTypes = reader.readUInt();
+	mesh->mMaterialIndex = reader.readUInt();
+	reader.check(mesh->mMaterialIndex < numMaterials);
+	mesh->mNumVertices = reader.readUInt();
+	unsigned int numFaces = reader.readUInt();
+	unsigned int channels = reader.readUInt();
+
+	unsigned int numVertices = mesh->mNumVertices;
+	mesh->mVertices = reader.readArray<aiVector3D>(numVertices);
+	if(channels & normalsChannel){
+		mesh->mNormals = reader.readArray<aiVector3D>(numVertices);
+	}
+	if(channels & tangentsChannel){
+		mesh->mTangents = reader.readArray<aiVector3D>(numVertices);
+		mesh->mBitangents = reader.readArray<aiVector3D>(numVertices);
+	}
+	for(unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; i++){
+		if(channels & (colorsChannel << i)){
+			mesh->mColors[i] = reader.readArray<aiColor4D>(numVertices);
+		}
+	}
+	for(unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; i++){
+		if(channels & (texCoordsChannel << i)){
+			mesh->mNumUVComponents[i] = reader.readUInt();
+			mesh->mTextureCoords[i] = reader.readArray<aiVector3D>(numVertices);
+		}
+	}
+
+	uint32_t * faceSizes = reader.readArray<uint32_t>(numFaces);
+	uint64_t numIndices = 0;
+	for(unsigned int i = 0; faceSizes && i < numFaces; i++){
+		numIndices += faceSizes[i];
+	}
+	unsigned int * indices = reader.readArray<unsigned int>(numIndices);
+	for(uint64_t i = 0; indices && i < numIndices; i++){
+		reader.check(indices[i] < numVertices);
+	}
+	if(reader.isValid() && numFaces){
+		mesh->mFaces = new aiFace[numFaces];
+		mesh->mNumFaces = numFaces;
+		for(unsigned int i = 0; i < numFaces; i++){
+			mesh->mFaces[i].mNumIndices = faceSizes[i];
+			mesh->mFaces[i].mIndices = faceSizes[i] ? indices : NULL;
+			indices += faceSizes[i];
+		}
+	}
+
+	unsigned int numBones = reader.readCount(4);
+	if(numBones){
+		mesh->mBones = new aiBone*[numBones]();
+		mesh->mNumBones = numBones;
+	}
+	for(unsigned int i = 0; i < numBones && reader.isValid(); i++){
+		aiBone * bone = new aiBone;
+		mesh->mBones[i] = bone;
+		reader.readString(bone->mName);
+		reader.readInto(&bone->mOffsetMatrix, sizeof(bone->mOffsetMatrix));
+		unsigned int numWeights = reader.readUInt();
+		bone->mWeights = reader.readArray<aiVertexWeight>(numWeights);
+		if(bone->mWeights){
+			bone->mNumWeights = numWeights;
+		}
+		for(unsigned int j = 0; j < bone->mNumWeights; j++){
+			reader.check(bone->mWeights[j].mVertexId < numVertices);
+		}
+	}
+	return mesh;
+}
+
+//--------------------------------------------------------------
+static void writeNode(ostream & out, const aiNode * node){
+	writeString(out, node->mName);
+	writeData(out, &node->mTransformation, sizeof(node->mTransformation));
+	writeUInt(out, node->mNumMeshes);
+	writeData(out, node->mMeshes, node->mNumMeshes * sizeof(unsigned int));
+	writeUInt(out, node->mNumChildren);
+	for(unsigned int i = 0; i < node->mNumChildren; i++){
+		writeNode(out, node->mChildren[i]);
+	}
+}
+
+static aiNode * readNode(ofxAssimpSceneReader & reader, aiNode * parent, unsigned int numMeshes){
+	aiNode * node = new aiNode;
+	node->mParent = parent;
+	reader.readString(node->mName);
+	reader.readInto(&node->mTransformation, sizeof(node->mTransformation));
+	unsigned int nodeMeshes = reader.readCount(sizeof(unsigned int));
+	if(nodeMeshes){
+		node->mMeshes = new unsigned int[nodeMeshes];
+		node->mNumMeshes = nodeMeshes;
+		reader.readInto(node->mMeshes, nodeMeshes * sizeof(unsigned int));
+		for(unsigned int i = 0; i < nodeMeshes; i++){
+			reader.check(node->mMeshes[i] < numMeshes);
+		}
+	}
+	unsigned int numChildren = reader.readCount(4);
+	if(numChildren){
+		node->mChildren = new aiNode*[numChildren]();
+		node->mNumChildren = numChildren;
+	}
+	for(unsigned int i = 0; i < numChildren && reader.isValid(); i++){
+		node->mChildren[i] = readNode(reader, node, numMeshes);
+	}
+	return node;
+}
+
+//--------------------------------------------------------------
+static void writeVectorKeys(ostream & out, const aiVectorKey * keys, unsigned int numKeys){
+	writeUInt(out, numKeys);
+	for(unsigned int i = 0; i < numKeys; i++){
+		writeDouble(out, keys[i].mTime);
+		writeData(out, &keys[i].mValue, sizeof(keys[i].mValue));
+	}
+}
+
+static void readVectorKeys(ofxAssimpSceneReader & reader, aiVectorKey *& keys, unsigned int & numKeys){
+	unsigned int count = reader.readCount(sizeof(double) + sizeof(aiVector3D));
+	if(count){
+		keys = new aiVectorKey[count];
+		numKeys = count;
+	}
+	for(unsigned int i = 0; i < count; i++){
+		keys[i].mTime = reader.readDouble();
+		reader.readInto(&keys[i].mValue, sizeof(keys[i].mValue));
+	}
+}
+
+static void writeQuatKeys(ostream & out, const aiQuatKey * keys, unsigned int numKeys){
+	writeUInt(out, numKeys);
+	for(unsigned int i = 0; i < numKeys; i++){
+		writeDouble(out, keys[i].mTime);
+		writeData(out, &keys[i].mValue, sizeof(keys[i].mValue));
+	}
+}
+
+static void readQuatKeys(ofxAssimpSceneReader & reader, aiQuatKey *& keys, unsigned int & numKeys){
+	unsigned int count = reader.readCount(sizeof(double) + sizeof(aiQuaternion));
+	if(count){
+		keys = new aiQuatKey[count];
+		numKeys = count;
+	}
+	for(unsigned int i = 0; i < count; i++){
+		keys[i].mTime = reader.readDouble();
+		reader.readInto(&keys[i].mValue, sizeof(keys[i].mValue));
+	}
+}
+
+static void writeAnimation(ostream & out, const aiAnimation * animation){
+	writeString(out, animation->mName);
+	writeDouble(out, animation->mDuration);
+	writeDouble(out, animation->mTicksPerSecond);
+	writeUInt(out, animation->mNumChannels);
+	for(unsigned int i = 0; i < animation->mNumChannels; i++){
+		const aiNodeAnim * channel = animation->mChannels[i];
+		writeString(out, channel->mNodeName);
+		writeUInt(out, channel->mPreState);
+		writeUInt(out, channel->mPostState);
+		writeVectorKeys(out, channel->mPositionKeys, channel->mNumPositionKeys);
+		writeQuatKeys(out, channel->mRotationKeys, channel->mNumRotationKeys);
+		writeVectorKeys(out, channel->mScalingKeys, channel->mNumScalingKeys);
+	}
+}
+
+static aiAnimation * readAnimation(ofxAssimpSceneReader & reader){
+	aiAnimation * animation = new aiAnimation;
+	reader.readString(animation->mName);
+	animation->mDuration = reader.readDouble();
+	animation->mTicksPerSecond = reader.readDouble();
+	unsigned int numChannels = reader.readCount(4);
+	if(numChannels){
+		animation->mChannels = new aiNodeAnim*[numChannels]();
+		animation->mNumChannels = numChannels;
+	}
+	for(unsigned int i = 0; i < numChannels && reader.isValid(); i++){
+		aiNodeAnim * channel = new aiNodeAnim;
+		animation->mChannels[i] = channel;
+		reader.readString(channel->mNodeName);
+		channel->mPreState = (aiAnimBehaviour)reader.readUInt();
+		channel->mPostState = (aiAnimBehaviour)reader.readUInt();
+		readVectorKeys(reader, channel->mPositionKeys, channel->mNumPositionKeys);
+		readQuatKeys(reader, channel->mRotationKeys, channel->mNumRotationKeys);
+		readVectorKeys(reader, channel->mScalingKeys, channel->mNumScalingKeys);
+	}
+	return animation;
+}
+
+//--------------------------------------------------------------
+// embedded textures, an array of texels or mWidth bytes of a compressed
+// image when mHeight is 0
+static uint64_t getTextureSize(const aiTexture * texture){
+	return texture->mHeight ? uint64_t(texture->mWidth) * texture->mHeight * sizeof(aiTexel) : texture->mWidth;
+}
+
+static void writeTexture(ostream & out, const aiTexture * texture){
+	writeUInt(out, texture->mWidth);
+	writeUInt(out, texture->mHeight);
+	writeData(out, texture->achFormatHint, sizeof(texture->achFormatHint));
+	writeData(out, texture->pcData, getTextureSize(texture));
+}
+
+static aiTexture * readTexture(ofxAssimpSceneReader & reader){
+	aiTexture * texture = new aiTexture;
+	texture->mWidth = reader.readUInt();
+	texture->mHeight = reader.readUInt();
+	reader.readInto(texture->achFormatHint, sizeof(texture->achFormatHint));
+	texture->pcData = (aiTexel*)reader.readArray<char>(getTextureSize(texture));
+	return texture;
+}
+
+//--------------------------------------------------------------
+static void writeLight(ostream & out, const aiLight * light){
+	writeString(out, light->mName);
+	writeUInt(out, light->mType);
+	writeData(out, &light->mPosition, sizeof(light->mPosition));
+	writeData(out, &light->mDirection, sizeof(light->mDirection));
+	writeFloat(out, light->mAttenuationConstant);
+	writeFloat(out, light->mAttenuationLinear);
+	writeFloat(out, light->mAttenuationQuadratic);
+	writeData(out, &light->mColorDiffuse, sizeof(light->mColorDiffuse));
+	writeData(out, &light->mColorSpecular, sizeof(light->mColorSpecular));
+	writeData(out, &light->mColorAmbient, sizeof(light->mColorAmbient));
+	writeFloat(out, light->mAngleInnerCone);
+	writeFloat(out, light->mAngleOuterCone);
+}
+
+static aiLight * readLight(ofxAssimpSceneReader & reader){
+	aiLight * light = new aiLight;
+	reader.readString(light->mName);
+	light->mType = (aiLightSourceType)reader.readUInt();
+	reader.readInto(&light->mPosition, sizeof(light->mPosition));
+	reader.readInto(&light->mDirection, sizeof(light->mDirection));
+	light->mAttenuationConstant = reader.readFloat();
+	light->mAttenuationLinear = reader.readFloat();
+	light->mAttenuationQuadratic = reader.readFloat();
+	reader.readInto(&light->mColorDiffuse, sizeof(light->mColorDiffuse));
+	reader.readInto(&light->mColorSpecular, sizeof(light->mColorSpecular));
+	reader.readInto(&light->mColorAmbient, sizeof(light->mColorAmbient));
+	light->mAngleInnerCone = reader.readFloat();
+	light->mAngleOuterCone = reader.readFloat();
+	return light;
+}
+
+static void writeCamera(ostream & out, const aiCamera * camera){
+	writeString(out, camera->mName);
+	writeData(out, &camera->mPosition, sizeof(camera->mPosition));
+	writeData(out, &camera->mUp, sizeof(camera->mUp));
+	writeData(out, &camera->mLookAt, sizeof(camera->mLookAt));
+	writeFloat(out, camera->mHorizontalFOV);
+	writeFloat(out, camera->mClipPlaneNear);
+	writeFloat(out, camera->mClipPlaneFar);
+	writeFloat(out, camera->mAspect);
+}
+
+static aiCamera * readCamera(ofxAssimpSceneReader & reader){
+	aiCamera * camera = new aiCamera;
+	reader.readString(camera->mName);
+	reader.readInto(&camera->mPosition, sizeof(camera->mPosition));
+	reader.readInto(&camera->mUp, sizeof(camera->mUp));
+	reader.readInto(&camera->mLookAt, sizeof(camera->mLookAt));
+	camera->mHorizontalFOV = reader.readFloat();
+	camera->mClipPlaneNear = reader.readFloat();
+	camera->mClipPlaneFar = reader.readFloat();
+	camera->mAspect = reader.readFloat();
+	return camera;
+}
+
+//--------------------------------------------------------------
+string ofxAssimpGetSceneCachePath(const string & folder, const string & modelPath, unsigned int flags){
+	ofBuffer model;
+	if(!model.mapFile(modelPath, ofBuffer::Sequential)){
+		return "";
+	}
+	uint64_t key[3] = {uint64_t(model.size()), flags, cacheVersion};
+	uint64_t hash = hashData(model.getData(), model.size(), 0);
+	hash = hashData((const char*)key, sizeof(key), hash);
+	string name = ofFilePath::getBaseName(modelPath) + "." + ofToHex(hash) + ".cache";
+	return ofFilePath::join(ofToDataPath(folder, true), name);
+}
+
+//--------------------------------------------------------------
+shared_ptr<const aiScene> ofxAssimpLoadSceneCache(const string & cachePath){
+	if(!ofFile::doesFileExist(cachePath, false)){
+		return shared_ptr<const aiScene>();
+	}
+	shared_ptr<ofBuffer> file(new ofBuffer);
+	if(!file->mapFile(cachePath, ofBuffer::Normal)){
+		ofLogError("ofxAssimpSceneCache") << "couldn't open cache file \"" << cachePath << "\"";
+		return shared_ptr<const aiScene>();
+	}
+
+	ofxAssimpSceneReader reader(file->getData(), file->size());
+	char magic[sizeof(cacheMagic)];
+	reader.readInto(magic, sizeof(magic));
+	if(memcmp(magic, cacheMagic, sizeof(magic)) != 0 || reader.readUInt() != cacheVersion){
+		ofLogWarning("ofxAssimpSceneCache") << "ignoring cache file with a different format \"" << cachePath << "\"";
+		return shared_ptr<const aiScene>();
+	}
+
+	ofxAssimpCachedSceneDeleter deleter(file);
+	aiScene * scene = new aiScene;
+	scene->mFlags = reader.readUInt();
+
+	unsigned int numMaterials = reader.readCount(4);
+	if(numMaterials){
+		scene->mMaterials = new aiMaterial*[numMaterials]();
+		scene->mNumMaterials = numMaterials;
+	}
+	for(unsigned int i = 0; i < numMaterials && reader.isValid(); i++){
+		scene->mMaterials[i] = readMaterial(reader);
+	}
+
+	unsigned int numMeshes = reader.readCount(4);
+	if(numMeshes){
+		scene->mMeshes = new aiMesh*[numMeshes]();
+		scene->mNumMeshes = numMeshes;
+	}
+	for(unsigned int i = 0; i < numMeshes && reader.isValid(); i++){
+		scene->mMeshes[i] = readMesh(reader, numMaterials);
+	}
+
+	if(reader.isValid()){
+		scene->mRootNode = readNode(reader, NULL, numMeshes);
+	}
+
+	unsigned int numAnimations = reader.readCount(4);
+	if(numAnimations){
+		scene->mAnimations = new aiAnimation*[numAnimations]();
+		scene->mNumAnimations = numAnimations;
+	}
+	for(unsigned int i = 0; i < numAnimations && reader.isValid(); i++){
+		scene->mAnimations[i] = readAnimation(reader);
+	}
+
+	unsigned int numTextures = reader.readCount(4);
+	if(numTextures){
+		scene->mTextures = new aiTexture*[numTextures]();
+		scene->mNumTextures = numTextures;
+	}
+	for(unsigned int i = 0; i < numTextures && reader.isValid(); i++){
+		scene->mTextures[i] = readTexture(reader);
+	}
+
+	unsigned int numLights = reader.readCount(4);
+	if(numLights){
+		scene->mLights = new aiLight*[numLights]();
+		scene->mNumLights = numLights;
+	}
+	for(unsigned int i = 0; i < numLights && reader.isValid(); i++){
+		scene->mLights[i] = readLight(reader);
+	}
+
+	unsigned int numCameras = reader.readCount(4);
+	if(numCameras){
+		scene->mCameras = new aiCamera*[numCameras]();
+		scene->mNumCameras = numCameras;
+	}
+	for(unsigned int i = 0; i < numCameras && reader.isValid(); i++){
+		scene->mCameras[i] = readCamera(reader);
+	}
+
+	if(!reader.isValid() || !reader.isAtEnd()){
+		ofLogError("ofxAssimpSceneCache") << "ignoring corrupt cache file \"" << cachePath << "\"";
+		deleter(scene);
+		return shared_ptr<const aiScene>();
+	}
+	return shared_ptr<const aiScene>(scene, deleter);
+}
+
+//--------------------------------------------------------------
+bool ofxAssimpSaveSceneCache(const aiScene & scene, const string & cachePath){
+	bool meshAnimations = false;
+	for(unsigned int i = 0; i < scene.mNumMeshes; i++){
+		meshAnimations |= scene.mMeshes[i]->mNumAnimMeshes != 0;
+	}
+	for(unsigned int i = 0; i < scene.mNumAnimations; i++){
+		meshAnimations |= scene.mAnimations[i]->mNumMeshChannels != 0;
+	}
+	if(meshAnimations){
+		ofLogWarning("ofxAssimpSceneCache") << "scenes with mesh animations can't be cached \"" << cachePath << "\"";
+		return false;
+	}
+
+	ofDirectory::createDirectory(ofFilePath::getEnclosingDirectory(cachePath, false), false, true);
+
+	// written to a temporary file first so there's never an incomplete
+	// cache file, even if two loaders write the same model at once
+	string tmpPath = cachePath + "." + ofToHex(&scene) + ".tmp";
+	ofstream out(tmpPath.c_str(), ios::binary);
+	out.write(cacheMagic, sizeof(cacheMagic));
+	writeUInt(out, cacheVersion);
+	writeUInt(out, scene.mFlags);
+
+	writeUInt(out, scene.mNumMaterials);
+	for(unsigned int i = 0; i < scene.mNumMaterials; i++){
+		writeMaterial(out, scene.mMaterials[i]);
+	}
+	writeUInt(out, scene.mNumMeshes);
+	for(unsigned int i = 0; i < scene.mNumMeshes; i++){
+		writeMesh(out, scene.mMeshes[i]);
+	}
+	writeNode(out, scene.mRootNode);
+	writeUInt(out, scene.mNumAnimations);
+	for(unsigned int i = 0; i < scene.mNumAnimations; i++){
+		writeAnimation(out, scene.mAnimations[i]);
+	}
+	writeUInt(out, scene.mNumTextures);
+	for(unsigned int i = 0; i < scene.mNumTextures; i++){
+		writeTexture(out, scene.mTextures[i]);
+	}
+	writeUInt(out, scene.mNumLights);
+	for(unsigned int i = 0; i < scene.mNumLights; i++){
+		writeLight(out, scene.mLights[i]);
+	}
+	writeUInt(out, scene.mNumCameras);
+	for(unsigned int i = 0; i < scene.mNumCameras; i++){
+		writeCamera(out, scene.mCameras[i]);
+	}
+	out.close();
+
+	if(!out || !ofFile::moveFromTo(tmpPath, cachePath, false, true)){
+		ofLogError("ofxAssimpSceneCache") << "couldn't write cache file \"" << cachePath << "\"";
+		ofFile::removeFile(tmpPath, false);
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofxAssimpIsCachedScene(const shared_ptr<const aiScene> & scene){
+	return std::get_deleter<ofxAssimpCachedSceneDeleter>(scene) != NULL;
+}
@@ -0,0 +1,33 @@
+//
+//  ofxAssimpSceneCache.h
+//
+//  Binary cache of imported scenes, so the import and post processing of a
+//  model only happen the first time it's loaded. The cache files are memory
+//  mapped and the vertex, face, weight and embedded texture data of a cached
+//  scene points into the mapping instead of being copied.
+//
+
+#pragma once
+
+#include "ofMain.h"
+
+struct aiScene;
+
+/// \returns the path of the cache file of a model imported with flags in
+/// folder, named after a hash of the contents of the model and the flags,
+/// or "" if the model can't be read. Only the model file is hashed, changing
+/// a file it references, like the .mtl of an .obj, doesn't invalidate it.
+string ofxAssimpGetSceneCachePath(const string & folder, const string & modelPath, unsigned int flags);
+
+/// \returns the scene in a cache file or NULL if it doesn't exist or isn't
+/// valid. The file stays mapped while the scene is alive.
+shared_ptr<const aiScene> ofxAssimpLoadSceneCache(const string & cachePath);
+
+/// \brief Writes a scene to a cache file.
+/// \returns false if it couldn't be written or the scene has mesh
+/// animations, which the cache doesn't support.
+bool ofxAssimpSaveSceneCache(const aiScene & scene, const string & cachePath);
+
+/// \returns true if the scene was loaded from a cache file. Assimp can't
+/// post process these with aiApplyPostProcessing.
+bool ofxAssimpIsCachedScene(const shared_ptr<const aiScene> & scene);
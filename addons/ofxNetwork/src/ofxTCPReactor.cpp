@@ -0,0 +1,534 @@
+#include "ofxTCPReactor.h"
+#include "ofLog.h"
+#include "ofUtils.h"
+#include <deque>
+
+#ifdef TARGET_LINUX
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+// bytes read from a socket at once
+static const int readBufferSize = 65536;
+
+//--------------------------------------------------------------
+// owned by the loop thread except the write queue, that any thread
+// sending to the client can fill under the client mutex
+struct ofxTCPReactor::Client{
+	Client()
+	:fd(-1)
+	,id(0)
+	,port(0)
+	,loop(NULL)
+	,sentBytes(0)
+	,queuedBytes(0)
+	,waitingWrite(false)
+	,closing(false){}
+
+	int fd;
+	int id;
+	string ip;
+	int port;
+	Loop * loop;
+
+	// read side, only used by the loop
+	string partialMessage;
+
+	// write side
+	ofMutex mutex;
+	std::deque<shared_ptr<const string> > queued;
+	size_t sentBytes;
+	size_t queuedBytes;
+	bool waitingWrite;
+	std::atomic<bool> closing;
+};
+
+#ifdef TARGET_LINUX
+
+// one epoll instance and the thread waiting on it
+struct ofxTCPReactor::Loop: public Poco::Runnable{
+	Loop(ofxTCPReactor & reactor)
+	:reactor(reactor)
+	,epollFd(epoll_create1(EPOLL_CLOEXEC))
+	,wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+	,exiting(false){
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = &wakeFd;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+	}
+
+	~Loop(){
+		::close(wakeFd);
+		::close(epollFd);
+	}
+
+	void wake(){
+		uint64_t one = 1;
+		if(::write(wakeFd, &one, sizeof(one)) < 0){
+			ofLogError("ofxTCPReactor") << "couldn't wake up the reactor thread";
+		}
+	}
+
+	void run(){
+		vector<epoll_event> ready(256);
+		vector<char> buffer(readBufferSize);
+		vector<Event> events;
+		readBuffer = &buffer[0];
+		while(!exiting){
+			int numReady = epoll_wait(epollFd, &ready[0], ready.size(), -1);
+			if(numReady < 0){
+				if(errno != EINTR){
+					ofLogError("ofxTCPReactor") << "epoll_wait failed: " << strerror(errno);
+					break;
+				}
+				continue;
+			}
+			for(int i = 0; i < numReady && !exiting; i++){
+				void * source = ready[i].data.ptr;
+				if(source == &wakeFd){
+					uint64_t count;
+					while(::read(wakeFd, &count, sizeof(count)) > 0);
+				}else if(source == &reactor.listenFd){
+					reactor.accept(*this);
+				}else{
+					Client & client = *static_cast<Client*>(source);
+					uint32_t flags = ready[i].events;
+					if(flags & EPOLLOUT){
+						if(!reactor.write(client)){
+							reactor.closeClient(*this, client, events);
+							continue;
+						}
+					}
+					if(flags & (EPOLLIN | EPOLLHUP | EPOLLERR)){
+						reactor.read(*this, client, events);
+					}
+				}
+			}
+			// everything read in this round is handed to the app at once
+			reactor.pushEvents(events);
+		}
+	}
+
+	ofxTCPReactor & reactor;
+	int epollFd;
+	int wakeFd;
+	std::atomic<bool> exiting;
+	char * readBuffer;
+	Poco::Thread thread;
+};
+
+#else
+
+struct ofxTCPReactor::Loop{};
+
+#endif
+
+//--------------------------------------------------------------
+ofxTCPReactor::ofxTCPReactor()
+:listenFd(-1)
+,mode(OFXTCP_RECEIVE_MESSAGES)
+,delimiter(new string)
+,maxQueuedBytes(64 * 1024 * 1024)
+,nextID(0){
+}
+
+ofxTCPReactor::~ofxTCPReactor(){
+	close();
+}
+
+//--------------------------------------------------------------
+bool ofxTCPReactor::setup(int port, ofxTCPReceiveMode _mode, const string & _delimiter, int numThreads){
+#ifdef TARGET_LINUX
+	close();
+	mode = _mode;
+	setDelimiter(_delimiter);
+
+	listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(listenFd < 0){
+		ofLogError("ofxTCPReactor") << "setup(): couldn't create socket: " << strerror(errno);
+		return false;
+	}
+	int reuse = 1;
+	setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+	sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(port);
+	if(bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0){
+		ofLogError("ofxTCPReactor") << "setup(): couldn't bind to port " << port << ": " << strerror(errno);
+		close();
+		return false;
+	}
+	if(listen(listenFd, SOMAXCONN) < 0){
+		ofLogError("ofxTCPReactor") << "setup(): couldn't listen on port " << port << ": " << strerror(errno);
+		close();
+		return false;
+	}
+
+	numThreads = max(numThreads, 1);
+	for(int i = 0; i < numThreads; i++){
+		loops.push_back(new Loop(*this));
+	}
+
+	// the first loop accepts the connections and spreads them over all
+	epoll_event event;
+	event.events = EPOLLIN;
+	event.data.ptr = &listenFd;
+	epoll_ctl(loops[0]->epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+	for(int i = 0; i < numThreads; i++){
+		loops[i]->thread.setName("ofxTCPReactor " + ofToString(i));
+		loops[i]->thread.start(*loops[i]);
+	}
+	return true;
+#else
+	ofLogError("ofxTCPReactor") << "setup(): the event driven mode is only available on linux";
+	return false;
+#endif
+}
+
+//--------------------------------------------------------------
+void ofxTCPReactor::close(){
+#ifdef TARGET_LINUX
+	for(size_t i = 0; i < loops.size(); i++){
+		loops[i]->exiting = true;
+		loops[i]->wake();
+	}
+	for(size_t i = 0; i < loops.size(); i++){
+		loops[i]->thread.join();
+		delete loops[i];
+	}
+	loops.clear();
+
+	ofScopedLock lock(clientsMutex);
+	for(ClientMap::iterator it = clients.begin(); it != clients.end(); ++it){
+		::close(it->second->fd);
+	}
+	clients.clear();
+
+	if(listenFd >= 0){
+		::close(listenFd);
+		listenFd = -1;
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+shared_ptr<ofxTCPReactor::Client> ofxTCPReactor::getClient(int clientID){
+	ofScopedLock lock(clientsMutex);
+	ClientMap::iterator it = clients.find(clientID);
+	if(it == clients.end()){
+		return shared_ptr<Client>();
+	}
+	return it->second;
+}
+
+// read from the loops and from send, so it's replaced instead of modified
+shared_ptr<const string> ofxTCPReactor::getDelimiter(){
+	ofScopedLock lock(delimiterMutex);
+	return delimiter;
+}
+
+//--------------------------------------------------------------
+void ofxTCPReactor::accept(Loop & loop){
+#ifdef TARGET_LINUX
+	while(true){
+		sockaddr_in address;
+		socklen_t addressSize = sizeof(address);
+		int fd = accept4(listenFd, (sockaddr*)&address, &addressSize, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if(fd < 0){
+			if(errno == EINTR || errno == ECONNABORTED) continue;
+			if(errno != EAGAIN && errno != EWOULDBLOCK){
+				ofLogError("ofxTCPReactor") << "couldn't accept client: " << strerror(errno);
+			}
+			return;
+		}
+
+		shared_ptr<Client> client(new Client);
+		client->fd = fd;
+		client->id = nextID++;
+		char ip[INET_ADDRSTRLEN];
+		inet_ntop(AF_INET, &address.sin_addr, ip, sizeof(ip));
+		client->ip = ip;
+		client->port = ntohs(address.sin_port);
+		client->loop = loops[client->id % loops.size()];
+
+		{
+			ofScopedLock lock(clientsMutex);
+			clients[client->id] = client;
+		}
+
+		// notify the connection before any data of the client can be read
+		{
+			ofScopedLock lock(eventsMutex);
+			Event connected = { Event::Connected, client->id, string() };
+			events.push_back(connected);
+		}
+
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = client.get();
+		epoll_ctl(client->loop->epollFd, EPOLL_CTL_ADD, fd, &event);
+		ofLogVerbose("ofxTCPReactor") << "client " << client->id << " connected from " << client->ip << ":" << client->port;
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofxTCPReactor::read(Loop & loop, Client & client, vector<Event> & events){
+#ifdef TARGET_LINUX
+	ssize_t size = recv(client.fd, loop.readBuffer, readBufferSize, 0);
+	if(size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)){
+		return;
+	}
+	if(size <= 0){
+		closeClient(loop, client, events);
+		return;
+	}
+
+	if(mode == OFXTCP_RECEIVE_RAW){
+		Event received = { Event::Received, client.id, string(loop.readBuffer, size) };
+		events.push_back(received);
+		return;
+	}
+
+	// like ofxTCPClient::receive, zeros aren't part of the messages
+	shared_ptr<const string> currentDelimiter = getDelimiter();
+	const string & delimiter = *currentDelimiter;
+	string & partial = client.partialMessage;
+	size_t searchFrom = partial.size() >= delimiter.size() ? partial.size() - delimiter.size() + 1 : 0;
+	for(ssize_t i = 0; i < size; i++){
+		if(loop.readBuffer[i] != 0){
+			partial += loop.readBuffer[i];
+		}
+	}
+	size_t begin = 0;
+	size_t end;
+	while((end = partial.find(delimiter, max(begin, searchFrom))) != string::npos){
+		Event received = { Event::Received, client.id, partial.substr(begin, end - begin) };
+		events.push_back(received);
+		begin = end + delimiter.size();
+	}
+	partial.erase(0, begin);
+#endif
+}
+
+//--------------------------------------------------------------
+// writes as much of the queue as the socket accepts, called with the
+// client mutex locked or from the loop. returns false on error
+static bool writeQueued(int fd, std::deque<shared_ptr<const string> > & queued, size_t & sentBytes, size_t & queuedBytes){
+#ifdef TARGET_LINUX
+	while(!queued.empty()){
+		const string & data = *queued.front();
+		ssize_t sent = ::send(fd, data.c_str() + sentBytes, data.size() - sentBytes, MSG_NOSIGNAL);
+		if(sent < 0){
+			if(errno == EINTR) continue;
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+		sentBytes += sent;
+		queuedBytes -= sent;
+		if(sentBytes == data.size()){
+			queued.pop_front();
+			sentBytes = 0;
+		}
+	}
+#endif
+	return true;
+}
+
+bool ofxTCPReactor::write(Client & client){
+#ifdef TARGET_LINUX
+	ofScopedLock lock(client.mutex);
+	if(!writeQueued(client.fd, client.queued, client.sentBytes, client.queuedBytes)){
+		return false;
+	}
+	if(client.queued.empty() && client.waitingWrite){
+		// everything sent, stop waiting for the socket to be writable
+		epoll_event event;
+		event.events = EPOLLIN;
+		event.data.ptr = &client;
+		epoll_ctl(client.loop->epollFd, EPOLL_CTL_MOD, client.fd, &event);
+		client.waitingWrite = false;
+	}
+#endif
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofxTCPReactor::queue(Client & client, const shared_ptr<const string> & data){
+#ifdef TARGET_LINUX
+	ofScopedLock lock(client.mutex);
+	if(client.closing) return false;
+	client.queued.push_back(data);
+	client.queuedBytes += data->size();
+	if(!client.waitingWrite){
+		// try to send right away, only wait for the loop if the socket
+		// can't take everything
+		if(!writeQueued(client.fd, client.queued, client.sentBytes, client.queuedBytes)){
+			client.closing = true;
+			shutdown(client.fd, SHUT_RDWR);
+			return false;
+		}
+		if(!client.queued.empty()){
+			epoll_event event;
+			event.events = EPOLLIN | EPOLLOUT;
+			event.data.ptr = &client;
+			epoll_ctl(client.loop->epollFd, EPOLL_CTL_MOD, client.fd, &event);
+			client.waitingWrite = true;
+		}
+	}else if(client.queuedBytes > maxQueuedBytes){
+		ofLogWarning("ofxTCPReactor") << "client " << client.id << " isn't reading fast enough, "
+				<< client.queuedBytes << " bytes queued, disconnecting it";
+		client.closing = true;
+		// the loop sees the hang up and removes the client
+		shutdown(client.fd, SHUT_RDWR);
+		return false;
+	}
+#endif
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofxTCPReactor::closeClient(Loop & loop, Client & client, vector<Event> & events){
+#ifdef TARGET_LINUX
+	epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, client.fd, NULL);
+	int id = client.id;
+	shared_ptr<Client> keepAlive;
+	{
+		ofScopedLock lock(clientsMutex);
+		ClientMap::iterator it = clients.find(id);
+		if(it != clients.end()){
+			keepAlive = it->second;
+			clients.erase(it);
+		}
+	}
+	{
+		// wait for any thread writing to it before closing the socket
+		ofScopedLock lock(client.mutex);
+		client.closing = true;
+		::close(client.fd);
+	}
+	Event disconnected = { Event::Disconnected, id, string() };
+	events.push_back(disconnected);
+	ofLogVerbose("ofxTCPReactor") << "client " << id << " disconnected";
+#endif
+}
+
+//--------------------------------------------------------------
+void ofxTCPReactor::pushEvents(vector<Event> & newEvents){
+	if(newEvents.empty()) return;
+	ofScopedLock lock(eventsMutex);
+	if(events.empty()){
+		events.swap(newEvents);
+	}else{
+		events.insert(events.end(), newEvents.begin(), newEvents.end());
+		newEvents.clear();
+	}
+}
+
+void ofxTCPReactor::getEvents(vector<Event> & received){
+	received.clear();
+	ofScopedLock lock(eventsMutex);
+	events.swap(received);
+}
+
+//--------------------------------------------------------------
+bool ofxTCPReactor::send(int clientID, const char * data, int size, bool appendDelimiter){
+	shared_ptr<Client> client = getClient(clientID);
+	if(!client){
+		ofLogWarning("ofxTCPReactor") << "send(): client " << clientID << " doesn't exist";
+		return false;
+	}
+	shared_ptr<string> message(new string(data, size));
+	if(appendDelimiter) *message += *getDelimiter();
+	return queue(*client, message);
+}
+
+bool ofxTCPReactor::sendToAll(const char * data, int size, bool appendDelimiter){
+	// the same buffer is queued for every client
+	shared_ptr<string> message(new string(data, size));
+	if(appendDelimiter) *message += *getDelimiter();
+	vector<shared_ptr<Client> > all;
+	{
+		ofScopedLock lock(clientsMutex);
+		if(clients.empty()) return false;
+		all.reserve(clients.size());
+		for(ClientMap::iterator it = clients.begin(); it != clients.end(); ++it){
+			all.push_back(it->second);
+		}
+	}
+	for(size_t i = 0; i < all.size(); i++){
+		queue(*all[i], message);
+	}
+	return true;
+}
+
+bool ofxTCPReactor::disconnectClient(int clientID){
+	shared_ptr<Client> client = getClient(clientID);
+	if(!client){
+		ofLogWarning("ofxTCPReactor") << "disconnectClient(): client " << clientID << " doesn't exist";
+		return false;
+	}
+#ifdef TARGET_LINUX
+	ofScopedLock lock(client->mutex);
+	if(!client->closing){
+		client->closing = true;
+		// the loop sees the hang up and removes the client
+		shutdown(client->fd, SHUT_RDWR);
+	}
+#endif
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofxTCPReactor::setMaxQueuedBytes(size_t bytes){
+	maxQueuedBytes = bytes;
+}
+
+void ofxTCPReactor::setDelimiter(const string & _delimiter){
+	shared_ptr<const string> next(new string(_delimiter));
+	ofScopedLock lock(delimiterMutex);
+	delimiter = next;
+}
+
+int ofxTCPReactor::getNumClients(){
+	ofScopedLock lock(clientsMutex);
+	return clients.size();
+}
+
+int ofxTCPReactor::getLastID(){
+	return nextID;
+}
+
+bool ofxTCPReactor::isClientConnected(int clientID){
+	shared_ptr<Client> client = getClient(clientID);
+	return client && !client->closing;
+}
+
+string ofxTCPReactor::getClientIP(int clientID){
+	shared_ptr<Client> client = getClient(clientID);
+	if(!client){
+		ofLogWarning("ofxTCPReactor") << "getClientIP(): client " << clientID << " doesn't exist";
+		return "000.000.000.000";
+	}
+	return client->ip;
+}
+
+int ofxTCPReactor::getClientPort(int clientID){
+	shared_ptr<Client> client = getClient(clientID);
+	if(!client){
+		ofLogWarning("ofxTCPReactor") << "getClientPort(): client " << clientID << " doesn't exist";
+		return 0;
+	}
+	return client->port;
+}
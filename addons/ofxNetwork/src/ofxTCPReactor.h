@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofTypes.h"
+#include <atomic>
+#include <map>
+
+/// how the event driven mode of ofxTCPServer delivers received data
+enum ofxTCPReceiveMode{
+	/// complete messages ended by the message delimiter, without it
+	OFXTCP_RECEIVE_MESSAGES,
+	/// every chunk of bytes as it's read from the socket
+	OFXTCP_RECEIVE_RAW
+};
+
+/// data received from a client in the event driven mode of ofxTCPServer
+class ofxTCPMessage{
+public:
+	int clientID;
+	string data;
+};
+
+/// accepts, reads and writes the clients of ofxTCPServer::setupReactor
+/// without blocking on a few threads using epoll. only available on linux
+class ofxTCPReactor{
+public:
+	struct Event{
+		enum Type{
+			Connected,
+			Received,
+			Disconnected
+		};
+		Type type;
+		int clientID;
+		string data;
+	};
+
+	ofxTCPReactor();
+	~ofxTCPReactor();
+
+	bool setup(int port, ofxTCPReceiveMode mode, const string & delimiter, int numThreads);
+	void close();
+
+	/// queues data for a client, appending the message delimiter if
+	/// asked. never blocks, the data is written as the socket accepts it
+	bool send(int clientID, const char * data, int size, bool appendDelimiter);
+	bool sendToAll(const char * data, int size, bool appendDelimiter);
+	bool disconnectClient(int clientID);
+
+	/// bytes queued for a client beyond which it's disconnected
+	void setMaxQueuedBytes(size_t bytes);
+
+	/// delimiter used by the data received and sent after the call
+	void setDelimiter(const string & delimiter);
+
+	int getNumClients();
+	int getLastID();
+	bool isClientConnected(int clientID);
+	string getClientIP(int clientID);
+	int getClientPort(int clientID);
+
+	/// swaps events with the events that happened since the last call,
+	/// in the order they happened
+	void getEvents(vector<Event> & events);
+
+private:
+	struct Client;
+	struct Loop;
+	typedef map<int, shared_ptr<Client> > ClientMap;
+
+	shared_ptr<Client> getClient(int clientID);
+	shared_ptr<const string> getDelimiter();
+	void accept(Loop & loop);
+	void read(Loop & loop, Client & client, vector<Event> & events);
+	bool write(Client & client);
+	bool queue(Client & client, const shared_ptr<const string> & data);
+	void closeClient(Loop & loop, Client & client, vector<Event> & events);
+	void pushEvents(vector<Event> & events);
+
+	vector<Loop*> loops;
+	int listenFd;
+	ofxTCPReceiveMode mode;
+	ofMutex delimiterMutex;
+	shared_ptr<const string> delimiter;
+	size_t maxQueuedBytes;
+	std::atomic<int> nextID;
+
+	ofMutex clientsMutex;
+	ClientMap clients;
+
+	ofMutex eventsMutex;
+	vector<Event> events;
+};
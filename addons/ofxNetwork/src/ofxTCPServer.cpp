@@ -41,16 +41,77 @@ bool ofxTCPServer::setup(int _port, bool blocking){
 	return true;
 }
 
+//--------------------------
+bool ofxTCPServer::setupReactor(int _port, ofxTCPReceiveMode mode, int numThreads){
+	close();
+	reactor = ofPtr<ofxTCPReactor>(new ofxTCPReactor);
+	if( !reactor->setup(_port, mode, messageDelimiter, numThreads) ){
+		ofLogError("ofxTCPServer") << "setupReactor(): couldn't setup server on port " << _port;
+		reactor.reset();
+		return false;
+	}
+
+	connected		= true;
+	port			= _port;
+
+	ofAddListener(ofEvents().update, this, &ofxTCPServer::dispatchReactorEvents, OF_EVENT_ORDER_BEFORE_APP);
+	return true;
+}
+
+//--------------------------
+void ofxTCPServer::setMaxQueuedBytes(size_t bytes){
+	if(reactor) reactor->setMaxQueuedBytes(bytes);
+	else ofLogWarning("ofxTCPServer") << "setMaxQueuedBytes(): only used in the event driven mode, call setupReactor() first";
+}
+
+//--------------------------
+void ofxTCPServer::dispatchReactorEvents(ofEventArgs &){
+	reactor->getEvents(reactorEvents);
+	// consecutive messages are notified together, connections and
+	// disconnections keep their order with respect to them
+	receivedMessages.clear();
+	for(size_t i = 0; i < reactorEvents.size(); i++){
+		ofxTCPReactor::Event & event = reactorEvents[i];
+		if(event.type == ofxTCPReactor::Event::Received){
+			receivedMessages.push_back(ofxTCPMessage());
+			receivedMessages.back().clientID = event.clientID;
+			receivedMessages.back().data.swap(event.data);
+			continue;
+		}
+		if(!receivedMessages.empty()){
+			ofNotifyEvent(messagesReceived, receivedMessages, this);
+			receivedMessages.clear();
+		}
+		if(event.type == ofxTCPReactor::Event::Connected){
+			ofNotifyEvent(clientConnected, event.clientID, this);
+		}else{
+			ofNotifyEvent(clientDisconnected, event.clientID, this);
+		}
+	}
+	if(!receivedMessages.empty()){
+		ofNotifyEvent(messagesReceived, receivedMessages, this);
+	}
+}
+
 //--------------------------
 void ofxTCPServer::setMessageDelimiter(string delim){
 	if(delim != ""){
 		messageDelimiter = delim;
+		if(reactor) reactor->setDelimiter(delim);
 	}
 }
 
 //--------------------------
 bool ofxTCPServer::close(){
 
+	if(reactor){
+		ofRemoveListener(ofEvents().update, this, &ofxTCPServer::dispatchReactorEvents, OF_EVENT_ORDER_BEFORE_APP);
+		reactor->close();
+		reactor.reset();
+		connected = false;
+		return true;
+	}
+
 	if(connected)
 	{
 		mConnectionsLock.lock();
@@ -83,6 +144,7 @@ ofxTCPClient & ofxTCPServer::getClient(int clientID){
 
 //--------------------------
 bool ofxTCPServer::disconnectClient(int clientID){
+	if(reactor) return reactor->disconnectClient(clientID);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "disconnectClient(): client " << clientID << " doesn't exist";
@@ -96,6 +158,7 @@ bool ofxTCPServer::disconnectClient(int clientID){
 
 //--------------------------
 bool ofxTCPServer::send(int clientID, string message){
+	if(reactor) return reactor->send(clientID, message.c_str(), message.size(), true);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "send(): client " << clientID << " doesn't exist";
@@ -109,6 +172,7 @@ bool ofxTCPServer::send(int clientID, string message){
 
 //--------------------------
 bool ofxTCPServer::sendToAll(string message){
+	if(reactor) return reactor->sendToAll(message.c_str(), message.size(), true);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if(TCPConnections.size() == 0) return false;
 
@@ -126,6 +190,10 @@ bool ofxTCPServer::sendToAll(string message){
 
 //--------------------------
 string ofxTCPServer::receive(int clientID){
+	if(reactor){
+		ofLogWarning("ofxTCPServer") << "receive(): not available in the event driven mode, use messagesReceived";
+		return "";
+	}
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "receive(): client " << clientID << " doesn't exist";
@@ -142,6 +210,7 @@ string ofxTCPServer::receive(int clientID){
 
 //--------------------------
 bool ofxTCPServer::sendRawBytes(int clientID, const char * rawBytes, const int numBytes){
+	if(reactor) return reactor->send(clientID, rawBytes, numBytes, false);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "sendRawBytes(): client " << clientID << " doesn't exist";
@@ -155,6 +224,7 @@ bool ofxTCPServer::sendRawBytes(int clientID, const char * rawBytes, const int n
 
 //--------------------------
 bool ofxTCPServer::sendRawBytesToAll(const char * rawBytes, const int numBytes){
+	if(reactor) return numBytes > 0 && reactor->sendToAll(rawBytes, numBytes, false);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if(TCPConnections.size() == 0 || numBytes <= 0) return false;
 
@@ -168,6 +238,7 @@ bool ofxTCPServer::sendRawBytesToAll(const char * rawBytes, const int numBytes){
 
 //--------------------------
 bool ofxTCPServer::sendRawMsg(int clientID, const char * rawBytes, const int numBytes){
+	if(reactor) return reactor->send(clientID, rawBytes, numBytes, true);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "sendRawMsg(): client " << clientID << " doesn't exist";
@@ -180,6 +251,7 @@ bool ofxTCPServer::sendRawMsg(int clientID, const char * rawBytes, const int num
 
 //--------------------------
 bool ofxTCPServer::sendRawMsgToAll(const char * rawBytes, const int numBytes){
+	if(reactor) return numBytes > 0 && reactor->sendToAll(rawBytes, numBytes, true);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if(TCPConnections.size() == 0 || numBytes <= 0) return false;
 
@@ -192,6 +264,10 @@ bool ofxTCPServer::sendRawMsgToAll(const char * rawBytes, const int numBytes){
 
 //--------------------------
 int ofxTCPServer::getNumReceivedBytes(int clientID){
+	if(reactor){
+		ofLogWarning("ofxTCPServer") << "getNumReceivedBytes(): not available in the event driven mode, use messagesReceived";
+		return 0;
+	}
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "getNumReceivedBytes(): client " << clientID << " doesn't exist";
@@ -203,6 +279,10 @@ int ofxTCPServer::getNumReceivedBytes(int clientID){
 
 //--------------------------
 int ofxTCPServer::receiveRawBytes(int clientID, char * receiveBytes,  int numBytes){
+	if(reactor){
+		ofLogWarning("ofxTCPServer") << "receiveRawBytes(): not available in the event driven mode, use messagesReceived";
+		return 0;
+	}
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "receiveRawBytes(): client " << clientID << " doesn't exist";
@@ -215,6 +295,10 @@ int ofxTCPServer::receiveRawBytes(int clientID, char * receiveBytes,  int numByt
 
 //--------------------------
 int ofxTCPServer::peekReceiveRawBytes(int clientID, char * receiveBytes,  int numBytes){
+	if(reactor){
+		ofLogWarning("ofxTCPServer") << "peekReceiveRawBytes(): not available in the event driven mode, use messagesReceived";
+		return 0;
+	}
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLog(OF_LOG_WARNING, "ofxTCPServer: client " + ofToString(clientID) + " doesn't exist");
@@ -226,6 +310,10 @@ int ofxTCPServer::peekReceiveRawBytes(int clientID, char * receiveBytes,  int nu
 
 //--------------------------
 int ofxTCPServer::receiveRawMsg(int clientID, char * receiveBytes,  int numBytes){
+	if(reactor){
+		ofLogWarning("ofxTCPServer") << "receiveRawMsg(): not available in the event driven mode, use messagesReceived";
+		return 0;
+	}
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "receiveRawMsg(): client " << clientID << " doesn't exist";
@@ -237,6 +325,7 @@ int ofxTCPServer::receiveRawMsg(int clientID, char * receiveBytes,  int numBytes
 
 //--------------------------
 int ofxTCPServer::getClientPort(int clientID){
+	if(reactor) return reactor->getClientPort(clientID);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "getClientPort(): client " << clientID << " doesn't exist";
@@ -247,6 +336,7 @@ int ofxTCPServer::getClientPort(int clientID){
 
 //--------------------------
 string ofxTCPServer::getClientIP(int clientID){
+	if(reactor) return reactor->getClientIP(clientID);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	if( !isClientSetup(clientID) ){
 		ofLogWarning("ofxTCPServer") << "getClientIP(): client " << clientID << " doesn't exist";
@@ -257,12 +347,14 @@ string ofxTCPServer::getClientIP(int clientID){
 
 //--------------------------
 int ofxTCPServer::getNumClients(){
+	if(reactor) return reactor->getNumClients();
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	return TCPConnections.size();
 }
 
 //--------------------------
 int ofxTCPServer::getLastID(){
+	if(reactor) return reactor->getLastID();
 	return idCount;
 }
 
@@ -284,6 +376,7 @@ bool ofxTCPServer::isClientSetup(int clientID){
 
 //--------------------------
 bool ofxTCPServer::isClientConnected(int clientID){
+	if(reactor) return reactor->isClientConnected(clientID);
 	ofMutex::ScopedLock Lock( mConnectionsLock );
 	return isClientSetup(clientID) && getClient(clientID).isConnected();
 }
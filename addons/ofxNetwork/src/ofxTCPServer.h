@@ -3,6 +3,8 @@
 #include "ofConstants.h"
 #include "ofThread.h"
 #include "ofxTCPManager.h"
+#include "ofxTCPReactor.h"
+#include "ofEvents.h"
 #include <map>
 
 #define TCP_MAX_CLIENTS  32
@@ -18,6 +20,22 @@ class ofxTCPServer : public ofThread{
 		~ofxTCPServer();
 		void setVerbose(bool _verbose);
 		bool setup(int _port, bool blocking = false);
+
+		//event driven mode, linux only: instead of polling every client
+		//with receive(), the clients are accepted, read and written without
+		//blocking by numThreads threads using epoll, with no limit in the
+		//number of clients. the received data is notified before update
+		//through messagesReceived in a batch per frame, complete messages
+		//ended by the message delimiter or raw chunks depending on mode.
+		//send and sendToAll queue the data and never block
+		bool setupReactor(int _port, ofxTCPReceiveMode mode = OFXTCP_RECEIVE_MESSAGES, int numThreads = 1);
+
+		//in the event driven mode, clients with more bytes than this waiting
+		//to be sent are disconnected, 64MB by default
+		void setMaxQueuedBytes(size_t bytes);
+
+		//can be changed after setupReactor, the event driven mode uses it
+		//for the data received and sent from then on
 		void setMessageDelimiter(string delim);
 	
 		bool close();
@@ -78,6 +96,11 @@ class ofxTCPServer : public ofThread{
 		//amount of filled-bytes returned
 		int peekReceiveRawBytes(int clientID, char * receiveBytes,  int numBytes);
 
+		//events of the event driven mode, notified in the main thread
+		ofEvent<vector<ofxTCPMessage> > messagesReceived;
+		ofEvent<int> clientConnected;
+		ofEvent<int> clientDisconnected;
+
 
 
 	private:
@@ -89,6 +112,7 @@ class ofxTCPServer : public ofThread{
 		bool isClientSetup(int clientID);
 
 		void threadedFunction();
+		void dispatchReactorEvents(ofEventArgs & args);
 
 		ofxTCPManager			TCPServer;
 		map<int,ofPtr<ofxTCPClient> >	TCPConnections;
@@ -100,4 +124,8 @@ class ofxTCPServer : public ofThread{
 		bool			bClientBlocking;
 		string			messageDelimiter;
 
+		ofPtr<ofxTCPReactor>	reactor;
+		vector<ofxTCPReactor::Event>	reactorEvents;
+		vector<ofxTCPMessage>	receivedMessages;
+
 };
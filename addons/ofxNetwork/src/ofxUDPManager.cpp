@@ -2,6 +2,171 @@
 
 #include "ofxUDPManager.h"
 #include "ofxNetworkUtils.h"
+#include "Poco/Runnable.h"
+#include "Poco/Thread.h"
+
+//	packets per recvmmsg / sendmmsg call
+#define UDP_BATCH_CHUNK 64
+
+//--------------------------------------------------------------------------------
+ofxUDPPacketBatch::ofxUDPPacketBatch()
+:capacity(0)
+,maxPacketSize(0)
+,numPackets(0)
+{
+}
+
+ofxUDPPacketBatch::ofxUDPPacketBatch(size_t numPackets, size_t maxPacketSize)
+:capacity(0)
+,maxPacketSize(0)
+,numPackets(0)
+{
+	Allocate(numPackets, maxPacketSize);
+}
+
+void ofxUDPPacketBatch::Allocate(size_t _numPackets, size_t _maxPacketSize)
+{
+	capacity = _numPackets;
+	maxPacketSize = _maxPacketSize;
+	numPackets = 0;
+	buffer.assign(capacity * maxPacketSize, 0);
+	sizes.assign(capacity, 0);
+	addresses.resize(capacity);
+}
+
+size_t ofxUDPPacketBatch::GetCapacity() const
+{
+	return capacity;
+}
+
+size_t ofxUDPPacketBatch::GetMaxPacketSize() const
+{
+	return maxPacketSize;
+}
+
+size_t ofxUDPPacketBatch::GetNumPackets() const
+{
+	return numPackets;
+}
+
+void ofxUDPPacketBatch::Clear()
+{
+	numPackets = 0;
+}
+
+char* ofxUDPPacketBatch::GetData(size_t packet)
+{
+	return &buffer[packet * maxPacketSize];
+}
+
+const char* ofxUDPPacketBatch::GetData(size_t packet) const
+{
+	return &buffer[packet * maxPacketSize];
+}
+
+size_t ofxUDPPacketBatch::GetSize(size_t packet) const
+{
+	return sizes[packet];
+}
+
+bool ofxUDPPacketBatch::GetAddr(size_t packet, string& address, int& port) const
+{
+	if (packet >= numPackets || addresses[packet].sin_family != AF_INET) return false;
+	address = inet_ntoa((in_addr)addresses[packet].sin_addr);
+	port = ntohs(addresses[packet].sin_port);
+	return true;
+}
+
+bool ofxUDPPacketBatch::Add(const char* pBuff, size_t iSize)
+{
+	if (numPackets == capacity || iSize > maxPacketSize) return false;
+	memcpy(GetData(numPackets), pBuff, iSize);
+	sizes[numPackets] = iSize;
+	//	AF_UNSPEC sends to the address the socket is connected to
+	memset(&addresses[numPackets], 0, sizeof(sockaddr_in));
+	addresses[numPackets].sin_family = AF_UNSPEC;
+	numPackets++;
+	return true;
+}
+
+bool ofxUDPPacketBatch::Add(const char* pBuff, size_t iSize, const string& address, unsigned short usPort)
+{
+	if (!Add(pBuff, iSize)) return false;
+	sockaddr_in & addr = addresses[numPackets - 1];
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(usPort);
+	addr.sin_addr.s_addr = inet_addr(address.c_str());
+	return true;
+}
+
+//--------------------------------------------------------------------------------
+//	fills a ring of packets from the socket, the ring is only written by
+//	this thread and only read by the thread calling Receive
+struct ofxUDPManager::ReceiveThread: public Poco::Runnable
+{
+	ReceiveThread(ofxUDPManager& manager, size_t numPackets, size_t maxPacketSize)
+	:manager(manager)
+	,ring(numPackets, maxPacketSize)
+	,overflow(UDP_BATCH_CHUNK, maxPacketSize)
+	,readPos(0)
+	,writePos(0)
+	,numDropped(0)
+	,running(true)
+	{
+	}
+
+	void run()
+	{
+		while (running)
+		{
+			//	wait with a timeout so the thread can be stopped
+			fd_set fd;
+			FD_ZERO(&fd);
+			FD_SET(manager.m_hSocket, &fd);
+			timeval	tv=	{0, 100000};
+			if (select(manager.m_hSocket+1, &fd, NULL, NULL, &tv) <= 0) continue;
+
+			uint64_t write = writePos.load(std::memory_order_relaxed);
+			size_t free = ring.capacity - (write - readPos.load(std::memory_order_acquire));
+			if (free == 0)
+			{
+				int n = manager.ReceiveInto(overflow, 0, overflow.capacity, false);
+				if (n > 0) numDropped += n;
+				continue;
+			}
+			size_t slot = write % ring.capacity;
+			int n = manager.ReceiveInto(ring, slot, min(free, ring.capacity - slot), false);
+			if (n > 0) writePos.store(write + n, std::memory_order_release);
+		}
+	}
+
+	//	copies up to count packets from the ring into batch starting at first
+	size_t Pop(ofxUDPPacketBatch& batch, size_t first, size_t count)
+	{
+		uint64_t read = readPos.load(std::memory_order_relaxed);
+		uint64_t available = writePos.load(std::memory_order_acquire) - read;
+		count = min<uint64_t>(count, available);
+		for (size_t i = 0; i < count; i++)
+		{
+			size_t slot = (read + i) % ring.capacity;
+			size_t size = min(ring.sizes[slot], batch.maxPacketSize);
+			memcpy(batch.GetData(first + i), ring.GetData(slot), size);
+			batch.sizes[first + i] = size;
+			batch.addresses[first + i] = ring.addresses[slot];
+		}
+		readPos.store(read + count, std::memory_order_release);
+		return count;
+	}
+
+	ofxUDPManager& manager;
+	ofxUDPPacketBatch ring;
+	ofxUDPPacketBatch overflow;
+	std::atomic<uint64_t> readPos;
+	std::atomic<uint64_t> writePos;
+	std::atomic<uint64_t> numDropped;
+	std::atomic<bool> running;
+	Poco::Thread thread;
+};
 
 //--------------------------------------------------------------------------------
 bool ofxUDPManager::m_bWinsockInit= false;
@@ -36,6 +201,8 @@ bool ofxUDPManager::Close()
 	if (m_hSocket == INVALID_SOCKET)
 		return(false);
 
+	StopReceiveThread();
+
 	#ifdef TARGET_WIN32
 		if(closesocket(m_hSocket) == SOCKET_ERROR)
 	#else
@@ -318,6 +485,22 @@ int	ofxUDPManager::Receive(char* pBuff, const int iSize)
 	int	ret=0;
 
 	memset(pBuff, 0, iSize);
+
+	if (receiveThread)
+	{
+		//	take the packet from the ring filled by the receive thread
+		ofxUDPPacketBatch& ring = receiveThread->ring;
+		uint64_t read = receiveThread->readPos.load(std::memory_order_relaxed);
+		if (read == receiveThread->writePos.load(std::memory_order_acquire)) return 0;
+		size_t slot = read % ring.capacity;
+		ret = min(ring.sizes[slot], (size_t)iSize);
+		memcpy(pBuff, ring.GetData(slot), ret);
+		saClient = ring.addresses[slot];
+		receiveThread->readPos.store(read + 1, std::memory_order_release);
+		canGetRemoteAddress = true;
+		return ret;
+	}
+
 	ret= recvfrom(m_hSocket, pBuff,	iSize, 0, (sockaddr *)&saClient, &nLen);
 
 	if (ret	> 0)
@@ -339,6 +522,180 @@ int	ofxUDPManager::Receive(char* pBuff, const int iSize)
 	//	return(recvfrom(m_hSocket, pBuff, iSize, 0));
 }
 
+//--------------------------------------------------------------------------------
+int ofxUDPManager::ReceiveInto(ofxUDPPacketBatch& batch, size_t first, size_t count, bool wait)
+{
+	size_t received = 0;
+#ifdef TARGET_LINUX
+	mmsghdr headers[UDP_BATCH_CHUNK];
+	iovec buffers[UDP_BATCH_CHUNK];
+	while (received < count)
+	{
+		size_t chunk = min(count - received, (size_t)UDP_BATCH_CHUNK);
+		for (size_t i = 0; i < chunk; i++)
+		{
+			size_t packet = first + received + i;
+			buffers[i].iov_base = batch.GetData(packet);
+			buffers[i].iov_len = batch.maxPacketSize;
+			memset(&headers[i], 0, sizeof(mmsghdr));
+			headers[i].msg_hdr.msg_iov = &buffers[i];
+			headers[i].msg_hdr.msg_iovlen = 1;
+			headers[i].msg_hdr.msg_name = &batch.addresses[packet];
+			headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		}
+		//	MSG_WAITFORONE only blocks until the first packet on a blocking socket
+		int flags = (wait && received == 0) ? MSG_WAITFORONE : MSG_DONTWAIT;
+		int n = recvmmsg(m_hSocket, headers, chunk, flags, NULL);
+		if (n < 0)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && received == 0)
+			{
+				ofxNetworkCheckError();
+				return SOCKET_ERROR;
+			}
+			break;
+		}
+		for (int i = 0; i < n; i++)
+		{
+			batch.sizes[first + received + i] = headers[i].msg_len;
+		}
+		received += n;
+		if ((size_t)n < chunk) break;
+	}
+#else
+	while (received < count)
+	{
+		if (!wait || received > 0)
+		{
+			//	don't block once there are no packets waiting
+			fd_set fd;
+			FD_ZERO(&fd);
+			FD_SET(m_hSocket, &fd);
+			timeval	tv=	{0, 0};
+			if (select(m_hSocket+1, &fd, NULL, NULL, &tv) <= 0) break;
+		}
+		size_t packet = first + received;
+		#ifndef TARGET_WIN32
+			socklen_t nLen= sizeof(sockaddr_in);
+		#else
+			int	nLen= sizeof(sockaddr_in);
+		#endif
+		int n = recvfrom(m_hSocket, batch.GetData(packet), batch.maxPacketSize, 0, (sockaddr *)&batch.addresses[packet], &nLen);
+		if (n < 0)
+		{
+			int SocketError = ofxNetworkCheckError();
+			if (received == 0 && SocketError != OFXNETWORK_ERROR(WOULDBLOCK)) return SOCKET_ERROR;
+			break;
+		}
+		batch.sizes[packet] = n;
+		received++;
+	}
+#endif
+	return received;
+}
+
+//--------------------------------------------------------------------------------
+int ofxUDPManager::ReceiveBatch(ofxUDPPacketBatch& batch)
+{
+	if (m_hSocket == INVALID_SOCKET){
+		ofLogError("ofxUDPManager") << "INVALID_SOCKET";
+		return(SOCKET_ERROR);
+	}
+
+	batch.numPackets = 0;
+	if (receiveThread)
+	{
+		batch.numPackets = receiveThread->Pop(batch, 0, batch.capacity);
+		return batch.numPackets;
+	}
+
+	int ret = ReceiveInto(batch, 0, batch.capacity, !nonBlocking);
+	if (ret > 0) batch.numPackets = ret;
+	return ret;
+}
+
+//--------------------------------------------------------------------------------
+int ofxUDPManager::SendBatch(ofxUDPPacketBatch& batch)
+{
+	if (m_hSocket == INVALID_SOCKET) return(SOCKET_ERROR);
+
+	size_t sent = 0;
+#ifdef TARGET_LINUX
+	mmsghdr headers[UDP_BATCH_CHUNK];
+	iovec buffers[UDP_BATCH_CHUNK];
+	while (sent < batch.numPackets)
+	{
+		size_t chunk = min(batch.numPackets - sent, (size_t)UDP_BATCH_CHUNK);
+		for (size_t i = 0; i < chunk; i++)
+		{
+			size_t packet = sent + i;
+			buffers[i].iov_base = batch.GetData(packet);
+			buffers[i].iov_len = batch.sizes[packet];
+			memset(&headers[i], 0, sizeof(mmsghdr));
+			headers[i].msg_hdr.msg_iov = &buffers[i];
+			headers[i].msg_hdr.msg_iovlen = 1;
+			headers[i].msg_hdr.msg_name = batch.addresses[packet].sin_family == AF_INET ? &batch.addresses[packet] : &saClient;
+			headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		}
+		int n = sendmmsg(m_hSocket, headers, chunk, 0);
+		if (n < 0)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && sent == 0)
+			{
+				ofxNetworkCheckError();
+				return SOCKET_ERROR;
+			}
+			break;
+		}
+		sent += n;
+		if ((size_t)n < chunk) break;
+	}
+#else
+	for (; sent < batch.numPackets; sent++)
+	{
+		const sockaddr_in * addr = batch.addresses[sent].sin_family == AF_INET ? &batch.addresses[sent] : &saClient;
+		int n = sendto(m_hSocket, batch.GetData(sent), batch.sizes[sent], 0, (sockaddr *)addr, sizeof(sockaddr));
+		if (n == -1)
+		{
+			ofxNetworkCheckError();
+			if (sent == 0) return SOCKET_ERROR;
+			break;
+		}
+	}
+#endif
+	return sent;
+}
+
+//--------------------------------------------------------------------------------
+bool ofxUDPManager::StartReceiveThread(size_t numPackets, size_t maxPacketSize)
+{
+	if (m_hSocket == INVALID_SOCKET){
+		ofLogError("ofxUDPManager") << "StartReceiveThread(): INVALID_SOCKET";
+		return false;
+	}
+	StopReceiveThread();
+	receiveThread = ofPtr<ReceiveThread>(new ReceiveThread(*this, numPackets, maxPacketSize));
+	receiveThread->thread.setName("ofxUDPManager receive");
+	receiveThread->thread.start(*receiveThread);
+	return true;
+}
+
+//--------------------------------------------------------------------------------
+void ofxUDPManager::StopReceiveThread()
+{
+	if (!receiveThread) return;
+	receiveThread->running = false;
+	receiveThread->thread.join();
+	receiveThread.reset();
+}
+
+//--------------------------------------------------------------------------------
+uint64_t ofxUDPManager::GetNumDroppedPackets() const
+{
+	return receiveThread ? receiveThread->numDropped.load() : 0;
+}
+
+//--------------------------------------------------------------------------------
 void ofxUDPManager::SetTimeoutSend(int	timeoutInSeconds)
 {
 	m_dwTimeoutSend= timeoutInSeconds;
@@ -63,6 +63,8 @@ x) Close()
 
 --------------------------------------------------------------------------------*/
 #include "ofConstants.h"
+#include "ofTypes.h"
+#include <atomic>
 #include <string.h>
 #include <wchar.h>
 #include <stdio.h>
@@ -108,6 +110,47 @@ x) Close()
 //--------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------
 
+// Preallocated datagrams for ofxUDPManager::ReceiveBatch and SendBatch.
+// All the packets live in one buffer allocated once, so receiving or
+// sending thousands of packets per frame doesn't allocate.
+class ofxUDPPacketBatch
+{
+public:
+	ofxUDPPacketBatch();
+	ofxUDPPacketBatch(size_t numPackets, size_t maxPacketSize);
+
+	// room for numPackets datagrams of up to maxPacketSize bytes each,
+	// received datagrams that are longer are truncated
+	void Allocate(size_t numPackets, size_t maxPacketSize);
+	size_t GetCapacity() const;
+	size_t GetMaxPacketSize() const;
+
+	// number of packets received or added
+	size_t GetNumPackets() const;
+	void Clear();
+
+	char* GetData(size_t packet);
+	const char* GetData(size_t packet) const;
+	size_t GetSize(size_t packet) const;
+	// source of a received packet or destination of one to send
+	bool GetAddr(size_t packet, string& address, int& port) const;
+
+	// adds a packet to send to the address the socket is connected to,
+	// returns false if the batch is full or the data too long
+	bool Add(const char* pBuff, size_t iSize);
+	// adds a packet to send to an ip and port
+	bool Add(const char* pBuff, size_t iSize, const string& address, unsigned short usPort);
+
+private:
+	friend class ofxUDPManager;
+	vector<char> buffer;
+	vector<size_t> sizes;
+	vector<struct sockaddr_in> addresses;
+	size_t capacity;
+	size_t maxPacketSize;
+	size_t numPackets;
+};
+
 // Implementation of a UDP socket.
 class ofxUDPManager
 {
@@ -134,6 +177,27 @@ public:
 	int  SendAll(const char* pBuff, const int iSize);
 	int  PeekReceive();			//	return number of bytes waiting
 	int  Receive(char* pBuff, const int iSize);
+
+	//	batched versions, one system call for many datagrams where the
+	//	system supports it (recvmmsg/sendmmsg on linux).
+	//	ReceiveBatch fills the batch with the packets waiting, blocking only
+	//	for the first one with a blocking socket. returns the number of
+	//	packets or SOCKET_ERROR. GetRemoteAddr isn't changed, use
+	//	ofxUDPPacketBatch::GetAddr for the source of each packet
+	int  ReceiveBatch(ofxUDPPacketBatch& batch);
+	//	returns the number of packets sent, less than the batch size if the
+	//	socket couldn't take them all, or SOCKET_ERROR
+	int  SendBatch(ofxUDPPacketBatch& batch);
+
+	//	receive on a thread that keeps a ring of numPackets preallocated
+	//	packets full so the socket buffer never overflows while the app is
+	//	busy. Receive and ReceiveBatch then take the packets from the ring
+	//	without any system call. call after Bind
+	bool StartReceiveThread(size_t numPackets, size_t maxPacketSize);
+	void StopReceiveThread();
+	//	packets lost because the ring was full
+	uint64_t GetNumDroppedPackets() const;
+
 	void SetTimeoutSend(int timeoutInSeconds);
 	void SetTimeoutReceive(int timeoutInSeconds);
 	int  GetTimeoutSend();
@@ -171,4 +235,12 @@ protected:
 	static bool m_bWinsockInit;
 	bool canGetRemoteAddress;
 
+private:
+	//	receives up to count packets into the slots of batch starting at
+	//	first, waiting only for the first one if wait is true
+	int ReceiveInto(ofxUDPPacketBatch& batch, size_t first, size_t count, bool wait);
+
+	struct ReceiveThread;
+	ofPtr<ReceiveThread> receiveThread;
+
 };
@@ -32,3 +32,4 @@
 #include "ofxOscMessage.h"
 #include "ofxOscSender.h"
 #include "ofxOscReceiver.h"
+#include "ofxOscRouter.h"
@@ -138,9 +138,10 @@ public:
 	string getTypeName() { return "string"; }
 
 	/// return value
-	string get() const { return value; }
+	const string & get() const { return value; }
 	/// set value
 	void set( const char* _value ) { value = _value; }
+	void set( const string& _value ) { value = _value; }
 
 private:
 	std::string value;
@@ -159,7 +160,7 @@ public:
 	string getTypeName() { return "blob"; }
 
 	/// return value
-	ofBuffer get() const { return value; }
+	const ofBuffer & get() const { return value; }
 	/// set value
 	void set( const char * _value, unsigned int length ) { value.set(_value, length); }
 
@@ -39,14 +39,34 @@ ofxOscMessage::ofxOscMessage()
 ofxOscMessage::~ofxOscMessage()
 {
 	clear();
+	for ( unsigned int i=0; i<spareArgs.size(); ++i )
+		delete spareArgs[i];
 }
 
 void ofxOscMessage::clear()
 {
+	// keep the arguments by position so they can be reused
+	if ( spareArgs.size() < args.size() )
+		spareArgs.resize( args.size(), NULL );
 	for ( unsigned int i=0; i<args.size(); ++i )
-		delete args[i];
+	{
+		delete spareArgs[i];
+		spareArgs[i] = args[i];
+	}
 	args.clear();
-	address = "";
+	address.clear();
+}
+
+ofxOscArg* ofxOscMessage::getSpareArg( ofxOscArgType type )
+{
+	size_t index = args.size();
+	if ( index < spareArgs.size() && spareArgs[index] && spareArgs[index]->getType() == type )
+	{
+		ofxOscArg* arg = spareArgs[index];
+		spareArgs[index] = NULL;
+		return arg;
+	}
+	return NULL;
 }
 
 /*
@@ -192,30 +212,68 @@ set methods
 
 void ofxOscMessage::addIntArg( int32_t argument )
 {
-
-	args.push_back( new ofxOscArgInt32( argument ) );
+	ofxOscArgInt32* arg = (ofxOscArgInt32*)getSpareArg( OFXOSC_TYPE_INT32 );
+	if ( arg )
+		arg->set( argument );
+	else
+		arg = new ofxOscArgInt32( argument );
+	args.push_back( arg );
 }
 
 void ofxOscMessage::addInt64Arg( uint64_t argument )
 {
-
-	args.push_back( new ofxOscArgInt64( argument ) );
+	ofxOscArgInt64* arg = (ofxOscArgInt64*)getSpareArg( OFXOSC_TYPE_INT64 );
+	if ( arg )
+		arg->set( argument );
+	else
+		arg = new ofxOscArgInt64( argument );
+	args.push_back( arg );
 }
 
 
 void ofxOscMessage::addFloatArg( float argument )
 {
-	args.push_back( new ofxOscArgFloat( argument ) );
+	ofxOscArgFloat* arg = (ofxOscArgFloat*)getSpareArg( OFXOSC_TYPE_FLOAT );
+	if ( arg )
+		arg->set( argument );
+	else
+		arg = new ofxOscArgFloat( argument );
+	args.push_back( arg );
+}
+
+void ofxOscMessage::addStringArg( const string& argument )
+{
+	ofxOscArgString* arg = (ofxOscArgString*)getSpareArg( OFXOSC_TYPE_STRING );
+	if ( arg )
+		arg->set( argument );
+	else
+		arg = new ofxOscArgString( argument );
+	args.push_back( arg );
 }
 
-void ofxOscMessage::addStringArg( string argument )
+void ofxOscMessage::addStringArg( const char* argument )
 {
-	args.push_back( new ofxOscArgString( argument ) );
+	ofxOscArgString* arg = (ofxOscArgString*)getSpareArg( OFXOSC_TYPE_STRING );
+	if ( arg )
+		arg->set( argument );
+	else
+		arg = new ofxOscArgString( argument );
+	args.push_back( arg );
 }
 
-void ofxOscMessage::addBlobArg( ofBuffer argument )
+void ofxOscMessage::addBlobArg( const ofBuffer& argument )
 {
-	args.push_back( new ofxOscArgBlob( argument ) );
+	addBlobArg( argument.getData(), argument.size() );
+}
+
+void ofxOscMessage::addBlobArg( const char* data, size_t size )
+{
+	ofxOscArgBlob* arg = (ofxOscArgBlob*)getSpareArg( OFXOSC_TYPE_BLOB );
+	if ( arg )
+		arg->set( data, size );
+	else
+		arg = new ofxOscArgBlob( ofBuffer( data, size ) );
+	args.push_back( arg );
 }
 
 /*
@@ -226,6 +284,9 @@ void ofxOscMessage::addBlobArg( ofBuffer argument )
 
 ofxOscMessage& ofxOscMessage::copy( const ofxOscMessage& other )
 {
+	if ( &other == this )
+		return *this;
+
 	clear();
 	// copy address
 	address = other.address;
@@ -236,17 +297,17 @@ ofxOscMessage& ofxOscMessage::copy( const ofxOscMessage& other )
 	// copy arguments
 	for ( int i=0; i<(int)other.args.size(); ++i )
 	{
-		ofxOscArgType argType = other.getArgType( i );
+		ofxOscArgType argType = other.args[i]->getType();
 		if ( argType == OFXOSC_TYPE_INT32 )
-			args.push_back( new ofxOscArgInt32( other.getArgAsInt32( i ) ) );
+			addIntArg( ((ofxOscArgInt32*)other.args[i])->get() );
 		else if ( argType == OFXOSC_TYPE_INT64 )
-			args.push_back( new ofxOscArgInt64( other.getArgAsInt64( i ) ) );
+			addInt64Arg( ((ofxOscArgInt64*)other.args[i])->get() );
 		else if ( argType == OFXOSC_TYPE_FLOAT )
-			args.push_back( new ofxOscArgFloat( other.getArgAsFloat( i ) ) );
+			addFloatArg( ((ofxOscArgFloat*)other.args[i])->get() );
 		else if ( argType == OFXOSC_TYPE_STRING )
-			args.push_back( new ofxOscArgString( other.getArgAsString( i ) ) );
+			addStringArg( ((ofxOscArgString*)other.args[i])->get() );
 		else if ( argType == OFXOSC_TYPE_BLOB )
-			args.push_back( new ofxOscArgBlob( other.getArgAsBlob( i ) ) );
+			addBlobArg( ((ofxOscArgBlob*)other.args[i])->get() );
 		else
 		{
 			assert( false && "bad argument type" );
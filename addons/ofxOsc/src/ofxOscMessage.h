@@ -44,7 +44,9 @@ public:
 	/// for operator= and copy constructor
 	ofxOscMessage& copy( const ofxOscMessage& other );
 
-	/// clear this message, erase all contents
+	/// clear this message, erase all contents. the argument objects are
+	/// kept and reused by the next add*Arg calls of the same type, so
+	/// refilling a message with the same layout doesn't allocate
 	void clear();
 
 	/// return the address
@@ -74,19 +76,27 @@ public:
 	ofBuffer getArgAsBlob( int index ) const;
 
 	/// message construction
-	void setAddress( string _address ) { address = _address; };
+	void setAddress( const string& _address ) { address = _address; };
+	void setAddress( const char* _address ) { address = _address; };
 	/// host and port of the remote endpoint
-	void setRemoteEndpoint( string host, int port ) { remote_host = host; remote_port = port; }
+	void setRemoteEndpoint( const string& host, int port ) { remote_host = host; remote_port = port; }
+	void setRemoteEndpoint( const char* host, int port ) { remote_host = host; remote_port = port; }
 	void addIntArg( int32_t argument );
 	void addInt64Arg( uint64_t argument );
 	void addFloatArg( float argument );
-	void addStringArg( string argument );
-	void addBlobArg( ofBuffer argument );
+	void addStringArg( const string& argument );
+	void addStringArg( const char* argument );
+	void addBlobArg( const ofBuffer& argument );
+	void addBlobArg( const char* data, size_t size );
 
 private:
+	/// returns the argument that was at the next position before clear()
+	/// if it has the requested type, NULL otherwise
+	ofxOscArg* getSpareArg( ofxOscArgType type );
 
 	string address;
 	vector<ofxOscArg*> args;
+	vector<ofxOscArg*> spareArgs;
 
 	string remote_host;
 	int remote_port;
@@ -19,17 +19,55 @@ ofxOscParameterSync::~ofxOscParameterSync(){
 
 
 void ofxOscParameterSync::setup(ofParameterGroup & group, int localPort, string host, int remotePort){
+	if(syncGroup)
+		ofRemoveListener(syncGroup->parameterChangedE,this,&ofxOscParameterSync::parameterChanged);
 	syncGroup = &group;
 	ofAddListener(group.parameterChangedE,this,&ofxOscParameterSync::parameterChanged);
+	router.clear();
+	setters.clear();
+	// ofxOscSender::sendParameter prefixes the names of every group
+	// containing the parameter, including the ones above the synced group
+	string address = "/";
+	const vector<string> hierarchy = group.getGroupHierarchyNames();
+	for(int i=0;i<(int)hierarchy.size()-1;i++){
+		address += hierarchy[i] + "/";
+	}
+	addParameters(group,address);
 	sender.setup(host,remotePort);
 	receiver.setup(localPort);
 }
 
+void ofxOscParameterSync::addParameters(const ofParameterGroup & group, string address){
+	address += group.getEscapedName() + "/";
+	for(int i=0;i<group.size();i++){
+		const ofAbstractParameter & p = group[i];
+		if(p.type()==typeid(ofParameterGroup).name()){
+			addParameters(static_cast<const ofParameterGroup &>(p),address);
+		}else{
+			shared_ptr<ParameterSetter> setter(new ParameterSetter(p.newReference()));
+			setters.push_back(setter);
+			router.addListener(address+p.getEscapedName(),setter.get(),&ParameterSetter::set);
+		}
+	}
+}
+
 void ofxOscParameterSync::update(){
-	if(receiver.hasWaitingMessages()){
-		updatingParameter = true;
-		receiver.getParameter(*syncGroup);
-		updatingParameter = false;
+	updatingParameter = true;
+	router.dispatchAll(receiver);
+	updatingParameter = false;
+}
+
+void ofxOscParameterSync::ParameterSetter::set(const ofxOscMessage & msg){
+	if(msg.getNumArgs()==0) return;
+	ofAbstractParameter * p = parameter.get();
+	if(p->type()==typeid(ofParameter<int>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
+		p->cast<int>() = msg.getArgAsInt32(0);
+	}else if(p->type()==typeid(ofParameter<float>).name() && msg.getArgType(0)==OFXOSC_TYPE_FLOAT){
+		p->cast<float>() = msg.getArgAsFloat(0);
+	}else if(p->type()==typeid(ofParameter<bool>).name() && msg.getArgType(0)==OFXOSC_TYPE_INT32){
+		p->cast<bool>() = msg.getArgAsInt32(0);
+	}else if(msg.getArgType(0)==OFXOSC_TYPE_STRING){
+		p->fromString(msg.getArgAsString(0));
 	}
 }
 
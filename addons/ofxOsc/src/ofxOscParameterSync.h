@@ -9,6 +9,7 @@
 
 #include "ofxOscSender.h"
 #include "ofxOscReceiver.h"
+#include "ofxOscRouter.h"
 #include "ofParameter.h"
 #include "ofParameterGroup.h"
 
@@ -17,14 +18,31 @@ public:
 	ofxOscParameterSync();
 	~ofxOscParameterSync();
 
-	/// the remote and local ports must be different to avoid collisions
+	/// the remote and local ports must be different to avoid collisions.
+	/// the addresses of the parameters in group are registered in a router
+	/// during setup, parameters added to the group later aren't synced.
+	/// addresses start with the names of the groups containing group at
+	/// that moment, so both sides need to nest it in the same groups
 	void setup(ofParameterGroup & group, int localPort, string remoteHost, int remotePort);
 	void update();
 
 private:
+	// sets a parameter from the messages sent to its address
+	class ParameterSetter{
+	public:
+		ParameterSetter(shared_ptr<ofAbstractParameter> parameter)
+		:parameter(parameter){}
+		void set(const ofxOscMessage & msg);
+	private:
+		shared_ptr<ofAbstractParameter> parameter;
+	};
+
+	void addParameters(const ofParameterGroup & group, string address);
 	void parameterChanged( ofAbstractParameter & parameter );
 	ofxOscSender sender;
 	ofxOscReceiver receiver;
+	ofxOscRouter router;
+	vector<shared_ptr<ParameterSetter> > setters;
 	ofParameterGroup * syncGroup;
 	bool updatingParameter;
 };
@@ -35,10 +35,36 @@
 #include <assert.h>
 
 ofxOscReceiver::ofxOscReceiver()
+:poolRead(0)
+,poolWrite(0)
+,numDropped(0)
 {
 	listen_socket = NULL;
 }
 
+void ofxOscReceiver::setPoolSize( size_t poolSize )
+{
+	if ( listen_socket )
+	{
+		ofLogError("ofxOscReceiver") << "setPoolSize(): can't change the pool size after setup";
+		return;
+	}
+	pool.clear();
+	pool.resize( poolSize );
+	poolRead = 0;
+	poolWrite = 0;
+}
+
+size_t ofxOscReceiver::getPoolSize() const
+{
+	return pool.size();
+}
+
+uint64_t ofxOscReceiver::getNumDroppedMessages() const
+{
+	return numDropped.load();
+}
+
 void ofxOscReceiver::setup( int listen_port, bool allowReuse )
 {
     if( UdpSocket::GetUdpBufferSize() == 0 ){
@@ -134,19 +160,17 @@ ofxOscReceiver::startThread( void* receiverInstance )
     #endif
 }
 
-void ofxOscReceiver::ProcessMessage( const osc::ReceivedMessage &m, const IpEndpointName& remoteEndpoint )
+void ofxOscReceiver::convertMessage( const osc::ReceivedMessage &m, const IpEndpointName& remoteEndpoint, ofxOscMessage& message )
 {
-
-	// convert the message to an ofxOscMessage
-	ofxOscMessage* ofMessage = new ofxOscMessage();
+	message.clear();
 
 	// set the address
-	ofMessage->setAddress( m.AddressPattern() );
-    
+	message.setAddress( m.AddressPattern() );
+
 	// set the sender ip/host
 	char endpoint_host[ IpEndpointName::ADDRESS_STRING_LENGTH ];
 	remoteEndpoint.AddressAsString( endpoint_host );
-    ofMessage->setRemoteEndpoint( endpoint_host, remoteEndpoint.port );
+	message.setRemoteEndpoint( endpoint_host, remoteEndpoint.port );
 
 	// transfer the arguments
 	for ( osc::ReceivedMessage::const_iterator arg = m.ArgumentsBegin();
@@ -154,32 +178,52 @@ void ofxOscReceiver::ProcessMessage( const osc::ReceivedMessage &m, const IpEndp
 		  ++arg )
 	{
 		if ( arg->IsInt32() )
-			ofMessage->addIntArg( arg->AsInt32Unchecked() );
+			message.addIntArg( arg->AsInt32Unchecked() );
 		else if ( arg->IsInt64() )
-			ofMessage->addInt64Arg( arg->AsInt64Unchecked() );
+			message.addInt64Arg( arg->AsInt64Unchecked() );
 		else if ( arg->IsFloat() )
-			ofMessage->addFloatArg( arg->AsFloatUnchecked() );
+			message.addFloatArg( arg->AsFloatUnchecked() );
 		else if ( arg->IsString() )
-			ofMessage->addStringArg( arg->AsStringUnchecked() );
+			message.addStringArg( arg->AsStringUnchecked() );
 		else if ( arg->IsBlob() ){
-            const char * dataPtr;
-            osc::osc_bundle_element_size_t len = 0;
-            arg->AsBlobUnchecked((const void*&)dataPtr, len);
-            ofBuffer buffer(dataPtr, len);
-			ofMessage->addBlobArg( buffer );
+			const char * dataPtr;
+			osc::osc_bundle_element_size_t len = 0;
+			arg->AsBlobUnchecked((const void*&)dataPtr, len);
+			message.addBlobArg( dataPtr, len );
 		}else
 		{
 			ofLogError("ofxOscReceiver") << "ProcessMessage: argument in message " << m.AddressPattern() << " is not an int, float, or string";
 		}
 	}
+}
 
-	// now add to the queue
-
+void ofxOscReceiver::ProcessMessage( const osc::ReceivedMessage &m, const IpEndpointName& remoteEndpoint )
+{
 	// at this point we are running inside the thread created by startThread,
 	// so anyone who calls hasWaitingMessages() or getNextMessage() is coming
 	// from a different thread
 
-	// so we have to practise shared memory management
+	if ( !pool.empty() )
+	{
+		// this thread is the only writer of the ring: parse straight into
+		// the next free slot and publish it, no locks and no allocations
+		// once the slots have been used with messages of the same layout
+		uint64_t write = poolWrite.load( std::memory_order_relaxed );
+		if ( write - poolRead.load( std::memory_order_acquire ) >= pool.size() )
+		{
+			++numDropped;
+			return;
+		}
+		convertMessage( m, remoteEndpoint, pool[ write % pool.size() ] );
+		poolWrite.store( write + 1, std::memory_order_release );
+		return;
+	}
+
+	// convert the message to an ofxOscMessage
+	ofxOscMessage* ofMessage = new ofxOscMessage();
+	convertMessage( m, remoteEndpoint, *ofMessage );
+
+	// now add to the queue, we have to practise shared memory management
 
 	// grab a lock on the queue
 	grabMutex();
@@ -193,6 +237,9 @@ void ofxOscReceiver::ProcessMessage( const osc::ReceivedMessage &m, const IpEndp
 
 bool ofxOscReceiver::hasWaitingMessages()
 {
+	if ( !pool.empty() )
+		return poolRead.load( std::memory_order_relaxed ) != poolWrite.load( std::memory_order_acquire );
+
 	// grab a lock on the queue
 	grabMutex();
 
@@ -208,6 +255,16 @@ bool ofxOscReceiver::hasWaitingMessages()
 
 bool ofxOscReceiver::getNextMessage( ofxOscMessage* message )
 {
+	if ( !pool.empty() )
+	{
+		uint64_t read = poolRead.load( std::memory_order_relaxed );
+		if ( read == poolWrite.load( std::memory_order_acquire ) )
+			return false;
+		message->copy( pool[ read % pool.size() ] );
+		poolRead.store( read + 1, std::memory_order_release );
+		return true;
+	}
+
 	// grab a lock on the queue
 	grabMutex();
 
@@ -235,10 +292,43 @@ bool ofxOscReceiver::getNextMessage( ofxOscMessage* message )
 	return true;
 }
 
+size_t ofxOscReceiver::drainAll( vector<ofxOscMessage> & messages )
+{
+	size_t numMessages = 0;
+	if ( !pool.empty() )
+	{
+		uint64_t read = poolRead.load( std::memory_order_relaxed );
+		uint64_t write = poolWrite.load( std::memory_order_acquire );
+		numMessages = write - read;
+		if ( messages.size() < numMessages )
+			messages.resize( numMessages );
+		for ( size_t i = 0; i < numMessages; ++i )
+			messages[i].copy( pool[ ( read + i ) % pool.size() ] );
+		poolRead.store( write, std::memory_order_release );
+	}
+	else
+	{
+		std::deque< ofxOscMessage* > batch;
+		grabMutex();
+		batch.swap( this->messages );
+		releaseMutex();
+		numMessages = batch.size();
+		if ( messages.size() < numMessages )
+			messages.resize( numMessages );
+		for ( size_t i = 0; i < numMessages; ++i )
+		{
+			messages[i].copy( *batch[i] );
+			delete batch[i];
+		}
+	}
+	// the vector keeps its capacity for the next call
+	messages.erase( messages.begin() + numMessages, messages.end() );
+	return numMessages;
+}
 
 bool ofxOscReceiver::getParameter(ofAbstractParameter & parameter){
 	ofxOscMessage msg;
-	if ( messages.size() == 0 ) return false;
+	if ( !hasWaitingMessages() ) return false;
 	while(hasWaitingMessages()){
 		ofAbstractParameter * p = &parameter;
         
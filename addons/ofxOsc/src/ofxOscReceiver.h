@@ -29,6 +29,7 @@
 #pragma once
 
 #include <deque>
+#include <atomic>
 #include "ofMain.h"
 
 #ifdef TARGET_WIN32
@@ -63,6 +64,29 @@ public:
 	/// return true
 	bool getNextMessage( ofxOscMessage* );
 
+	/// copy every waiting message into messages, replacing its contents, and
+	/// remove them from the queue. messages are taken under a single lock,
+	/// reusing the same vector every frame avoids allocating. returns the
+	/// number of messages
+	size_t drainAll( vector<ofxOscMessage> & messages );
+
+	/// call callback( const ofxOscMessage& ) for every waiting message and
+	/// remove them from the queue. with a message pool the messages are
+	/// passed without copying them and are only valid during the call.
+	/// returns the number of messages
+	template<typename Callback>
+	size_t drainAll( Callback callback );
+
+	/// parse incoming messages into a ring of poolSize preallocated messages
+	/// instead of allocating a new one per packet. messages that arrive
+	/// while the ring is full are dropped, see getNumDroppedMessages().
+	/// 0, the default, uses an unbounded queue. call before setup
+	void setPoolSize( size_t poolSize );
+	size_t getPoolSize() const;
+
+	/// number of messages dropped because the pool was full
+	uint64_t getNumDroppedMessages() const;
+
 	bool getParameter(ofAbstractParameter & parameter);
 
 protected:
@@ -70,6 +94,9 @@ protected:
 	virtual void ProcessMessage( const osc::ReceivedMessage &m, const IpEndpointName& remoteEndpoint );
 
 private:
+	// fill message with the contents of m
+	static void convertMessage( const osc::ReceivedMessage &m, const IpEndpointName& remoteEndpoint, ofxOscMessage& message );
+
 	// shutdown the listener
 	void shutdown();
 
@@ -82,6 +109,13 @@ private:
 	// queue of osc messages
 	std::deque< ofxOscMessage* > messages;
 
+	// ring of reused messages, written only by the listening thread and
+	// read only by the thread getting the messages
+	vector< ofxOscMessage > pool;
+	std::atomic< uint64_t > poolRead;
+	std::atomic< uint64_t > poolWrite;
+	std::atomic< uint64_t > numDropped;
+
 	// socket to listen on
 	UdpListeningReceiveSocket* listen_socket;
 
@@ -104,3 +138,34 @@ private:
 	bool socketHasShutdown;
 
 };
+
+template<typename Callback>
+size_t ofxOscReceiver::drainAll( Callback callback )
+{
+	if ( !pool.empty() )
+	{
+		// one acquire for the whole batch, the slots are handed back to the
+		// listening thread at once after the callbacks
+		uint64_t read = poolRead.load( std::memory_order_relaxed );
+		uint64_t write = poolWrite.load( std::memory_order_acquire );
+		for ( uint64_t i = read; i != write; ++i )
+		{
+			const ofxOscMessage& message = pool[ i % pool.size() ];
+			callback( message );
+		}
+		poolRead.store( write, std::memory_order_release );
+		return write - read;
+	}
+
+	std::deque< ofxOscMessage* > batch;
+	grabMutex();
+	batch.swap( messages );
+	releaseMutex();
+	for ( size_t i = 0; i < batch.size(); ++i )
+	{
+		const ofxOscMessage& message = *batch[i];
+		callback( message );
+		delete batch[i];
+	}
+	return batch.size();
+}
@@ -0,0 +1,245 @@
+/*
+ * ofxOscRouter.cpp
+ *
+ * dispatches osc messages to listeners registered for address patterns
+ */
+
+#include "ofxOscRouter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace{
+	const char * patternChars = "?*[{";
+
+	bool isPattern( const char * part, const char * end ){
+		for ( ; part != end; ++part ){
+			if ( strchr( patternChars, *part ) ) return true;
+		}
+		return false;
+	}
+
+	// end of the address part starting at part
+	const char * partEnd( const char * part, const char * end ){
+		const char * slash = (const char*)memchr( part, '/', end - part );
+		return slash ? slash : end;
+	}
+
+	// skips the slashes before the next part, empty parts are ignored
+	const char * nextPart( const char * part, const char * end ){
+		while ( part != end && *part == '/' ) ++part;
+		return part;
+	}
+
+	// matches the character set starting after '[', sets setEnd after the
+	// closing ']'. returns false if the set isn't closed
+	bool matchesSet( const char * set, const char * patternEnd, char c, const char *& setEnd, bool & matched ){
+		bool negate = set != patternEnd && *set == '!';
+		if ( negate ) ++set;
+		matched = false;
+		const char * first = set;
+		while ( set != patternEnd && ( *set != ']' || set == first ) ){
+			if ( set + 2 < patternEnd && set[1] == '-' && set[2] != ']' ){
+				if ( (unsigned char)c >= (unsigned char)set[0] && (unsigned char)c <= (unsigned char)set[2] ) matched = true;
+				set += 3;
+			}else{
+				if ( c == *set ) matched = true;
+				++set;
+			}
+		}
+		if ( set == patternEnd ) return false;
+		setEnd = set + 1;
+		matched = matched != negate;
+		return true;
+	}
+}
+
+struct ofxOscRouter::Node{
+	typedef pair<string, Node*> Child;
+
+	~Node(){
+		for ( size_t i = 0; i < literals.size(); ++i ) delete literals[i].second;
+		for ( size_t i = 0; i < patterns.size(); ++i ) delete patterns[i].second;
+	}
+
+	struct CompareChild{
+		// compares a child name with the part [first, second) of an address
+		bool operator()( const Child & child, const pair<const char*, const char*> & part ) const{
+			return child.first.compare( 0, string::npos, part.first, part.second - part.first ) < 0;
+		}
+	};
+
+	Node * findLiteral( const char * part, const char * end ){
+		vector<Child>::iterator it = lower_bound( literals.begin(), literals.end(), make_pair( part, end ), CompareChild() );
+		if ( it != literals.end() && it->first.compare( 0, string::npos, part, end - part ) == 0 ){
+			return it->second;
+		}
+		return NULL;
+	}
+
+	Node * getChild( const char * part, const char * end ){
+		if ( !isPattern( part, end ) ){
+			vector<Child>::iterator it = lower_bound( literals.begin(), literals.end(), make_pair( part, end ), CompareChild() );
+			if ( it == literals.end() || it->first.compare( 0, string::npos, part, end - part ) != 0 ){
+				it = literals.insert( it, Child( string( part, end ), new Node ) );
+			}
+			return it->second;
+		}else{
+			for ( size_t i = 0; i < patterns.size(); ++i ){
+				if ( patterns[i].first.compare( 0, string::npos, part, end - part ) == 0 ){
+					return patterns[i].second;
+				}
+			}
+			patterns.push_back( Child( string( part, end ), new Node ) );
+			return patterns.back().second;
+		}
+	}
+
+	// children sorted by name to find the part of an address by bisection
+	vector<Child> literals;
+	// children with wildcards, tested one by one
+	vector<Child> patterns;
+	unique_ptr<ofEvent<const ofxOscMessage> > event;
+};
+
+//--------------------------------------------------------------
+ofxOscRouter::ofxOscRouter()
+:root( new Node ){
+}
+
+ofxOscRouter::~ofxOscRouter(){
+}
+
+//--------------------------------------------------------------
+ofEvent<const ofxOscMessage> & ofxOscRouter::getEvent( const string & pattern ){
+	const char * part = pattern.c_str();
+	const char * end = part + pattern.size();
+	Node * node = root.get();
+	for ( part = nextPart( part, end ); part != end; part = nextPart( part, end ) ){
+		const char * pend = partEnd( part, end );
+		node = node->getChild( part, pend );
+		part = pend;
+	}
+	if ( !node->event ){
+		node->event.reset( new ofEvent<const ofxOscMessage> );
+	}
+	return *node->event;
+}
+
+//--------------------------------------------------------------
+void ofxOscRouter::clear(){
+	root.reset( new Node );
+}
+
+//--------------------------------------------------------------
+size_t ofxOscRouter::dispatch( const ofxOscMessage & message ){
+	const string & address = message.getAddress();
+	const char * begin = address.c_str();
+	size_t matched = dispatch( *root, nextPart( begin, begin + address.size() ), begin + address.size(), message );
+	if ( matched == 0 ){
+		ofNotifyEvent( unmatchedMessage, message, this );
+	}
+	return matched;
+}
+
+size_t ofxOscRouter::dispatch( Node & node, const char * part, const char * end, const ofxOscMessage & message ){
+	if ( part == end ){
+		if ( node.event ){
+			ofNotifyEvent( *node.event, message, this );
+			return 1;
+		}
+		return 0;
+	}
+
+	size_t matched = 0;
+	const char * pend = partEnd( part, end );
+	const char * next = nextPart( pend, end );
+	if ( !isPattern( part, pend ) ){
+		Node * child = node.findLiteral( part, pend );
+		if ( child ){
+			matched += dispatch( *child, next, end, message );
+		}
+	}else{
+		// the address of the message is a pattern itself
+		for ( size_t i = 0; i < node.literals.size(); ++i ){
+			const string & name = node.literals[i].first;
+			if ( matches( part, pend, name.c_str(), name.c_str() + name.size() ) ){
+				matched += dispatch( *node.literals[i].second, next, end, message );
+			}
+		}
+	}
+	for ( size_t i = 0; i < node.patterns.size(); ++i ){
+		const string & pattern = node.patterns[i].first;
+		if ( matches( pattern.c_str(), pattern.c_str() + pattern.size(), part, pend ) ){
+			matched += dispatch( *node.patterns[i].second, next, end, message );
+		}
+	}
+	return matched;
+}
+
+//--------------------------------------------------------------
+size_t ofxOscRouter::dispatchAll( ofxOscReceiver & receiver ){
+	Dispatcher dispatcher = { this };
+	return receiver.drainAll( dispatcher );
+}
+
+//--------------------------------------------------------------
+bool ofxOscRouter::matches( const char * pattern, const char * patternEnd, const char * str, const char * strEnd ){
+	while ( pattern != patternEnd ){
+		switch ( *pattern ){
+		case '?':
+			if ( str == strEnd ) return false;
+			++pattern;
+			++str;
+			break;
+		case '*':
+			while ( pattern != patternEnd && *pattern == '*' ) ++pattern;
+			if ( pattern == patternEnd ) return true;
+			for ( ; str != strEnd; ++str ){
+				if ( matches( pattern, patternEnd, str, strEnd ) ) return true;
+			}
+			return false;
+		case '[':{
+			if ( str == strEnd ) return false;
+			const char * setEnd;
+			bool matched;
+			if ( matchesSet( pattern + 1, patternEnd, *str, setEnd, matched ) ){
+				if ( !matched ) return false;
+				pattern = setEnd;
+			}else{
+				// not closed, compare it as a character
+				if ( *str != '[' ) return false;
+				++pattern;
+			}
+			++str;
+			break;
+		}
+		case '{':{
+			const char * close = (const char*)memchr( pattern, '}', patternEnd - pattern );
+			if ( !close ){
+				// not closed, compare it as a character
+				if ( str == strEnd || *str != '{' ) return false;
+				++pattern;
+				++str;
+				break;
+			}
+			const char * option = pattern + 1;
+			while ( true ){
+				const char * optionEnd = option;
+				while ( optionEnd != close && *optionEnd != ',' ) ++optionEnd;
+				size_t len = optionEnd - option;
+				if ( (size_t)( strEnd - str ) >= len && strncmp( option, str, len ) == 0 &&
+						matches( close + 1, patternEnd, str + len, strEnd ) ){
+					return true;
+				}
+				if ( optionEnd == close ) return false;
+				option = optionEnd + 1;
+			}
+		}
+		default:
+			if ( str == strEnd || *str != *pattern ) return false;
+			++pattern;
+			++str;
+		}
+	}
+	return str == strEnd;
+}
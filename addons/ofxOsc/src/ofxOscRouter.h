@@ -0,0 +1,85 @@
+/*
+ * ofxOscRouter.h
+ *
+ * dispatches osc messages to listeners registered for address patterns
+ */
+
+#pragma once
+
+#include "ofxOscMessage.h"
+#include "ofxOscReceiver.h"
+#include "ofEvents.h"
+
+/// dispatches osc messages to the listeners registered for the addresses
+/// they match:
+///
+///     router.addListener("/sensor/*/accel", this, &ofApp::accelReceived);
+///     ...
+///     void ofApp::update(){
+///         router.dispatchAll(receiver);
+///     }
+///     void ofApp::accelReceived(const ofxOscMessage & message){
+///         ...
+///     }
+///
+/// patterns can use the osc wildcards in any part of the address: ? for
+/// any character, * for any sequence of characters, [abc] [a-z] [!abc] for
+/// character sets and {foo,bar} for alternatives. they are split once into
+/// a tree of address parts, so dispatching a message only looks at the
+/// parts that can match it without creating any string. addresses of
+/// incoming messages with wildcards are matched against the literal parts
+/// of the registered addresses as the osc spec describes
+class ofxOscRouter {
+public:
+	ofxOscRouter();
+	~ofxOscRouter();
+
+	/// event notified with the messages that match pattern, created the
+	/// first time it's requested. the same pattern always returns the
+	/// same event
+	ofEvent<const ofxOscMessage> & getEvent( const string & pattern );
+
+	/// calls method( const ofxOscMessage & ) on listener for every
+	/// dispatched message that matches pattern
+	template<class ListenerClass, typename ListenerMethod>
+	void addListener( const string & pattern, ListenerClass * listener, ListenerMethod method, int prio = OF_EVENT_ORDER_AFTER_APP ){
+		ofAddListener( getEvent( pattern ), listener, method, prio );
+	}
+
+	template<class ListenerClass, typename ListenerMethod>
+	void removeListener( const string & pattern, ListenerClass * listener, ListenerMethod method, int prio = OF_EVENT_ORDER_AFTER_APP ){
+		ofRemoveListener( getEvent( pattern ), listener, method, prio );
+	}
+
+	/// removes every pattern and its listeners, can't be called from a
+	/// listener while dispatching
+	void clear();
+
+	/// notifies the events of every pattern that matches the address of
+	/// message. returns the number of matching patterns
+	size_t dispatch( const ofxOscMessage & message );
+
+	/// dispatches every waiting message of receiver, returns the number
+	/// of messages
+	size_t dispatchAll( ofxOscReceiver & receiver );
+
+	/// notified with the messages that don't match any pattern
+	ofEvent<const ofxOscMessage> unmatchedMessage;
+
+	/// returns true if the part of an address in [str, strEnd) matches the
+	/// osc pattern in [pattern, patternEnd). neither can contain '/'
+	static bool matches( const char * pattern, const char * patternEnd, const char * str, const char * strEnd );
+
+private:
+	struct Node;
+	struct Dispatcher{
+		ofxOscRouter * router;
+		void operator()( const ofxOscMessage & message ){
+			router->dispatch( message );
+		}
+	};
+
+	size_t dispatch( Node & node, const char * part, const char * end, const ofxOscMessage & message );
+
+	unique_ptr<Node> root;
+};
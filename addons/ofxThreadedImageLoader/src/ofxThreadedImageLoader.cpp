@@ -1,67 +1,289 @@
 #include "ofxThreadedImageLoader.h"
+#include "Poco/Environment.h"
 #include <sstream>
+
+// Extra decoding threads, the loader's own thread is the first worker.
+class ofxThreadedImageLoader::Worker: public ofThread {
+public:
+	Worker(ofxThreadedImageLoader & loader, int index)
+	:loader(loader)
+	,index(index){}
+
+	void threadedFunction(){
+		thread.setName("ofxThreadedImageLoader " + thread.name());
+		loader.decodeLoop(index);
+	}
+
+private:
+	ofxThreadedImageLoader & loader;
+	int index;
+};
+
+static void updateAverage(float & average, float value){
+	average = average == 0 ? value : average * 0.9f + value * 0.1f;
+}
+
 ofxThreadedImageLoader::ofxThreadedImageLoader(){
 	nextID = 0;
+	numWorkers = 1;
+	closed = false;
+	uploadMillis = 4;
+	uploadBytes = 0;
+	decodeTime = 0;
+	uploadTime = 0;
     ofAddListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofAddListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
-    
+
     startThread();
-    lastUpdate = 0;
+    setNumWorkers(Poco::Environment::processorCount() - 1);
 }
 
 ofxThreadedImageLoader::~ofxThreadedImageLoader(){
-	images_to_load_from_disk.close();
-	images_to_update.close();
+	lock();
+	closed = true;
+	imagesQueued.broadcast();
+	unlock();
 	waitForThread(true);
+	for(size_t i = 0; i < workers.size(); i++){
+		workers[i]->waitForThread(true);
+	}
     ofRemoveListener(ofEvents().update, this, &ofxThreadedImageLoader::update);
 	ofRemoveListener(ofURLResponseEvent(),this,&ofxThreadedImageLoader::urlResponse);
 }
 
 // Load an image from disk.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename) {
-	nextID++;
+int ofxThreadedImageLoader::loadFromDisk(ofImage& image, string filename, int priority) {
 	ofImageLoaderEntry entry(image);
 	entry.filename = filename;
 	entry.image->setUseTexture(false);
 	entry.name = filename;
-    
-	images_to_load_from_disk.send(entry);
+	entry.priority = priority;
+
+	ofScopedLock lock(mutex);
+	entry.id = ++nextID;
+	queued_priorities[entry.id] = priority;
+	images_to_load[make_pair(-priority, entry.id)] = std::move(entry);
+	imagesQueued.signal();
+	return nextID;
 }
 
 
 // Load an url asynchronously from an url.
 //--------------------------------------------------------------
-void ofxThreadedImageLoader::loadFromURL(ofImage& image, string url) {
-	nextID++;
+int ofxThreadedImageLoader::loadFromURL(ofImage& image, string url, int priority) {
+	lock();
+	int id = ++nextID;
+	unlock();
 	ofImageLoaderEntry entry(image);
 	entry.url = url;
-	entry.image->setUseTexture(false);	
-	entry.name = "image" + ofToString(nextID);
+	entry.image->setUseTexture(false);
+	entry.name = "image" + ofToString(id);
+	entry.id = id;
+	entry.priority = priority;
+	entry.urlRequestID = ofLoadURLAsync(entry.url, entry.name);
 	images_async_loading[entry.name] = entry;
-	ofLoadURLAsync(entry.url, entry.name);
+	return id;
+}
+
+
+// Changes the priority of a queued image.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setPriority(int id, int priority) {
+	for(entry_iterator it = images_async_loading.begin(); it != images_async_loading.end(); ++it) {
+		if(it->second.id == id) {
+			it->second.priority = priority;
+			return;
+		}
+	}
+
+	ofScopedLock lock(mutex);
+	map<int,int>::iterator queued = queued_priorities.find(id);
+	if(queued == queued_priorities.end() || queued->second == priority) {
+		return;
+	}
+	load_queue::iterator it = images_to_load.find(make_pair(-queued->second, id));
+	ofImageLoaderEntry entry = std::move(it->second);
+	images_to_load.erase(it);
+	entry.priority = priority;
+	queued->second = priority;
+	images_to_load[make_pair(-priority, id)] = std::move(entry);
+}
+
+
+// Removes an image from whichever stage it's in.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancel(int id) {
+	for(entry_iterator it = images_async_loading.begin(); it != images_async_loading.end(); ++it) {
+		if(it->second.id == id) {
+			ofRemoveURLRequest(it->second.urlRequestID);
+			images_async_loading.erase(it);
+			return;
+		}
+	}
+
+	ofScopedLock lock(mutex);
+	map<int,int>::iterator queued = queued_priorities.find(id);
+	if(queued != queued_priorities.end()) {
+		images_to_load.erase(make_pair(-queued->second, id));
+		queued_priorities.erase(queued);
+		return;
+	}
+	if(images_decoding.count(id)) {
+		images_cancelled.insert(id);
+		while(images_decoding.count(id)) {
+			imageDecoded.wait(mutex);
+		}
+		return;
+	}
+	for(deque<ofImageLoaderEntry>::iterator it = images_to_update.begin(); it != images_to_update.end(); ++it) {
+		if(it->id == id) {
+			images_to_update.erase(it);
+			return;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::cancelAll() {
+	for(entry_iterator it = images_async_loading.begin(); it != images_async_loading.end(); ++it) {
+		ofRemoveURLRequest(it->second.urlRequestID);
+	}
+	images_async_loading.clear();
+
+	ofScopedLock lock(mutex);
+	images_to_load.clear();
+	queued_priorities.clear();
+	images_cancelled.insert(images_decoding.begin(), images_decoding.end());
+	while(!images_decoding.empty()) {
+		imageDecoded.wait(mutex);
+	}
+	images_to_update.clear();
+}
+
+
+// Starts or stops worker threads, the loader's own thread always decodes.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setNumWorkers(int num) {
+	num = MAX(num, 1);
+	vector<ofPtr<Worker> > stopped;
+	lock();
+	numWorkers = num;
+	while((int)workers.size() < num - 1) {
+		workers.push_back(ofPtr<Worker>(new Worker(*this, workers.size() + 1)));
+		workers.back()->startThread();
+	}
+	if((int)workers.size() > num - 1) {
+		stopped.assign(workers.begin() + num - 1, workers.end());
+		workers.resize(num - 1);
+		imagesQueued.broadcast();
+	}
+	unlock();
+	for(size_t i = 0; i < stopped.size(); i++) {
+		stopped[i]->waitForThread(true);
+	}
+}
+
+
+//--------------------------------------------------------------
+int ofxThreadedImageLoader::getNumWorkers() {
+	ofScopedLock lock(mutex);
+	return numWorkers;
+}
+
+
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::setUploadBudget(float millisPerFrame, size_t bytesPerFrame) {
+	uploadMillis = millisPerFrame;
+	uploadBytes = bytesPerFrame;
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumQueued() {
+	ofScopedLock lock(mutex);
+	return images_to_load.size() + images_async_loading.size();
+}
+
+
+//--------------------------------------------------------------
+size_t ofxThreadedImageLoader::getNumWaitingUpload() {
+	ofScopedLock lock(mutex);
+	return images_to_update.size();
+}
+
+
+//--------------------------------------------------------------
+float ofxThreadedImageLoader::getDecodeTime() {
+	ofScopedLock lock(mutex);
+	return decodeTime;
+}
+
+
+//--------------------------------------------------------------
+float ofxThreadedImageLoader::getUploadTime() {
+	return uploadTime;
 }
 
 
-// Reads from the queue and loads new images.
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::threadedFunction() {
 	thread.setName("ofxThreadedImageLoader " + thread.name());
-	ofImageLoaderEntry entry;
-	while( images_to_load_from_disk.receive(entry) ) {
-		if(entry.image->load(entry.filename) )  {
-			images_to_update.send(entry);
-		}else{
+	decodeLoop(0);
+	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
+}
+
+
+// Takes the image with the highest priority from the queue and decodes
+// it until the loader is closed or this worker is stopped.
+//--------------------------------------------------------------
+void ofxThreadedImageLoader::decodeLoop(int worker) {
+	ofScopedLock lock(mutex);
+	while(true) {
+		while(!closed && worker < numWorkers && images_to_load.empty()) {
+			imagesQueued.wait(mutex);
+		}
+		if(closed || worker >= numWorkers) {
+			break;
+		}
+
+		ofImageLoaderEntry entry = std::move(images_to_load.begin()->second);
+		images_to_load.erase(images_to_load.begin());
+		queued_priorities.erase(entry.id);
+		images_decoding.insert(entry.id);
+
+		bool loaded;
+		unsigned long long start;
+		{
+			Poco::ScopedUnlock<ofMutex> unlock(mutex);
+			start = ofGetElapsedTimeMicros();
+			if(entry.url.empty()) {
+				loaded = entry.image->load(entry.filename);
+			}else{
+				loaded = entry.image->load(entry.data);
+				entry.data.clear();
+			}
+		}
+		updateAverage(decodeTime, (ofGetElapsedTimeMicros() - start) / 1000.f);
+
+		images_decoding.erase(entry.id);
+		if(images_cancelled.erase(entry.id)) {
+			imageDecoded.broadcast();
+		}else if(loaded) {
+			images_to_update.push_back(std::move(entry));
+		}else if(entry.url.empty()) {
 			ofLogError("ofxThreadedImageLoader") << "couldn't load file: \"" << entry.filename << "\"";
+		}else{
+			ofLogError("ofxThreadedImageLoader") << "couldn't load url: \"" << entry.url << "\"";
 		}
 	}
-	ofLogVerbose("ofxThreadedImageLoader") << "finishing thread on closed queue";
 }
 
 
-// When we receive an url response this method is called; 
-// The loaded image is removed from the async_queue and added to the
-// update queue. The update queue is used to update the texture.
+// When we receive an url response this method is called;
+// The loaded image is removed from the async_queue and queued to be
+// decoded by the workers with the rest of the images.
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	// this happens in the update thread so no need to lock to access
@@ -69,8 +291,12 @@ void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 	entry_iterator it = images_async_loading.find(response.request.name);
 	if(response.status == 200) {
 		if(it != images_async_loading.end()) {
-			it->second.image->load(response.data);
-			images_to_update.send(it->second);
+			ofImageLoaderEntry & entry = it->second;
+			entry.data = response.data;
+			ofScopedLock lock(mutex);
+			queued_priorities[entry.id] = entry.priority;
+			images_to_load[make_pair(-entry.priority, entry.id)] = std::move(entry);
+			imagesQueued.signal();
 		}
 	}else{
 		// log error.
@@ -85,14 +311,31 @@ void ofxThreadedImageLoader::urlResponse(ofHttpResponse & response) {
 }
 
 
-// Check the update queue and update the texture
+// Check the update queue and update the textures until the frame's
+// upload budget is spent
 //--------------------------------------------------------------
 void ofxThreadedImageLoader::update(ofEventArgs & a){
-    // Load 1 image per update so we don't block the gl thread for too long
+	unsigned long long start = ofGetElapsedTimeMicros();
+	size_t bytes = 0;
 	ofImageLoaderEntry entry;
-	if (images_to_update.tryReceive(entry)) {
+	while(true) {
+		{
+			ofScopedLock lock(mutex);
+			if(images_to_update.empty()) {
+				break;
+			}
+			entry = std::move(images_to_update.front());
+			images_to_update.pop_front();
+		}
+		unsigned long long uploadStart = ofGetElapsedTimeMicros();
 		entry.image->setUseTexture(true);
 		entry.image->update();
+		unsigned long long now = ofGetElapsedTimeMicros();
+		updateAverage(uploadTime, (now - uploadStart) / 1000.f);
+
+		bytes += entry.image->getPixels().getTotalBytes();
+		if((uploadMillis > 0 && now - start >= uploadMillis * 1000) || (uploadBytes > 0 && bytes >= uploadBytes)) {
+			break;
+		}
 	}
 }
-
@@ -3,51 +3,109 @@
 #include "ofThread.h"
 #include "ofImage.h"
 #include "ofURLFileLoader.h"
-#include "ofTypes.h" 
-#include "ofThreadChannel.h"
+#include "ofTypes.h"
+#include "Poco/Condition.h"
+#include <deque>
+#include <set>
 
 
 using namespace std;
 
+/// Decodes images on a pool of worker threads, the ones with the highest
+/// priority first, and uploads their textures from update() within a per
+/// frame budget so loading many images doesn't stall the app.
 class ofxThreadedImageLoader : public ofThread {
 public:
     ofxThreadedImageLoader();
     ~ofxThreadedImageLoader();
 
-	void loadFromDisk(ofImage& image, string file);
-	void loadFromURL(ofImage& image, string url);
+	/// Returns an id that can be used to change the priority of the load
+	/// or cancel it. Images with a higher priority are decoded first,
+	/// images with the same priority in the order they were requested.
+	int loadFromDisk(ofImage& image, string file, int priority = 0);
+	int loadFromURL(ofImage& image, string url, int priority = 0);
 
+	/// Changes the priority of a load that hasn't started decoding yet.
+	void setPriority(int id, int priority);
 
+	/// Drops a load. If the image is being decoded waits until it's done,
+	/// once this returns the loader doesn't touch the image anymore.
+	void cancel(int id);
+	void cancelAll();
+
+	/// Number of threads decoding images, one less than the number of
+	/// cores by default.
+	void setNumWorkers(int numWorkers);
+	int getNumWorkers();
+
+	/// Every update() uploads decoded images until it has spent
+	/// millisPerFrame or uploaded bytesPerFrame of pixels, 0 means no
+	/// limit. At least one image is uploaded per frame. 4ms by default.
+	void setUploadBudget(float millisPerFrame, size_t bytesPerFrame = 0);
+
+	/// Loads waiting for a worker to decode them.
+	size_t getNumQueued();
+	/// Decoded images waiting for their texture to be uploaded.
+	size_t getNumWaitingUpload();
+	/// Moving averages of the time to decode and to upload an image in ms.
+	float getDecodeTime();
+	float getUploadTime();
 
 private:
 	void update(ofEventArgs & a);
     virtual void threadedFunction();
 	void urlResponse(ofHttpResponse & response);
-    
+	void decodeLoop(int worker);
+
     // Entry to load.
     struct ofImageLoaderEntry {
         ofImageLoaderEntry() {
             image = NULL;
+            id = 0;
+            priority = 0;
+            urlRequestID = 0;
         }
-        
+
         ofImageLoaderEntry(ofImage & pImage) {
             image = &pImage;
+            id = 0;
+            priority = 0;
+            urlRequestID = 0;
         }
         ofImage* image;
         string filename;
         string url;
         string name;
+        ofBuffer data;
+        int id;
+        int priority;
+        int urlRequestID;
     };
 
+    class Worker;
 
+    // queue ordered by highest priority and then lowest id
+    typedef map<pair<int,int>, ofImageLoaderEntry> load_queue;
     typedef map<string, ofImageLoaderEntry>::iterator entry_iterator;
 
 	int                 nextID;
-    int                 lastUpdate;
+	int                 numWorkers;
+	bool                closed;
+	float               uploadMillis;
+	size_t              uploadBytes;
+	float               decodeTime;
+	float               uploadTime;
 
 	map<string,ofImageLoaderEntry> images_async_loading; // keeps track of images which are loading async
-	ofThreadChannel<ofImageLoaderEntry> images_to_load_from_disk;
-	ofThreadChannel<ofImageLoaderEntry> images_to_update;
+	load_queue images_to_load;
+	map<int,int> queued_priorities;
+	set<int> images_decoding;
+	set<int> images_cancelled;
+	deque<ofImageLoaderEntry> images_to_update;
+
+	vector<ofPtr<Worker> > workers;
+	Poco::Condition imagesQueued;
+	Poco::Condition imageDecoded;
 };
 
 
@@ -0,0 +1,53 @@
+#include "ofMain.h"
+#include "Poco/Path.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/LocalDateTime.h"
+
+// converts a log file written by ofBinaryLoggerChannel to text:
+//
+//     binaryLogDecoder log.bin [minimum level] > log.txt
+//
+// every line has the local time, the thread id, the level, the module and
+// the message, from the oldest message in the file to the newest
+
+//========================================================================
+int main(int argc, char ** argv){
+	if(argc < 2){
+		cerr << "usage: " << argv[0] << " log.bin [verbose|notice|warning|error|fatal]" << endl;
+		return 1;
+	}
+
+	ofLogLevel minLevel = OF_LOG_VERBOSE;
+	if(argc > 2){
+		string name = argv[2];
+		for(int level = OF_LOG_VERBOSE; level < OF_LOG_SILENT; level++){
+			if(ofGetLogLevelName(ofLogLevel(level)) == name){
+				minLevel = ofLogLevel(level);
+			}
+		}
+	}
+
+	// paths are relative to the working directory, not the data folder
+	string path = Poco::Path(argv[1]).absolute().toString();
+	vector<ofBinaryLoggerChannel::Message> messages;
+	if(!ofBinaryLoggerChannel::read(path, messages)){
+		cerr << "couldn't read \"" << argv[1] << "\", it's not a binary log" << endl;
+		return 1;
+	}
+
+	for(size_t i = 0; i < messages.size(); i++){
+		const ofBinaryLoggerChannel::Message & message = messages[i];
+		if(message.level < minLevel){
+			continue;
+		}
+		Poco::LocalDateTime time(Poco::DateTime(Poco::Timestamp(message.time)));
+		cout << Poco::DateTimeFormatter::format(time, "%Y-%m-%d %H:%M:%S.%F");
+		cout << " [" << ofToHex(message.thread) << "]";
+		cout << " [" << ofGetLogLevelName(message.level, true) << "] ";
+		if(message.module != ""){
+			cout << message.module << ": ";
+		}
+		cout << message.message << '\n';
+	}
+	return 0;
+}
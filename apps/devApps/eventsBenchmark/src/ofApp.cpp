@@ -0,0 +1,99 @@
+#include "ofApp.h"
+#include "Poco/PriorityEvent.h"
+#include "Poco/PriorityDelegate.h"
+
+//--------------------------------------------------------------
+class Counter{
+public:
+	Counter():count(0){}
+	void onEvent(int & value){
+		count += value;
+	}
+	// only compared after notifying from one thread
+	long long count;
+};
+
+//--------------------------------------------------------------
+// notifies the same event from several threads, numNotifications each
+template<class EventType>
+class Notifier: public ofThread{
+public:
+	Notifier(EventType & event, int numNotifications)
+	:event(event)
+	,numNotifications(numNotifications){}
+
+	void threadedFunction(){
+		int value = 1;
+		for(int i = 0; i < numNotifications; i++){
+			event.notify(this, value);
+		}
+	}
+
+	EventType & event;
+	int numNotifications;
+};
+
+//--------------------------------------------------------------
+// ns per notification
+template<class EventType>
+static float timeNotify(EventType & event, int numNotifications, int numThreads){
+	unsigned long long start = ofGetElapsedTimeMicros();
+	if(numThreads == 1){
+		int value = 1;
+		for(int i = 0; i < numNotifications; i++){
+			event.notify(NULL, value);
+		}
+	}else{
+		vector<shared_ptr<Notifier<EventType> > > notifiers;
+		for(int i = 0; i < numThreads; i++){
+			notifiers.push_back(shared_ptr<Notifier<EventType> >(new Notifier<EventType>(event, numNotifications / numThreads)));
+			notifiers.back()->startThread(false);
+		}
+		for(int i = 0; i < numThreads; i++){
+			notifiers[i]->waitForThread(false);
+		}
+	}
+	return (ofGetElapsedTimeMicros() - start) * 1000.f / numNotifications;
+}
+
+//--------------------------------------------------------------
+bool ofApp::benchmarkListeners(int numListeners){
+	vector<Counter> pocoCounters(numListeners);
+	vector<Counter> ofCounters(numListeners);
+	Poco::PriorityEvent<int> pocoEvent;
+	ofEvent<int> event;
+	for(int i = 0; i < numListeners; i++){
+		pocoEvent += Poco::priorityDelegate(&pocoCounters[i], &Counter::onEvent, i % 3);
+		ofAddListener(event, &ofCounters[i], &Counter::onEvent, i % 3);
+	}
+
+	int numNotifications = max(1000, 2000000 / numListeners);
+	float poco = timeNotify(pocoEvent, numNotifications, 1);
+	float of = timeNotify(event, numNotifications, 1);
+	bool same = true;
+	for(int i = 0; i < numListeners; i++){
+		same &= pocoCounters[i].count == ofCounters[i].count;
+	}
+	float pocoThreads = timeNotify(pocoEvent, numNotifications, 4);
+	float ofThreads = timeNotify(event, numNotifications, 4);
+
+	ofLogNotice("eventsBenchmark") << ofToString(numListeners, 9, ' ')
+		<< ofToString(poco, 1, 10, ' ') << " ->" << ofToString(of, 1, 8, ' ')
+		<< ofToString(pocoThreads, 1, 10, ' ') << " ->" << ofToString(ofThreads, 1, 8, ' ');
+	if(!same){
+		ofLogError("eventsBenchmark") << "ofEvent called its " << numListeners << " listeners differently than Poco::PriorityEvent";
+	}
+	return same;
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofLogNotice("eventsBenchmark") << "ns per notify, Poco::PriorityEvent -> ofEvent";
+	ofLogNotice("eventsBenchmark") << "listeners" << ofToString("1 thread", 21, ' ') << ofToString("4 threads", 21, ' ');
+	bool same = true;
+	same &= benchmarkListeners(1);
+	same &= benchmarkListeners(10);
+	same &= benchmarkListeners(100);
+	same &= benchmarkListeners(1000);
+	ofExit(same ? 0 : 1);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "ofMain.h"
+
+// times notifying an ofEvent<int> with 1 to 1000 listeners against the
+// Poco::PriorityEvent it used to be based on, from one thread and from
+// several threads notifying the same event at the same time. Logs the
+// times and exits, with status 1 if both called the listeners differently
+class ofApp : public ofBaseApp {
+
+	public:
+		void setup();
+
+		bool benchmarkListeners(int numListeners);
+};
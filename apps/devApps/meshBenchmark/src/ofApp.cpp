@@ -0,0 +1,166 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+// a height field of numCells x numCells quads made of 2 triangles with 3
+// vertices each, so every inner position is repeated 6 times
+static ofMesh makeTriangleSoup(int numCells){
+	ofMesh mesh;
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	mesh.getVertices().reserve(numCells * numCells * 6);
+	mesh.getColors().reserve(numCells * numCells * 6);
+	mesh.getTexCoords().reserve(numCells * numCells * 6);
+	const int corners[6][2] = {{0,0},{1,0},{0,1},{1,0},{1,1},{0,1}};
+	for(int y = 0; y < numCells; y++){
+		for(int x = 0; x < numCells; x++){
+			for(int k = 0; k < 6; k++){
+				float px = x + corners[k][0];
+				float py = y + corners[k][1];
+				float pz = sin(px * 0.3f) * cos(py * 0.2f) * 4.f;
+				mesh.addVertex(ofVec3f(px, py, pz));
+				mesh.addColor(ofFloatColor(px / numCells, py / numCells, 0.5f));
+				mesh.addTexCoord(ofVec2f(px / numCells, py / numCells));
+			}
+		}
+	}
+	mesh.setupIndicesAuto();
+	return mesh;
+}
+
+//--------------------------------------------------------------
+// brute force versions, O(n^2), only usable for small meshes
+static void referenceMergeDuplicateVertices(ofMesh & mesh){
+	const vector<ofVec3f> & vertices = mesh.getVertices();
+	const vector<ofIndexType> & indices = mesh.getIndices();
+	ofMesh merged;
+	merged.setMode(mesh.getMode());
+	vector<int> newIndices(vertices.size(), -1);
+	for(size_t i = 0; i < indices.size(); i++){
+		ofIndexType index = indices[i];
+		if(newIndices[index] == -1){
+			for(size_t j = 0; j < i; j++){
+				if(vertices[indices[j]] == vertices[index]){
+					newIndices[index] = newIndices[indices[j]];
+					break;
+				}
+			}
+		}
+		if(newIndices[index] == -1){
+			newIndices[index] = merged.getNumVertices();
+			merged.addVertex(vertices[index]);
+			merged.addColor(mesh.getColor(index));
+			merged.addTexCoord(mesh.getTexCoord(index));
+		}
+		merged.addIndex(newIndices[index]);
+	}
+	mesh = merged;
+}
+
+//--------------------------------------------------------------
+static void referenceSmoothNormals(ofMesh & mesh, float angle){
+	const vector<ofMeshFace> & faces = mesh.getUniqueFaces();
+	float angleCos = cos(angle * DEG_TO_RAD);
+	vector<ofMeshFace> triangles = faces;
+	for(size_t i = 0; i < faces.size(); i++){
+		for(int k = 0; k < 3; k++){
+			ofVec3f normal;
+			float numNormals = 0;
+			for(size_t j = 0; j < faces.size(); j++){
+				for(int l = 0; l < 3; l++){
+					if(faces[j].getVertex(l) == faces[i].getVertex(k) && faces[i].getFaceNormal().dot(faces[j].getFaceNormal()) >= angleCos){
+						normal += faces[j].getFaceNormal();
+						numNormals += 1.f;
+					}
+				}
+			}
+			triangles[i].setNormal(k, normal / numNormals);
+		}
+	}
+	mesh.setFromTriangles(triangles);
+}
+
+//--------------------------------------------------------------
+static bool equal(ofMesh & a, ofMesh & b){
+	if(a.getNumIndices() != b.getNumIndices() || a.getNumVertices() != b.getNumVertices() || a.getNumNormals() != b.getNumNormals()){
+		return false;
+	}
+	for(int i = 0; i < a.getNumIndices(); i++){
+		if(a.getVertex(a.getIndex(i)) != b.getVertex(b.getIndex(i))){
+			return false;
+		}
+		if(a.getNumNormals() && a.getNormal(a.getIndex(i)).distance(b.getNormal(b.getIndex(i))) > 1e-5){
+			return false;
+		}
+		if(a.getColor(a.getIndex(i)) != b.getColor(b.getIndex(i))){
+			return false;
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofApp::checkReference(){
+	ofMesh mesh = makeTriangleSoup(40);
+	ofMesh reference = mesh;
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	referenceMergeDuplicateVertices(reference);
+	float referenceMerge = (ofGetElapsedTimeMicros() - start) / 1000.f;
+	start = ofGetElapsedTimeMicros();
+	mesh.mergeDuplicateVertices();
+	float merge = (ofGetElapsedTimeMicros() - start) / 1000.f;
+	bool sameMerge = equal(mesh, reference);
+
+	start = ofGetElapsedTimeMicros();
+	referenceSmoothNormals(reference, 45);
+	float referenceSmooth = (ofGetElapsedTimeMicros() - start) / 1000.f;
+	start = ofGetElapsedTimeMicros();
+	mesh.smoothNormals(45);
+	float smooth = (ofGetElapsedTimeMicros() - start) / 1000.f;
+	bool sameSmooth = equal(mesh, reference);
+
+	ofLogNotice("meshBenchmark") << "ms, brute force -> spatial hash, " << 40 * 40 * 6 << " vertices";
+	ofLogNotice("meshBenchmark") << "merge " << ofToString(referenceMerge, 2, 10, ' ') << " ->" << ofToString(merge, 2, 8, ' ');
+	ofLogNotice("meshBenchmark") << "smooth" << ofToString(referenceSmooth, 2, 10, ' ') << " ->" << ofToString(smooth, 2, 8, ' ');
+	if(!sameMerge){
+		ofLogError("meshBenchmark") << "mergeDuplicateVertices() output differs from the brute force version";
+	}
+	if(!sameSmooth){
+		ofLogError("meshBenchmark") << "smoothNormals() output differs from the brute force version";
+	}
+	return sameMerge && sameSmooth;
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkSize(int numVertices){
+	int numCells = sqrt(numVertices / 6.f);
+	ofMesh mesh = makeTriangleSoup(numCells);
+
+	unsigned long long start = ofGetElapsedTimeMicros();
+	mesh.mergeDuplicateVertices();
+	float merge = (ofGetElapsedTimeMicros() - start) / 1000.f;
+	int merged = mesh.getNumVertices();
+
+	start = ofGetElapsedTimeMicros();
+	mesh.mergeDuplicateVertices(0.01f);
+	float mergeEpsilon = (ofGetElapsedTimeMicros() - start) / 1000.f;
+
+	start = ofGetElapsedTimeMicros();
+	mesh.smoothNormals(45);
+	float smooth = (ofGetElapsedTimeMicros() - start) / 1000.f;
+
+	ofLogNotice("meshBenchmark") << ofToString(numCells * numCells * 6, 8, ' ') << ofToString(merged, 8, ' ')
+		<< ofToString(merge, 2, 10, ' ') << ofToString(mergeEpsilon, 2, 15, ' ') << ofToString(smooth, 2, 15, ' ');
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	bool same = checkReference();
+
+	ofLogNotice("meshBenchmark") << "ms per call";
+	ofLogNotice("meshBenchmark") << "vertices  merged     merge  merge epsilon smooth normals";
+	benchmarkSize(10000);
+	benchmarkSize(100000);
+	benchmarkSize(1000000);
+	benchmarkSize(5000000);
+	ofExit(same ? 0 : 1);
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "ofMain.h"
+
+// times ofMesh::mergeDuplicateVertices and ofMesh::smoothNormals on
+// procedurally generated meshes from 10k to 5M vertices and checks the
+// results on the smallest one against the previous brute force versions.
+// Logs the times and exits, with status 1 if the results differ
+class ofApp : public ofBaseApp {
+
+	public:
+		void setup();
+
+		void benchmarkSize(int numVertices);
+		bool checkReference();
+};
@@ -0,0 +1,85 @@
+#include "ofApp.h"
+
+// frames to wait for a message to arrive before failing a check
+static const int maxFramesWaiting = 60;
+static const size_t numChecks = 3;
+
+//--------------------------------------------------------------
+void SyncedParameters::setup(int localPort, int remotePort){
+	circle.setName("circle");
+	circle.add(resolution.set("resolution",20,3,100));
+
+	parameters.setName("parameters");
+	parameters.add(size.set("size",10,0,100));
+	parameters.add(circle);
+
+	app.setName("app");
+	app.add(parameters);
+
+	// the group stored in app is the parent its parameters notify
+	sync.setup(static_cast<ofParameterGroup&>(app.get("parameters")),localPort,"localhost",remotePort);
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	// without a window nothing else limits the frames maxFramesWaiting counts
+	ofSetFrameRate(60);
+	local.setup(6670,6671);
+	remote.setup(6671,6670);
+	failures = 0;
+	startCheck(0);
+}
+
+//--------------------------------------------------------------
+void ofApp::startCheck(size_t check){
+	currentCheck = check;
+	framesWaiting = 0;
+	switch(currentCheck){
+	case 0:
+		local.size = 42;
+		break;
+	case 1:
+		local.resolution = 7;
+		break;
+	case 2:
+		remote.resolution = 3;
+		break;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	local.sync.update();
+	remote.sync.update();
+	if(currentCheck >= numChecks) return;
+
+	string name;
+	bool synced = false;
+	switch(currentCheck){
+	case 0:
+		name = "/app/parameters/size local -> remote";
+		synced = remote.size == 42;
+		break;
+	case 1:
+		name = "/app/parameters/circle/resolution local -> remote";
+		synced = remote.resolution == 7;
+		break;
+	case 2:
+		name = "/app/parameters/circle/resolution remote -> local";
+		synced = local.resolution == 3;
+		break;
+	}
+	if(synced || ++framesWaiting == maxFramesWaiting){
+		if(synced){
+			ofLogNotice("oscParameterSyncTest") << "PASS " << name;
+		}else{
+			ofLogError("oscParameterSyncTest") << "FAIL " << name << ", not synced after " << maxFramesWaiting << " frames";
+			failures++;
+		}
+		startCheck(currentCheck + 1);
+		if(currentCheck == numChecks){
+			ofLogNotice("oscParameterSyncTest") << numChecks - failures << " of " << numChecks << " checks passed";
+			ofExit(failures ? 1 : 0);
+		}
+	}
+}
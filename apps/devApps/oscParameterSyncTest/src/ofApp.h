@@ -0,0 +1,37 @@
+#pragma once
+#include "ofMain.h"
+#include "ofxOscParameterSync.h"
+
+// two apps syncing their parameters through ofxOscParameterSync over
+// localhost. the synced group is nested in another group and contains a
+// group itself, so the addresses the sender builds from the whole group
+// hierarchy have to match the ones the receiver registers. Logs every
+// check and exits with status 1 if any of them failed
+class SyncedParameters{
+public:
+	void setup(int localPort, int remotePort);
+
+	// kept alive, destroying a group clears the parent of its parameters
+	ofParameterGroup app;
+	ofParameterGroup parameters;
+	ofParameterGroup circle;
+	ofParameter<float> size;
+	ofParameter<int> resolution;
+	ofxOscParameterSync sync;
+};
+
+class ofApp : public ofBaseApp {
+
+	public:
+		void setup();
+		void update();
+
+		void startCheck(size_t check);
+
+		SyncedParameters local;
+		SyncedParameters remote;
+
+		size_t currentCheck;
+		int framesWaiting;
+		size_t failures;
+};
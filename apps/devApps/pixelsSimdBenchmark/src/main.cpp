@@ -0,0 +1,14 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+
+	// only logs, doesn't need a window
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window, 1024,768, OF_WINDOW);
+
+	return ofRunApp( new ofApp());
+
+}
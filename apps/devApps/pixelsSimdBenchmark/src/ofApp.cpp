@@ -0,0 +1,101 @@
+#include "ofApp.h"
+
+static const int numIterations = 20;
+
+//--------------------------------------------------------------
+template<typename Operation>
+static float measure(Operation op){
+	op(); // warm up
+	unsigned long long start = ofGetElapsedTimeMicros();
+	for(int i=0;i<numIterations;i++){
+		op();
+	}
+	return (ofGetElapsedTimeMicros() - start) / 1000.f / numIterations;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+static bool equal(const ofPixels_<PixelType> & a, const ofPixels_<PixelType> & b){
+	return a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight() &&
+			memcmp(a.getData(), b.getData(), a.getTotalBytes()) == 0;
+}
+
+//--------------------------------------------------------------
+struct Results{
+	float swapRgb, mirror, mirrorTo, rotate90, downscale, upscale;
+};
+
+//--------------------------------------------------------------
+template<typename PixelType>
+static Results run(ofPixels_<PixelType> & pixels, ofPixels_<PixelType> * out){
+	ofPixels_<PixelType> mirrored, rotated, small, big;
+	small.allocate(pixels.getWidth()/3, pixels.getHeight()/3, pixels.getPixelFormat());
+	big.allocate(pixels.getWidth()*2, pixels.getHeight()*2, pixels.getPixelFormat());
+
+	Results results;
+	results.swapRgb = measure([&]{ pixels.swapRgb(); });
+	results.mirror = measure([&]{ pixels.mirror(true, true); });
+	results.mirrorTo = measure([&]{ pixels.mirrorTo(mirrored, false, true); });
+	results.rotate90 = measure([&]{ pixels.rotate90To(rotated, 1); });
+	results.downscale = measure([&]{ pixels.resizeTo(small); });
+	results.upscale = measure([&]{ pixels.resizeTo(big); });
+
+	out[0] = mirrored;
+	out[1] = rotated;
+	out[2] = small;
+	out[3] = big;
+	return results;
+}
+
+//--------------------------------------------------------------
+template<typename PixelType>
+bool ofApp::benchmarkFormat(const string & name, ofPixelFormat format){
+	ofPixels_<PixelType> pixels;
+	pixels.allocate(1920, 1080, format);
+	for(int i=0;i<pixels.size();i++){
+		pixels[i] = PixelType(ofRandom(0,255));
+	}
+	ofPixels_<PixelType> scalarPixels = pixels;
+	ofPixels_<PixelType> simdPixels = pixels;
+	ofPixels_<PixelType> scalarOut[4], simdOut[4];
+
+	ofDisablePixelsSimd();
+	Results scalar = run(scalarPixels, scalarOut);
+	ofEnablePixelsSimd();
+	Results simd = run(simdPixels, simdOut);
+
+	bool same = equal(scalarPixels, simdPixels);
+	for(int i=0;i<4;i++){
+		same &= equal(scalarOut[i], simdOut[i]);
+	}
+
+	string operations[] = {"swapRgb", "mirror", "mirrorTo", "rotate90", "downscale", "upscale"};
+	float scalarTimes[] = {scalar.swapRgb, scalar.mirror, scalar.mirrorTo, scalar.rotate90, scalar.downscale, scalar.upscale};
+	float simdTimes[] = {simd.swapRgb, simd.mirror, simd.mirrorTo, simd.rotate90, simd.downscale, simd.upscale};
+	for(int i=0;i<6;i++){
+		ofLogNotice("pixelsSimdBenchmark") << name << string(12 - name.size(), ' ') << operations[i] << string(10 - operations[i].size(), ' ')
+			<< ofToString(scalarTimes[i], 2, 8, ' ') << ofToString(simdTimes[i], 2, 8, ' ');
+	}
+	if(!same){
+		ofLogError("pixelsSimdBenchmark") << name << ": the SIMD output differs from the scalar one";
+	}
+	return same;
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofLogNotice("pixelsSimdBenchmark") << "ms, 1920x1080, average of " << numIterations << " runs";
+	ofLogNotice("pixelsSimdBenchmark") << "format      operation   scalar" << ofToString(ofGetPixelsSimdInstructionSet(), 8, ' ');
+
+	bool same = true;
+	same &= benchmarkFormat<unsigned char>("8bit gray", OF_PIXELS_GRAY);
+	same &= benchmarkFormat<unsigned char>("8bit rgb", OF_PIXELS_RGB);
+	same &= benchmarkFormat<unsigned char>("8bit rgba", OF_PIXELS_RGBA);
+	same &= benchmarkFormat<unsigned short>("16bit gray", OF_PIXELS_GRAY);
+	same &= benchmarkFormat<unsigned short>("16bit rgb", OF_PIXELS_RGB);
+	same &= benchmarkFormat<unsigned short>("16bit rgba", OF_PIXELS_RGBA);
+	same &= benchmarkFormat<float>("float gray", OF_PIXELS_GRAY);
+	same &= benchmarkFormat<float>("float rgb", OF_PIXELS_RGB);
+	same &= benchmarkFormat<float>("float rgba", OF_PIXELS_RGBA);
+	ofExit(same ? 0 : 1);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "ofMain.h"
+
+// compares the scalar and SIMD paths of the ofPixels kernels on a 1080p
+// frame for every pixel format and checks that both produce the same output.
+// Logs the times and exits, with status 1 if the outputs differ
+class ofApp : public ofBaseApp {
+
+	public:
+		void setup();
+
+		template<typename PixelType>
+		bool benchmarkFormat(const string & name, ofPixelFormat format);
+};
@@ -1,6 +1,108 @@
 #include "ofMesh.h"
 #include "ofAppRunner.h"
 #include <map>
+#include <algorithm>
+
+#include "ofFileUtils.h"
+#include "ofThreadPool.h"
+
+//--------------------------------------------------------------
+// work split in ranges of [0, size) by runMeshJob
+class ofMeshJob: public ofParallelJob{
+};
+
+//--------------------------------------------------------------
+// runs a job in one range per thread of the global pool and the calling
+// thread when it's big enough to pay for the synchronization
+static void runMeshJob(ofMeshJob & job, size_t size){
+	static const size_t minRangeSize = 16384;
+	size_t numRanges = MIN(ofGetThreadPool().getNumThreads() + 1, size / minRangeSize);
+	if(numRanges > 1){
+		ofParallelFor(job, 0, size, (size + numRanges - 1) / numRanges);
+	}else{
+		job.run(0, size);
+	}
+}
+
+//--------------------------------------------------------------
+// finds groups of vertices closer than epsilon using a hash of a grid with
+// cells of size epsilon, or of the exact positions if epsilon is 0
+class ofMeshVertexGrid{
+public:
+	ofMeshVertexGrid(const vector<ofVec3f> & vertices, float epsilon)
+	:vertices(vertices)
+	,epsilon(MAX(epsilon, 0.f))
+	,next(vertices.size(), -1){
+		size_t numBuckets = 1;
+		while(numBuckets < vertices.size() * 2){
+			numBuckets *= 2;
+		}
+		buckets.resize(numBuckets, -1);
+	}
+
+	// returns the vertex added before that's closest to vertex and not
+	// further than epsilon, or adds vertex and returns it if there's none
+	int findOrAdd(int vertex){
+		const ofVec3f & v = vertices[vertex];
+		int found = -1;
+		if(epsilon == 0){
+			// + 0.f turns -0 into 0 so they are equal
+			size_t bucket = hash(bits(v.x + 0.f), bits(v.y + 0.f), bits(v.z + 0.f));
+			for(int i = buckets[bucket]; i != -1 && found == -1; i = next[i]){
+				if(vertices[i] == v){
+					found = i;
+				}
+			}
+			if(found == -1){
+				add(vertex, bucket);
+			}
+		}else{
+			long long x = floor(v.x / epsilon);
+			long long y = floor(v.y / epsilon);
+			long long z = floor(v.z / epsilon);
+			float minDistance = epsilon * epsilon;
+			for(long long cx = x - 1; cx <= x + 1; cx++){
+				for(long long cy = y - 1; cy <= y + 1; cy++){
+					for(long long cz = z - 1; cz <= z + 1; cz++){
+						for(int i = buckets[hash(cx, cy, cz)]; i != -1; i = next[i]){
+							float distance = vertices[i].squareDistance(v);
+							if(distance < minDistance || (distance == minDistance && (found == -1 || i < found))){
+								minDistance = distance;
+								found = i;
+							}
+						}
+					}
+				}
+			}
+			if(found == -1){
+				add(vertex, hash(x, y, z));
+			}
+		}
+		return found == -1 ? vertex : found;
+	}
+
+private:
+	static long long bits(float f){
+		union{ float f; int i; } u;
+		u.f = f;
+		return u.i;
+	}
+
+	size_t hash(long long x, long long y, long long z) const{
+		unsigned long long h = (x * 73856093LL) ^ (y * 19349663LL) ^ (z * 83492791LL);
+		return (h ^ (h >> 29)) & (buckets.size() - 1);
+	}
+
+	void add(int vertex, size_t bucket){
+		next[vertex] = buckets[bucket];
+		buckets[bucket] = vertex;
+	}
+
+	const vector<ofVec3f> & vertices;
+	float epsilon;
+	vector<int> buckets;
+	vector<int> next;
+};
 
 //--------------------------------------------------------------
 ofMesh::ofMesh(){
@@ -769,13 +871,757 @@ void ofMesh::append(const ofMesh & mesh){
 
 
 //--------------------------------------------------------------
-void ofMesh::load(string path){
-	ofFile is(path, ofFile::ReadOnly);
-	ofMesh& data = *this;
+ofMeshLoadSettings::ofMeshLoadSettings()
+:stride(1)
+,useBoundingBox(false){
+
+}
+
+//--------------------------------------------------------------
+enum ofPlyType{
+	OF_PLY_NONE,
+	OF_PLY_CHAR,
+	OF_PLY_UCHAR,
+	OF_PLY_SHORT,
+	OF_PLY_USHORT,
+	OF_PLY_INT,
+	OF_PLY_UINT,
+	OF_PLY_FLOAT,
+	OF_PLY_DOUBLE
+};
+
+struct ofPlyProperty{
+	string name;
+	ofPlyType type;
+	ofPlyType countType; // OF_PLY_NONE unless it's a list
+};
+
+struct ofPlyElement{
+	string name;
+	uint64_t count;
+	vector<ofPlyProperty> properties;
+};
+
+struct ofPlyHeader{
+	enum Format{
+		Ascii,
+		BinaryLittleEndian,
+		BinaryBigEndian
+	};
+	Format format;
+	vector<ofPlyElement> elements;
+	size_t size;
+};
+
+//--------------------------------------------------------------
+static ofPlyType plyTypeFromString(const string & type){
+	if(type == "char" || type == "int8") return OF_PLY_CHAR;
+	if(type == "uchar" || type == "uint8") return OF_PLY_UCHAR;
+	if(type == "short" || type == "int16") return OF_PLY_SHORT;
+	if(type == "ushort" || type == "uint16") return OF_PLY_USHORT;
+	if(type == "int" || type == "int32") return OF_PLY_INT;
+	if(type == "uint" || type == "uint32") return OF_PLY_UINT;
+	if(type == "float" || type == "float32") return OF_PLY_FLOAT;
+	if(type == "double" || type == "float64") return OF_PLY_DOUBLE;
+	return OF_PLY_NONE;
+}
+
+//--------------------------------------------------------------
+static size_t plyTypeSize(ofPlyType type){
+	switch(type){
+	case OF_PLY_CHAR:
+	case OF_PLY_UCHAR:
+		return 1;
+	case OF_PLY_SHORT:
+	case OF_PLY_USHORT:
+		return 2;
+	case OF_PLY_INT:
+	case OF_PLY_UINT:
+	case OF_PLY_FLOAT:
+		return 4;
+	case OF_PLY_DOUBLE:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+//--------------------------------------------------------------
+static bool isLittleEndian(){
+	unsigned short value = 1;
+	return *(unsigned char*)&value == 1;
+}
 
+//--------------------------------------------------------------
+static inline double readPlyValue(const char * src, ofPlyType type, bool swapBytes){
+	unsigned char bytes[8];
+	size_t size = plyTypeSize(type);
+	memcpy(bytes, src, size);
+	if(swapBytes){
+		std::reverse(bytes, bytes + size);
+	}
+	switch(type){
+	case OF_PLY_CHAR: { signed char v; memcpy(&v, bytes, 1); return v; }
+	case OF_PLY_UCHAR: { unsigned char v; memcpy(&v, bytes, 1); return v; }
+	case OF_PLY_SHORT: { short v; memcpy(&v, bytes, 2); return v; }
+	case OF_PLY_USHORT: { unsigned short v; memcpy(&v, bytes, 2); return v; }
+	case OF_PLY_INT: { int v; memcpy(&v, bytes, 4); return v; }
+	case OF_PLY_UINT: { unsigned int v; memcpy(&v, bytes, 4); return v; }
+	case OF_PLY_FLOAT: { float v; memcpy(&v, bytes, 4); return v; }
+	case OF_PLY_DOUBLE: { double v; memcpy(&v, bytes, 8); return v; }
+	default: return 0;
+	}
+}
+
+//--------------------------------------------------------------
+// parses everything up to end_header, data and size are the whole file
+static bool parsePlyHeader(const char * data, size_t size, ofPlyHeader & header, string & error){
+	static const string endHeader = "end_header";
+	const char * end = std::search(data, data + size, endHeader.begin(), endHeader.end());
+	if(size < 3 || string(data, 3) != "ply"){
+		error = "wrong format, expecting 'ply'";
+		return false;
+	}
+	if(end == data + size){
+		error = "couldn't find 'end_header'";
+		return false;
+	}
+	end += endHeader.size();
+	if(end < data + size && *end == '\r') end++;
+	if(end < data + size && *end == '\n') end++;
+	header.size = end - data;
+
+	stringstream lines(string(data, header.size));
+	string line;
+	bool formatFound = false;
+	while(getline(lines, line)){
+		if(!line.empty() && line[line.size() - 1] == '\r'){
+			line.resize(line.size() - 1);
+		}
+		stringstream words(line);
+		string keyword;
+		words >> keyword;
+		if(keyword == "format"){
+			string format, version;
+			words >> format >> version;
+			if(format == "ascii"){
+				header.format = ofPlyHeader::Ascii;
+			}else if(format == "binary_little_endian"){
+				header.format = ofPlyHeader::BinaryLittleEndian;
+			}else if(format == "binary_big_endian"){
+				header.format = ofPlyHeader::BinaryBigEndian;
+			}else{
+				error = "unknown format '" + format + "'";
+				return false;
+			}
+			formatFound = true;
+		}else if(keyword == "element"){
+			ofPlyElement element;
+			words >> element.name >> element.count;
+			if(words.fail()){
+				error = "wrong element definition '" + line + "'";
+				return false;
+			}
+			header.elements.push_back(element);
+		}else if(keyword == "property"){
+			if(header.elements.empty()){
+				error = "property '" + line + "' outside of an element";
+				return false;
+			}
+			ofPlyProperty property;
+			string type;
+			words >> type;
+			if(type == "list"){
+				string countType;
+				words >> countType >> type;
+				property.countType = plyTypeFromString(countType);
+				if(property.countType == OF_PLY_NONE){
+					error = "unknown type in '" + line + "'";
+					return false;
+				}
+			}else{
+				property.countType = OF_PLY_NONE;
+			}
+			property.type = plyTypeFromString(type);
+			words >> property.name;
+			if(property.type == OF_PLY_NONE || property.name.empty()){
+				error = "wrong property definition '" + line + "'";
+				return false;
+			}
+			header.elements.back().properties.push_back(property);
+		}
+	}
+	if(!formatFound){
+		error = "couldn't find the format";
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+// where each attribute of a vertex is in the records of a binary vertex
+// element, -1 if the file doesn't have it
+struct ofPlyVertexFormat{
+	enum Attribute{
+		X, Y, Z,
+		NX, NY, NZ,
+		Red, Green, Blue, Alpha,
+		U, V,
+		NumAttributes
+	};
+
+	ofPlyVertexFormat(const ofPlyElement & element, bool swapBytes)
+	:recordSize(0)
+	,swapBytes(swapBytes)
+	,hasLists(false){
+		for(int i = 0; i < NumAttributes; i++){
+			offsets[i] = -1;
+			types[i] = OF_PLY_NONE;
+		}
+		for(size_t i = 0; i < element.properties.size(); i++){
+			const ofPlyProperty & property = element.properties[i];
+			if(property.countType != OF_PLY_NONE){
+				hasLists = true;
+				continue;
+			}
+			int attribute = getAttribute(property.name);
+			if(attribute != -1){
+				offsets[attribute] = recordSize;
+				types[attribute] = property.type;
+			}
+			recordSize += plyTypeSize(property.type);
+		}
+		floatPositions = !swapBytes && types[X] == OF_PLY_FLOAT && types[Y] == OF_PLY_FLOAT && types[Z] == OF_PLY_FLOAT
+				&& offsets[Y] == offsets[X] + 4 && offsets[Z] == offsets[X] + 8;
+	}
+
+	static int getAttribute(const string & name){
+		if(name == "x") return X;
+		if(name == "y") return Y;
+		if(name == "z") return Z;
+		if(name == "nx") return NX;
+		if(name == "ny") return NY;
+		if(name == "nz") return NZ;
+		if(name == "red" || name == "r" || name == "diffuse_red") return Red;
+		if(name == "green" || name == "g" || name == "diffuse_green") return Green;
+		if(name == "blue" || name == "b" || name == "diffuse_blue") return Blue;
+		if(name == "alpha" || name == "a") return Alpha;
+		if(name == "u" || name == "s" || name == "texture_u" || name == "texture_s") return U;
+		if(name == "v" || name == "t" || name == "texture_v" || name == "texture_t") return V;
+		return -1;
+	}
+
+	bool has(Attribute attribute) const{
+		return offsets[attribute] != -1;
+	}
+
+	bool hasColors() const{
+		return has(Red) || has(Green) || has(Blue) || has(Alpha);
+	}
+
+	bool hasNormals() const{
+		return has(NX) || has(NY) || has(NZ);
+	}
+
+	bool hasTexCoords() const{
+		return has(U) || has(V);
+	}
+
+	float read(const char * record, Attribute attribute) const{
+		if(offsets[attribute] == -1){
+			return 0;
+		}
+		return readPlyValue(record + offsets[attribute], types[attribute], swapBytes);
+	}
+
+	// colors stored as integers go from 0 to the maximum of their type
+	float readColor(const char * record, Attribute attribute) const{
+		if(offsets[attribute] == -1){
+			return 1;
+		}
+		float value = readPlyValue(record + offsets[attribute], types[attribute], swapBytes);
+		switch(types[attribute]){
+		case OF_PLY_CHAR:
+		case OF_PLY_UCHAR:
+			return value / 255.f;
+		case OF_PLY_SHORT:
+		case OF_PLY_USHORT:
+			return value / 65535.f;
+		case OF_PLY_INT:
+		case OF_PLY_UINT:
+			return value / 4294967295.f;
+		default:
+			return value;
+		}
+	}
+
+	void readPosition(const char * record, ofVec3f & position) const{
+		if(floatPositions){
+			memcpy(&position, record + offsets[X], sizeof(ofVec3f));
+		}else{
+			position.set(read(record, X), read(record, Y), read(record, Z));
+		}
+	}
+
+	void readAttributes(const char * record, ofFloatColor * color, ofVec3f * normal, ofVec2f * texCoord) const{
+		if(color){
+			color->set(readColor(record, Red), readColor(record, Green), readColor(record, Blue), readColor(record, Alpha));
+		}
+		if(normal){
+			normal->set(read(record, NX), read(record, NY), read(record, NZ));
+		}
+		if(texCoord){
+			texCoord->set(read(record, U), read(record, V));
+		}
+	}
+
+	int offsets[NumAttributes];
+	ofPlyType types[NumAttributes];
+	size_t recordSize;
+	bool swapBytes;
+	bool hasLists;
+	bool floatPositions;
+};
+
+//--------------------------------------------------------------
+// decodes a range of vertex records straight into the mesh arrays
+class ofPlyReadVerticesJob: public ofMeshJob{
+public:
+	ofPlyReadVerticesJob(const ofPlyVertexFormat & format, const char * records, size_t recordStep, ofMesh & mesh, size_t first)
+	:format(format)
+	,records(records)
+	,recordStep(recordStep)
+	,mesh(mesh)
+	,first(first){}
+
+	void run(size_t begin, size_t end){
+		ofVec3f * vertices = &mesh.getVertices()[first];
+		ofFloatColor * colors = mesh.hasColors() ? &mesh.getColors()[first] : NULL;
+		ofVec3f * normals = mesh.hasNormals() ? &mesh.getNormals()[first] : NULL;
+		ofVec2f * texCoords = mesh.hasTexCoords() ? &mesh.getTexCoords()[first] : NULL;
+		for(size_t i = begin; i < end; i++){
+			const char * record = records + i * recordStep;
+			format.readPosition(record, vertices[i]);
+			format.readAttributes(record, colors ? colors + i : NULL, normals ? normals + i : NULL, texCoords ? texCoords + i : NULL);
+		}
+	}
+
+	const ofPlyVertexFormat & format;
+	const char * records;
+	size_t recordStep;
+	ofMesh & mesh;
+	size_t first;
+};
+
+//--------------------------------------------------------------
+static void notifyPlyProgress(ofMeshLoadSettings & settings, const string & path, uint64_t bytesLoaded, uint64_t totalBytes){
+	ofMeshLoadEventArgs args;
+	args.path = path;
+	args.bytesLoaded = bytesLoaded;
+	args.totalBytes = totalBytes;
+	ofNotifyEvent(settings.progressEvent, args);
+}
+
+//--------------------------------------------------------------
+static bool isInsideLoadBox(const ofMeshLoadSettings & settings, const ofVec3f & v){
+	return v.x >= settings.boundingBoxMin.x && v.y >= settings.boundingBoxMin.y && v.z >= settings.boundingBoxMin.z
+		&& v.x <= settings.boundingBoxMax.x && v.y <= settings.boundingBoxMax.y && v.z <= settings.boundingBoxMax.z;
+}
+
+//--------------------------------------------------------------
+// keeps only the triangles whose 3 vertices were loaded, with their new
+// index. newIndices has the new index of each vertex in the file or -1
+static void remapPlyIndices(vector<ofIndexType> & indices, const vector<int> & newIndices){
+	size_t numIndices = 0;
+	for(size_t i = 0; i + 2 < indices.size(); i += 3){
+		int a = newIndices[indices[i]];
+		int b = newIndices[indices[i + 1]];
+		int c = newIndices[indices[i + 2]];
+		if(a != -1 && b != -1 && c != -1){
+			indices[numIndices++] = a;
+			indices[numIndices++] = b;
+			indices[numIndices++] = c;
+		}
+	}
+	indices.resize(numIndices);
+}
+
+//--------------------------------------------------------------
+// applies the stride and bounding box of the settings to a mesh that was
+// loaded whole
+static void decimateMesh(ofMesh & mesh, const ofMeshLoadSettings & settings){
+	size_t stride = MAX(settings.stride, 1);
+	vector<ofVec3f> & vertices = mesh.getVertices();
+	vector<ofFloatColor> & colors = mesh.getColors();
+	vector<ofVec3f> & normals = mesh.getNormals();
+	vector<ofVec2f> & texCoords = mesh.getTexCoords();
+	vector<int> newIndices(vertices.size(), -1);
+	size_t numVertices = 0;
+	for(size_t i = 0; i < vertices.size(); i += stride){
+		if(settings.useBoundingBox && !isInsideLoadBox(settings, vertices[i])){
+			continue;
+		}
+		newIndices[i] = numVertices;
+		vertices[numVertices] = vertices[i];
+		if(colors.size() > i) colors[numVertices] = colors[i];
+		if(normals.size() > i) normals[numVertices] = normals[i];
+		if(texCoords.size() > i) texCoords[numVertices] = texCoords[i];
+		numVertices++;
+	}
+	vertices.resize(numVertices);
+	if(!colors.empty()) colors.resize(numVertices);
+	if(!normals.empty()) normals.resize(numVertices);
+	if(!texCoords.empty()) texCoords.resize(numVertices);
+	remapPlyIndices(mesh.getIndices(), newIndices);
+}
+
+//--------------------------------------------------------------
+// skips the records of an element the mesh doesn't use
+static bool skipPlyElement(const ofPlyElement & element, const char *& src, const char * end, bool swapBytes){
+	size_t recordSize = 0;
+	bool hasLists = false;
+	for(size_t i = 0; i < element.properties.size(); i++){
+		if(element.properties[i].countType != OF_PLY_NONE){
+			hasLists = true;
+		}
+		recordSize += plyTypeSize(element.properties[i].type);
+	}
+	if(!hasLists){
+		if(uint64_t(end - src) < element.count * recordSize){
+			return false;
+		}
+		src += element.count * recordSize;
+		return true;
+	}
+	for(uint64_t i = 0; i < element.count; i++){
+		for(size_t j = 0; j < element.properties.size(); j++){
+			const ofPlyProperty & property = element.properties[j];
+			size_t count = 1;
+			if(property.countType != OF_PLY_NONE){
+				size_t countSize = plyTypeSize(property.countType);
+				if(size_t(end - src) < countSize){
+					return false;
+				}
+				count = readPlyValue(src, property.countType, swapBytes);
+				src += countSize;
+			}
+			if(size_t(end - src) < count * plyTypeSize(property.type)){
+				return false;
+			}
+			src += count * plyTypeSize(property.type);
+		}
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+// smallest size of a record of an element, lists count as empty
+static size_t plyMinRecordSize(const ofPlyElement & element){
+	size_t size = 0;
+	for(size_t i = 0; i < element.properties.size(); i++){
+		const ofPlyProperty & property = element.properties[i];
+		size += plyTypeSize(property.countType != OF_PLY_NONE ? property.countType : property.type);
+	}
+	return size;
+}
+
+//--------------------------------------------------------------
+// loads a binary PLY from the mapped file into mesh, which has to be empty
+static bool loadPlyBinary(ofMesh & mesh, const ofBuffer & file, const ofPlyHeader & header, ofMeshLoadSettings & settings, const string & path, string & error){
+	// vertices are decoded in chunks to report the progress between them
+	static const size_t chunkSize = 1 << 20;
+
+	bool swapBytes = (header.format == ofPlyHeader::BinaryLittleEndian) != isLittleEndian();
+	size_t stride = MAX(settings.stride, 1);
+	bool decimate = stride > 1 || settings.useBoundingBox;
+	const char * src = file.getData() + header.size;
+	const char * end = file.getData() + file.size();
+
+	// the counts in the header are checked against the size of the file
+	// before anything is allocated with them
+	uint64_t numFileVertices = 0;
+	for(size_t i = 0; i < header.elements.size(); i++){
+		const ofPlyElement & element = header.elements[i];
+		size_t minRecordSize = plyMinRecordSize(element);
+		if(minRecordSize > 0 && element.count > uint64_t(end - src) / minRecordSize){
+			error = "file is shorter than the " + ofToString(element.count) + " " + element.name + " elements specified in the header";
+			return false;
+		}
+		if(element.name == "vertex"){
+			numFileVertices = element.count;
+		}
+	}
+	vector<int> newIndices;
+	if(decimate){
+		newIndices.resize(numFileVertices, -1);
+	}
+
+	for(size_t e = 0; e < header.elements.size(); e++){
+		const ofPlyElement & element = header.elements[e];
+
+		if(element.name == "vertex"){
+			ofPlyVertexFormat format(element, swapBytes);
+			if(format.hasLists){
+				error = "list properties in vertices are not supported";
+				return false;
+			}
+			if(!format.has(ofPlyVertexFormat::X) || !format.has(ofPlyVertexFormat::Y)){
+				error = "vertices without x and y coordinates";
+				return false;
+			}
+			if(uint64_t(end - src) < element.count * format.recordSize){
+				error = "file is shorter than the " + ofToString(element.count) + " vertices specified in the header";
+				return false;
+			}
+
+			if(!settings.useBoundingBox){
+				size_t numVertices = (element.count + stride - 1) / stride;
+				mesh.getVertices().resize(numVertices);
+				if(format.hasColors()) mesh.getColors().resize(numVertices);
+				if(format.hasNormals()) mesh.getNormals().resize(numVertices);
+				if(format.hasTexCoords()) mesh.getTexCoords().resize(numVertices);
+				for(size_t first = 0; first < numVertices; first += chunkSize){
+					size_t count = MIN(chunkSize, numVertices - first);
+					const char * records = src + first * stride * format.recordSize;
+					ofPlyReadVerticesJob job(format, records, stride * format.recordSize, mesh, first);
+					runMeshJob(job, count);
+					notifyPlyProgress(settings, path, records + count * stride * format.recordSize - file.getData(), file.size());
+				}
+				if(decimate){
+					for(size_t i = 0; i < numVertices; i++){
+						newIndices[i * stride] = i;
+					}
+				}
+			}else{
+				ofVec3f position;
+				ofFloatColor color;
+				ofVec3f normal;
+				ofVec2f texCoord;
+				for(size_t i = 0; i < element.count; i += stride){
+					const char * record = src + i * format.recordSize;
+					format.readPosition(record, position);
+					if(isInsideLoadBox(settings, position)){
+						newIndices[i] = mesh.getNumVertices();
+						format.readAttributes(record, &color, &normal, &texCoord);
+						mesh.getVertices().push_back(position);
+						if(format.hasColors()) mesh.getColors().push_back(color);
+						if(format.hasNormals()) mesh.getNormals().push_back(normal);
+						if(format.hasTexCoords()) mesh.getTexCoords().push_back(texCoord);
+					}
+					if(i % chunkSize < stride){
+						notifyPlyProgress(settings, path, record - file.getData(), file.size());
+					}
+				}
+			}
+			src += element.count * format.recordSize;
+
+		}else if(element.name == "face"){
+			int indicesProperty = -1;
+			for(size_t i = 0; i < element.properties.size(); i++){
+				const ofPlyProperty & property = element.properties[i];
+				if(property.countType != OF_PLY_NONE && (property.name == "vertex_indices" || property.name == "vertex_index")){
+					indicesProperty = i;
+				}
+			}
+			if(indicesProperty == -1){
+				if(!skipPlyElement(element, src, end, swapBytes)){
+					error = "file is shorter than the faces specified in the header";
+					return false;
+				}
+				continue;
+			}
+
+			vector<ofIndexType> & indices = mesh.getIndices();
+			const ofPlyProperty & list = element.properties[indicesProperty];
+			size_t indexSize = plyTypeSize(list.type);
+			// room for as many triangles as fit in the rest of the file
+			uint64_t maxTriangles = uint64_t(end - src) / (plyMinRecordSize(element) + 3 * indexSize);
+			indices.reserve(MIN(element.count, maxTriangles) * 3);
+			bool fastPath = element.properties.size() == 1 && !swapBytes && list.countType == OF_PLY_UCHAR
+					&& (list.type == OF_PLY_INT || list.type == OF_PLY_UINT);
+			for(uint64_t f = 0; f < element.count; f++){
+				if(f % chunkSize == 0){
+					notifyPlyProgress(settings, path, src - file.getData(), file.size());
+				}
+				if(fastPath && end - src >= 13 && *src == 3){
+					unsigned int face[3];
+					memcpy(face, src + 1, sizeof(face));
+					if(face[0] >= numFileVertices || face[1] >= numFileVertices || face[2] >= numFileVertices){
+						error = "face " + ofToString(f) + " has an index out of range";
+						return false;
+					}
+					indices.push_back(face[0]);
+					indices.push_back(face[1]);
+					indices.push_back(face[2]);
+					src += 13;
+					continue;
+				}
+				for(size_t p = 0; p < element.properties.size(); p++){
+					const ofPlyProperty & property = element.properties[p];
+					size_t count = 1;
+					if(property.countType != OF_PLY_NONE){
+						if(size_t(end - src) < plyTypeSize(property.countType)){
+							error = "file is shorter than the faces specified in the header";
+							return false;
+						}
+						count = readPlyValue(src, property.countType, swapBytes);
+						src += plyTypeSize(property.countType);
+					}
+					size_t size = count * plyTypeSize(property.type);
+					if(size_t(end - src) < size){
+						error = "file is shorter than the faces specified in the header";
+						return false;
+					}
+					if(int(p) == indicesProperty){
+						for(size_t i = 0; i < count; i++){
+							uint64_t index = readPlyValue(src + i * indexSize, list.type, swapBytes);
+							if(index >= numFileVertices){
+								error = "face " + ofToString(f) + " has an index out of range";
+								return false;
+							}
+						}
+						// polygons are split in a fan of triangles
+						ofIndexType first = readPlyValue(src, list.type, swapBytes);
+						for(size_t i = 2; i < count; i++){
+							indices.push_back(first);
+							indices.push_back(readPlyValue(src + (i - 1) * indexSize, list.type, swapBytes));
+							indices.push_back(readPlyValue(src + i * indexSize, list.type, swapBytes));
+						}
+					}
+					src += size;
+				}
+			}
+
+		}else{
+			if(!skipPlyElement(element, src, end, swapBytes)){
+				error = "file is shorter than the " + element.name + " elements specified in the header";
+				return false;
+			}
+		}
+	}
+
+	if(decimate){
+		remapPlyIndices(mesh.getIndices(), newIndices);
+	}
+	notifyPlyProgress(settings, path, file.size(), file.size());
+	return true;
+}
+
+//--------------------------------------------------------------
+// writes the vertex records of a binary PLY, see ofMesh::save
+class ofPlyWriteVerticesJob: public ofMeshJob{
+public:
+	ofPlyWriteVerticesJob(const ofMesh & mesh, char * dst, size_t recordSize)
+	:mesh(mesh)
+	,dst(dst)
+	,recordSize(recordSize){}
+
+	void run(size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			char * record = dst + i * recordSize;
+			memcpy(record, &mesh.getVertices()[i], sizeof(ofVec3f));
+			record += sizeof(ofVec3f);
+			if(mesh.getNumColors()){
+				// VCG lib / MeshLab don't support float colors, so we have to cast
+				ofColor color = mesh.getColors()[i];
+				memcpy(record, &color, sizeof(ofColor));
+				record += sizeof(ofColor);
+			}
+			if(mesh.getNumTexCoords()){
+				memcpy(record, &mesh.getTexCoords()[i], sizeof(ofVec2f));
+				record += sizeof(ofVec2f);
+			}
+			if(mesh.getNumNormals()){
+				memcpy(record, &mesh.getNormals()[i], sizeof(ofVec3f));
+			}
+		}
+	}
 
+	const ofMesh & mesh;
+	char * dst;
+	size_t recordSize;
+};
+
+//--------------------------------------------------------------
+// writes the face records of a binary PLY, triangles of the indices or of
+// consecutive vertices if the mesh has no indices
+class ofPlyWriteFacesJob: public ofMeshJob{
+public:
+	ofPlyWriteFacesJob(const ofMesh & mesh, char * dst)
+	:mesh(mesh)
+	,dst(dst){}
+
+	void run(size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			char * record = dst + i * recordSize;
+			int face[3];
+			for(int j = 0; j < 3; j++){
+				face[j] = mesh.getNumIndices() ? mesh.getIndices()[i * 3 + j] : i * 3 + j;
+			}
+			record[0] = 3;
+			memcpy(record + 1, face, sizeof(face));
+		}
+	}
+
+	static const size_t recordSize = 1 + 3 * sizeof(int);
+	const ofMesh & mesh;
+	char * dst;
+};
+
+//--------------------------------------------------------------
+static bool savePlyBinary(const ofMesh & mesh, const string & path){
+	size_t numFaces = 0;
+	if(mesh.getNumIndices()){
+		numFaces = mesh.getNumIndices() / 3;
+	}else if(mesh.getMode() == OF_PRIMITIVE_TRIANGLES){
+		numFaces = mesh.getNumVertices() / 3;
+	}
+
+	stringstream header;
+	header << "ply\n";
+	header << (isLittleEndian() ? "format binary_little_endian 1.0\n" : "format binary_big_endian 1.0\n");
+	size_t vertexSize = sizeof(ofVec3f);
+	if(mesh.getNumVertices()){
+		header << "element vertex " << mesh.getNumVertices() << "\n";
+		header << "property float x\nproperty float y\nproperty float z\n";
+		if(mesh.getNumColors()){
+			header << "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n";
+			vertexSize += sizeof(ofColor);
+		}
+		if(mesh.getNumTexCoords()){
+			header << "property float u\nproperty float v\n";
+			vertexSize += sizeof(ofVec2f);
+		}
+		if(mesh.getNumNormals()){
+			header << "property float nx\nproperty float ny\nproperty float nz\n";
+			vertexSize += sizeof(ofVec3f);
+		}
+	}
+	if(mesh.getNumIndices() || mesh.getMode() == OF_PRIMITIVE_TRIANGLES){
+		header << "element face " << numFaces << "\n";
+		header << "property list uchar int vertex_indices\n";
+	}
+	header << "end_header\n";
+	string headerStr = header.str();
+
+	size_t verticesSize = mesh.getNumVertices() * vertexSize;
+	ofMappedFile file;
+	if(!file.create(path, headerStr.size() + verticesSize + numFaces * ofPlyWriteFacesJob::recordSize)){
+		return false;
+	}
+	char * data = file.getData();
+	memcpy(data, headerStr.c_str(), headerStr.size());
+	ofPlyWriteVerticesJob verticesJob(mesh, data + headerStr.size(), vertexSize);
+	runMeshJob(verticesJob, mesh.getNumVertices());
+	ofPlyWriteFacesJob facesJob(mesh, data + headerStr.size() + verticesSize);
+	runMeshJob(facesJob, numFaces);
+	return true;
+}
+
+//--------------------------------------------------------------
+// the original line based loader for ASCII PLY files
+static bool loadPlyAscii(ofMesh & data, ofBuffer & buffer, const string & path){
 	string error;
-	ofBuffer buffer(is);
 	ofMesh backup = data;
 
 	int orderVertices=-1;
@@ -984,23 +1830,81 @@ void ofMesh::load(string path){
 	}
 
 
-	return;
+	return true;
 	clean:
 	ofLogError("ofMesh") << "load(): " << lineNum << ":" << error;
 	ofLogError("ofMesh") << "load(): \"" << *line << "\"";
 	data = backup;
+	return false;
 }
 
+//--------------------------------------------------------------
+void ofMesh::load(string path){
+	ofMeshLoadSettings settings;
+	load(path, settings);
+}
+
+//--------------------------------------------------------------
+void ofMesh::load(string path, ofMeshLoadSettings & settings){
+	ofBuffer file;
+	if(!file.mapFile(path)){
+		ofLogError("ofMesh") << "load(): couldn't open \"" << path << "\"";
+		return;
+	}
+
+	ofPlyHeader header;
+	string error;
+	if(!parsePlyHeader(file.getData(), file.size(), header, error)){
+		ofLogError("ofMesh") << "load(): \"" << path << "\": " << error;
+		return;
+	}
+
+	if(header.format == ofPlyHeader::Ascii){
+		uint64_t size = file.size();
+		if(loadPlyAscii(*this, file, path)){
+			if(settings.stride > 1 || settings.useBoundingBox){
+				decimateMesh(*this, settings);
+			}
+			notifyPlyProgress(settings, path, size, size);
+		}
+		return;
+	}
+
+	// load into a different mesh so this one is untouched if there's an error
+	ofMesh loaded;
+	if(!loadPlyBinary(loaded, file, header, settings, path, error)){
+		ofLogError("ofMesh") << "load(): \"" << path << "\": " << error;
+		return;
+	}
+	clear();
+	vertices.swap(loaded.vertices);
+	colors.swap(loaded.colors);
+	normals.swap(loaded.normals);
+	texCoords.swap(loaded.texCoords);
+	indices.swap(loaded.indices);
+	bVertsChanged = true;
+	bColorsChanged = true;
+	bNormalsChanged = true;
+	bTexCoordsChanged = true;
+	bIndicesChanged = true;
+	bFacesDirty = true;
+}
+
+//--------------------------------------------------------------
+
 void ofMesh::save(string path, bool useBinary) const{
+	if(useBinary){
+		if(!savePlyBinary(*this, ofToDataPath(path))){
+			ofLogError("ofMesh") << "save(): couldn't write \"" << path << "\"";
+		}
+		return;
+	}
+
 	ofFile os(path, ofFile::WriteOnly);
 	const ofMesh& data = *this;
 
 	os << "ply" << endl;
-	if(useBinary) {
-		os << "format binary_little_endian 1.0" << endl;
-	} else {
-		os << "format ascii 1.0" << endl;
-	}
+	os << "format ascii 1.0" << endl;
 
 	if(data.getNumVertices()){
 		os << "element vertex " << data.getNumVertices() << endl;
@@ -1036,62 +1940,28 @@ void ofMesh::save(string path, bool useBinary) const{
 	os << "end_header" << endl;
 
 	for(int i = 0; i < data.getNumVertices(); i++){
-		if(useBinary) {
-			os.write((char*) &data.getVertices()[i], sizeof(ofVec3f));
-		} else {
-			os << data.getVertex(i).x << " " << data.getVertex(i).y << " " << data.getVertex(i).z;
-		}
+		os << data.getVertex(i).x << " " << data.getVertex(i).y << " " << data.getVertex(i).z;
 		if(data.getNumColors()){
 			// VCG lib / MeshLab don't support float colors, so we have to cast
 			ofColor cur = data.getColors()[i];
-			if(useBinary) {
-				os.write((char*) &cur, sizeof(ofColor));
-			} else {
-				os << " " << (int) cur.r << " " << (int) cur.g << " " << (int) cur.b << " " << (int) cur.a;
-			}
+			os << " " << (int) cur.r << " " << (int) cur.g << " " << (int) cur.b << " " << (int) cur.a;
 		}
 		if(data.getNumTexCoords()){
-			if(useBinary) {
-				os.write((char*) &data.getTexCoords()[i], sizeof(ofVec2f));
-			} else {
-				os << " " << data.getTexCoord(i).x << " " << data.getTexCoord(i).y;
-			}
+			os << " " << data.getTexCoord(i).x << " " << data.getTexCoord(i).y;
 		}
 		if(data.getNumNormals()){
-			if(useBinary) {
-				os.write((char*) &data.getNormals()[i], sizeof(ofVec3f));
-			} else {
-				os << " " << data.getNormal(i).x << " " << data.getNormal(i).y << " " << data.getNormal(i).z;
-			}
-		}
-		if(!useBinary) {
-			os << endl;
+			os << " " << data.getNormal(i).x << " " << data.getNormal(i).y << " " << data.getNormal(i).z;
 		}
+		os << endl;
 	}
 
 	if(data.getNumIndices()) {
 		for(int i = 0; i < data.getNumIndices(); i += faceSize) {
-			if(useBinary) {
-				os.write((char*) &faceSize, sizeof(unsigned char));
-				for(int j = 0; j < faceSize; j++) {
-					int curIndex = data.getIndex(i + j);
-					os.write((char*) &curIndex, sizeof(int));
-				}
-			} else {
-				os << (int) faceSize << " " << data.getIndex(i) << " " << data.getIndex(i+1) << " " << data.getIndex(i+2) << endl;
-			}
+			os << (int) faceSize << " " << data.getIndex(i) << " " << data.getIndex(i+1) << " " << data.getIndex(i+2) << endl;
 		}
 	} else if(data.getMode() == OF_PRIMITIVE_TRIANGLES) {
-		for(int i = 0; i < data.getNumVertices(); i += faceSize) {
-			int indices[] = {i, i + 1, i + 2};
-			if(useBinary) {
-				os.write((char*) &faceSize, sizeof(unsigned char));
-				for(int j = 0; j < faceSize; j++) {
-					os.write((char*) &indices[j], sizeof(int));
-				}
-			} else {
-				os << (int) faceSize << " " << indices[0] << " " << indices[1] << " " << indices[2] << endl;
-			}
+		for(int i = 0; i + 2 < data.getNumVertices(); i += faceSize) {
+			os << (int) faceSize << " " << i << " " << i + 1 << " " << i + 2 << endl;
 		}
 	}
 
@@ -1176,97 +2046,63 @@ ofMesh ofMesh::getMeshForIndices( int startIndex, int endIndex, int startVertInd
 }
 
 //----------------------------------------------------------
-void ofMesh::mergeDuplicateVertices() {
-    
-    vector<ofVec3f> verts         = getVertices();
-    vector<ofIndexType> indices   = getIndices();
-    
-    //get indexes to share single point - TODO: try j < i
-    for(unsigned int i = 0; i < indices.size(); i++) {
-        for(unsigned int j = 0; j < indices.size(); j++ ) {
-            if(i==j) continue;
-            
-            ofIndexType i1  = indices[i];
-            ofIndexType i2  = indices[j];
-            ofVec3f v1      = verts[ i1 ];
-            ofVec3f v2      = verts[ i2 ];
-            
-            if( v1 == v2 && i1 != i2) {
-                indices[j] = i1;
-                break;
-            }
-        }
-    }
-    
-    //indices array now has list of unique points we need
-    //but we need to delete the old points we're not using and that means the index values will change
-    //so we are going to create a new list of points and new indexes - we will use a map to map old index values to the new ones
-    vector <ofPoint> newPoints;
-    vector <ofIndexType> newIndexes;
-    map <int, bool> ptCreated;
-    map <int, int> oldIndexNewIndex;
-    
-    vector<ofFloatColor> newColors;
-    vector<ofFloatColor>& colors    = getColors();
-    vector<ofVec2f> newTCoords;
-    vector<ofVec2f>& tcoords        = getTexCoords();
-    vector<ofVec3f> newNormals;
-    vector<ofVec3f>& normals        = getNormals();
-    
-    for(unsigned int i = 0; i < indices.size(); i++){
-        ptCreated[i] = false;
-    }
-    
-    for(unsigned int i = 0; i < indices.size(); i++){
-        ofIndexType index = indices[i];
-        ofPoint p = verts[ index ];
-        
-        if( ptCreated[index] == false ){
-            oldIndexNewIndex[index] = newPoints.size();
-            newPoints.push_back( p );
-            if(hasColors()) {
-                newColors.push_back(colors[index]);
-            }
-            if(hasTexCoords()) {
-                newTCoords.push_back(tcoords[index]);
-            }
-            if(hasNormals()) {
-                newNormals.push_back(normals[index]);
-            }
-            
-            ptCreated[index] = true;
-        }
-        
-        //ofLogNotice("ofMesh") << "[" << i << "]: old " << index << " --> " << oldIndexNewIndex[index];
-        newIndexes.push_back( oldIndexNewIndex[index] );
-    }
-    
-    verts.clear();
-    verts = newPoints;
-    
-    indices.clear();
-    indices = newIndexes;
-    
-    clearIndices();
-    addIndices(indices);
-    clearVertices();
-    addVertices( verts );
-    
-    if(hasColors()) {
-        clearColors();
-        addColors( newColors );
-    }
-    
-    if(hasTexCoords()) {
-        clearTexCoords();
-        addTexCoords( newTCoords );
-    }
-    
-    if(hasNormals()) {
-        clearNormals();
-        addNormals( newNormals );
-    }
-    
+void ofMesh::mergeDuplicateVertices(float epsilon) {
+	if(vertices.empty()){
+		return;
+	}
+	if(indices.empty()){
+		setupIndicesAuto();
+	}
+	for(unsigned int i = 0; i < indices.size(); i++){
+		if(indices[i] >= vertices.size()){
+			ofLogError("ofMesh") << "mergeDuplicateVertices(): index " << indices[i] << " out of bounds, mesh has " << vertices.size() << " vertices";
+			return;
+		}
+	}
+
+	// vertices are kept in the order they are first used by the indices,
+	// each one with the attributes of the first vertex of its group
+	ofMeshVertexGrid grid(vertices, epsilon);
+	vector<int> newIndices(vertices.size(), -1);
+	vector<ofVec3f> newVertices;
+	vector<ofFloatColor> newColors;
+	vector<ofVec2f> newTexCoords;
+	vector<ofVec3f> newNormals;
+
+	for(unsigned int i = 0; i < indices.size(); i++){
+		ofIndexType index = indices[i];
+		if(newIndices[index] == -1){
+			int first = grid.findOrAdd(index);
+			if(first == (int)index){
+				newIndices[index] = newVertices.size();
+				newVertices.push_back(vertices[index]);
+				if(index < colors.size()){
+					newColors.push_back(colors[index]);
+				}
+				if(index < texCoords.size()){
+					newTexCoords.push_back(texCoords[index]);
+				}
+				if(index < normals.size()){
+					newNormals.push_back(normals[index]);
+				}
+			}else{
+				newIndices[index] = newIndices[first];
+			}
+		}
+		indices[i] = newIndices[index];
+	}
+
+	vertices.swap(newVertices);
+	colors.swap(newColors);
+	texCoords.swap(newTexCoords);
+	normals.swap(newNormals);
+
+	bVertsChanged = true;
+	bIndicesChanged = true;
+	bColorsChanged = true;
+	bTexCoordsChanged = true;
+	bNormalsChanged = true;
+	bFacesDirty = true;
 }
 
 //----------------------------------------------------------
@@ -1412,104 +2248,137 @@ void ofMesh::setFromTriangles( const vector<ofMeshFace>& tris, bool bUseFaceNorm
 
 //----------------------------------------------------------
 void ofMesh::smoothNormals( float angle ) {
-    
-    if( getMode() == OF_PRIMITIVE_TRIANGLES) {
-        vector<ofMeshFace> triangles = getUniqueFaces();
-        vector<ofVec3f> verts;
-        for(unsigned int i = 0; i < triangles.size(); i++) {
-            for(unsigned int j = 0; j < 3; j++) {
-                verts.push_back( triangles[i].getVertex(j) );
-            }
-        }
-        
-        map<int, int> removeIds;
-        
-        float epsilon = .01f;
-        for(unsigned int i = 0; i < verts.size()-1; i++) {
-            for(unsigned int j = i+1; j < verts.size(); j++) {
-                if(i != j) {
-                    ofVec3f& v1 = verts[i];
-                    ofVec3f& v2 = verts[j];
-                    if( v1.distance(v2) <= epsilon ) {
-                        // average the location //
-                        verts[i] = (v1+v2)/2.f;
-                        verts[j] = verts[i];
-                        removeIds[j] = 1;
-                    }
-                }
-            }
-        }
-        
-        // string of vertex in 3d space to triangle index //
-        map<string, vector<int> > vertHash;
-        
-		//ofLogNotice("ofMesh") << "smoothNormals(): num verts = " << verts.size() << " tris size = " << triangles.size();
-        
-        string xStr, yStr, zStr;
-        
-        for(unsigned int i = 0; i < verts.size(); i++ ) {
-            xStr = "x"+ofToString(verts[i].x==-0?0:verts[i].x);
-            yStr = "y"+ofToString(verts[i].y==-0?0:verts[i].y);
-            zStr = "z"+ofToString(verts[i].z==-0?0:verts[i].z);
-            string vstring = xStr+yStr+zStr;
-            if(vertHash.find(vstring) == vertHash.end()) {
-                for(unsigned int j = 0; j < triangles.size(); j++) {
-                    for(unsigned int k = 0; k < 3; k++) {
-                        if(verts[i].x == triangles[j].getVertex(k).x) {
-                            if(verts[i].y == triangles[j].getVertex(k).y) {
-                                if(verts[i].z == triangles[j].getVertex(k).z) {
-                                    vertHash[vstring].push_back( j );
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
-//        for( map<string, vector<int> >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//            //for( map<string, int >::iterator it = vertHash.begin(); it != vertHash.end(); ++it) {
-//            ofLogNotice("ofMesh") << "smoothNormals(): " << it->first << "  num = " << it->second.size();
-//        }
-        
-        
-        ofVec3f normal;
-        float angleCos = cos(angle * DEG_TO_RAD );
-        float numNormals=0;
-        ofVec3f f1, f2;
-        ofVec3f vert;
-        
-        for(unsigned int j = 0; j < triangles.size(); j++) {
-            for(unsigned int k = 0; k < 3; k++) {
-                vert = triangles[j].getVertex(k);
-                xStr = "x"+ofToString(vert.x==-0?0:vert.x);
-                yStr = "y"+ofToString(vert.y==-0?0:vert.y);
-                zStr = "z"+ofToString(vert.z==-0?0:vert.z);
-                
-                string vstring = xStr+yStr+zStr;
-                numNormals=0;
-                normal.set(0,0,0);
-                if(vertHash.find(vstring) != vertHash.end()) {
-                    for(unsigned int i = 0; i < vertHash[vstring].size(); i++) {
-                        f1 = triangles[j].getFaceNormal();
-                        f2 = triangles[vertHash[vstring][i]].getFaceNormal();
-                        if(f1.dot(f2) >= angleCos ) {
-                            normal += f2;
-                            numNormals+=1.f;
-                        }
-                    }
-                    //normal /= (float)vertHash[vstring].size();
-                    normal /= numNormals;
-                    
-                    triangles[j].setNormal(k, normal);
-                }
-            }
-        }
-        
-        //ofLogNotice("ofMesh") << "smoothNormals(): setting from triangles ";
-        setFromTriangles( triangles );
-        
-    }
+	if(getMode() != OF_PRIMITIVE_TRIANGLES) {
+		return;
+	}
+
+	if(indices.empty()){
+		setupIndicesAuto();
+	}
+	int numTriangles = indices.size() / 3;
+	if(numTriangles == 0){
+		return;
+	}
+	for(unsigned int i = 0; i < indices.size(); i++){
+		if(indices[i] >= vertices.size()){
+			ofLogError("ofMesh") << "smoothNormals(): index " << indices[i] << " out of bounds, mesh has " << vertices.size() << " vertices";
+			return;
+		}
+	}
+
+	// face normal of every triangle
+	struct FaceNormalsJob: public ofMeshJob{
+		FaceNormalsJob(const vector<ofVec3f> & vertices, const vector<ofIndexType> & indices, vector<ofVec3f> & faceNormals)
+		:vertices(vertices), indices(indices), faceNormals(faceNormals){}
+
+		void run(size_t begin, size_t end){
+			for(size_t i = begin; i < end; i++){
+				const ofVec3f & v0 = vertices[indices[i*3]];
+				faceNormals[i] = (vertices[indices[i*3+1]] - v0).getCrossed(vertices[indices[i*3+2]] - v0).getNormalized();
+			}
+		}
+
+		const vector<ofVec3f> & vertices;
+		const vector<ofIndexType> & indices;
+		vector<ofVec3f> & faceNormals;
+	};
+	vector<ofVec3f> faceNormals(numTriangles);
+	FaceNormalsJob faceNormalsJob(vertices, indices, faceNormals);
+	runMeshJob(faceNormalsJob, numTriangles);
+
+	// group the vertices by position and list the triangles that touch
+	// each position contiguously, indexed by the first vertex at it
+	ofMeshVertexGrid grid(vertices, 0);
+	vector<int> positions(vertices.size(), -1);
+	vector<int> trianglesStart(vertices.size() + 1, 0);
+	for(int i = 0; i < numTriangles * 3; i++){
+		int & position = positions[indices[i]];
+		if(position == -1){
+			position = grid.findOrAdd(indices[i]);
+		}
+		trianglesStart[position + 1]++;
+	}
+	for(unsigned int i = 0; i < vertices.size(); i++){
+		trianglesStart[i + 1] += trianglesStart[i];
+	}
+	vector<int> triangles(numTriangles * 3);
+	vector<int> trianglesEnd(trianglesStart.begin(), trianglesStart.end() - 1);
+	for(int i = 0; i < numTriangles * 3; i++){
+		triangles[trianglesEnd[positions[indices[i]]]++] = i / 3;
+	}
+
+	// every corner gets the average of the normals of the triangles that
+	// share its position and face less than angle away from its triangle
+	struct CornerNormalsJob: public ofMeshJob{
+		CornerNormalsJob(const ofMesh & mesh, const vector<int> & positions, const vector<int> & trianglesStart, const vector<int> & triangles,
+				const vector<ofVec3f> & faceNormals, float angleCos, ofMesh & result)
+		:mesh(mesh), positions(positions), trianglesStart(trianglesStart), triangles(triangles)
+		,faceNormals(faceNormals), angleCos(angleCos), result(result){}
+
+		void run(size_t begin, size_t end){
+			const vector<ofIndexType> & indices = mesh.getIndices();
+			bool copyColors = mesh.getNumColors() == mesh.getNumVertices();
+			bool copyTexCoords = mesh.getNumTexCoords() == mesh.getNumVertices();
+			for(size_t i = begin; i < end; i++){
+				const ofVec3f & faceNormal = faceNormals[i];
+				for(size_t k = i*3; k < i*3+3; k++){
+					ofIndexType index = indices[k];
+					int position = positions[index];
+					ofVec3f normal;
+					float numNormals = 0;
+					for(int j = trianglesStart[position]; j < trianglesStart[position + 1]; j++){
+						const ofVec3f & other = faceNormals[triangles[j]];
+						if(faceNormal.dot(other) >= angleCos){
+							normal += other;
+							numNormals += 1.f;
+						}
+					}
+					normal /= numNormals;
+
+					result.getVertices()[k] = mesh.getVertices()[index];
+					result.getNormals()[k] = normal;
+					if(copyColors){
+						result.getColors()[k] = mesh.getColors()[index];
+					}
+					if(copyTexCoords){
+						result.getTexCoords()[k] = mesh.getTexCoords()[index];
+					}
+				}
+			}
+		}
+
+		const ofMesh & mesh;
+		const vector<int> & positions;
+		const vector<int> & trianglesStart;
+		const vector<int> & triangles;
+		const vector<ofVec3f> & faceNormals;
+		float angleCos;
+		ofMesh & result;
+	};
+
+	// like setFromTriangles the result has 3 vertices per triangle
+	ofMesh result;
+	result.setMode(OF_PRIMITIVE_TRIANGLES);
+	result.getVertices().resize(numTriangles * 3);
+	result.getNormals().resize(numTriangles * 3);
+	if(getNumColors() == getNumVertices()){
+		result.getColors().resize(numTriangles * 3);
+	}
+	if(getNumTexCoords() == getNumVertices()){
+		result.getTexCoords().resize(numTriangles * 3);
+	}
+	CornerNormalsJob cornerNormalsJob(*this, positions, trianglesStart, triangles, faceNormals, cos(angle * DEG_TO_RAD), result);
+	runMeshJob(cornerNormalsJob, numTriangles);
+
+	vertices.swap(result.getVertices());
+	normals.swap(result.getNormals());
+	colors.swap(result.getColors());
+	texCoords.swap(result.getTexCoords());
+	setupIndicesAuto();
+	bVertsChanged = true;
+	bNormalsChanged = true;
+	bColorsChanged = true;
+	bTexCoordsChanged = true;
 }
 
 // PLANE MESH //
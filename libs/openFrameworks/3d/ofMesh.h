@@ -10,9 +10,47 @@
 #include "ofUtils.h"
 #include "ofConstants.h"
 #include "ofGLUtils.h"
+#include "ofEventUtils.h"
 
 class ofMeshFace; 
 
+/// \brief Arguments of ofMeshLoadSettings::progressEvent
+class ofMeshLoadEventArgs{
+public:
+	/// \brief Path of the file being loaded
+	string path;
+	/// \brief Number of bytes of the file read so far
+	uint64_t bytesLoaded;
+	/// \brief Size of the file in bytes
+	uint64_t totalBytes;
+};
+
+/// \brief Options for ofMesh::load() to load only part of a file and to get
+/// notified of its progress.
+///
+/// ~~~~{.cpp}
+/// ofMeshLoadSettings settings;
+/// settings.stride = 10;
+/// ofAddListener(settings.progressEvent, this, &ofApp::onMeshProgress);
+/// mesh.load("scan.ply", settings);
+/// ~~~~
+class ofMeshLoadSettings{
+public:
+	ofMeshLoadSettings();
+
+	/// \brief Load only one of every stride vertices, 1 by default loads
+	/// all of them
+	int stride;
+
+	/// \brief Load only the vertices inside boundingBoxMin, boundingBoxMax
+	bool useBoundingBox;
+	ofVec3f boundingBoxMin;
+	ofVec3f boundingBoxMax;
+
+	/// \brief Notified from the thread calling load() as the file is read
+	ofEvent<ofMeshLoadEventArgs> progressEvent;
+};
+
 /// \brief Represents a set of vertices in 3D spaces with normals, colors, 
 /// and texture coordinates at those points. 
 ///
@@ -238,7 +276,17 @@ public:
 	/// of the current mesh's lists.
     void append(const ofMesh & mesh);
 
-    void mergeDuplicateVertices();
+    /// \brief Welds vertices that are at the same position.
+    ///
+    /// Vertices closer than epsilon are replaced by the first of them used
+    /// by the indices, with its color, normal and texture coordinates, and
+    /// the indices are updated to point to it. Vertices that aren't used by
+    /// any index are removed. Uses a spatial hash so it's fast even for
+    /// meshes with millions of vertices.
+    ///
+    /// \param epsilon Maximum distance between vertices to merge them, by
+    /// default only vertices at exactly the same position are merged.
+    void mergeDuplicateVertices(float epsilon=0);
 
     /// \returns a ofVec3f defining the centroid of all the vetices in the mesh.
 	ofVec3f getCentroid() const;
@@ -319,6 +367,13 @@ public:
     virtual void disableNormals();
     virtual bool usingNormals() const;
     
+    /// \brief Sets the normal of every corner of every triangle to the
+    /// average of the normals of the triangles that share its position and
+    /// face less than angle degrees away.
+    ///
+    /// Only works with OF_PRIMITIVE_TRIANGLES. The mesh is converted to 3
+    /// vertices per triangle so each corner can have its own normal. Large
+    /// meshes are processed in parallel on all the cores.
     void smoothNormals( float angle );
 
     /// \}
@@ -604,16 +659,23 @@ public:
     /// This will replace any existing data within the mesh.
     /// 
     /// It expects that the file will be in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
-    /// It will only load meshes saved in the PLY ASCII format; the binary format is not supported.
+    /// Binary PLY files are memory mapped and their vertices and faces copied
+    /// straight into the mesh, so even very large point clouds load quickly.
+    /// Faces with more than 3 vertices are split into triangles.
 	void load(string path);
 
+	/// \brief Loads a mesh from a PLY file keeping only the vertices selected
+	/// by settings, and the faces whose vertices are all kept.
+	void load(string path, ofMeshLoadSettings & settings);
+
     ///  \brief Saves the mesh at the passed path in the [PLY Format](http://en.wikipedia.org/wiki/PLY_(file_format)).
     ///  
     ///  There are two format options for PLY: a binary format and an ASCII format.
     ///  By default, it will save using the ASCII format.
     ///  Passing ``true`` into the ``useBinary`` parameter will save it in the binary format.
     ///  
-    ///  If you're planning on reloading the mesh into ofMesh, ofMesh currently only supports loading the ASCII format.
+    ///  The binary format is much faster to save and load and is written
+    ///  straight to a memory mapped file.
     ///  
     ///  For more information, see the [PLY format specification](http://paulbourke.net/dataformats/ply/).
 	void save(string path, bool useBinary = false) const;
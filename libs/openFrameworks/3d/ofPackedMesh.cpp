@@ -0,0 +1,372 @@
+#include "ofPackedMesh.h"
+
+//--------------------------------------------------------------
+ofPackedMesh::ofPackedMesh(){
+	numVertices = 0;
+	layout = OF_MESH_LAYOUT_INTERLEAVED;
+	mode = OF_PRIMITIVE_TRIANGLES;
+	for(int i = 0; i < NUM_ATTRIBUTES; i++){
+		enabled[i] = false;
+		offsets[i] = 0;
+		strides[i] = 0;
+		changedBegin[i] = 0;
+		changedEnd[i] = 0;
+	}
+	bLayoutChanged = false;
+	bIndicesChanged = false;
+}
+
+//--------------------------------------------------------------
+ofPackedMesh::ofPackedMesh(int numVertices, bool useColors, bool useNormals, bool useTexCoords, ofMeshLayout layout){
+	mode = OF_PRIMITIVE_TRIANGLES;
+	bIndicesChanged = false;
+	allocate(numVertices, useColors, useNormals, useTexCoords, layout);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::allocate(int _numVertices, bool useColors, bool useNormals, bool useTexCoords, ofMeshLayout _layout){
+	numVertices = MAX(_numVertices, 0);
+	layout = _layout;
+	enabled[OF_MESH_POSITION] = true;
+	enabled[OF_MESH_COLOR] = useColors;
+	enabled[OF_MESH_NORMAL] = useNormals;
+	enabled[OF_MESH_TEXCOORD] = useTexCoords;
+
+	int vertexSize = 0;
+	for(int i = 0; i < NUM_ATTRIBUTES; i++){
+		if(enabled[i]){
+			vertexSize += getNumCoords((ofMeshAttribute)i);
+		}
+	}
+
+	int offset = 0;
+	for(int i = 0; i < NUM_ATTRIBUTES; i++){
+		int numCoords = enabled[i] ? getNumCoords((ofMeshAttribute)i) : 0;
+		offsets[i] = offset;
+		if(layout == OF_MESH_LAYOUT_INTERLEAVED){
+			strides[i] = vertexSize;
+			offset += numCoords;
+		}else{
+			strides[i] = numCoords;
+			offset += numCoords * numVertices;
+		}
+	}
+
+	data.assign(size_t(vertexSize) * numVertices, 0.f);
+	if(useColors){
+		ofFloatColor white(1,1,1,1);
+		for(int i = 0; i < numVertices; i++){
+			setColor(i, white);
+		}
+	}
+
+	for(int i = 0; i < NUM_ATTRIBUTES; i++){
+		changedBegin[i] = 0;
+		changedEnd[i] = enabled[i] ? numVertices : 0;
+	}
+	bLayoutChanged = true;
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setFromMesh(const ofMesh & mesh, ofMeshLayout layout){
+	allocate(mesh.getNumVertices(), mesh.hasColors(), mesh.hasNormals(), mesh.hasTexCoords(), layout);
+	setVertices(0, mesh.getVerticesPointer(), mesh.getNumVertices());
+	if(mesh.hasColors()){
+		setColors(0, mesh.getColorsPointer(), MIN(mesh.getNumColors(), numVertices));
+	}
+	if(mesh.hasNormals()){
+		setNormals(0, mesh.getNormalsPointer(), MIN(mesh.getNumNormals(), numVertices));
+	}
+	if(mesh.hasTexCoords()){
+		setTexCoords(0, mesh.getTexCoordsPointer(), MIN(mesh.getNumTexCoords(), numVertices));
+	}
+	setIndices(mesh.getIndices());
+	setMode(mesh.getMode());
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::clear(){
+	allocate(0, false, false, false, layout);
+	clearIndices();
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setMode(ofPrimitiveMode _mode){
+	mode = _mode;
+}
+
+//--------------------------------------------------------------
+ofPrimitiveMode ofPackedMesh::getMode() const{
+	return mode;
+}
+
+//--------------------------------------------------------------
+int ofPackedMesh::getNumVertices() const{
+	return numVertices;
+}
+
+//--------------------------------------------------------------
+ofMeshLayout ofPackedMesh::getLayout() const{
+	return layout;
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::hasAttribute(ofMeshAttribute attribute) const{
+	return enabled[attribute];
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::hasColors() const{
+	return enabled[OF_MESH_COLOR];
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::hasNormals() const{
+	return enabled[OF_MESH_NORMAL];
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::hasTexCoords() const{
+	return enabled[OF_MESH_TEXCOORD];
+}
+
+//--------------------------------------------------------------
+float * ofPackedMesh::getAttribute(ofMeshAttribute attribute, int index){
+	return &data[offsets[attribute] + size_t(index) * strides[attribute]];
+}
+
+//--------------------------------------------------------------
+const float * ofPackedMesh::getAttribute(ofMeshAttribute attribute, int index) const{
+	return &data[offsets[attribute] + size_t(index) * strides[attribute]];
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setAttribute(ofMeshAttribute attribute, int first, const float * values, int stride, int count){
+	if(!enabled[attribute]){
+		ofLogError("ofPackedMesh") << "setting attribute " << attribute << " that wasn't allocated";
+		return;
+	}
+	if(count == 0){
+		return;
+	}
+	if(first < 0 || count < 0 || first + count > numVertices){
+		ofLogError("ofPackedMesh") << "range " << first << " - " << first + count << " out of bounds, mesh has " << numVertices << " vertices";
+		return;
+	}
+	int numCoords = getNumCoords(attribute);
+	float * dst = getAttribute(attribute, first);
+	if(layout == OF_MESH_LAYOUT_PLANAR && stride == numCoords){
+		memcpy(dst, values, sizeof(float) * numCoords * count);
+	}else{
+		for(int i = 0; i < count; i++){
+			memcpy(dst, values, sizeof(float) * numCoords);
+			dst += strides[attribute];
+			values += stride;
+		}
+	}
+	markChanged(attribute, first, count);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setVertex(int index, const ofVec3f & vertex){
+	setAttribute(OF_MESH_POSITION, index, vertex.getPtr(), 3, 1);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setColor(int index, const ofFloatColor & color){
+	setAttribute(OF_MESH_COLOR, index, &color.r, 4, 1);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setNormal(int index, const ofVec3f & normal){
+	setAttribute(OF_MESH_NORMAL, index, normal.getPtr(), 3, 1);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setTexCoord(int index, const ofVec2f & texCoord){
+	setAttribute(OF_MESH_TEXCOORD, index, texCoord.getPtr(), 2, 1);
+}
+
+//--------------------------------------------------------------
+ofVec3f ofPackedMesh::getVertex(int index) const{
+	const float * v = getAttribute(OF_MESH_POSITION, index);
+	return ofVec3f(v[0], v[1], v[2]);
+}
+
+//--------------------------------------------------------------
+ofFloatColor ofPackedMesh::getColor(int index) const{
+	if(!enabled[OF_MESH_COLOR]) return ofFloatColor::white;
+	const float * c = getAttribute(OF_MESH_COLOR, index);
+	return ofFloatColor(c[0], c[1], c[2], c[3]);
+}
+
+//--------------------------------------------------------------
+ofVec3f ofPackedMesh::getNormal(int index) const{
+	if(!enabled[OF_MESH_NORMAL]) return ofVec3f();
+	const float * n = getAttribute(OF_MESH_NORMAL, index);
+	return ofVec3f(n[0], n[1], n[2]);
+}
+
+//--------------------------------------------------------------
+ofVec2f ofPackedMesh::getTexCoord(int index) const{
+	if(!enabled[OF_MESH_TEXCOORD]) return ofVec2f();
+	const float * t = getAttribute(OF_MESH_TEXCOORD, index);
+	return ofVec2f(t[0], t[1]);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setVertices(int first, const ofVec3f * vertices, int count){
+	setAttribute(OF_MESH_POSITION, first, vertices->getPtr(), sizeof(ofVec3f) / sizeof(float), count);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setColors(int first, const ofFloatColor * colors, int count){
+	setAttribute(OF_MESH_COLOR, first, &colors->r, sizeof(ofFloatColor) / sizeof(float), count);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setNormals(int first, const ofVec3f * normals, int count){
+	setAttribute(OF_MESH_NORMAL, first, normals->getPtr(), sizeof(ofVec3f) / sizeof(float), count);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setTexCoords(int first, const ofVec2f * texCoords, int count){
+	setAttribute(OF_MESH_TEXCOORD, first, texCoords->getPtr(), sizeof(ofVec2f) / sizeof(float), count);
+}
+
+//--------------------------------------------------------------
+float * ofPackedMesh::getAttributePointer(ofMeshAttribute attribute){
+	if(!enabled[attribute] || data.empty()) return NULL;
+	return getAttribute(attribute, 0);
+}
+
+//--------------------------------------------------------------
+const float * ofPackedMesh::getAttributePointer(ofMeshAttribute attribute) const{
+	if(!enabled[attribute] || data.empty()) return NULL;
+	return getAttribute(attribute, 0);
+}
+
+//--------------------------------------------------------------
+int ofPackedMesh::getAttributeStride(ofMeshAttribute attribute) const{
+	return strides[attribute] * sizeof(float);
+}
+
+//--------------------------------------------------------------
+int ofPackedMesh::getAttributeOffset(ofMeshAttribute attribute) const{
+	return offsets[attribute] * sizeof(float);
+}
+
+//--------------------------------------------------------------
+int ofPackedMesh::getNumCoords(ofMeshAttribute attribute){
+	switch(attribute){
+	case OF_MESH_POSITION:
+	case OF_MESH_NORMAL:
+		return 3;
+	case OF_MESH_COLOR:
+		return 4;
+	case OF_MESH_TEXCOORD:
+		return 2;
+	}
+	return 0;
+}
+
+//--------------------------------------------------------------
+const float * ofPackedMesh::getData() const{
+	return data.empty() ? NULL : &data[0];
+}
+
+//--------------------------------------------------------------
+size_t ofPackedMesh::getDataSize() const{
+	return data.size() * sizeof(float);
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::markChanged(ofMeshAttribute attribute, int first, int count){
+	if(!enabled[attribute] || count <= 0) return;
+	int end = MIN(first + count, numVertices);
+	first = MAX(first, 0);
+	if(first >= end) return;
+	if(changedBegin[attribute] >= changedEnd[attribute]){
+		changedBegin[attribute] = first;
+		changedEnd[attribute] = end;
+	}else{
+		changedBegin[attribute] = MIN(changedBegin[attribute], first);
+		changedEnd[attribute] = MAX(changedEnd[attribute], end);
+	}
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::getChangedRange(ofMeshAttribute attribute, int & first, int & count) const{
+	if(changedBegin[attribute] >= changedEnd[attribute]){
+		first = 0;
+		count = 0;
+		return false;
+	}
+	first = changedBegin[attribute];
+	count = changedEnd[attribute] - changedBegin[attribute];
+	return true;
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::hasLayoutChanged() const{
+	return bLayoutChanged;
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::haveIndicesChanged() const{
+	return bIndicesChanged;
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::clearChanges(){
+	for(int i = 0; i < NUM_ATTRIBUTES; i++){
+		changedBegin[i] = 0;
+		changedEnd[i] = 0;
+	}
+	bLayoutChanged = false;
+	bIndicesChanged = false;
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::addIndex(ofIndexType index){
+	indices.push_back(index);
+	bIndicesChanged = true;
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::addIndices(const vector<ofIndexType> & inds){
+	indices.insert(indices.end(), inds.begin(), inds.end());
+	bIndicesChanged = true;
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::setIndices(const vector<ofIndexType> & inds){
+	indices = inds;
+	bIndicesChanged = true;
+}
+
+//--------------------------------------------------------------
+void ofPackedMesh::clearIndices(){
+	indices.clear();
+	bIndicesChanged = true;
+}
+
+//--------------------------------------------------------------
+const vector<ofIndexType> & ofPackedMesh::getIndices() const{
+	return indices;
+}
+
+//--------------------------------------------------------------
+const ofIndexType * ofPackedMesh::getIndexPointer() const{
+	return indices.empty() ? NULL : &indices[0];
+}
+
+//--------------------------------------------------------------
+int ofPackedMesh::getNumIndices() const{
+	return indices.size();
+}
+
+//--------------------------------------------------------------
+bool ofPackedMesh::hasIndices() const{
+	return !indices.empty();
+}
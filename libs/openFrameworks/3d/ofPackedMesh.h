@@ -0,0 +1,174 @@
+#pragma once
+
+#include "ofMesh.h"
+
+/// \brief Attributes stored in an ofPackedMesh
+enum ofMeshAttribute{
+	OF_MESH_POSITION = 0,
+	OF_MESH_COLOR,
+	OF_MESH_NORMAL,
+	OF_MESH_TEXCOORD
+};
+
+/// \brief How the attributes of an ofPackedMesh are laid out in memory
+enum ofMeshLayout{
+	/// \brief The attributes of each vertex are stored together:
+	/// xyz rgba xyz uv, xyz rgba xyz uv...
+	OF_MESH_LAYOUT_INTERLEAVED,
+	/// \brief Each attribute is stored contiguously after the previous one
+	/// (structure of arrays): xyz xyz... rgba rgba... xyz xyz... uv uv...
+	OF_MESH_LAYOUT_PLANAR
+};
+
+/// \brief A mesh with a fixed number of vertices whose attributes are
+/// packed in one contiguous block of memory.
+///
+/// Unlike ofMesh, which keeps a vector per attribute, all the positions,
+/// colors, normals and texture coordinates of an ofPackedMesh live in a
+/// single block, either interleaved or one attribute after another. The
+/// mesh also remembers which range of vertices of each attribute has
+/// changed, so an ofVbo can keep all the attributes in one GL buffer and
+/// upload only the modified bytes in one call:
+///
+/// ~~~~{.cpp}
+/// ofPackedMesh particles(1000000, true, false, false);
+/// ofVbo vbo;
+/// vbo.setMesh(particles, GL_DYNAMIC_DRAW);
+///
+/// // update:
+/// for(int i = 0; i < particles.getNumVertices(); i++){
+///     particles.setVertex(i, positions[i]);
+/// }
+/// vbo.updateMesh(particles);
+///
+/// // draw:
+/// vbo.draw(GL_POINTS, 0, particles.getNumVertices());
+/// ~~~~
+///
+/// For the fastest updates write directly to the memory returned by
+/// getAttributePointer() and call markChanged() for the modified range.
+class ofPackedMesh{
+public:
+	ofPackedMesh();
+
+	/// \brief Allocates a mesh with numVertices vertices.
+	/// \sa allocate()
+	ofPackedMesh(int numVertices, bool useColors, bool useNormals, bool useTexCoords, ofMeshLayout layout = OF_MESH_LAYOUT_INTERLEAVED);
+
+	/// \brief Allocates a mesh with numVertices vertices.
+	///
+	/// Positions are always stored, colors, normals and texture coordinates
+	/// only if requested. Positions, normals and texture coordinates start
+	/// as 0 and colors as white. The whole mesh is marked as changed.
+	void allocate(int numVertices, bool useColors, bool useNormals, bool useTexCoords, ofMeshLayout layout = OF_MESH_LAYOUT_INTERLEAVED);
+
+	/// \brief Allocates the mesh with the attributes of an ofMesh and copies
+	/// them, along with its indices and primitive mode.
+	void setFromMesh(const ofMesh & mesh, ofMeshLayout layout = OF_MESH_LAYOUT_INTERLEAVED);
+
+	/// \brief Deallocates all the vertices and indices
+	void clear();
+
+	void setMode(ofPrimitiveMode mode);
+	ofPrimitiveMode getMode() const;
+
+	int getNumVertices() const;
+	ofMeshLayout getLayout() const;
+	bool hasAttribute(ofMeshAttribute attribute) const;
+	bool hasColors() const;
+	bool hasNormals() const;
+	bool hasTexCoords() const;
+
+	void setVertex(int index, const ofVec3f & vertex);
+	void setColor(int index, const ofFloatColor & color);
+	void setNormal(int index, const ofVec3f & normal);
+	void setTexCoord(int index, const ofVec2f & texCoord);
+
+	ofVec3f getVertex(int index) const;
+	ofFloatColor getColor(int index) const;
+	ofVec3f getNormal(int index) const;
+	ofVec2f getTexCoord(int index) const;
+
+	/// \brief Copies count vertices starting at index first
+	void setVertices(int first, const ofVec3f * vertices, int count);
+	void setColors(int first, const ofFloatColor * colors, int count);
+	void setNormals(int first, const ofVec3f * normals, int count);
+	void setTexCoords(int first, const ofVec2f * texCoords, int count);
+
+	/// \brief Pointer to the first coordinate of an attribute of the first
+	/// vertex, the next vertex is getAttributeStride() bytes after it.
+	///
+	/// Writing through this pointer doesn't mark the mesh as changed, call
+	/// markChanged() for the range that was modified.
+	float * getAttributePointer(ofMeshAttribute attribute);
+	const float * getAttributePointer(ofMeshAttribute attribute) const;
+
+	/// \brief Distance in bytes between an attribute of two consecutive
+	/// vertices
+	int getAttributeStride(ofMeshAttribute attribute) const;
+
+	/// \brief Distance in bytes from the start of getData() to an attribute
+	/// of the first vertex
+	int getAttributeOffset(ofMeshAttribute attribute) const;
+
+	/// \brief Number of floats of an attribute: 3 for positions and normals,
+	/// 4 for colors and 2 for texture coordinates
+	static int getNumCoords(ofMeshAttribute attribute);
+
+	/// \brief The block of memory holding all the attributes
+	const float * getData() const;
+
+	/// \brief Size in bytes of getData()
+	size_t getDataSize() const;
+
+	/// \brief Marks count vertices starting at first of an attribute as
+	/// modified, the changed range grows to include them.
+	void markChanged(ofMeshAttribute attribute, int first, int count);
+
+	/// \brief Get the range of vertices of an attribute modified since the
+	/// last call to clearChanges().
+	/// \returns false if the attribute hasn't changed
+	bool getChangedRange(ofMeshAttribute attribute, int & first, int & count) const;
+
+	/// \brief Whether the mesh has been reallocated since the last call to
+	/// clearChanges(), the number of vertices, layout or attributes might
+	/// be different.
+	bool hasLayoutChanged() const;
+
+	/// \brief Whether the indices have changed since the last call to
+	/// clearChanges()
+	bool haveIndicesChanged() const;
+
+	/// \brief Forget all the changes, ofVbo::updateMesh() calls this once
+	/// the changes have been uploaded.
+	void clearChanges();
+
+	void addIndex(ofIndexType index);
+	void addIndices(const vector<ofIndexType> & indices);
+	void setIndices(const vector<ofIndexType> & indices);
+	void clearIndices();
+	const vector<ofIndexType> & getIndices() const;
+	const ofIndexType * getIndexPointer() const;
+	int getNumIndices() const;
+	bool hasIndices() const;
+
+private:
+	static const int NUM_ATTRIBUTES = 4;
+
+	float * getAttribute(ofMeshAttribute attribute, int index);
+	const float * getAttribute(ofMeshAttribute attribute, int index) const;
+	void setAttribute(ofMeshAttribute attribute, int first, const float * values, int stride, int count);
+
+	vector<float> data;
+	vector<ofIndexType> indices;
+	int numVertices;
+	ofMeshLayout layout;
+	ofPrimitiveMode mode;
+	bool enabled[NUM_ATTRIBUTES];
+	int offsets[NUM_ATTRIBUTES];		// in floats
+	int strides[NUM_ATTRIBUTES];		// in floats
+	int changedBegin[NUM_ATTRIBUTES];
+	int changedEnd[NUM_ATTRIBUTES];
+	bool bLayoutChanged;
+	bool bIndicesChanged;
+};
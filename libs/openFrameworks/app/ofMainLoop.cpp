@@ -243,3 +243,7 @@ void ofMainLoop::keyPressed(ofKeyEventArgs & key){
 		shouldClose(0);
     }
 }
+
+void ofMainLoop::drainDeferredEvents(ofEventArgs &){
+	ofDeferredEvents().drain();
+}
@@ -26,6 +26,7 @@ public:
 		windowsApps[window] = shared_ptr<ofBaseApp>();
 		currentWindow = window;
 		ofAddListener(window->events().keyPressed,this,&ofMainLoop::keyPressed);
+		ofAddListener(window->events().update,this,&ofMainLoop::drainDeferredEvents,OF_EVENT_ORDER_BEFORE_APP);
 	}
 
 	void run(shared_ptr<ofAppBaseWindow> window, shared_ptr<ofBaseApp> app);
@@ -44,6 +45,7 @@ public:
 	ofEvent<void> exitEvent;
 private:
 	void keyPressed(ofKeyEventArgs & key);
+	void drainDeferredEvents(ofEventArgs & args);
 	map<shared_ptr<ofAppBaseWindow>,shared_ptr<ofBaseApp> > windowsApps;
 	bool bShouldClose;
 	shared_ptr<ofAppBaseWindow> currentWindow;
@@ -4,37 +4,757 @@
 
 #include "Poco/PriorityEvent.h"
 #include "Poco/PriorityDelegate.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Mutex.h"
 #include "ofDelegate.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <atomic>
+#include <deque>
+
+//-----------------------------------------
+// listeners registered to an ofEvent. they are
+// usually created by ofAddListener for a method
+// of an object
+
+template<typename ArgumentsType>
+class ofEventListener{
+public:
+	ofEventListener(int priority)
+	:priority(priority)
+	,removed(false){}
+
+	ofEventListener(const ofEventListener<ArgumentsType> & mom)
+	:priority(mom.priority)
+	,removed(false){}
+
+	virtual ~ofEventListener(){}
+
+	/// \returns true if the listener attended the event and it shouldn't
+	/// be propagated to the rest of listeners
+	virtual bool notify(const void * sender, ArgumentsType & args) = 0;
+	virtual bool equals(const ofEventListener<ArgumentsType> & other) const = 0;
+	virtual ofEventListener<ArgumentsType> * clone() const = 0;
+
+	const int priority;
+	std::atomic<bool> removed;
+};
+
+template<>
+class ofEventListener<void>{
+public:
+	ofEventListener(int priority)
+	:priority(priority)
+	,removed(false){}
+
+	ofEventListener(const ofEventListener<void> & mom)
+	:priority(mom.priority)
+	,removed(false){}
+
+	virtual ~ofEventListener(){}
+
+	virtual bool notify(const void * sender) = 0;
+	virtual bool equals(const ofEventListener<void> & other) const = 0;
+	virtual ofEventListener<void> * clone() const = 0;
+
+	const int priority;
+	std::atomic<bool> removed;
+};
+
+template<class TObj, typename TArgs>
+inline bool ofCallEventListener(TObj * obj, void (TObj::*method)(const void*, TArgs&), const void * sender, TArgs & args){
+	(obj->*method)(sender, args);
+	return false;
+}
+
+template<class TObj, typename TArgs>
+inline bool ofCallEventListener(TObj * obj, void (TObj::*method)(TArgs&), const void *, TArgs & args){
+	(obj->*method)(args);
+	return false;
+}
+
+template<class TObj, typename TArgs>
+inline bool ofCallEventListener(TObj * obj, bool (TObj::*method)(const void*, TArgs&), const void * sender, TArgs & args){
+	return (obj->*method)(sender, args);
+}
+
+template<class TObj, typename TArgs>
+inline bool ofCallEventListener(TObj * obj, bool (TObj::*method)(TArgs&), const void *, TArgs & args){
+	return (obj->*method)(args);
+}
+
+template<class TObj>
+inline bool ofCallEventListener(TObj * obj, void (TObj::*method)(const void*), const void * sender){
+	(obj->*method)(sender);
+	return false;
+}
+
+template<class TObj>
+inline bool ofCallEventListener(TObj * obj, void (TObj::*method)(), const void *){
+	(obj->*method)();
+	return false;
+}
+
+template<class TObj>
+inline bool ofCallEventListener(TObj * obj, bool (TObj::*method)(const void*), const void * sender){
+	return (obj->*method)(sender);
+}
+
+template<class TObj>
+inline bool ofCallEventListener(TObj * obj, bool (TObj::*method)(), const void *){
+	return (obj->*method)();
+}
+
+template<class TObj, typename TArgs, typename TMethod>
+class ofMemberEventListener: public ofEventListener<TArgs>{
+public:
+	ofMemberEventListener(TObj * obj, TMethod method, int priority)
+	:ofEventListener<TArgs>(priority)
+	,obj(obj)
+	,method(method){}
+
+	bool notify(const void * sender, TArgs & args){
+		return ofCallEventListener(obj, method, sender, args);
+	}
+
+	bool equals(const ofEventListener<TArgs> & other) const{
+		const ofMemberEventListener * listener = dynamic_cast<const ofMemberEventListener*>(&other);
+		return listener && listener->obj == obj && listener->method == method && listener->priority == this->priority;
+	}
+
+	ofEventListener<TArgs> * clone() const{
+		return new ofMemberEventListener(*this);
+	}
+
+private:
+	TObj * obj;
+	TMethod method;
+};
+
+template<class TObj, typename TMethod>
+class ofMemberEventListener<TObj, void, TMethod>: public ofEventListener<void>{
+public:
+	ofMemberEventListener(TObj * obj, TMethod method, int priority)
+	:ofEventListener<void>(priority)
+	,obj(obj)
+	,method(method){}
+
+	bool notify(const void * sender){
+		return ofCallEventListener(obj, method, sender);
+	}
+
+	bool equals(const ofEventListener<void> & other) const{
+		const ofMemberEventListener * listener = dynamic_cast<const ofMemberEventListener*>(&other);
+		return listener && listener->obj == obj && listener->method == method && listener->priority == this->priority;
+	}
+
+	ofEventListener<void> * clone() const{
+		return new ofMemberEventListener(*this);
+	}
+
+private:
+	TObj * obj;
+	TMethod method;
+};
+
+template<typename TArgs, class TObj, typename TMethod>
+ofMemberEventListener<TObj, TArgs, TMethod> ofMakeEventListener(TObj * obj, TMethod method, int priority){
+	return ofMemberEventListener<TObj, TArgs, TMethod>(obj, method, priority);
+}
+
+// wraps the poco delegates that could be added to
+// ofEvent when it was a Poco::PriorityEvent
+template<typename TArgs>
+class ofPocoEventListener: public ofEventListener<TArgs>{
+public:
+	ofPocoEventListener(const Poco::AbstractPriorityDelegate<TArgs> & delegate)
+	:ofEventListener<TArgs>(delegate.priority())
+	,delegate(static_cast<Poco::AbstractPriorityDelegate<TArgs>*>(delegate.clone())){}
+
+	bool notify(const void * sender, TArgs & args){
+		try{
+			delegate->notify(sender, args);
+		}catch(ofEventAttendedException &){
+			return true;
+		}
+		return false;
+	}
+
+	bool equals(const ofEventListener<TArgs> & other) const{
+		const ofPocoEventListener * listener = dynamic_cast<const ofPocoEventListener*>(&other);
+		return listener && delegate->equals(*listener->delegate);
+	}
+
+	ofEventListener<TArgs> * clone() const{
+		return new ofPocoEventListener(*this);
+	}
+
+private:
+	Poco::SharedPtr<Poco::AbstractPriorityDelegate<TArgs> > delegate;
+};
+
+template<>
+class ofPocoEventListener<void>: public ofEventListener<void>{
+public:
+	ofPocoEventListener(const Poco::AbstractPriorityDelegate<void> & delegate)
+	:ofEventListener<void>(delegate.priority())
+	,delegate(static_cast<Poco::AbstractPriorityDelegate<void>*>(delegate.clone())){}
+
+	bool notify(const void * sender){
+		try{
+			delegate->notify(sender);
+		}catch(ofEventAttendedException &){
+			return true;
+		}
+		return false;
+	}
+
+	bool equals(const ofEventListener<void> & other) const{
+		const ofPocoEventListener * listener = dynamic_cast<const ofPocoEventListener*>(&other);
+		return listener && delegate->equals(*listener->delegate);
+	}
+
+	ofEventListener<void> * clone() const{
+		return new ofPocoEventListener(*this);
+	}
+
+private:
+	Poco::SharedPtr<Poco::AbstractPriorityDelegate<void> > delegate;
+};
+
+
+//-----------------------------------------
+// state shared by every ofEvent: whether it's enabled
+// and the count of notifications in progress that
+// registering and unregistering listeners waits for
+// before deleting the old list of listeners.
+
+class ofBaseDeferredNotification;
+
+class ofBaseEvent{
+public:
+	ofBaseEvent();
+	ofBaseEvent(const ofBaseEvent & mom);
+	ofBaseEvent & operator=(const ofBaseEvent & mom);
+	virtual ~ofBaseEvent();
+
+	void enable();
+	void disable();
+	bool isEnabled() const;
+
+	/// \returns true if notifyDeferred keeps only the latest arguments
+	/// until the deferred notifications are drained
+	bool isDeferredCoalescing() const;
+
+protected:
+	class Notification{
+	public:
+		Notification(ofBaseEvent & event)
+		:event(event){
+			event.beginNotify(*this);
+		}
+
+		~Notification(){
+			event.endNotify(*this);
+		}
+
+	private:
+		friend class ofBaseEvent;
+		Notification(const Notification &);
+		Notification & operator=(const Notification &);
+		ofBaseEvent & event;
+		Notification * previous;
+		int slot;
+	};
+
+	void beginNotify(Notification & notification);
+	void endNotify(Notification & notification);
+
+	/// waits until every notification that started before the call
+	/// has finished. returns false without waiting when called from a
+	/// listener of this event, since the calling notification would never
+	/// finish, and stops waiting after a while when called from a listener
+	/// of another event
+	bool synchronize();
+
+	/// deletes what was replaced or removed once no notification can use
+	/// it. called again when the outermost notification of this event in
+	/// the current thread finishes if reclaimPending is set
+	virtual void reclaim(){}
+
+	void notifyDeferred(ofBaseDeferredNotification * notification);
+	void setCoalescedNotification(ofBaseDeferredNotification * notification);
+
+	Poco::FastMutex mutex;
+	ofBaseDeferredNotification * coalesced;
+	std::atomic<bool> reclaimPending;
+
+private:
+	friend class ofDeferredEventQueue;
+	std::atomic<int> numDeferred;
+	std::atomic<bool> enabled;
+	std::atomic<unsigned int> epoch;
+	std::atomic<int> readers[2];
+	Poco::FastMutex synchronizeMutex;
+
+	bool isNotifyingInThisThread() const;
+	static Notification *& currentNotification();
+};
+
+//-----------------------------------------
+// notifications queued with ofEvent::notifyDeferred
+// from any thread until ofDeferredEventQueue::drain
+// calls them, usually from ofMainLoop right before
+// the app's update.
+
+class ofBaseDeferredNotification{
+public:
+	ofBaseDeferredNotification(const ofBaseEvent * event, bool coalesced)
+	:event(event)
+	,coalesced(coalesced){}
+
+	virtual ~ofBaseDeferredNotification(){}
+
+	virtual void notify() = 0;
+
+	/// called when the event is destroyed before the notification was drained
+	virtual void cancel(){}
+
+	const ofBaseEvent * event;
+
+	/// coalesced notifications belong to their event, the rest are
+	/// deleted once they are drained
+	const bool coalesced;
+};
+
+template<class EventType, typename ArgumentsType>
+class ofDeferredNotification: public ofBaseDeferredNotification{
+public:
+	ofDeferredNotification(EventType & event, const void * sender, const ArgumentsType & args)
+	:ofBaseDeferredNotification(&event, false)
+	,event(event)
+	,sender(sender)
+	,args(args){}
+
+	void notify(){
+		try{
+			event.notify(sender, args);
+		}catch(ofEventAttendedException &){
+
+		}
+	}
+
+private:
+	EventType & event;
+	const void * sender;
+	ArgumentsType args;
+};
+
+template<class EventType>
+class ofDeferredVoidNotification: public ofBaseDeferredNotification{
+public:
+	ofDeferredVoidNotification(EventType & event, const void * sender)
+	:ofBaseDeferredNotification(&event, false)
+	,event(event)
+	,sender(sender){}
+
+	void notify(){
+		try{
+			event.notify(sender);
+		}catch(ofEventAttendedException &){
+
+		}
+	}
+
+private:
+	EventType & event;
+	const void * sender;
+};
+
+// keeps the latest arguments of an event, it's queued
+// only once until it's drained
+template<class EventType, typename ArgumentsType>
+class ofCoalescedNotification: public ofBaseDeferredNotification{
+public:
+	ofCoalescedNotification(EventType & event)
+	:ofBaseDeferredNotification(&event, true)
+	,event(event)
+	,sender(NULL)
+	,queued(false){}
+
+	/// \returns true if the notification has to be queued
+	bool set(const void * _sender, const ArgumentsType & _args){
+		Poco::FastMutex::ScopedLock lock(mutex);
+		sender = _sender;
+		args = _args;
+		bool wasQueued = queued;
+		queued = true;
+		return !wasQueued;
+	}
+
+	void notify(){
+		const void * currentSender;
+		ArgumentsType currentArgs;
+		{
+			Poco::FastMutex::ScopedLock lock(mutex);
+			currentSender = sender;
+			currentArgs = args;
+			queued = false;
+		}
+		try{
+			event.notify(currentSender, currentArgs);
+		}catch(ofEventAttendedException &){
+
+		}
+	}
+
+	void cancel(){
+		Poco::FastMutex::ScopedLock lock(mutex);
+		queued = false;
+	}
+
+private:
+	EventType & event;
+	Poco::FastMutex mutex;
+	const void * sender;
+	ArgumentsType args;
+	bool queued;
+};
+
+template<class EventType>
+class ofCoalescedVoidNotification: public ofBaseDeferredNotification{
+public:
+	ofCoalescedVoidNotification(EventType & event)
+	:ofBaseDeferredNotification(&event, true)
+	,event(event)
+	,sender(NULL)
+	,queued(false){}
+
+	bool set(const void * _sender){
+		Poco::FastMutex::ScopedLock lock(mutex);
+		sender = _sender;
+		bool wasQueued = queued;
+		queued = true;
+		return !wasQueued;
+	}
+
+	void notify(){
+		const void * currentSender;
+		{
+			Poco::FastMutex::ScopedLock lock(mutex);
+			currentSender = sender;
+			queued = false;
+		}
+		try{
+			event.notify(currentSender);
+		}catch(ofEventAttendedException &){
+
+		}
+	}
+
+	void cancel(){
+		Poco::FastMutex::ScopedLock lock(mutex);
+		queued = false;
+	}
+
+private:
+	EventType & event;
+	Poco::FastMutex mutex;
+	const void * sender;
+	bool queued;
+};
+
+/// \brief Queue of the deferred notifications of every ofEvent.
+///
+/// ofMainLoop drains it in the main thread right before notifying the
+/// update event of every window, so listeners of events notified with
+/// notifyDeferred from other threads run in the main thread before the
+/// app's update.
+class ofDeferredEventQueue{
+public:
+	ofDeferredEventQueue();
+
+	/// \brief Notifies the notifications queued before the call.
+	///
+	/// Notifications queued by the listeners are left for the next drain.
+	/// Only one thread should drain the queue.
+	void drain();
+
+	/// \returns the number of queued notifications.
+	size_t getQueueSize() const;
+
+	/// \returns the maximum number of queued notifications since the
+	/// creation of the queue or the last call to resetStats().
+	size_t getMaxQueueSize() const;
+
+	/// \returns the number of notifications in the last drain.
+	size_t getLastDrainSize() const;
+
+	/// \returns the time the last drain took in microseconds.
+	uint64_t getLastDrainTime() const;
+
+	/// \returns the maximum time a drain took in microseconds since the
+	/// creation of the queue or the last call to resetStats().
+	uint64_t getMaxDrainTime() const;
+
+	void resetStats();
+
+private:
+	friend class ofBaseEvent;
+	void push(ofBaseDeferredNotification * notification);
+	void cancel(const ofBaseEvent * event, const ofBaseDeferredNotification * notification = NULL);
+
+	mutable Poco::FastMutex mutex;
+	deque<ofBaseDeferredNotification*> queue;
+	size_t maxQueueSize;
+	size_t lastDrainSize;
+	uint64_t lastDrainTime;
+	uint64_t maxDrainTime;
+};
+
+ofDeferredEventQueue & ofDeferredEvents();
+
+//-----------------------------------------
+// listeners sorted by priority in an immutable list
+// that notify reads without locking. adding or removing
+// a listener publishes a modified copy, the old list and
+// removed listeners are deleted once no notification
+// can be using them anymore.
+
+template<class TListener>
+class ofEventListenerList: public ofBaseEvent{
+public:
+	ofEventListenerList()
+	:listeners(NULL){}
+
+	ofEventListenerList(const ofEventListenerList<TListener> & mom)
+	:ofBaseEvent(mom)
+	,listeners(NULL){}
+
+	ofEventListenerList<TListener> & operator=(const ofEventListenerList<TListener> & mom){
+		ofBaseEvent::operator=(mom);
+		return *this;
+	}
+
+	~ofEventListenerList(){
+		Snapshot * snapshot = listeners.load();
+		if(snapshot){
+			retiredListeners.insert(retiredListeners.end(), snapshot->begin(), snapshot->end());
+			delete snapshot;
+		}
+		deleteRetired(retiredSnapshots, retiredListeners);
+	}
+
+	/// adds a copy of listener after the ones with the same priority,
+	/// replacing any equal listener already registered
+	void add(const TListener & listener){
+		TListener * added = listener.clone();
+		update(added, listener);
+	}
+
+	/// removes the listener equal to listener if it's registered. once
+	/// this returns the listener won't be called again, and when it's not
+	/// called from a listener no other thread is still calling it.
+	void remove(const TListener & listener){
+		update(NULL, listener);
+	}
+
+	void clear(){
+		{
+			Poco::FastMutex::ScopedLock lock(mutex);
+			Snapshot * snapshot = listeners.load();
+			if(!snapshot) return;
+			for(size_t i = 0; i < snapshot->size(); i++){
+				(*snapshot)[i]->removed = true;
+			}
+			retiredListeners.insert(retiredListeners.end(), snapshot->begin(), snapshot->end());
+			retiredSnapshots.push_back(snapshot);
+			listeners.store(NULL);
+		}
+		reclaim();
+	}
+
+	bool empty() const{
+		return listeners.load() == NULL;
+	}
+
+protected:
+	typedef vector<TListener*> Snapshot;
+	std::atomic<Snapshot*> listeners;
+
+private:
+	void update(TListener * added, const TListener & removed){
+		{
+			Poco::FastMutex::ScopedLock lock(mutex);
+			Snapshot * snapshot = listeners.load();
+			Snapshot * next = new Snapshot;
+			if(snapshot){
+				next->reserve(snapshot->size() + 1);
+				for(size_t i = 0; i < snapshot->size(); i++){
+					TListener * listener = (*snapshot)[i];
+					if(listener->equals(removed)){
+						listener->removed = true;
+						retiredListeners.push_back(listener);
+					}else{
+						next->push_back(listener);
+					}
+				}
+			}
+			if(added){
+				typename Snapshot::iterator it = next->begin();
+				while(it != next->end() && (*it)->priority <= added->priority){
+					++it;
+				}
+				next->insert(it, added);
+			}else if(!snapshot || next->size() == snapshot->size()){
+				delete next;
+				return;
+			}
+			if(next->empty()){
+				delete next;
+				next = NULL;
+			}
+			listeners.store(next);
+			if(snapshot){
+				retiredSnapshots.push_back(snapshot);
+			}
+		}
+		reclaim();
+	}
+
+	void reclaim(){
+		vector<Snapshot*> snapshots;
+		vector<TListener*> removed;
+		{
+			Poco::FastMutex::ScopedLock lock(mutex);
+			snapshots.swap(retiredSnapshots);
+			removed.swap(retiredListeners);
+			this->reclaimPending = false;
+		}
+		if(snapshots.empty() && removed.empty()) return;
+		if(this->synchronize()){
+			deleteRetired(snapshots, removed);
+		}else{
+			Poco::FastMutex::ScopedLock lock(mutex);
+			retiredSnapshots.insert(retiredSnapshots.end(), snapshots.begin(), snapshots.end());
+			retiredListeners.insert(retiredListeners.end(), removed.begin(), removed.end());
+			this->reclaimPending = true;
+		}
+	}
+
+	static void deleteRetired(vector<Snapshot*> & snapshots, vector<TListener*> & removed){
+		for(size_t i = 0; i < snapshots.size(); i++){
+			delete snapshots[i];
+		}
+		for(size_t i = 0; i < removed.size(); i++){
+			delete removed[i];
+		}
+		snapshots.clear();
+		removed.clear();
+	}
+
+	vector<Snapshot*> retiredSnapshots;
+	vector<TListener*> retiredListeners;
+};
 
 //-----------------------------------------
-// define ofEvent as a poco FIFOEvent
 // to create your own events use:
 // ofEvent<argType> myEvent
+//
+// notifying an event doesn't lock or allocate, listeners
+// can be added or removed from any thread, including from
+// the listeners of the same event, which only affects the
+// following notifications.
 
 template <typename ArgumentsType>
-class ofEvent: public Poco::PriorityEvent<ArgumentsType> {
+class ofEvent: public ofEventListenerList<ofEventListener<ArgumentsType> > {
 public:
+	void notify(const void * sender, ArgumentsType & args){
+		if(this->listeners.load(std::memory_order_relaxed) == NULL || !this->isEnabled()) return;
+		ofBaseEvent::Notification notification(*this);
+		typename ofEvent<ArgumentsType>::Snapshot * snapshot = this->listeners.load();
+		if(!snapshot) return;
+		for(size_t i = 0; i < snapshot->size(); i++){
+			ofEventListener<ArgumentsType> * listener = (*snapshot)[i];
+			if(!listener->removed.load(std::memory_order_relaxed) && listener->notify(sender, args)){
+				break;
+			}
+		}
+	}
 
-	ofEvent():Poco::PriorityEvent<ArgumentsType>(){
+	/// \brief Queues a copy of args to notify the listeners from the main
+	/// thread. Safe to call from any thread.
+	void notifyDeferred(const void * sender, const ArgumentsType & args){
+		if(this->coalesced){
+			typedef ofCoalescedNotification<ofEvent<ArgumentsType>, ArgumentsType> Coalesced;
+			if(static_cast<Coalesced*>(this->coalesced)->set(sender, args)){
+				ofBaseEvent::notifyDeferred(this->coalesced);
+			}
+		}else{
+			ofBaseEvent::notifyDeferred(new ofDeferredNotification<ofEvent<ArgumentsType>, ArgumentsType>(*this, sender, args));
+		}
+	}
 
+	/// \brief Keep only the latest arguments passed to notifyDeferred
+	/// until the queue is drained, for events that notify states like
+	/// parameters changing faster than the app's frame rate.
+	///
+	/// Has to be set before notifyDeferred is called from other threads,
+	/// it isn't copied with the event.
+	void setDeferredCoalescing(bool coalesce){
+		if(coalesce == this->isDeferredCoalescing()) return;
+		this->setCoalescedNotification(coalesce ? new ofCoalescedNotification<ofEvent<ArgumentsType>, ArgumentsType>(*this) : NULL);
 	}
 
-	// allow copy of events, by copying everything except the mutex
-	ofEvent(const ofEvent<ArgumentsType> & mom)
-	:Poco::PriorityEvent<ArgumentsType>()
-	{
-		this->_enabled = mom._enabled;
+	void operator+=(const Poco::AbstractPriorityDelegate<ArgumentsType> & delegate){
+		this->add(ofPocoEventListener<ArgumentsType>(delegate));
 	}
 
-	ofEvent<ArgumentsType> & operator=(const ofEvent<ArgumentsType> & mom){
-		if(&mom == this) return *this;
-		this->_enabled = mom._enabled;
-		return *this;
+	void operator-=(const Poco::AbstractPriorityDelegate<ArgumentsType> & delegate){
+		this->remove(ofPocoEventListener<ArgumentsType>(delegate));
 	}
+};
 
+template <>
+class ofEvent<void>: public ofEventListenerList<ofEventListener<void> > {
+public:
+	void notify(const void * sender){
+		if(this->listeners.load(std::memory_order_relaxed) == NULL || !this->isEnabled()) return;
+		ofBaseEvent::Notification notification(*this);
+		Snapshot * snapshot = this->listeners.load();
+		if(!snapshot) return;
+		for(size_t i = 0; i < snapshot->size(); i++){
+			ofEventListener<void> * listener = (*snapshot)[i];
+			if(!listener->removed.load(std::memory_order_relaxed) && listener->notify(sender)){
+				break;
+			}
+		}
+	}
+
+	void notifyDeferred(const void * sender){
+		if(this->coalesced){
+			typedef ofCoalescedVoidNotification<ofEvent<void> > Coalesced;
+			if(static_cast<Coalesced*>(this->coalesced)->set(sender)){
+				ofBaseEvent::notifyDeferred(this->coalesced);
+			}
+		}else{
+			ofBaseEvent::notifyDeferred(new ofDeferredVoidNotification<ofEvent<void> >(*this, sender));
+		}
+	}
+
+	void setDeferredCoalescing(bool coalesce){
+		if(coalesce == this->isDeferredCoalescing()) return;
+		this->setCoalescedNotification(coalesce ? new ofCoalescedVoidNotification<ofEvent<void> >(*this) : NULL);
+	}
+
+	void operator+=(const Poco::AbstractPriorityDelegate<void> & delegate){
+		this->add(ofPocoEventListener<void>(delegate));
+	}
+
+	void operator-=(const Poco::AbstractPriorityDelegate<void> & delegate){
+		this->remove(ofPocoEventListener<void>(delegate));
+	}
 };
 
 
@@ -55,50 +775,42 @@ enum ofEventOrder{
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofAddListener(EventType & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(const void*, ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
-    event += Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofAddListener(EventType & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
-    event += Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofAddListener(ofEvent<void> & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(const void*), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
-    event += Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofAddListener(ofEvent<void> & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
-    event += Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofAddListener(EventType & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(const void*, ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,ArgumentsType,true>(listener, listenerMethod, prio);
-    event += ofDelegate<ListenerClass,ArgumentsType,true>(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofAddListener(EventType & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,ArgumentsType,false>(listener, listenerMethod, prio);
-    event += ofDelegate<ListenerClass,ArgumentsType,false>(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofAddListener(ofEvent<void> & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(const void*), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,void,true>(listener, listenerMethod, prio);
-    event += ofDelegate<ListenerClass,void,true>(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofAddListener(ofEvent<void> & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,void,false>(listener, listenerMethod, prio);
-    event += ofDelegate<ListenerClass,void,false>(listener, listenerMethod, prio);
+	event.add(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 //----------------------------------------------------
 // unregister any method of any class to an event.
@@ -111,42 +823,42 @@ void ofAddListener(ofEvent<void> & event, ListenerClass  * listener, bool (Liste
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofRemoveListener(EventType & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(const void*, ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofRemoveListener(EventType & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofRemoveListener(ofEvent<void> & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(const void*), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofRemoveListener(ofEvent<void> & event, ListenerClass  * listener, void (ListenerClass::*listenerMethod)(), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= Poco::priorityDelegate(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofRemoveListener(EventType & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(const void*, ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,ArgumentsType,true>(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class EventType,typename ArgumentsType, class ListenerClass>
 void ofRemoveListener(EventType & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(ArgumentsType&), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,ArgumentsType,false>(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<ArgumentsType>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofRemoveListener(ofEvent<void> & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(const void*), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,void,true>(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 
 template <class ListenerClass>
 void ofRemoveListener(ofEvent<void> & event, ListenerClass  * listener, bool (ListenerClass::*listenerMethod)(), int prio=OF_EVENT_ORDER_AFTER_APP){
-    event -= ofDelegate<ListenerClass,void,false>(listener, listenerMethod, prio);
+	event.remove(ofMakeEventListener<void>(listener, listenerMethod, prio));
 }
 //----------------------------------------------------
 // notifies an event so all the registered listeners
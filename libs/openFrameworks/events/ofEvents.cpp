@@ -1,8 +1,266 @@
 #include "ofEvents.h"
+#include "ofUtils.h"
+#include "Poco/Thread.h"
 
 
 static ofEventArgs voidEventArgs;
 
+// times a listener of another event waits for the notifications of
+// an event before giving up, since a thread notifying that event could be
+// waiting for a notification in progress in this one
+static const int maxSynchronizeTries = 1000;
+
+//--------------------------------------
+ofBaseEvent::ofBaseEvent()
+:coalesced(NULL)
+,reclaimPending(false)
+,numDeferred(0)
+,enabled(true)
+,epoch(0){
+	readers[0] = 0;
+	readers[1] = 0;
+}
+
+//--------------------------------------
+ofBaseEvent::ofBaseEvent(const ofBaseEvent & mom)
+:coalesced(NULL)
+,reclaimPending(false)
+,numDeferred(0)
+,enabled(mom.isEnabled())
+,epoch(0){
+	readers[0] = 0;
+	readers[1] = 0;
+}
+
+//--------------------------------------
+ofBaseEvent::~ofBaseEvent(){
+	if(numDeferred.load() > 0){
+		ofDeferredEvents().cancel(this);
+	}
+	delete coalesced;
+}
+
+//--------------------------------------
+ofBaseEvent & ofBaseEvent::operator=(const ofBaseEvent & mom){
+	if(&mom == this) return *this;
+	enabled = mom.isEnabled();
+	return *this;
+}
+
+//--------------------------------------
+void ofBaseEvent::enable(){
+	enabled = true;
+}
+
+//--------------------------------------
+void ofBaseEvent::disable(){
+	enabled = false;
+}
+
+//--------------------------------------
+bool ofBaseEvent::isEnabled() const{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+//--------------------------------------
+bool ofBaseEvent::isDeferredCoalescing() const{
+	return coalesced != NULL;
+}
+
+//--------------------------------------
+void ofBaseEvent::notifyDeferred(ofBaseDeferredNotification * notification){
+	numDeferred++;
+	ofDeferredEvents().push(notification);
+}
+
+//--------------------------------------
+void ofBaseEvent::setCoalescedNotification(ofBaseDeferredNotification * notification){
+	if(coalesced){
+		if(numDeferred.load() > 0){
+			ofDeferredEvents().cancel(this, coalesced);
+		}
+		delete coalesced;
+	}
+	coalesced = notification;
+}
+
+//--------------------------------------
+ofBaseEvent::Notification *& ofBaseEvent::currentNotification(){
+	// innermost notification in progress in the current thread, each one
+	// links to the one that was in progress when it started
+#if defined(TARGET_NO_THREADS)
+	static Notification * current = NULL;
+#elif defined(_MSC_VER)
+	static __declspec(thread) Notification * current = NULL;
+#else
+	static __thread Notification * current = NULL;
+#endif
+	return current;
+}
+
+//--------------------------------------
+void ofBaseEvent::beginNotify(Notification & notification){
+	Notification *& current = currentNotification();
+	notification.previous = current;
+	current = &notification;
+	notification.slot = epoch.load() & 1;
+	readers[notification.slot]++;
+}
+
+//--------------------------------------
+void ofBaseEvent::endNotify(Notification & notification){
+	readers[notification.slot]--;
+	currentNotification() = notification.previous;
+	if(reclaimPending.load(std::memory_order_relaxed) && !isNotifyingInThisThread()){
+		reclaim();
+	}
+}
+
+//--------------------------------------
+bool ofBaseEvent::isNotifyingInThisThread() const{
+	for(Notification * notification = currentNotification(); notification; notification = notification->previous){
+		if(&notification->event == this){
+			return true;
+		}
+	}
+	return false;
+}
+
+//--------------------------------------
+bool ofBaseEvent::synchronize(){
+	if(isNotifyingInThisThread()){
+		return false;
+	}
+	bool fromListener = currentNotification() != NULL;
+	// a notification counts itself in the slot of the epoch it read
+	// before reading the listeners. flipping the epoch twice and waiting
+	// for both slots to empty waits for every notification that could
+	// have read the listeners before they were replaced
+	Poco::FastMutex::ScopedLock lock(synchronizeMutex);
+	for(int i = 0; i < 2; i++){
+		int slot = epoch.fetch_add(1) & 1;
+		for(int tries = 0; readers[slot].load() != 0; tries++){
+			if(fromListener && tries == maxSynchronizeTries){
+				return false;
+			}
+#ifndef TARGET_NO_THREADS
+			Poco::Thread::yield();
+#endif
+		}
+	}
+	return true;
+}
+
+//--------------------------------------
+ofDeferredEventQueue & ofDeferredEvents(){
+	// never deleted so events destroyed after main returns can still
+	// cancel their notifications
+	static ofDeferredEventQueue * queue = new ofDeferredEventQueue;
+	return *queue;
+}
+
+//--------------------------------------
+ofDeferredEventQueue::ofDeferredEventQueue()
+:maxQueueSize(0)
+,lastDrainSize(0)
+,lastDrainTime(0)
+,maxDrainTime(0){
+
+}
+
+//--------------------------------------
+void ofDeferredEventQueue::push(ofBaseDeferredNotification * notification){
+	ofScopedLock lock(mutex);
+	queue.push_back(notification);
+	maxQueueSize = max(maxQueueSize, queue.size());
+}
+
+//--------------------------------------
+void ofDeferredEventQueue::drain(){
+	uint64_t start = ofGetElapsedTimeMicros();
+	size_t numNotifications;
+	{
+		ofScopedLock lock(mutex);
+		numNotifications = queue.size();
+	}
+	// notifications are taken one by one so events destroyed by a
+	// listener can still cancel the rest of theirs
+	for(size_t i = 0; i < numNotifications; i++){
+		ofBaseDeferredNotification * notification;
+		{
+			ofScopedLock lock(mutex);
+			if(queue.empty()) break;
+			notification = queue.front();
+			queue.pop_front();
+			const_cast<ofBaseEvent*>(notification->event)->numDeferred--;
+		}
+		notification->notify();
+		if(!notification->coalesced){
+			delete notification;
+		}
+	}
+	uint64_t time = ofGetElapsedTimeMicros() - start;
+	ofScopedLock lock(mutex);
+	lastDrainSize = numNotifications;
+	lastDrainTime = time;
+	maxDrainTime = max(maxDrainTime, time);
+}
+
+//--------------------------------------
+void ofDeferredEventQueue::cancel(const ofBaseEvent * event, const ofBaseDeferredNotification * only){
+	ofScopedLock lock(mutex);
+	deque<ofBaseDeferredNotification*>::iterator it = queue.begin();
+	while(it != queue.end()){
+		ofBaseDeferredNotification * notification = *it;
+		if(notification->event == event && (!only || notification == only)){
+			const_cast<ofBaseEvent*>(event)->numDeferred--;
+			notification->cancel();
+			if(!notification->coalesced){
+				delete notification;
+			}
+			it = queue.erase(it);
+		}else{
+			++it;
+		}
+	}
+}
+
+//--------------------------------------
+size_t ofDeferredEventQueue::getQueueSize() const{
+	ofScopedLock lock(mutex);
+	return queue.size();
+}
+
+//--------------------------------------
+size_t ofDeferredEventQueue::getMaxQueueSize() const{
+	ofScopedLock lock(mutex);
+	return maxQueueSize;
+}
+
+//--------------------------------------
+size_t ofDeferredEventQueue::getLastDrainSize() const{
+	ofScopedLock lock(mutex);
+	return lastDrainSize;
+}
+
+//--------------------------------------
+uint64_t ofDeferredEventQueue::getLastDrainTime() const{
+	ofScopedLock lock(mutex);
+	return lastDrainTime;
+}
+
+//--------------------------------------
+uint64_t ofDeferredEventQueue::getMaxDrainTime() const{
+	ofScopedLock lock(mutex);
+	return maxDrainTime;
+}
+
+//--------------------------------------
+void ofDeferredEventQueue::resetStats(){
+	ofScopedLock lock(mutex);
+	maxQueueSize = queue.size();
+	maxDrainTime = 0;
+}
 
 //--------------------------------------
 void ofSetFrameRate(int targetRate){
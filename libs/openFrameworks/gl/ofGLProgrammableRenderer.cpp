@@ -1760,8 +1760,9 @@ void ofGLProgrammableRenderer::drawString(const ofTrueTypeFont & font, string te
 
 	mutThis->setBlendMode(OF_BLENDMODE_ALPHA);
 
+	const ofMesh & mesh = font.getStringMesh(text,x,y,isVFlipped());
 	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
+	draw(mesh,OF_MESH_FILL);
 	mutThis->unbind(font.getFontTexture(),0);
 
 	mutThis->setBlendMode(blendMode);
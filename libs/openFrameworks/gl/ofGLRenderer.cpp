@@ -1611,8 +1611,11 @@ void ofGLRenderer::drawString(const ofTrueTypeFont & font, string text, float x,
     glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+	// the mesh is created first, fonts with a glyph cache upload the glyphs
+	// it needs when the texture is requested
+	const ofMesh & mesh = font.getStringMesh(text,x,y,isVFlipped());
 	mutThis->bind(font.getFontTexture(),0);
-	draw(font.getStringMesh(text,x,y,isVFlipped()),OF_MESH_FILL);
+	draw(mesh,OF_MESH_FILL);
 	mutThis->unbind(font.getFontTexture(),0);
 
 	if(!blendEnabled){
@@ -263,6 +263,21 @@ int ofGetGlTypeFromInternal(int glInternalFormat){
 
 //---------------------------------
 int ofGetGlType(const ofPixels & pixels) {
+	return ofGetGlType(pixels.getView());
+}
+
+//---------------------------------
+int ofGetGlType(const ofShortPixels & pixels) {
+	return GL_UNSIGNED_SHORT;
+}
+
+//---------------------------------
+int ofGetGlType(const ofFloatPixels & pixels) {
+	return GL_FLOAT;
+}
+
+//---------------------------------
+int ofGetGlType(const ofPixelsView & pixels) {
 #ifndef TARGET_OPENGLES
 	if(pixels.getPixelFormat()==OF_PIXELS_RGB565){
 		return GL_UNSIGNED_SHORT_5_6_5;
@@ -275,12 +290,12 @@ int ofGetGlType(const ofPixels & pixels) {
 }
 
 //---------------------------------
-int ofGetGlType(const ofShortPixels & pixels) {
+int ofGetGlType(const ofShortPixelsView & pixels) {
 	return GL_UNSIGNED_SHORT;
 }
 
 //---------------------------------
-int ofGetGlType(const ofFloatPixels & pixels) {
+int ofGetGlType(const ofFloatPixelsView & pixels) {
 	return GL_FLOAT;
 }
 
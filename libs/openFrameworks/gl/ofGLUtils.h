@@ -56,6 +56,9 @@ shared_ptr<ofBaseGLRenderer> ofGetGLRenderer();
 int ofGetGlType(const ofPixels & pixels);
 int ofGetGlType(const ofShortPixels & pixels);
 int ofGetGlType(const ofFloatPixels & pixels);
+int ofGetGlType(const ofPixelsView & pixels);
+int ofGetGlType(const ofShortPixelsView & pixels);
+int ofGetGlType(const ofFloatPixelsView & pixels);
 
 ofImageType ofGetImageTypeFromGLType(int glType);
 
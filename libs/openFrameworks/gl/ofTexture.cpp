@@ -505,6 +505,77 @@ void ofTexture::loadData(const ofFloatPixels & pix){
 	loadData(pix.getData(), pix.getWidth(), pix.getHeight(), ofGetGlFormat(pix), ofGetGlType(pix));
 }
 
+//----------------------------------------------------------
+// views of a rectangle of bigger pixels are uploaded setting
+// GL_UNPACK_ROW_LENGTH to the length of the original rows, which doesn't
+// exist in OpenGL ES. views that skip components inside a row, like a
+// channel of an rgb image, can't be uploaded directly at all
+template<typename PixelType>
+static bool canLoadViewDirectly(const ofPixelsView_<PixelType> & pix){
+	if(pix.getPixelStride() != pix.getNumChannels()) return false;
+	if(pix.isContiguous()) return true;
+#ifndef TARGET_OPENGLES
+	return pix.getStride() % pix.getNumChannels() == 0;
+#else
+	return false;
+#endif
+}
+
+template<typename PixelType>
+static void setUnpackStride(const ofPixelsView_<PixelType> & pix){
+	ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT, pix.getStride() * sizeof(PixelType));
+#ifndef TARGET_OPENGLES
+	if(!pix.isContiguous()){
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, pix.getStride() / pix.getNumChannels());
+	}
+#endif
+}
+
+static void resetUnpackStride(){
+#ifndef TARGET_OPENGLES
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofPixelsView & pix){
+	if(!canLoadViewDirectly(pix)){
+		ofPixels copy;
+		copy.setFromPixels(pix);
+		loadData(copy);
+		return;
+	}
+	setUnpackStride(pix);
+	loadData(pix.getData(), pix.getWidth(), pix.getHeight(), ofGetGLFormatFromPixelFormat(pix.getPixelFormat()), ofGetGlType(pix));
+	resetUnpackStride();
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofShortPixelsView & pix){
+	if(!canLoadViewDirectly(pix)){
+		ofShortPixels copy;
+		copy.setFromPixels(pix);
+		loadData(copy);
+		return;
+	}
+	setUnpackStride(pix);
+	loadData(pix.getData(), pix.getWidth(), pix.getHeight(), ofGetGLFormatFromPixelFormat(pix.getPixelFormat()), ofGetGlType(pix));
+	resetUnpackStride();
+}
+
+//----------------------------------------------------------
+void ofTexture::loadData(const ofFloatPixelsView & pix){
+	if(!canLoadViewDirectly(pix)){
+		ofFloatPixels copy;
+		copy.setFromPixels(pix);
+		loadData(copy);
+		return;
+	}
+	setUnpackStride(pix);
+	loadData(pix.getData(), pix.getWidth(), pix.getHeight(), ofGetGLFormatFromPixelFormat(pix.getPixelFormat()), ofGetGlType(pix));
+	resetUnpackStride();
+}
+
 //----------------------------------------------------------
 void ofTexture::loadData(const ofPixels & pix, int glFormat){
 	ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT,pix.getWidth(),pix.getBytesPerChannel(),ofGetNumChannelsFromGLFormat(glFormat));
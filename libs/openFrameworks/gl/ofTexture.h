@@ -526,6 +526,27 @@ class ofTexture : public ofBaseDraws {
 	/// \param glFormat GL pixel type: GL_RGBA, GL_LUMINANCE, etc.
 	void loadData(const ofFloatPixels & pix, int glFormat);
 
+	/// \brief Load pixels from an ofPixelsView.
+	///
+	/// Views of a rectangle of some bigger pixels are uploaded without
+	/// copying them, except on OpenGL ES which can't skip the rest of each
+	/// row. Views of one channel of a multichannel image are always copied.
+	///
+	/// \param pix Reference to ofPixelsView instance.
+	void loadData(const ofPixelsView & pix);
+
+	/// \brief Load pixels from an ofShortPixelsView.
+	///
+	/// \sa loadData(const ofPixelsView & pix)
+	/// \param pix Reference to ofShortPixelsView instance.
+	void loadData(const ofShortPixelsView & pix);
+
+	/// \brief Load pixels from an ofFloatPixelsView.
+	///
+	/// \sa loadData(const ofPixelsView & pix)
+	/// \param pix Reference to ofFloatPixelsView instance.
+	void loadData(const ofFloatPixelsView & pix);
+
 #ifndef TARGET_OPENGLES
 	/// \brief Load pixels from an ofBufferObject
 	///
@@ -308,6 +308,45 @@ void ofVbo::setMesh(const ofMesh & mesh, int usage, bool useColors, bool useText
 	}
 }
 
+//--------------------------------------------------------------
+void ofVbo::setMesh(const ofPackedMesh & mesh, int usage){
+	if(mesh.getNumVertices()==0){
+		ofLogWarning("ofVbo") << "setMesh(): ignoring mesh with no vertices";
+		return;
+	}
+	ofBufferObject buffer;
+	buffer.allocate(mesh.getDataSize(), mesh.getData(), usage);
+
+	setVertexBuffer(buffer, 3, mesh.getAttributeStride(OF_MESH_POSITION), mesh.getAttributeOffset(OF_MESH_POSITION));
+	totalVerts = mesh.getNumVertices();
+	if(mesh.hasColors()){
+		setColorBuffer(buffer, mesh.getAttributeStride(OF_MESH_COLOR), mesh.getAttributeOffset(OF_MESH_COLOR));
+	}else{
+		disableColors();
+	}
+	if(mesh.hasNormals()){
+		setNormalBuffer(buffer, mesh.getAttributeStride(OF_MESH_NORMAL), mesh.getAttributeOffset(OF_MESH_NORMAL));
+		// same as setNormalData
+		normalAttribute.normalize = true;
+	}else{
+		disableNormals();
+	}
+	if(mesh.hasTexCoords()){
+		setTexCoordBuffer(buffer, mesh.getAttributeStride(OF_MESH_TEXCOORD), mesh.getAttributeOffset(OF_MESH_TEXCOORD));
+	}else{
+		disableTexCoords();
+	}
+	if(mesh.hasIndices()){
+		setIndexData(mesh.getIndexPointer(), mesh.getNumIndices(), usage);
+		enableIndices();
+	}else{
+		disableIndices();
+	}
+	vaoChanged = true;
+
+	const_cast<ofPackedMesh&>(mesh).clearChanges();
+}
+
 //--------------------------------------------------------------
 void ofVbo::setVertexData(const ofVec3f * verts, int total, int usage) {
 	setVertexData(&verts[0].x,3,total,usage,sizeof(ofVec3f));
@@ -443,6 +482,77 @@ void ofVbo::updateMesh(const ofMesh & mesh){
 	if(nonconstMesh->haveTexCoordsChanged()) updateTexCoordData(mesh.getTexCoordsPointer(),mesh.getNumTexCoords());
 }
 
+//--------------------------------------------------------------
+void ofVbo::updateMesh(const ofPackedMesh & mesh){
+	ofPackedMesh & nonconstMesh = const_cast<ofPackedMesh&>(mesh);
+	if(mesh.hasLayoutChanged() || positionAttribute.buffer.size() != GLsizeiptr(mesh.getDataSize())){
+		setMesh(mesh, GL_DYNAMIC_DRAW);
+		return;
+	}
+
+	// byte ranges changed for each attribute, sorted by offset
+	GLintptr begins[4];
+	GLintptr ends[4];
+	int numRanges = 0;
+	GLsizeiptr changedBytes = 0;
+	for(int i = OF_MESH_POSITION; i <= OF_MESH_TEXCOORD; i++){
+		ofMeshAttribute attribute = (ofMeshAttribute)i;
+		int first, count;
+		if(!mesh.getChangedRange(attribute, first, count)) continue;
+		GLintptr begin = mesh.getAttributeOffset(attribute) + GLintptr(first) * mesh.getAttributeStride(attribute);
+		GLintptr end = begin + GLintptr(count - 1) * mesh.getAttributeStride(attribute) + ofPackedMesh::getNumCoords(attribute) * sizeof(float);
+		int j = numRanges;
+		while(j > 0 && begins[j-1] > begin){
+			begins[j] = begins[j-1];
+			ends[j] = ends[j-1];
+			j--;
+		}
+		begins[j] = begin;
+		ends[j] = end;
+		numRanges++;
+		changedBytes += end - begin;
+	}
+
+	if(numRanges > 0){
+		const unsigned char * data = (const unsigned char *)mesh.getData();
+		GLintptr begin = begins[0];
+		GLintptr end = 0;
+		for(int i = 0; i < numRanges; i++){
+			end = MAX(end, ends[i]);
+		}
+		// a single update unless that would upload much more than what
+		// changed, which only happens with planar meshes
+		if(end - begin <= 2 * changedBytes){
+			positionAttribute.updateData(begin, end - begin, data + begin);
+		}else{
+			end = ends[0];
+			for(int i = 1; i < numRanges; i++){
+				if(begins[i] > end){
+					positionAttribute.updateData(begin, end - begin, data + begin);
+					begin = begins[i];
+				}
+				end = MAX(end, ends[i]);
+			}
+			positionAttribute.updateData(begin, end - begin, data + begin);
+		}
+	}
+
+	if(mesh.haveIndicesChanged()){
+		if(!mesh.hasIndices()){
+			disableIndices();
+		}else if(totalIndices < mesh.getNumIndices() || !indexAttribute.isAllocated()){
+			setIndexData(mesh.getIndexPointer(), mesh.getNumIndices(), GL_DYNAMIC_DRAW);
+			enableIndices();
+		}else{
+			updateIndexData(mesh.getIndexPointer(), mesh.getNumIndices());
+			totalIndices = mesh.getNumIndices();
+			enableIndices();
+		}
+	}
+
+	nonconstMesh.clearChanges();
+}
+
 //--------------------------------------------------------------
 void ofVbo::updateVertexData(const ofVec3f * verts, int total) {
 	updateVertexData(&verts[0].x,total);
@@ -6,6 +6,7 @@
 #include "ofColor.h"
 #include "ofUtils.h"
 #include "ofMesh.h"
+#include "ofPackedMesh.h"
 #include "ofGLUtils.h"
 #include "ofBufferObject.h"
 #include <map>
@@ -20,6 +21,13 @@ public:
 
 	void setMesh(const ofMesh & mesh, int usage);
 	void setMesh(const ofMesh & mesh, int usage, bool useColors, bool useTextures, bool useNormals);
+
+	/// \brief Uploads all the attributes of a packed mesh to a single buffer
+	///
+	/// The position, color, normal and texcoord attributes of the vbo all
+	/// point into that buffer, following the layout of the mesh.
+	/// \sa ofPackedMesh
+	void setMesh(const ofPackedMesh & mesh, int usage);
 	
 	void setVertexData(const ofVec3f * verts, int total, int usage);
 	void setVertexData(const ofVec2f * verts, int total, int usage);
@@ -70,6 +78,15 @@ public:
 
 	void updateMesh(const ofMesh & mesh);
 
+	/// \brief Uploads the ranges of a packed mesh that changed since the last
+	/// upload and clears its changes.
+	///
+	/// The changed ranges of all the attributes are sent in a single buffer
+	/// update, or in one per attribute when they are far apart in a mesh
+	/// with OF_MESH_LAYOUT_PLANAR. If the mesh was reallocated the whole
+	/// buffer is reallocated as GL_DYNAMIC_DRAW.
+	void updateMesh(const ofPackedMesh & mesh);
+
 	void updateVertexData(const ofVec3f * verts, int total);
 	void updateVertexData(const ofVec2f * verts, int total);
 	void updateColorData(const ofFloatColor * colors, int total);
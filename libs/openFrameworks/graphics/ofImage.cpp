@@ -20,6 +20,9 @@ void ofInitFreeImage(bool deinit=false){
 	// need a new bool to avoid c++ "deinitialization order fiasco":
 	// http://www.parashift.com/c++-faq-lite/ctors.html#faq-10.15
 	static bool	* bFreeImageInited = new bool(false);
+	// images can be loaded from several threads at once
+	static ofMutex * mutex = new ofMutex;
+	ofScopedLock lock(*mutex);
 	if(!*bFreeImageInited && !deinit){
 		FreeImage_Initialise();
 		*bFreeImageInited = true;
@@ -30,15 +33,15 @@ void ofInitFreeImage(bool deinit=false){
 }
 
 template <typename T>
-FREE_IMAGE_TYPE getFreeImageType(ofPixels_<T>& pix);
+FREE_IMAGE_TYPE getFreeImageType(const ofPixelsView_<T>& pix);
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofPixelsView& pix) {
 	return FIT_BITMAP;
 }
 
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofShortPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofShortPixelsView& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_UINT16;
 		case 3: return FIT_RGB16;
@@ -49,7 +52,7 @@ FREE_IMAGE_TYPE getFreeImageType(ofShortPixels& pix) {
 	}
 }
 template <>
-FREE_IMAGE_TYPE getFreeImageType(ofFloatPixels& pix) {
+FREE_IMAGE_TYPE getFreeImageType(const ofFloatPixelsView& pix) {
 	switch(pix.getNumChannels()) {
 		case 1: return FIT_FLOAT;
 		case 3: return FIT_RGBF;
@@ -62,39 +65,60 @@ FREE_IMAGE_TYPE getFreeImageType(ofFloatPixels& pix) {
 
 //----------------------------------------------------
 template<typename PixelType>
-FIBITMAP* getBmpFromPixels(ofPixels_<PixelType> &pix){
-	PixelType* pixels = pix.getData();
+FIBITMAP* getBmpFromPixels(const ofPixelsView_<PixelType> &pix, bool swapRgb = false){
 	unsigned int width = pix.getWidth();
 	unsigned int height = pix.getHeight();
-	unsigned int bpp = pix.getBitsPerPixel();
+	int channels = pix.getNumChannels();
+	unsigned int bpp = channels * sizeof(PixelType) * 8;
 	
 	FREE_IMAGE_TYPE freeImageType = getFreeImageType(pix);
 	FIBITMAP* bmp = FreeImage_AllocateT(freeImageType, width, height, bpp);
 	unsigned char* bmpBits = FreeImage_GetBits(bmp);
 	if(bmpBits != NULL) {
-		int srcStride = width * pix.getBytesPerPixel();
 		int dstStride = FreeImage_GetPitch(bmp);
-		unsigned char* src = (unsigned char*) pixels;
-		unsigned char* dst = bmpBits;
-		if(srcStride != dstStride){
-			for(int i = 0; i < (int)height; i++) {
-				memcpy(dst, src, srcStride);
-				src += srcStride;
-				dst += dstStride;
+		for(int y = 0; y < (int)height; y++) {
+			// ofPixels are top left, FIBITMAP is bottom left
+			PixelType* dst = (PixelType*)(bmpBits + (height - 1 - y) * dstStride);
+			const PixelType* src = pix.getLine(y);
+			if(pix.getPixelStride() == channels){
+				memcpy(dst, src, width * channels * sizeof(PixelType));
+			}else{
+				for(int x = 0; x < (int)width; x++){
+					for(int c = 0; c < channels; c++){
+						dst[x * channels + c] = src[x * pix.getPixelStride() + c];
+					}
+				}
+			}
+			if(swapRgb){
+				ofPixels_<PixelType> row;
+				row.setFromExternalPixels(dst, width, 1, pix.getPixelFormat());
+				row.swapRgb();
 			}
-		}else{
-			memcpy(dst,src,dstStride*height);
 		}
 	} else {
 		ofLogError("ofImage") << "getBmpFromPixels(): unable to get FIBITMAP from ofPixels";
 	}
-	
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
 
 	return bmp;
 }
 
+//----------------------------------------------------
+template<typename PixelType>
+FIBITMAP* getBmpFromPixels(ofPixels_<PixelType> &pix){
+	return getBmpFromPixels(pix.getView());
+}
+
+//----------------------------------------------------
+// FreeImage expects 8 bit color images in BGR order on little endian
+template<typename PixelType>
+static bool needsRgbSwapForFreeImage(const ofPixelsView_<PixelType> & pix){
+#ifdef TARGET_LITTLE_ENDIAN
+	return sizeof(PixelType) == 1 && (pix.getPixelFormat()==OF_PIXELS_RGB || pix.getPixelFormat()==OF_PIXELS_RGBA);
+#else
+	return false;
+#endif
+}
+
 //----------------------------------------------------
 template<typename PixelType>
 void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLittleEndian = true) {
@@ -130,7 +154,6 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLit
 	unsigned int height = FreeImage_GetHeight(bmp);
 	unsigned int bpp = FreeImage_GetBPP(bmp);
 	unsigned int channels = (bpp / sizeof(PixelType)) / 8;
-	unsigned int pitch = FreeImage_GetPitch(bmp);
 
 	ofPixelFormat pixFormat;
 	if(channels==1) pixFormat=OF_PIXELS_GRAY;
@@ -147,12 +170,15 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLit
 	if(channels==4) pixFormat=OF_PIXELS_RGBA;
 #endif
 
-	// ofPixels are top left, FIBITMAP is bottom left
-	FreeImage_FlipVertical(bmp);
-	
-	unsigned char* bmpBits = FreeImage_GetBits(bmp);
-	if(bmpBits != NULL) {
-		pix.setFromAlignedPixels((PixelType*) bmpBits, width, height, pixFormat, pitch);
+	// ofPixels are top left, FIBITMAP is bottom left: copy the rows in
+	// reverse order straight into the pixels instead of flipping the bitmap
+	if(FreeImage_GetBits(bmp) != NULL) {
+		pix.allocate(width, height, pixFormat);
+		int stride = pix.getBytesStride();
+		unsigned char* dst = (unsigned char*) pix.getData();
+		for(unsigned int y = 0; y < height; y++) {
+			memcpy(dst + y * stride, FreeImage_GetScanLine(bmp, height - 1 - y), stride);
+		}
 	} else {
 		ofLogError("ofImage") << "putBmpIntoPixels(): unable to set ofPixels from FIBITMAP";
 	}
@@ -168,8 +194,155 @@ void putBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> &pix, bool swapForLit
 #endif
 }
 
+//----------------------------------------------------
+ofImageLoadSettings::ofImageLoadSettings()
+:maxWidth(0)
+,maxHeight(0)
+,scale(1)
+,useEmbeddedThumbnail(true)
+,exactSize(true){
+
+}
+
+//----------------------------------------------------
+ofImageLoadSettings::ofImageLoadSettings(int maxWidth, int maxHeight)
+:maxWidth(maxWidth)
+,maxHeight(maxHeight)
+,scale(1)
+,useEmbeddedThumbnail(true)
+,exactSize(true){
+
+}
+
+//----------------------------------------------------
+static bool isScaled(const ofImageLoadSettings & settings){
+	return settings.scale < 1 || settings.maxWidth > 0 || settings.maxHeight > 0;
+}
+
+//----------------------------------------------------
+// size an image of width x height is loaded at with settings
+static void getScaledSize(int & width, int & height, const ofImageLoadSettings & settings){
+	float scale = MIN(settings.scale, 1.f);
+	if(settings.maxWidth > 0) scale = MIN(scale, settings.maxWidth / float(width));
+	if(settings.maxHeight > 0) scale = MIN(scale, settings.maxHeight / float(height));
+	if(scale < 1){
+		width = MAX(1, int(width * scale + 0.5f));
+		height = MAX(1, int(height * scale + 0.5f));
+	}
+}
+
+//----------------------------------------------------
+// the file or memory an image is loaded from, which can be read more than
+// once to get the header first and then the pixels at the right size
+class ofFreeImageSource{
+public:
+	ofFreeImageSource(const string & fileName)
+	:fileName(fileName)
+	,hmem(NULL){}
+
+	ofFreeImageSource(FIMEMORY * hmem)
+	:hmem(hmem){}
+
+	FIBITMAP * load(FREE_IMAGE_FORMAT fif, int flags) const{
+		if(hmem != NULL){
+			FreeImage_SeekMemory(hmem, 0, SEEK_SET);
+			return FreeImage_LoadFromMemory(fif, hmem, flags);
+		}else{
+			return FreeImage_Load(fif, fileName.c_str(), flags);
+		}
+	}
+
+private:
+	string fileName;
+	FIMEMORY * hmem;
+};
+
+//----------------------------------------------------
+// loads the bitmap at the smallest size the format allows that is still at
+// least the size asked for in settings, which is returned in scaledWidth,
+// scaledHeight
+static FIBITMAP * loadBmp(const ofFreeImageSource & source, FREE_IMAGE_FORMAT fif, const ofImageLoadSettings & settings, int & scaledWidth, int & scaledHeight){
+	FIBITMAP * bmp = NULL;
+	scaledWidth = scaledHeight = 0;
+	if(!isScaled(settings)){
+		return source.load(fif, 0);
+	}
+
+	// the header, and any embedded thumbnail, give the size of the image
+	// without decoding it
+	FIBITMAP * header = source.load(fif, FIF_LOAD_NOPIXELS);
+	if(header != NULL && FreeImage_HasPixels(header)){
+		// the format can't load only the header, it's been decoded whole
+		bmp = header;
+	}else if(header != NULL){
+		int width = FreeImage_GetWidth(header);
+		int height = FreeImage_GetHeight(header);
+		scaledWidth = width;
+		scaledHeight = height;
+		getScaledSize(scaledWidth, scaledHeight, settings);
+		FIBITMAP * thumbnail = settings.useEmbeddedThumbnail ? FreeImage_GetThumbnail(header) : NULL;
+		if(thumbnail != NULL){
+			int thumbnailWidth = FreeImage_GetWidth(thumbnail);
+			int thumbnailHeight = FreeImage_GetHeight(thumbnail);
+			// exif thumbnails are sometimes letterboxed to 4:3
+			bool sameAspect = fabs(thumbnailWidth * height - thumbnailHeight * width) <= 0.02 * width * thumbnailHeight;
+			if(thumbnailWidth >= scaledWidth && thumbnailHeight >= scaledHeight && sameAspect){
+				bmp = FreeImage_Clone(thumbnail);
+			}
+		}
+		FreeImage_Unload(header);
+
+		// jpegs can be decoded at 1/2, 1/4 or 1/8 of their size, the size
+		// requested in the high bits of the flags is the minimum for the
+		// longest side
+		if(bmp == NULL && fif == FIF_JPEG && (scaledWidth < width || scaledHeight < height)){
+			bmp = source.load(fif, MAX(scaledWidth, scaledHeight) << 16);
+		}
+	}
+	if(bmp == NULL && fif == FIF_RAW && settings.useEmbeddedThumbnail){
+		bmp = source.load(fif, RAW_PREVIEW);
+	}
+	if(bmp == NULL){
+		bmp = source.load(fif, 0);
+	}
+	if(bmp != NULL && scaledWidth == 0){
+		// no header, scale the size of the decoded image
+		scaledWidth = FreeImage_GetWidth(bmp);
+		scaledHeight = FreeImage_GetHeight(bmp);
+		getScaledSize(scaledWidth, scaledHeight, settings);
+	}
+	return bmp;
+}
+
+//----------------------------------------------------
+// resizes the bitmap returned by loadBmp to scaledWidth x scaledHeight if
+// needed while copying it into pix
+template<typename PixelType>
+static void putScaledBmpIntoPixels(FIBITMAP * bmp, ofPixels_<PixelType> & pix, const ofImageLoadSettings & settings, int scaledWidth, int scaledHeight){
+	int width = FreeImage_GetWidth(bmp);
+	int height = FreeImage_GetHeight(bmp);
+	bool resize = scaledWidth > 0 && (width != scaledWidth || height != scaledHeight);
+	if(resize && !settings.exactSize){
+		// a size up to twice the requested one is good enough
+		resize = width > scaledWidth * 2 || height > scaledHeight * 2;
+	}
+	if(resize){
+		FIBITMAP * scaled = FreeImage_Rescale(bmp, scaledWidth, scaledHeight, FILTER_BILINEAR);
+		if(scaled != NULL){
+			putBmpIntoPixels(scaled, pix);
+			FreeImage_Unload(scaled);
+			return;
+		}
+	}
+	putBmpIntoPixels(bmp, pix);
+}
+
+//----------------------------------------------------
+template<typename PixelType>
+static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings);
+
 template<typename PixelType>
-static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
+static bool loadImage(ofPixels_<PixelType> & pix, string fileName, const ofImageLoadSettings & settings){
 	ofInitFreeImage();
 
 #ifndef TARGET_EMSCRIPTEN
@@ -183,13 +356,14 @@ static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
 		return false;
     }
 	if(uri.getScheme() == "http" || uri.getScheme() == "https"){
-		return ofLoadImage(pix, ofLoadURL(fileName).data);
+		return loadImage(pix, ofLoadURL(fileName).data, settings);
 	}
 #endif
 	
 	fileName = ofToDataPath(fileName);
 	bool bLoaded = false;
 	FIBITMAP * bmp = NULL;
+	int scaledWidth = 0, scaledHeight = 0;
 
 	FREE_IMAGE_FORMAT fif = FIF_UNKNOWN;
 	fif = FreeImage_GetFileType(fileName.c_str(), 0);
@@ -198,7 +372,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
 		fif = FreeImage_GetFIFFromFilename(fileName.c_str());
 	}
 	if((fif != FIF_UNKNOWN) && FreeImage_FIFSupportsReading(fif)) {
-		bmp = FreeImage_Load(fif, fileName.c_str(), 0);
+		bmp = loadBmp(ofFreeImageSource(fileName), fif, settings, scaledWidth, scaledHeight);
 
 		if (bmp != NULL){
 			bLoaded = true;
@@ -208,7 +382,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
 	//-----------------------------
 
 	if ( bLoaded ){
-		putBmpIntoPixels(bmp,pix);
+		putScaledBmpIntoPixels(bmp,pix,settings,scaledWidth,scaledHeight);
 	}
 
 	if (bmp != NULL){
@@ -219,11 +393,12 @@ static bool loadImage(ofPixels_<PixelType> & pix, string fileName){
 }
 
 template<typename PixelType>
-static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
+static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings){
 	ofInitFreeImage();
 	bool bLoaded = false;
 	FIBITMAP* bmp = NULL;
 	FIMEMORY* hmem = NULL;
+	int scaledWidth = 0, scaledHeight = 0;
 	
 	hmem = FreeImage_OpenMemory((unsigned char*) buffer.getData(), buffer.size());
 	if (hmem == NULL){
@@ -241,7 +416,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
 
 
 	//make the image!!
-	bmp = FreeImage_LoadFromMemory(fif, hmem, 0);
+	bmp = loadBmp(ofFreeImageSource(hmem), fif, settings, scaledWidth, scaledHeight);
 	
 	if( bmp != NULL ){
 		bLoaded = true;
@@ -250,7 +425,7 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
 	//-----------------------------
 	
 	if (bLoaded){
-		putBmpIntoPixels(bmp,pix);
+		putScaledBmpIntoPixels(bmp,pix,settings,scaledWidth,scaledHeight);
 	}
 
 	if (bmp != NULL){
@@ -267,32 +442,62 @@ static bool loadImage(ofPixels_<PixelType> & pix, const ofBuffer & buffer){
 
 //----------------------------------------------------
 bool ofLoadImage(ofPixels & pix, string fileName) {
-	return loadImage(pix,fileName);
+	return loadImage(pix,fileName,ofImageLoadSettings());
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofPixels & pix, string path, const ofImageLoadSettings & settings){
+	return loadImage(pix,path,settings);
 }
 
 //----------------------------------------------------
 bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer) {
-	return loadImage(pix,buffer);
+	return loadImage(pix,buffer,ofImageLoadSettings());
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings){
+	return loadImage(pix,buffer,settings);
 }
 
 //----------------------------------------------------
 bool ofLoadImage(ofFloatPixels & pix, string path){
-	return loadImage(pix,path);
+	return loadImage(pix,path,ofImageLoadSettings());
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofFloatPixels & pix, string path, const ofImageLoadSettings & settings){
+	return loadImage(pix,path,settings);
 }
 
 //----------------------------------------------------
 bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer){
-	return loadImage(pix,buffer);
+	return loadImage(pix,buffer,ofImageLoadSettings());
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings){
+	return loadImage(pix,buffer,settings);
 }
 
 //----------------------------------------------------
 bool ofLoadImage(ofShortPixels & pix, string path){
-	return loadImage(pix,path);
+	return loadImage(pix,path,ofImageLoadSettings());
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofShortPixels & pix, string path, const ofImageLoadSettings & settings){
+	return loadImage(pix,path,settings);
 }
 
 //----------------------------------------------------
 bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer){
-	return loadImage(pix,buffer);
+	return loadImage(pix,buffer,ofImageLoadSettings());
+}
+
+//----------------------------------------------------
+bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings){
+	return loadImage(pix,buffer,settings);
 }
 
 
@@ -320,26 +525,14 @@ bool ofLoadImage(ofTexture & tex, const ofBuffer & buffer){
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualityType qualityLevel) {
+static void saveImage(const ofPixelsView_<PixelType> & pix, string fileName, ofImageQualityType qualityLevel) {
 	ofInitFreeImage();
 	if (pix.isAllocated() == false){
 		ofLogError("ofImage") << "saveImage(): couldn't save \"" << fileName << "\", pixels are not allocated";
 		return;
 	}
 
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1 && (pix.getPixelFormat()==OF_PIXELS_RGB || pix.getPixelFormat()==OF_PIXELS_RGBA)) {
-		pix.swapRgb();
-	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1 && (pix.getPixelFormat()==OF_PIXELS_BGR || pix.getPixelFormat()==OF_PIXELS_BGRA)) {
-		pix.swapRgb();
-	}
-	#endif
+	FIBITMAP * bmp	= getBmpFromPixels(pix, needsRgbSwapForFreeImage(pix));
 	
 	ofFilePath::createEnclosingDirectory(fileName);
 	fileName = ofToDataPath(fileName);
@@ -392,22 +585,37 @@ static void saveImage(ofPixels_<PixelType> & pix, string fileName, ofImageQualit
 
 //----------------------------------------------------------------
 void ofSaveImage(ofPixels & pix, string fileName, ofImageQualityType qualityLevel){
-	saveImage(pix,fileName,qualityLevel);
+	saveImage(pix.getView(),fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
 void ofSaveImage(ofFloatPixels & pix, string fileName, ofImageQualityType qualityLevel) {
-	saveImage(pix,fileName,qualityLevel);
+	saveImage(pix.getView(),fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
 void ofSaveImage(ofShortPixels & pix, string fileName, ofImageQualityType qualityLevel) {
+	saveImage(pix.getView(),fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+void ofSaveImage(const ofPixelsView & pix, string fileName, ofImageQualityType qualityLevel){
+	saveImage(pix,fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+void ofSaveImage(const ofFloatPixelsView & pix, string fileName, ofImageQualityType qualityLevel) {
+	saveImage(pix,fileName,qualityLevel);
+}
+
+//----------------------------------------------------------------
+void ofSaveImage(const ofShortPixelsView & pix, string fileName, ofImageQualityType qualityLevel) {
 	saveImage(pix,fileName,qualityLevel);
 }
 
 //----------------------------------------------------------------
 template<typename PixelType>
-static void saveImage(ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+static void saveImage(const ofPixelsView_<PixelType> & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
 	// thanks to alvaro casinelli for the implementation
 
 	ofInitFreeImage();
@@ -418,25 +626,15 @@ static void saveImage(ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageForm
 	}
 
 	if(format==OF_IMAGE_FORMAT_JPEG && pix.getNumChannels()==4){
-		ofPixels pix3 = pix;
+		ofPixels_<PixelType> copy;
+		copy.setFromPixels(pix);
+		ofPixels pix3 = copy;
 		pix3.setNumChannels(3);
-		saveImage(pix3,buffer,format,qualityLevel);
+		saveImage(pix3.getView(),buffer,format,qualityLevel);
 		return;
 	}
 
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
-
-	FIBITMAP * bmp	= getBmpFromPixels(pix);
-
-	#ifdef TARGET_LITTLE_ENDIAN
-	if(sizeof(PixelType) == 1) {
-		pix.swapRgb();
-	}
-	#endif
+	FIBITMAP * bmp	= getBmpFromPixels(pix, needsRgbSwapForFreeImage(pix));
 
 	if (bmp)  // bitmap successfully created
 	{
@@ -496,14 +694,26 @@ static void saveImage(ofPixels_<PixelType> & pix, ofBuffer & buffer, ofImageForm
 
 //----------------------------------------------------------------
 void ofSaveImage(ofPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
-	saveImage(pix,buffer,format,qualityLevel);
+	saveImage(pix.getView(),buffer,format,qualityLevel);
 }
 
 void ofSaveImage(ofFloatPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
-	saveImage(pix,buffer,format,qualityLevel);
+	saveImage(pix.getView(),buffer,format,qualityLevel);
 }
 
 void ofSaveImage(ofShortPixels & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	saveImage(pix.getView(),buffer,format,qualityLevel);
+}
+
+void ofSaveImage(const ofPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	saveImage(pix,buffer,format,qualityLevel);
+}
+
+void ofSaveImage(const ofFloatPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
+	saveImage(pix,buffer,format,qualityLevel);
+}
+
+void ofSaveImage(const ofShortPixelsView & pix, ofBuffer & buffer, ofImageFormat format, ofImageQualityType qualityLevel) {
 	saveImage(pix,buffer,format,qualityLevel);
 }
 
@@ -624,11 +834,17 @@ bool ofImage_<PixelType>::loadImage(const ofFile & file){
 //----------------------------------------------------------
 template<typename PixelType>
 bool ofImage_<PixelType>::load(string fileName){
+	return load(fileName, ofImageLoadSettings());
+}
+
+//----------------------------------------------------------
+template<typename PixelType>
+bool ofImage_<PixelType>::load(string fileName, const ofImageLoadSettings & settings){
 	#if defined(TARGET_ANDROID)
 	ofAddListener(ofxAndroidEvents().unloadGL,this,&ofImage_<PixelType>::unloadTexture);
 	ofAddListener(ofxAndroidEvents().reloadGL,this,&ofImage_<PixelType>::update);
 	#endif
-	bool bLoadedOk = ofLoadImage(pixels, fileName);
+	bool bLoadedOk = ofLoadImage(pixels, fileName, settings);
 	if (!bLoadedOk) {
 		ofLogError("ofImage") << "loadImage(): couldn't load image from \"" << fileName << "\"";
 		clear();
@@ -647,11 +863,17 @@ bool ofImage_<PixelType>::loadImage(string fileName){
 //----------------------------------------------------------
 template<typename PixelType>
 bool ofImage_<PixelType>::load(const ofBuffer & buffer){
+	return load(buffer, ofImageLoadSettings());
+}
+
+//----------------------------------------------------------
+template<typename PixelType>
+bool ofImage_<PixelType>::load(const ofBuffer & buffer, const ofImageLoadSettings & settings){
 	#if defined(TARGET_ANDROID)
 	ofAddListener(ofxAndroidEvents().unloadGL,this,&ofImage_<PixelType>::unloadTexture);
 	ofAddListener(ofxAndroidEvents().reloadGL,this,&ofImage_<PixelType>::update);
 	#endif
-	bool bLoadedOk = ofLoadImage(pixels, buffer);
+	bool bLoadedOk = ofLoadImage(pixels, buffer, settings);
 	if (!bLoadedOk) {
 		ofLogError("ofImage") << "loadImage(): couldn't load image from ofBuffer";
 		clear();
@@ -1013,6 +1235,15 @@ void ofImage_<PixelType>::resize(int newWidth, int newHeight){
 	update();
 }
 
+//------------------------------------
+template<typename PixelType>
+void ofImage_<PixelType>::resize(int newWidth, int newHeight, ofInterpolationMethod interpolation){
+	if(newWidth == width && newHeight == height) return;
+
+	pixels.resize(newWidth, newHeight, interpolation);
+	update();
+}
+
 
 //------------------------------------
 template<typename PixelType>
@@ -68,17 +68,57 @@ enum ofImageFormat {
 //----------------------------------------------------
 // FreeImage based stuff
 
+/// \brief Options to load a smaller version of an image than the stored one.
+///
+/// Loading a thumbnail this way is much cheaper than loading the whole image
+/// and resizing it: jpegs are decoded directly at a fraction of their size
+/// and a thumbnail embedded in the file is used when it's big enough.
+///
+/// ~~~~{.cpp}
+/// ofLoadImage(pixels, "photo.jpg", ofImageLoadSettings(256, 256));
+/// ~~~~
+class ofImageLoadSettings{
+public:
+	ofImageLoadSettings();
+	ofImageLoadSettings(int maxWidth, int maxHeight);
+
+	/// \brief The image is scaled down keeping its aspect ratio to fit in
+	/// maxWidth x maxHeight, 0 means no limit
+	int maxWidth;
+	int maxHeight;
+
+	/// \brief Scale applied to the size of the stored image before fitting it
+	/// in maxWidth x maxHeight, only values smaller than 1 have any effect
+	float scale;
+
+	/// \brief Use a thumbnail embedded in the file, the exif thumbnail of a
+	/// jpeg or the preview of a raw file, if it's at least the requested size.
+	/// true by default
+	bool useEmbeddedThumbnail;
+
+	/// \brief Resize the decoded image to exactly the requested size. If false
+	/// the image is returned at the size the decoder produced, which can be up
+	/// to twice as big. true by default
+	bool exactSize;
+};
+
 /// \todo
 bool ofLoadImage(ofPixels & pix, string path);
 bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer);
+bool ofLoadImage(ofPixels & pix, string path, const ofImageLoadSettings & settings);
+bool ofLoadImage(ofPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings);
 
 /// \todo
 bool ofLoadImage(ofFloatPixels & pix, string path);
 bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer);
+bool ofLoadImage(ofFloatPixels & pix, string path, const ofImageLoadSettings & settings);
+bool ofLoadImage(ofFloatPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings);
 
 /// \todo
 bool ofLoadImage(ofShortPixels & pix, string path);
 bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer);
+bool ofLoadImage(ofShortPixels & pix, string path, const ofImageLoadSettings & settings);
+bool ofLoadImage(ofShortPixels & pix, const ofBuffer & buffer, const ofImageLoadSettings & settings);
 
 /// \todo
 bool ofLoadImage(ofTexture & tex, string path);
@@ -96,6 +136,18 @@ void ofSaveImage(ofFloatPixels & pix, ofBuffer & buffer, ofImageFormat format =
 void ofSaveImage(ofShortPixels & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 void ofSaveImage(ofShortPixels & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
 
+/// \brief Save the pixels referenced by a view without copying them first
+void ofSaveImage(const ofPixelsView & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+void ofSaveImage(const ofPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
+/// \brief Save the pixels referenced by a view without copying them first
+void ofSaveImage(const ofFloatPixelsView & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+void ofSaveImage(const ofFloatPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
+/// \brief Save the pixels referenced by a view without copying them first
+void ofSaveImage(const ofShortPixelsView & pix, string path, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+void ofSaveImage(const ofShortPixelsView & pix, ofBuffer & buffer, ofImageFormat format = OF_IMAGE_FORMAT_PNG, ofImageQualityType qualityLevel = OF_IMAGE_QUALITY_BEST);
+
 // when we exit, we shut down ofImage
 /// \todo
 void ofCloseFreeImage();
@@ -179,6 +231,13 @@ public:
     /// This actually loads the image data into an ofPixels object and then
     /// into the texture.
     bool load(const ofFile & file);
+
+    /// \brief Loads a smaller version of an image, for example a thumbnail,
+    /// without decoding it at full size when possible.
+    ///
+    /// \sa ofImageLoadSettings
+    bool load(string fileName, const ofImageLoadSettings & settings);
+    bool load(const ofBuffer & buffer, const ofImageLoadSettings & settings);
     
     OF_DEPRECATED_MSG("Use load instead",bool loadImage(string fileName));
     OF_DEPRECATED_MSG("Use load instead",bool loadImage(const ofBuffer & buffer));
@@ -464,6 +523,18 @@ public:
     /// \param newWidth New width of image.
     /// \param newHeight New height of image.
     void resize(int newWidth, int newHeight);
+
+    /// \brief Resizes the image to a new size (w, h) using ofPixels_::resize
+    /// instead of FreeImage.
+    ///
+    /// Unlike resize(int, int) this runs in parallel when
+    /// ofEnablePixelsThreads() has been called.
+    ///
+    /// \param newWidth New width of image.
+    /// \param newHeight New height of image.
+    /// \param interpolation Interpolation method to use.
+    /// \sa ofPixels_::resize
+    void resize(int newWidth, int newHeight, ofInterpolationMethod interpolation);
     
     /// \brief This crops the image to the w,h passed in from the x,y position.
     ///
@@ -0,0 +1,428 @@
+#include "ofImageSequenceWriter.h"
+#include "ofUtils.h"
+#include "ofFileUtils.h"
+#include "ofLog.h"
+#include "FreeImage.h"
+#include "Poco/Environment.h"
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+
+void ofInitFreeImage(bool deinit);
+
+//----------------------------------------------------
+// true if pattern has exactly one printf conversion and it takes an int,
+// anything else would read arguments write() doesn't pass. %% is allowed
+static bool isFrameNumberPattern(const string & pattern){
+	int numConversions = 0;
+	for(size_t i = 0; i < pattern.size(); i++){
+		if(pattern[i] != '%') continue;
+		i++;
+		if(i < pattern.size() && pattern[i] == '%') continue;
+		while(i < pattern.size() && strchr("-+ #0", pattern[i]) != NULL) i++;
+		while(i < pattern.size() && isdigit((unsigned char)pattern[i])) i++;
+		if(i < pattern.size() && pattern[i] == '.'){
+			i++;
+			while(i < pattern.size() && isdigit((unsigned char)pattern[i])) i++;
+		}
+		if(i == pattern.size() || strchr("diouxX", pattern[i]) == NULL){
+			return false;
+		}
+		numConversions++;
+	}
+	return numConversions == 1;
+}
+
+//----------------------------------------------------
+// encoding thread, keeps the bitmap and the memory stream it encodes into
+// from one frame to the next
+class ofImageSequenceWriter::Worker: public ofThread{
+public:
+	Worker(ofImageSequenceWriter & writer)
+	:writer(writer)
+	,bmp(NULL)
+	,hmem(NULL){}
+
+	~Worker(){
+		if(bmp != NULL){
+			FreeImage_Unload(bmp);
+		}
+		if(hmem != NULL){
+			FreeImage_CloseMemory(hmem);
+		}
+	}
+
+	void threadedFunction(){
+		thread.setName("ofImageSequenceWriter " + thread.name());
+		writer.encodeLoop(*this);
+	}
+
+	// encodes pixels into hmem, returns the size of the encoded image or 0
+	size_t encode(const ofPixels & pixels, FREE_IMAGE_FORMAT fif, int flags){
+		int width = pixels.getWidth();
+		int height = pixels.getHeight();
+		int srcChannels = pixels.getNumChannels();
+		ofPixelFormat format = pixels.getPixelFormat();
+		if(format != OF_PIXELS_GRAY && format != OF_PIXELS_RGB && format != OF_PIXELS_BGR
+				&& format != OF_PIXELS_RGBA && format != OF_PIXELS_BGRA){
+			ofLogError("ofImageSequenceWriter") << "can't encode pixels with format " << format;
+			return 0;
+		}
+		// jpegs can't store alpha
+		int channels = fif == FIF_JPEG ? MIN(srcChannels, 3) : srcChannels;
+
+		if(bmp == NULL || (int)FreeImage_GetWidth(bmp) != width || (int)FreeImage_GetHeight(bmp) != height
+				|| (int)FreeImage_GetBPP(bmp) != channels * 8){
+			if(bmp != NULL){
+				FreeImage_Unload(bmp);
+			}
+			bmp = FreeImage_Allocate(width, height, channels * 8);
+			if(bmp == NULL){
+				return 0;
+			}
+		}
+
+		// FreeImage expects BGR order on little endian
+#ifdef TARGET_LITTLE_ENDIAN
+		bool swapRgb = format == OF_PIXELS_RGB || format == OF_PIXELS_RGBA;
+#else
+		bool swapRgb = format == OF_PIXELS_BGR || format == OF_PIXELS_BGRA;
+#endif
+		int srcStride = pixels.getBytesStride();
+		const unsigned char * src = pixels.getData();
+		for(int y = 0; y < height; y++, src += srcStride){
+			// ofPixels are top left, FIBITMAP is bottom left
+			unsigned char * dst = FreeImage_GetScanLine(bmp, height - 1 - y);
+			if(channels == srcChannels && (channels == 1 || !swapRgb)){
+				memcpy(dst, src, width * channels);
+			}else{
+				int r = swapRgb ? 2 : 0;
+				int b = swapRgb ? 0 : 2;
+				for(int x = 0; x < width; x++){
+					const unsigned char * s = src + x * srcChannels;
+					unsigned char * d = dst + x * channels;
+					d[0] = s[r];
+					d[1] = s[1];
+					d[2] = s[b];
+					if(channels == 4){
+						d[3] = s[3];
+					}
+				}
+			}
+		}
+
+		// the stream is reused for formats that are written sequentially,
+		// its length then includes older bigger frames so the size is
+		// where the encoder stopped writing
+		bool reuseMemory = fif == FIF_PNG || fif == FIF_JPEG || fif == FIF_BMP;
+		if(hmem != NULL && reuseMemory){
+			FreeImage_SeekMemory(hmem, 0, SEEK_SET);
+		}else{
+			if(hmem != NULL){
+				FreeImage_CloseMemory(hmem);
+			}
+			hmem = FreeImage_OpenMemory();
+		}
+		if(!FreeImage_SaveToMemory(fif, bmp, hmem, flags)){
+			return 0;
+		}
+		if(reuseMemory){
+			return FreeImage_TellMemory(hmem);
+		}else{
+			unsigned char * data;
+			return acquireMemory(data);
+		}
+	}
+
+	const unsigned char * getData(){
+		unsigned char * data;
+		acquireMemory(data);
+		return data;
+	}
+
+private:
+	size_t acquireMemory(unsigned char *& data){
+#ifdef TARGET_WIN32
+		DWORD size = 0;
+#else
+		uint32_t size = 0;
+#endif
+		data = NULL;
+		FreeImage_AcquireMemory(hmem, &data, &size);
+		return size;
+	}
+
+	ofImageSequenceWriter & writer;
+	FIBITMAP * bmp;
+	FIMEMORY * hmem;
+};
+
+//----------------------------------------------------
+ofImageSequenceWriter::Frame::Frame()
+:index(0){
+
+}
+
+//----------------------------------------------------
+ofImageSequenceWriter::Frame::Frame(Frame && frame)
+:index(frame.index){
+	pixels.swap(frame.pixels);
+	path.swap(frame.path);
+}
+
+//----------------------------------------------------
+ofImageSequenceWriter::Frame & ofImageSequenceWriter::Frame::operator=(Frame && frame){
+	pixels.swap(frame.pixels);
+	path.swap(frame.path);
+	index = frame.index;
+	return *this;
+}
+
+//----------------------------------------------------
+ofImageSequenceWriter::ofImageSequenceWriter()
+:fif(FIF_UNKNOWN)
+,jpegQuality(90)
+,pngCompression(6)
+,blocking(true)
+,nextIndex(0)
+,nextToWrite(0)
+,encodeTime(0)
+,startTime(0)
+,lastWriteTime(0)
+,numWritten(0)
+,numDropped(0){
+
+}
+
+//----------------------------------------------------
+ofImageSequenceWriter::~ofImageSequenceWriter(){
+	close();
+}
+
+//----------------------------------------------------
+bool ofImageSequenceWriter::setup(const string & _pathPattern, int numThreads, size_t maxQueuedFrames){
+	close();
+	ofInitFreeImage(false);
+
+	fif = FreeImage_GetFIFFromFilename(_pathPattern.c_str());
+	if(fif == FIF_UNKNOWN || !FreeImage_FIFSupportsWriting((FREE_IMAGE_FORMAT)fif)){
+		ofLogError("ofImageSequenceWriter") << "setup(): can't write images with the extension of \"" << _pathPattern << "\"";
+		return false;
+	}
+	if(numThreads <= 0){
+		numThreads = MAX(Poco::Environment::processorCount(), 1);
+	}
+	if(maxQueuedFrames == 0){
+		maxQueuedFrames = numThreads * 2;
+	}
+
+	pathPattern = ofToDataPath(_pathPattern);
+	if(!isFrameNumberPattern(pathPattern)){
+		ofLogError("ofImageSequenceWriter") << "setup(): \"" << pathPattern << "\" needs exactly one integer conversion like %05d for the frame number, other % have to be written as %%";
+		return false;
+	}
+	ofFilePath::createEnclosingDirectory(pathPattern, false);
+
+	nextIndex = 0;
+	nextToWrite = 0;
+	encodeTime = 0;
+	startTime = 0;
+	lastWriteTime = 0;
+	numWritten = 0;
+	numDropped = 0;
+	frames.reset(new ofBoundedThreadChannel<Frame>(maxQueuedFrames, blocking ? OF_THREAD_CHANNEL_BLOCK : OF_THREAD_CHANNEL_FAIL));
+	for(int i = 0; i < numThreads; i++){
+		workers.push_back(unique_ptr<Worker>(new Worker(*this)));
+		workers.back()->startThread();
+	}
+	return true;
+}
+
+//----------------------------------------------------
+void ofImageSequenceWriter::setJpegQuality(int quality){
+	jpegQuality = MIN(MAX(quality, 1), 100);
+}
+
+//----------------------------------------------------
+void ofImageSequenceWriter::setPngCompression(int level){
+	pngCompression = MIN(MAX(level, 0), 9);
+}
+
+//----------------------------------------------------
+void ofImageSequenceWriter::setBlocking(bool _blocking){
+	blocking = _blocking;
+}
+
+//----------------------------------------------------
+bool ofImageSequenceWriter::write(ofPixels && pixels){
+	if(!queue(pixels)){
+		return false;
+	}
+	// give back the buffer of a written frame to read the next one into
+	ofScopedLock lock(mutex);
+	if(!spare.empty()){
+		pixels.swap(spare.back());
+		spare.pop_back();
+	}
+	return true;
+}
+
+//----------------------------------------------------
+bool ofImageSequenceWriter::write(const ofPixels & pixels){
+	ofPixels copy;
+	{
+		ofScopedLock lock(mutex);
+		if(!spare.empty()){
+			copy.swap(spare.back());
+			spare.pop_back();
+		}
+	}
+	copy = pixels;
+	return queue(copy);
+}
+
+//----------------------------------------------------
+bool ofImageSequenceWriter::queue(ofPixels & pixels){
+	if(!frames){
+		ofLogError("ofImageSequenceWriter") << "write(): call setup() first";
+		return false;
+	}
+	if(!pixels.isAllocated()){
+		ofLogError("ofImageSequenceWriter") << "write(): pixels are not allocated";
+		return false;
+	}
+
+	Frame frame;
+	{
+		ofScopedLock lock(mutex);
+		frame.index = nextIndex++;
+		if(startTime == 0){
+			startTime = ofGetElapsedTimeMicros();
+		}
+	}
+	frame.path = ofVAArgsToString(pathPattern.c_str(), (int)frame.index);
+	frame.pixels.swap(pixels);
+	if(frames->send(std::move(frame))){
+		return true;
+	}
+
+	// the queue is full or closed, the frame keeps its pixels
+	pixels.swap(frame.pixels);
+	ofScopedLock lock(mutex);
+	nextIndex--;
+	numDropped++;
+	return false;
+}
+
+//----------------------------------------------------
+void ofImageSequenceWriter::encodeLoop(Worker & worker){
+	Frame frame;
+	while(frames->receive(frame)){
+		int flags = 0;
+		if(fif == FIF_JPEG){
+			flags = jpegQuality;
+		}else if(fif == FIF_PNG){
+			flags = pngCompression == 0 ? PNG_Z_NO_COMPRESSION : pngCompression;
+		}
+		unsigned long long start = ofGetElapsedTimeMicros();
+		size_t size = worker.encode(frame.pixels, (FREE_IMAGE_FORMAT)fif, flags);
+		float encodeMillis = (ofGetElapsedTimeMicros() - start) / 1000.f;
+
+		// wait for the frames before this one to be written
+		mutex.lock();
+		while(nextToWrite != frame.index){
+			frameWritten.wait(mutex);
+		}
+		mutex.unlock();
+
+		bool written = false;
+		if(size > 0){
+			FILE * file = fopen(frame.path.c_str(), "wb");
+			if(file != NULL){
+				written = fwrite(worker.getData(), 1, size, file) == size;
+				written &= fclose(file) == 0;
+			}
+			if(!written){
+				ofLogError("ofImageSequenceWriter") << "couldn't write \"" << frame.path << "\"";
+			}
+		}else{
+			ofLogError("ofImageSequenceWriter") << "couldn't encode \"" << frame.path << "\"";
+		}
+
+		finishFrame(frame, written, encodeMillis);
+	}
+}
+
+//----------------------------------------------------
+void ofImageSequenceWriter::finishFrame(Frame & frame, bool written, float encodeMillis){
+	ofScopedLock lock(mutex);
+	encodeTime = encodeTime == 0 ? encodeMillis : encodeTime * 0.9f + encodeMillis * 0.1f;
+	if(written){
+		numWritten++;
+	}else{
+		numDropped++;
+	}
+	lastWriteTime = ofGetElapsedTimeMicros();
+	if(spare.size() < frames->capacity()){
+		spare.push_back(ofPixels());
+		spare.back().swap(frame.pixels);
+	}
+	nextToWrite++;
+	frameWritten.broadcast();
+}
+
+//----------------------------------------------------
+void ofImageSequenceWriter::close(){
+	if(!frames){
+		return;
+	}
+	{
+		ofScopedLock lock(mutex);
+		while(nextToWrite < nextIndex){
+			frameWritten.wait(mutex);
+		}
+	}
+	frames->close();
+	for(size_t i = 0; i < workers.size(); i++){
+		workers[i]->waitForThread(true);
+	}
+	workers.clear();
+	frames.reset();
+	spare.clear();
+}
+
+//----------------------------------------------------
+bool ofImageSequenceWriter::isSetup() const{
+	return frames != nullptr;
+}
+
+//----------------------------------------------------
+size_t ofImageSequenceWriter::getNumFramesQueued() const{
+	ofScopedLock lock(mutex);
+	return nextIndex - nextToWrite;
+}
+
+//----------------------------------------------------
+uint64_t ofImageSequenceWriter::getNumFramesWritten() const{
+	return numWritten;
+}
+
+//----------------------------------------------------
+uint64_t ofImageSequenceWriter::getNumFramesDropped() const{
+	return numDropped;
+}
+
+//----------------------------------------------------
+float ofImageSequenceWriter::getEncodeTime() const{
+	ofScopedLock lock(mutex);
+	return encodeTime;
+}
+
+//----------------------------------------------------
+float ofImageSequenceWriter::getFramesPerSecond() const{
+	ofScopedLock lock(mutex);
+	if(lastWriteTime <= startTime){
+		return 0;
+	}
+	return numWritten / ((lastWriteTime - startTime) / 1000000.f);
+}
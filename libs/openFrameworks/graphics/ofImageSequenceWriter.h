@@ -0,0 +1,127 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofPixels.h"
+#include "ofThread.h"
+#include "ofThreadChannel.h"
+#include "Poco/Condition.h"
+#include <atomic>
+
+/// \brief Encodes frames into numbered image files on a pool of threads.
+///
+/// Frames are queued by write(), which moves the pixels instead of copying
+/// them, and encoded in parallel by the worker threads. Each worker keeps
+/// its encoder bitmap and memory stream between frames, and the files are
+/// written to disk in the order the frames were queued. At most
+/// maxQueuedFrames frames wait to be encoded, so recording faster than the
+/// disk can keep up blocks or drops frames instead of using more memory.
+///
+/// ~~~~{.cpp}
+/// void ofApp::setup(){
+///     writer.setup("capture/frame_%05d.png");
+///     writer.setPngCompression(1);
+/// }
+///
+/// void ofApp::draw(){
+///     ...
+///     fbo.readToPixels(pixels);
+///     writer.write(std::move(pixels));
+/// }
+/// ~~~~
+class ofImageSequenceWriter{
+public:
+	ofImageSequenceWriter();
+	~ofImageSequenceWriter();
+
+	/// \brief Starts a new sequence.
+	///
+	/// \param pathPattern printf style pattern for the path of each frame
+	/// with one integer for the frame number, like "frames/%05d.jpg". Any
+	/// other % has to be written as %%. The extension selects the image
+	/// format.
+	/// \param numThreads Number of encoding threads, 0 uses one per core.
+	/// \param maxQueuedFrames Frames waiting to be encoded before write()
+	/// blocks or drops them, 0 uses twice the number of threads.
+	/// \returns false if the format can't be written or the pattern
+	/// doesn't have exactly one integer conversion.
+	bool setup(const string & pathPattern, int numThreads = 0, size_t maxQueuedFrames = 0);
+
+	/// \brief Quality of jpeg frames from 1 to 100, 90 by default.
+	void setJpegQuality(int quality);
+
+	/// \brief zlib compression level of png frames from 0, no compression,
+	/// to 9, smallest files. Lower levels are much faster to encode. 6 by
+	/// default.
+	void setPngCompression(int level);
+
+	/// \brief If false, write() drops the frame when maxQueuedFrames are
+	/// waiting instead of waiting for one of them to be encoded. true by
+	/// default, has to be called before setup().
+	void setBlocking(bool blocking);
+
+	/// \brief Queues a frame to be encoded.
+	///
+	/// The pixels are moved into the queue without copying them. In
+	/// exchange pixels gets the buffer of an already written frame, when
+	/// there's one, so reading every frame into the same ofPixels doesn't
+	/// allocate. Should be called from one thread only.
+	/// \returns false if the frame was dropped or the writer isn't setup.
+	bool write(ofPixels && pixels);
+
+	/// \brief Queues a copy of the pixels.
+	bool write(const ofPixels & pixels);
+
+	/// \brief Waits until every queued frame is written to disk and stops
+	/// the threads.
+	void close();
+
+	bool isSetup() const;
+
+	/// \brief Frames queued or being encoded.
+	size_t getNumFramesQueued() const;
+	uint64_t getNumFramesWritten() const;
+	/// \brief Frames dropped because the queue was full or that couldn't be
+	/// encoded or written.
+	uint64_t getNumFramesDropped() const;
+	/// \brief Moving average of the time to encode a frame in ms.
+	float getEncodeTime() const;
+	/// \brief Frames written per second since the first frame was queued.
+	float getFramesPerSecond() const;
+
+private:
+	class Worker;
+	struct Frame{
+		Frame();
+		Frame(Frame && frame);
+		Frame & operator=(Frame && frame);
+		ofPixels pixels;
+		string path;
+		uint64_t index;
+	};
+
+	bool queue(ofPixels & pixels);
+	void encodeLoop(Worker & worker);
+	void finishFrame(Frame & frame, bool written, float encodeMillis);
+
+	string pathPattern;
+	int fif;
+	int jpegQuality;
+	int pngCompression;
+	bool blocking;
+
+	unique_ptr<ofBoundedThreadChannel<Frame> > frames;
+	vector<unique_ptr<Worker> > workers;
+
+	// frames are written to disk when nextToWrite reaches their index
+	mutable ofMutex mutex;
+	Poco::Condition frameWritten;
+	uint64_t nextIndex;
+	uint64_t nextToWrite;
+	vector<ofPixels> spare;
+	float encodeTime;
+	unsigned long long startTime;
+	unsigned long long lastWriteTime;
+
+	std::atomic<uint64_t> numWritten;
+	std::atomic<uint64_t> numDropped;
+};
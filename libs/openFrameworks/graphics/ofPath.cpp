@@ -1,6 +1,29 @@
 #include "ofPath.h"
 #include "ofAppRunner.h"
 #include "ofTessellator.h"
+#include "ofThreadPool.h"
+#include <map>
+
+//----------------------------------------------------------
+// FNV-1a of the polylines, used to find the groups that changed
+static const uint64_t pathHashSeed = 14695981039346656037ULL;
+
+static uint64_t pathHash(const void * data, size_t size, uint64_t hash){
+	const unsigned char * bytes = (const unsigned char *)data;
+	for(size_t i = 0; i < size; i++){
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+static uint64_t pathHash(const ofPolyline & polyline, uint64_t hash){
+	if(polyline.size()){
+		hash = pathHash(&polyline.getVertices()[0], polyline.size() * sizeof(ofPoint), hash);
+	}
+	bool closed = polyline.isClosed();
+	return pathHash(&closed, sizeof(closed), hash);
+}
 
 ofPath::Command::Command(Type type)
 :type(type){
@@ -46,6 +69,8 @@ ofPath::ofPath(){
 	bHasChanged = false;
 	bUseShapeColor = true;
 	bNeedsPolylinesGeneration = false;
+	cachedTessellationValid = false;
+	tessellatedContourHash = 0;
 	clear();
 }
 
@@ -530,16 +555,144 @@ void ofPath::generatePolylinesFromCommands(){
 	}
 }
 
+//----------------------------------------------------------
+void ofPath::tessellateFill(){
+	// sub paths whose bounding boxes don't overlap can't change each other's
+	// winding, group the ones that do with a union find over a sweep of the
+	// boxes sorted by their left side. Paths that aren't flat in z are
+	// projected by the tessellator in ways the boxes don't account for, so
+	// they are always tessellated in one group
+	vector<size_t> contours;
+	vector<ofRectangle> bounds(polylines.size());
+	bool flat = true;
+	float z = 0;
+	for(size_t i = 0; i < polylines.size(); i++){
+		if(polylines[i].size()){
+			bounds[i] = polylines[i].getBoundingBox();
+			contours.push_back(i);
+			if(contours.size() == 1){
+				z = polylines[i][0].z;
+			}
+			for(size_t j = 0; j < polylines[i].size() && flat; j++){
+				flat = polylines[i][j].z == z;
+			}
+		}
+	}
+	if(!flat){
+		for(size_t i = 0; i < bounds.size(); i++){
+			bounds[i].set(0, 0, 0, 0);
+		}
+	}
+
+	struct LeftOf{
+		const vector<ofRectangle> * bounds;
+		bool operator()(size_t a, size_t b) const{
+			return (*bounds)[a].getLeft() < (*bounds)[b].getLeft();
+		}
+	};
+	LeftOf leftOf;
+	leftOf.bounds = &bounds;
+	std::sort(contours.begin(), contours.end(), leftOf);
+
+	vector<size_t> parent(polylines.size());
+	for(size_t i = 0; i < parent.size(); i++){
+		parent[i] = i;
+	}
+	vector<size_t> active;
+	for(size_t i = 0; i < contours.size(); i++){
+		const ofRectangle & r = bounds[contours[i]];
+		size_t numActive = 0;
+		for(size_t j = 0; j < active.size(); j++){
+			const ofRectangle & other = bounds[active[j]];
+			if(other.getRight() < r.getLeft()){
+				continue;
+			}
+			active[numActive++] = active[j];
+			if(other.getTop() <= r.getBottom() && r.getTop() <= other.getBottom()){
+				size_t a = contours[i];
+				size_t b = active[j];
+				while(parent[a] != a) a = parent[a] = parent[parent[a]];
+				while(parent[b] != b) b = parent[b] = parent[parent[b]];
+				parent[MAX(a, b)] = MIN(a, b);
+			}
+		}
+		active.resize(numActive);
+		active.push_back(contours[i]);
+	}
+
+	// the polylines of each group in their original order
+	map<size_t, vector<size_t> > groups;
+	for(size_t i = 0; i < polylines.size(); i++){
+		if(polylines[i].size()){
+			size_t root = i;
+			while(parent[root] != root) root = parent[root];
+			groups[root].push_back(i);
+		}
+	}
+
+	map<uint64_t, size_t> previous;
+	for(size_t i = 0; i < tessellationGroups.size(); i++){
+		previous[tessellationGroups[i].hash] = i;
+	}
+	vector<TessellationGroup> newGroups(groups.size());
+	vector<ofPolyline> groupPolylines;
+	size_t numGroup = 0;
+	for(map<size_t, vector<size_t> >::iterator it = groups.begin(); it != groups.end(); ++it, ++numGroup){
+		TessellationGroup & group = newGroups[numGroup];
+		group.hash = pathHash(&windingMode, sizeof(windingMode), pathHashSeed);
+		for(size_t i = 0; i < it->second.size(); i++){
+			group.hash = pathHash(polylines[it->second[i]], group.hash);
+		}
+		map<uint64_t, size_t>::iterator found = previous.find(group.hash);
+		if(found != previous.end()){
+			ofMesh & cached = tessellationGroups[found->second].mesh;
+			group.mesh.getVertices().swap(cached.getVertices());
+			group.mesh.getIndices().swap(cached.getIndices());
+			previous.erase(found);
+		}else if(groups.size() == 1){
+			tessellator.tessellateToMesh(polylines, windingMode, group.mesh);
+		}else{
+			groupPolylines.clear();
+			for(size_t i = 0; i < it->second.size(); i++){
+				groupPolylines.push_back(polylines[it->second[i]]);
+			}
+			tessellator.tessellateToMesh(groupPolylines, windingMode, group.mesh);
+		}
+	}
+	tessellationGroups.swap(newGroups);
+
+	size_t numVertices = 0;
+	size_t numIndices = 0;
+	for(size_t i = 0; i < tessellationGroups.size(); i++){
+		numVertices += tessellationGroups[i].mesh.getNumVertices();
+		numIndices += tessellationGroups[i].mesh.getNumIndices();
+	}
+	cachedTessellation.clear();
+	cachedTessellation.getVertices().reserve(numVertices);
+	cachedTessellation.getIndices().reserve(numIndices);
+	for(size_t i = 0; i < tessellationGroups.size(); i++){
+		cachedTessellation.append(tessellationGroups[i].mesh);
+	}
+	cachedTessellation.setMode(OF_PRIMITIVE_TRIANGLES);
+}
+
 //----------------------------------------------------------
 void ofPath::tessellate(){
 	generatePolylinesFromCommands();
 	if(!bNeedsTessellation) return;
 	if(bFill){
-		tessellator.tessellateToMesh( polylines, windingMode, cachedTessellation);
+		tessellateFill();
 		cachedTessellationValid=true;
 	}
 	if(hasOutline() && windingMode!=OF_POLY_WINDING_ODD){
-		tessellator.tessellateToPolylines( polylines, windingMode, tessellatedContour);
+		uint64_t hash = pathHash(&windingMode, sizeof(windingMode), pathHashSeed);
+		for(size_t i = 0; i < polylines.size(); i++){
+			hash = pathHash(polylines[i], hash);
+		}
+		if(hash != tessellatedContourHash || tessellatedContour.empty()){
+			tessellator.tessellateToPolylines( polylines, windingMode, tessellatedContour);
+			tessellatedContourHash = hash;
+		}
 	}
 	bNeedsTessellation = false;
 }
@@ -778,3 +931,34 @@ void ofPath::addCommand(const ofPath::Command & command){
 	}
 	commands.push_back(command);
 }
+
+//----------------------------------------------------------
+class ofPathTessellationJob: public ofParallelJob{
+public:
+	ofPathTessellationJob(const vector<ofPath*> & paths)
+	:paths(paths){}
+
+	void run(size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			paths[i]->tessellate();
+		}
+	}
+
+	const vector<ofPath*> & paths;
+};
+
+//----------------------------------------------------------
+void ofTessellatePaths(const vector<ofPath*> & paths){
+	// one path per chunk, paths can take very different times
+	ofPathTessellationJob job(paths);
+	ofParallelFor(job, 0, paths.size(), 1);
+}
+
+//----------------------------------------------------------
+void ofTessellatePaths(vector<ofPath> & paths){
+	vector<ofPath*> pointers(paths.size());
+	for(size_t i = 0; i < paths.size(); i++){
+		pointers[i] = &paths[i];
+	}
+	ofTessellatePaths(pointers);
+}
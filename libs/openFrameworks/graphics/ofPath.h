@@ -303,6 +303,13 @@ public:
 	vector<ofPolyline> & getOutline();
 	const vector<ofPolyline> & getOutline() const;
 
+	/// \brief Tessellates the path if it has changed since the last call.
+	///
+	/// Sub paths whose bounding boxes don't overlap can't affect each other,
+	/// so they are tessellated in separate groups. The result of each group
+	/// is cached along with a hash of its vertices and only the groups that
+	/// changed are tessellated again, even if the path was cleared and
+	/// rebuilt with the same commands.
 	void tessellate();
 
 	ofMesh & getTessellation();
@@ -379,6 +386,7 @@ private:
 	ofPolyline & lastPolyline();
 	void addCommand(const Command & command);
 	void generatePolylinesFromCommands();
+	void tessellateFill();
 
 	// path description
 	//vector<ofSubPath>		paths;
@@ -401,6 +409,15 @@ private:
 #endif
 	bool				cachedTessellationValid;
 
+	// fill tessellation of each group of overlapping polylines and hash of
+	// their vertices, reused while the group doesn't change
+	struct TessellationGroup{
+		uint64_t hash;
+		ofMesh mesh;
+	};
+	vector<TessellationGroup> tessellationGroups;
+	uint64_t			tessellatedContourHash;
+
 	ofTessellator tessellator;
 
 	bool				bHasChanged;
@@ -413,4 +430,12 @@ private:
 	Mode				mode;
 };
 
-
+/// \brief Tessellates many paths in parallel.
+///
+/// Each path has its own tessellator, so independent paths can be
+/// tessellated at the same time on the threads of the global
+/// ofThreadPool. Call it before
+/// drawing a large number of paths, like the ones loaded from an SVG, so
+/// drawing them only needs to upload their cached meshes.
+void ofTessellatePaths(vector<ofPath> & paths);
+void ofTessellatePaths(const vector<ofPath*> & paths);
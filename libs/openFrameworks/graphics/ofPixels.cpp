@@ -1,5 +1,7 @@
 #include "ofPixels.h"
 #include "ofMath.h"
+#include "ofPixelsPool.h"
+#include "ofThreadPool.h"
 
 
 static ofImageType getImageTypeFromChannels(int channels){
@@ -101,6 +103,69 @@ static int channelsFromPixelFormat(ofPixelFormat format){
 	}
 }
 
+// offset in components, size and format of one plane of an image. formats
+// with only one plane return the whole image for any plane
+static bool getPlaneLayout(int width, int height, ofPixelFormat format, int plane, size_t & offset, int & planeWidth, int & planeHeight, ofPixelFormat & planeFormat){
+	offset = 0;
+	planeWidth = width;
+	planeHeight = height;
+	planeFormat = format;
+	switch(format){
+		case OF_PIXELS_RGB:
+		case OF_PIXELS_BGR:
+		case OF_PIXELS_RGB565:
+		case OF_PIXELS_RGBA:
+		case OF_PIXELS_BGRA:
+		case OF_PIXELS_GRAY:
+		case OF_PIXELS_GRAY_ALPHA:
+		case OF_PIXELS_YUY2:
+		case OF_PIXELS_UYVY:
+		case OF_PIXELS_Y:
+		case OF_PIXELS_U:
+		case OF_PIXELS_V:
+		case OF_PIXELS_UV:
+		case OF_PIXELS_VU:
+			return true;
+		case OF_PIXELS_NV12:
+		case OF_PIXELS_NV21:
+		case OF_PIXELS_YV12:
+		case OF_PIXELS_I420:
+			break;
+		default:
+			return false;
+	}
+
+	if(plane<=0){
+		planeFormat = OF_PIXELS_Y;
+		return true;
+	}
+
+	planeWidth = width/2;
+	planeHeight = height/2;
+	offset = size_t(width)*height;
+	switch(format){
+		case OF_PIXELS_NV12:
+			planeFormat = OF_PIXELS_UV;
+			return plane==1;
+		case OF_PIXELS_NV21:
+			planeFormat = OF_PIXELS_VU;
+			return plane==1;
+		case OF_PIXELS_YV12:
+		case OF_PIXELS_I420:
+			if(plane==2){
+				offset += size_t(width/2)*(height/2);
+			}
+			if(format==OF_PIXELS_I420){
+				planeFormat = plane==1 ? OF_PIXELS_U : OF_PIXELS_V;
+			}else{
+				planeFormat = plane==1 ? OF_PIXELS_V : OF_PIXELS_U;
+			}
+			return plane==1 || plane==2;
+		default:
+			return false;
+	}
+}
+
 static ofPixelFormat ofPixelFormatFromImageType(ofImageType type){
 	switch(type){
 	case OF_IMAGE_GRAYSCALE:
@@ -180,10 +245,821 @@ static ofPixelFormat pixelFormatFromNumChannels(int channels){
 	}
 }
 
+//----------------------------------------------------------------------
+// SIMD kernels
+//
+// mirroring, rotating and nearest neighbor resizing only move whole pixels
+// around so they are implemented once per pixel size in bytes and shared by
+// every ofPixels_ instantiation. swapping r and b works on components so it
+// also depends on the size of the component.
+//
+// every kernel has a scalar version that is also used for the remaining
+// pixels at the end of a row, the SIMD versions produce exactly the same
+// output.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define OF_PIXELS_SSE2
+	#include <emmintrin.h>
+	#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+		// functions using newer instruction sets are compiled with a target
+		// attribute and only called after checking the cpu supports them
+		#define OF_PIXELS_RUNTIME_DISPATCH
+		#define OF_PIXELS_TARGET(isa) __attribute__((target(isa)))
+		#include <immintrin.h>
+	#elif defined(_MSC_VER)
+		#define OF_PIXELS_RUNTIME_DISPATCH
+		#define OF_PIXELS_TARGET(isa)
+		#include <intrin.h>
+		#include <immintrin.h>
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define OF_PIXELS_NEON
+	#include <arm_neon.h>
+#endif
+
+enum ofPixelsSimd{
+	OF_PIXELS_SIMD_NONE,
+	OF_PIXELS_SIMD_SSE2,
+	OF_PIXELS_SIMD_SSSE3,
+	OF_PIXELS_SIMD_AVX2,
+	OF_PIXELS_SIMD_NEON
+};
+
+static ofPixelsSimd detectPixelsSimd(){
+#if defined(OF_PIXELS_SSE2) && defined(OF_PIXELS_RUNTIME_DISPATCH) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info,0);
+	int maxLeaf = info[0];
+	__cpuid(info,1);
+	bool ssse3 = (info[2] & (1<<9)) != 0;
+	bool osAvx = (info[2] & (1<<27)) && (info[2] & (1<<28)) && (_xgetbv(0) & 6) == 6;
+	if(maxLeaf>=7 && osAvx){
+		__cpuidex(info,7,0);
+		if(info[1] & (1<<5)) return OF_PIXELS_SIMD_AVX2;
+	}
+	return ssse3 ? OF_PIXELS_SIMD_SSSE3 : OF_PIXELS_SIMD_SSE2;
+#elif defined(OF_PIXELS_SSE2) && defined(OF_PIXELS_RUNTIME_DISPATCH)
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx2")) return OF_PIXELS_SIMD_AVX2;
+	if(__builtin_cpu_supports("ssse3")) return OF_PIXELS_SIMD_SSSE3;
+	return OF_PIXELS_SIMD_SSE2;
+#elif defined(OF_PIXELS_SSE2)
+	return OF_PIXELS_SIMD_SSE2;
+#elif defined(OF_PIXELS_NEON)
+	return OF_PIXELS_SIMD_NEON;
+#else
+	return OF_PIXELS_SIMD_NONE;
+#endif
+}
+
+static bool & pixelsSimdEnabled(){
+	static bool enabled = true;
+	return enabled;
+}
+
+static ofPixelsSimd getPixelsSimd(){
+	static ofPixelsSimd simd = detectPixelsSimd();
+	return pixelsSimdEnabled() ? simd : OF_PIXELS_SIMD_NONE;
+}
+
+//----------------------------------------------------------------------
+void ofEnablePixelsSimd(){
+	pixelsSimdEnabled() = true;
+}
+
+//----------------------------------------------------------------------
+void ofDisablePixelsSimd(){
+	pixelsSimdEnabled() = false;
+}
+
+//----------------------------------------------------------------------
+bool ofGetUsingPixelsSimd(){
+	return getPixelsSimd() != OF_PIXELS_SIMD_NONE;
+}
+
+//----------------------------------------------------------------------
+string ofGetPixelsSimdInstructionSet(){
+	switch(getPixelsSimd()){
+	case OF_PIXELS_SIMD_SSE2:
+		return "SSE2";
+	case OF_PIXELS_SIMD_SSSE3:
+		return "SSSE3";
+	case OF_PIXELS_SIMD_AVX2:
+		return "AVX2";
+	case OF_PIXELS_SIMD_NEON:
+		return "NEON";
+	default:
+		return "none";
+	}
+}
+
+//----------------------------------------------------------------------
+// mirror a row horizontally, dst and src can't overlap
+template<int BytesPerPixel>
+static void mirrorRowScalar(unsigned char * dst, const unsigned char * src, int width, int from=0){
+	const unsigned char * srcPixel = src + (width - 1 - from) * BytesPerPixel;
+	dst += from * BytesPerPixel;
+	for(int x=from; x<width; x++){
+		memcpy(dst,srcPixel,BytesPerPixel);
+		dst += BytesPerPixel;
+		srcPixel -= BytesPerPixel;
+	}
+}
+
+static void mirrorRowScalar(unsigned char * dst, const unsigned char * src, int width, int bytesPerPixel){
+	const unsigned char * srcPixel = src + (width - 1) * bytesPerPixel;
+	for(int x=0; x<width; x++){
+		memcpy(dst,srcPixel,bytesPerPixel);
+		dst += bytesPerPixel;
+		srcPixel -= bytesPerPixel;
+	}
+}
+
+#ifdef OF_PIXELS_SSE2
+static inline __m128i reverse16x8_sse2(__m128i v){
+	v = _mm_shufflelo_epi16(v,_MM_SHUFFLE(0,1,2,3));
+	v = _mm_shufflehi_epi16(v,_MM_SHUFFLE(0,1,2,3));
+	return _mm_shuffle_epi32(v,_MM_SHUFFLE(1,0,3,2));
+}
+
+static void mirrorRow1_sse2(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+16<=width; x+=16){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + width - x - 16));
+		v = _mm_or_si128(_mm_slli_epi16(v,8),_mm_srli_epi16(v,8));
+		_mm_storeu_si128((__m128i*)(dst + x), reverse16x8_sse2(v));
+	}
+	mirrorRowScalar<1>(dst,src,width,x);
+}
+
+static void mirrorRow2_sse2(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+8<=width; x+=8){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + (width - x - 8) * 2));
+		_mm_storeu_si128((__m128i*)(dst + x * 2), reverse16x8_sse2(v));
+	}
+	mirrorRowScalar<2>(dst,src,width,x);
+}
+
+static void mirrorRow4_sse2(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+4<=width; x+=4){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + (width - x - 4) * 4));
+		_mm_storeu_si128((__m128i*)(dst + x * 4), _mm_shuffle_epi32(v,_MM_SHUFFLE(0,1,2,3)));
+	}
+	mirrorRowScalar<4>(dst,src,width,x);
+}
+
+static void mirrorRow8_sse2(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+2<=width; x+=2){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + (width - x - 2) * 8));
+		_mm_storeu_si128((__m128i*)(dst + x * 8), _mm_shuffle_epi32(v,_MM_SHUFFLE(1,0,3,2)));
+	}
+	mirrorRowScalar<8>(dst,src,width,x);
+}
+#endif
+
+#ifdef OF_PIXELS_RUNTIME_DISPATCH
+OF_PIXELS_TARGET("ssse3")
+static void mirrorRow1_ssse3(unsigned char * dst, const unsigned char * src, int width){
+	const __m128i reverse = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+	int x = 0;
+	for(; x+16<=width; x+=16){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + width - x - 16));
+		_mm_storeu_si128((__m128i*)(dst + x), _mm_shuffle_epi8(v,reverse));
+	}
+	mirrorRowScalar<1>(dst,src,width,x);
+}
+
+// 5 rgb pixels fit in 16 bytes, the load starts one byte before the 5
+// pixels so it never reads past the end of the row and the store writes one
+// extra byte that belongs to the next 5 pixels so we stop 6 pixels before
+// the end of the row
+OF_PIXELS_TARGET("ssse3")
+static void mirrorRow3_ssse3(unsigned char * dst, const unsigned char * src, int width){
+	const __m128i reverse = _mm_setr_epi8(13,14,15,10,11,12,7,8,9,4,5,6,1,2,3,0);
+	int x = 0;
+	for(; x+6<=width; x+=5){
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + (width - x - 5) * 3 - 1));
+		_mm_storeu_si128((__m128i*)(dst + x * 3), _mm_shuffle_epi8(v,reverse));
+	}
+	mirrorRowScalar<3>(dst,src,width,x);
+}
+
+OF_PIXELS_TARGET("avx2")
+static void mirrorRow4_avx2(unsigned char * dst, const unsigned char * src, int width){
+	const __m256i reverse = _mm256_setr_epi32(7,6,5,4,3,2,1,0);
+	int x = 0;
+	for(; x+8<=width; x+=8){
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + (width - x - 8) * 4));
+		_mm256_storeu_si256((__m256i*)(dst + x * 4), _mm256_permutevar8x32_epi32(v,reverse));
+	}
+	mirrorRowScalar<4>(dst,src,width,x);
+}
+
+OF_PIXELS_TARGET("avx2")
+static void mirrorRow8_avx2(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+4<=width; x+=4){
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + (width - x - 4) * 8));
+		_mm256_storeu_si256((__m256i*)(dst + x * 8), _mm256_permute4x64_epi64(v,_MM_SHUFFLE(0,1,2,3)));
+	}
+	mirrorRowScalar<8>(dst,src,width,x);
+}
+#endif
+
+#ifdef OF_PIXELS_NEON
+static inline uint8x16_t reverse8x16_neon(uint8x16_t v){
+	v = vrev64q_u8(v);
+	return vcombine_u8(vget_high_u8(v),vget_low_u8(v));
+}
+
+static void mirrorRow1_neon(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+16<=width; x+=16){
+		vst1q_u8(dst + x, reverse8x16_neon(vld1q_u8(src + width - x - 16)));
+	}
+	mirrorRowScalar<1>(dst,src,width,x);
+}
+
+static void mirrorRow2_neon(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+8<=width; x+=8){
+		uint16x8_t v = vrev64q_u16(vld1q_u16((const uint16_t*)(src + (width - x - 8) * 2)));
+		vst1q_u16((uint16_t*)(dst + x * 2), vcombine_u16(vget_high_u16(v),vget_low_u16(v)));
+	}
+	mirrorRowScalar<2>(dst,src,width,x);
+}
+
+static void mirrorRow3_neon(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+16<=width; x+=16){
+		uint8x16x3_t v = vld3q_u8(src + (width - x - 16) * 3);
+		v.val[0] = reverse8x16_neon(v.val[0]);
+		v.val[1] = reverse8x16_neon(v.val[1]);
+		v.val[2] = reverse8x16_neon(v.val[2]);
+		vst3q_u8(dst + x * 3, v);
+	}
+	mirrorRowScalar<3>(dst,src,width,x);
+}
+
+static void mirrorRow4_neon(unsigned char * dst, const unsigned char * src, int width){
+	int x = 0;
+	for(; x+4<=width; x+=4){
+		uint32x4_t v = vrev64q_u32(vld1q_u32((const uint32_t*)(src + (width - x - 4) * 4)));
+		vst1q_u32((uint32_t*)(dst + x * 4), vcombine_u32(vget_high_u32(v),vget_low_u32(v)));
+	}
+	mirrorRowScalar<4>(dst,src,width,x);
+}
+#endif
+
+static void mirrorRow(unsigned char * dst, const unsigned char * src, int width, int bytesPerPixel){
+	ofPixelsSimd simd = getPixelsSimd();
+	switch(bytesPerPixel){
+	case 1:
+#ifdef OF_PIXELS_RUNTIME_DISPATCH
+		if(simd>=OF_PIXELS_SIMD_SSSE3) return mirrorRow1_ssse3(dst,src,width);
+#endif
+#ifdef OF_PIXELS_SSE2
+		if(simd>=OF_PIXELS_SIMD_SSE2) return mirrorRow1_sse2(dst,src,width);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(simd==OF_PIXELS_SIMD_NEON) return mirrorRow1_neon(dst,src,width);
+#endif
+		return mirrorRowScalar<1>(dst,src,width);
+	case 2:
+#ifdef OF_PIXELS_SSE2
+		if(simd>=OF_PIXELS_SIMD_SSE2) return mirrorRow2_sse2(dst,src,width);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(simd==OF_PIXELS_SIMD_NEON) return mirrorRow2_neon(dst,src,width);
+#endif
+		return mirrorRowScalar<2>(dst,src,width);
+	case 3:
+#ifdef OF_PIXELS_RUNTIME_DISPATCH
+		if(simd>=OF_PIXELS_SIMD_SSSE3) return mirrorRow3_ssse3(dst,src,width);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(simd==OF_PIXELS_SIMD_NEON) return mirrorRow3_neon(dst,src,width);
+#endif
+		return mirrorRowScalar<3>(dst,src,width);
+	case 4:
+#ifdef OF_PIXELS_RUNTIME_DISPATCH
+		if(simd>=OF_PIXELS_SIMD_AVX2) return mirrorRow4_avx2(dst,src,width);
+#endif
+#ifdef OF_PIXELS_SSE2
+		if(simd>=OF_PIXELS_SIMD_SSE2) return mirrorRow4_sse2(dst,src,width);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(simd==OF_PIXELS_SIMD_NEON) return mirrorRow4_neon(dst,src,width);
+#endif
+		return mirrorRowScalar<4>(dst,src,width);
+	case 6:
+		return mirrorRowScalar<6>(dst,src,width);
+	case 8:
+#ifdef OF_PIXELS_RUNTIME_DISPATCH
+		if(simd>=OF_PIXELS_SIMD_AVX2) return mirrorRow8_avx2(dst,src,width);
+#endif
+#ifdef OF_PIXELS_SSE2
+		if(simd>=OF_PIXELS_SIMD_SSE2) return mirrorRow8_sse2(dst,src,width);
+#endif
+		return mirrorRowScalar<8>(dst,src,width);
+	case 12:
+		return mirrorRowScalar<12>(dst,src,width);
+	case 16:
+		return mirrorRowScalar<16>(dst,src,width);
+	default:
+		return mirrorRowScalar(dst,src,width,bytesPerPixel);
+	}
+}
+
+//----------------------------------------------------------------------
+// rotates a block of src into dst, clockwise src(x,y) goes to
+// dst(srcHeight-1-y,x), counter clockwise to dst(y,srcWidth-1-x)
+template<int BytesPerPixel>
+static void rotateBlockScalar(unsigned char * dst, const unsigned char * src, int srcWidth, int srcHeight, bool clockwise, int x0, int y0, int x1, int y1){
+	ptrdiff_t srcStride = ptrdiff_t(srcWidth) * BytesPerPixel;
+	ptrdiff_t dstStride = ptrdiff_t(srcHeight) * BytesPerPixel;
+	ptrdiff_t dstStep = clockwise ? dstStride : -dstStride;
+	for(int y=y0; y<y1; y++){
+		const unsigned char * srcPixel = src + y * srcStride + x0 * BytesPerPixel;
+		unsigned char * dstPixel = clockwise ?
+				dst + x0 * dstStride + (srcHeight - 1 - y) * BytesPerPixel :
+				dst + (srcWidth - 1 - x0) * dstStride + y * BytesPerPixel;
+		for(int x=x0; x<x1; x++){
+			memcpy(dstPixel,srcPixel,BytesPerPixel);
+			srcPixel += BytesPerPixel;
+			dstPixel += dstStep;
+		}
+	}
+}
+
+static void rotateBlockScalar(unsigned char * dst, const unsigned char * src, int srcWidth, int srcHeight, bool clockwise, int x0, int y0, int x1, int y1, int bytesPerPixel){
+	ptrdiff_t srcStride = ptrdiff_t(srcWidth) * bytesPerPixel;
+	ptrdiff_t dstStride = ptrdiff_t(srcHeight) * bytesPerPixel;
+	ptrdiff_t dstStep = clockwise ? dstStride : -dstStride;
+	for(int y=y0; y<y1; y++){
+		const unsigned char * srcPixel = src + y * srcStride + x0 * bytesPerPixel;
+		unsigned char * dstPixel = clockwise ?
+				dst + x0 * dstStride + (srcHeight - 1 - y) * bytesPerPixel :
+				dst + (srcWidth - 1 - x0) * dstStride + y * bytesPerPixel;
+		for(int x=x0; x<x1; x++){
+			memcpy(dstPixel,srcPixel,bytesPerPixel);
+			srcPixel += bytesPerPixel;
+			dstPixel += dstStep;
+		}
+	}
+}
+
+// rotates the part of the block that is a multiple of 4x4 transposing 4x4
+// tiles of 32bit pixels in registers and the borders with the scalar version
+#ifdef OF_PIXELS_SSE2
+static void rotateBlock4_sse2(unsigned char * dst, const unsigned char * src, int srcWidth, int srcHeight, bool clockwise, int x0, int y0, int x1, int y1){
+	size_t srcStride = size_t(srcWidth) * 4;
+	size_t dstStride = size_t(srcHeight) * 4;
+	int x4 = x0 + (x1 - x0) / 4 * 4;
+	int y4 = y0 + (y1 - y0) / 4 * 4;
+	for(int y=y0; y<y4; y+=4){
+		const unsigned char * srcRow = src + y * srcStride;
+		for(int x=x0; x<x4; x+=4){
+			__m128i r0 = _mm_loadu_si128((const __m128i*)(srcRow + x * 4));
+			__m128i r1 = _mm_loadu_si128((const __m128i*)(srcRow + srcStride + x * 4));
+			__m128i r2 = _mm_loadu_si128((const __m128i*)(srcRow + 2 * srcStride + x * 4));
+			__m128i r3 = _mm_loadu_si128((const __m128i*)(srcRow + 3 * srcStride + x * 4));
+			__m128i t0 = _mm_unpacklo_epi32(r0,r1);
+			__m128i t1 = _mm_unpacklo_epi32(r2,r3);
+			__m128i t2 = _mm_unpackhi_epi32(r0,r1);
+			__m128i t3 = _mm_unpackhi_epi32(r2,r3);
+			__m128i c[4] = {
+				_mm_unpacklo_epi64(t0,t1),
+				_mm_unpackhi_epi64(t0,t1),
+				_mm_unpacklo_epi64(t2,t3),
+				_mm_unpackhi_epi64(t2,t3)
+			};
+			if(clockwise){
+				unsigned char * dstPixel = dst + x * dstStride + (srcHeight - 4 - y) * 4;
+				for(int i=0; i<4; i++, dstPixel+=dstStride){
+					_mm_storeu_si128((__m128i*)dstPixel, _mm_shuffle_epi32(c[i],_MM_SHUFFLE(0,1,2,3)));
+				}
+			}else{
+				unsigned char * dstPixel = dst + (srcWidth - 1 - x) * dstStride + y * 4;
+				for(int i=0; i<4; i++, dstPixel-=dstStride){
+					_mm_storeu_si128((__m128i*)dstPixel, c[i]);
+				}
+			}
+		}
+	}
+	rotateBlockScalar<4>(dst,src,srcWidth,srcHeight,clockwise,x4,y0,x1,y4);
+	rotateBlockScalar<4>(dst,src,srcWidth,srcHeight,clockwise,x0,y4,x1,y1);
+}
+#endif
+
+#ifdef OF_PIXELS_NEON
+static void rotateBlock4_neon(unsigned char * dst, const unsigned char * src, int srcWidth, int srcHeight, bool clockwise, int x0, int y0, int x1, int y1){
+	size_t srcStride = size_t(srcWidth) * 4;
+	size_t dstStride = size_t(srcHeight) * 4;
+	int x4 = x0 + (x1 - x0) / 4 * 4;
+	int y4 = y0 + (y1 - y0) / 4 * 4;
+	for(int y=y0; y<y4; y+=4){
+		const unsigned char * srcRow = src + y * srcStride;
+		for(int x=x0; x<x4; x+=4){
+			uint32x4x2_t t0 = vtrnq_u32(vld1q_u32((const uint32_t*)(srcRow + x * 4)), vld1q_u32((const uint32_t*)(srcRow + srcStride + x * 4)));
+			uint32x4x2_t t1 = vtrnq_u32(vld1q_u32((const uint32_t*)(srcRow + 2 * srcStride + x * 4)), vld1q_u32((const uint32_t*)(srcRow + 3 * srcStride + x * 4)));
+			uint32x4_t c[4] = {
+				vcombine_u32(vget_low_u32(t0.val[0]),vget_low_u32(t1.val[0])),
+				vcombine_u32(vget_low_u32(t0.val[1]),vget_low_u32(t1.val[1])),
+				vcombine_u32(vget_high_u32(t0.val[0]),vget_high_u32(t1.val[0])),
+				vcombine_u32(vget_high_u32(t0.val[1]),vget_high_u32(t1.val[1]))
+			};
+			if(clockwise){
+				unsigned char * dstPixel = dst + x * dstStride + (srcHeight - 4 - y) * 4;
+				for(int i=0; i<4; i++, dstPixel+=dstStride){
+					uint32x4_t r = vrev64q_u32(c[i]);
+					vst1q_u32((uint32_t*)dstPixel, vcombine_u32(vget_high_u32(r),vget_low_u32(r)));
+				}
+			}else{
+				unsigned char * dstPixel = dst + (srcWidth - 1 - x) * dstStride + y * 4;
+				for(int i=0; i<4; i++, dstPixel-=dstStride){
+					vst1q_u32((uint32_t*)dstPixel, c[i]);
+				}
+			}
+		}
+	}
+	rotateBlockScalar<4>(dst,src,srcWidth,srcHeight,clockwise,x4,y0,x1,y4);
+	rotateBlockScalar<4>(dst,src,srcWidth,srcHeight,clockwise,x0,y4,x1,y1);
+}
+#endif
+
+static void rotateBlock(unsigned char * dst, const unsigned char * src, int srcWidth, int srcHeight, bool clockwise, int x0, int y0, int x1, int y1, int bytesPerPixel){
+	switch(bytesPerPixel){
+	case 1:
+		return rotateBlockScalar<1>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	case 2:
+		return rotateBlockScalar<2>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	case 3:
+		return rotateBlockScalar<3>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	case 4:
+#ifdef OF_PIXELS_SSE2
+		if(getPixelsSimd()>=OF_PIXELS_SIMD_SSE2) return rotateBlock4_sse2(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(getPixelsSimd()==OF_PIXELS_SIMD_NEON) return rotateBlock4_neon(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+#endif
+		return rotateBlockScalar<4>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	case 6:
+		return rotateBlockScalar<6>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	case 8:
+		return rotateBlockScalar<8>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	case 12:
+		return rotateBlockScalar<12>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	case 16:
+		return rotateBlockScalar<16>(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1);
+	default:
+		return rotateBlockScalar(dst,src,srcWidth,srcHeight,clockwise,x0,y0,x1,y1,bytesPerPixel);
+	}
+}
+
+// rotating in blocks keeps both the rows being read and the rows being
+// written in cache. only the source rows in [firstRow, lastRow) are rotated
+static void rotatePixels(unsigned char * dst, const unsigned char * src, int srcWidth, int srcHeight, bool clockwise, int bytesPerPixel, int firstRow, int lastRow){
+	const int blockSize = 32;
+	for(int y=firstRow; y<lastRow; y+=blockSize){
+		for(int x=0; x<srcWidth; x+=blockSize){
+			rotateBlock(dst,src,srcWidth,srcHeight,clockwise,x,y,MIN(x+blockSize,srcWidth),MIN(y+blockSize,lastRow),bytesPerPixel);
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+// computes int(rowIndex + srcX[x]) in float, as the original scalar loop did,
+// so the sampled pixels are exactly the same. when upscaling the last
+// positions can fall past the end of the row so they are clamped to it.
+// the indices are relative to the start of the row
+static void nearestIndices(int * indices, const float * srcX, int rowIndex, int srcWidth, int width){
+	int maxIndex = rowIndex + srcWidth - 1;
+	int x = 0;
+#if defined(OF_PIXELS_SSE2)
+	if(getPixelsSimd()>=OF_PIXELS_SIMD_SSE2){
+		__m128 row = _mm_set1_ps(float(rowIndex));
+		__m128i rowi = _mm_set1_epi32(rowIndex);
+		__m128i maxv = _mm_set1_epi32(maxIndex);
+		for(; x+4<=width; x+=4){
+			__m128i v = _mm_cvttps_epi32(_mm_add_ps(row,_mm_loadu_ps(srcX + x)));
+			__m128i over = _mm_cmpgt_epi32(v,maxv);
+			v = _mm_or_si128(_mm_and_si128(over,maxv),_mm_andnot_si128(over,v));
+			_mm_storeu_si128((__m128i*)(indices + x), _mm_sub_epi32(v,rowi));
+		}
+	}
+#elif defined(OF_PIXELS_NEON)
+	if(getPixelsSimd()==OF_PIXELS_SIMD_NEON){
+		float32x4_t row = vdupq_n_f32(float(rowIndex));
+		int32x4_t rowi = vdupq_n_s32(rowIndex);
+		int32x4_t maxv = vdupq_n_s32(maxIndex);
+		for(; x+4<=width; x+=4){
+			vst1q_s32(indices + x, vsubq_s32(vminq_s32(vcvtq_s32_f32(vaddq_f32(row,vld1q_f32(srcX + x))),maxv),rowi));
+		}
+	}
+#endif
+	for(; x<width; x++){
+		indices[x] = MIN(int(rowIndex + srcX[x]), maxIndex) - rowIndex;
+	}
+}
+
+//----------------------------------------------------------------------
+// copies the pixels at the indices in srcIndices, used by nearest neighbor
+template<int BytesPerPixel>
+static void gatherRow(unsigned char * dst, const unsigned char * src, const int * srcIndices, int width){
+	for(int x=0; x<width; x++, dst+=BytesPerPixel){
+		memcpy(dst, src + size_t(srcIndices[x]) * BytesPerPixel, BytesPerPixel);
+	}
+}
+
+static void gatherRow(unsigned char * dst, const unsigned char * src, const int * srcIndices, int width, int bytesPerPixel){
+	switch(bytesPerPixel){
+	case 1: return gatherRow<1>(dst,src,srcIndices,width);
+	case 2: return gatherRow<2>(dst,src,srcIndices,width);
+	case 3: return gatherRow<3>(dst,src,srcIndices,width);
+	case 4: return gatherRow<4>(dst,src,srcIndices,width);
+	case 6: return gatherRow<6>(dst,src,srcIndices,width);
+	case 8: return gatherRow<8>(dst,src,srcIndices,width);
+	case 12: return gatherRow<12>(dst,src,srcIndices,width);
+	case 16: return gatherRow<16>(dst,src,srcIndices,width);
+	default:
+		for(int x=0; x<width; x++, dst+=bytesPerPixel){
+			memcpy(dst, src + size_t(srcIndices[x]) * bytesPerPixel, bytesPerPixel);
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+// swaps components 0 and 2 of each pixel
+template<typename ComponentType>
+static void swapRgbScalar(ComponentType * pixels, size_t numPixels, int channels){
+	ComponentType * end = pixels + numPixels * channels;
+	for(ComponentType * pixel=pixels; pixel<end; pixel+=channels){
+		std::swap(pixel[0],pixel[2]);
+	}
+}
+
+#ifdef OF_PIXELS_SSE2
+// 4 channels of 8 bits, every 32bit lane is a pixel
+static size_t swapRgba8_sse2(unsigned char * pixels, size_t numPixels){
+	const __m128i keep = _mm_set1_epi32(0xFF00FF00);
+	const __m128i low = _mm_set1_epi32(0x000000FF);
+	const __m128i high = _mm_set1_epi32(0x00FF0000);
+	size_t i = 0;
+	for(; i+4<=numPixels; i+=4){
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+		__m128i r = _mm_and_si128(_mm_srli_epi32(v,16),low);
+		__m128i b = _mm_and_si128(_mm_slli_epi32(v,16),high);
+		v = _mm_or_si128(_mm_and_si128(v,keep),_mm_or_si128(r,b));
+		_mm_storeu_si128((__m128i*)(pixels + i * 4),v);
+	}
+	return i;
+}
+
+// 4 channels of 16 bits, every 64bit lane is a pixel
+static size_t swapRgba16_sse2(unsigned char * pixels, size_t numPixels){
+	const __m128i keep = _mm_set_epi32(0xFFFF0000,0xFFFF0000,0xFFFF0000,0xFFFF0000);
+	const __m128i low = _mm_set_epi32(0,0x0000FFFF,0,0x0000FFFF);
+	const __m128i high = _mm_set_epi32(0x0000FFFF,0,0x0000FFFF,0);
+	size_t i = 0;
+	for(; i+2<=numPixels; i+=2){
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i * 8));
+		__m128i r = _mm_and_si128(_mm_srli_epi64(v,32),low);
+		__m128i b = _mm_and_si128(_mm_slli_epi64(v,32),high);
+		v = _mm_or_si128(_mm_and_si128(v,keep),_mm_or_si128(r,b));
+		_mm_storeu_si128((__m128i*)(pixels + i * 8),v);
+	}
+	return i;
+}
+
+// 4 channels of 32 bits, every register is a pixel
+static size_t swapRgba32_sse2(unsigned char * pixels, size_t numPixels){
+	for(size_t i=0; i<numPixels; i++){
+		__m128i v = _mm_loadu_si128((const __m128i*)(pixels + i * 16));
+		_mm_storeu_si128((__m128i*)(pixels + i * 16),_mm_shuffle_epi32(v,_MM_SHUFFLE(3,0,1,2)));
+	}
+	return numPixels;
+}
+#endif
+
+#ifdef OF_PIXELS_RUNTIME_DISPATCH
+OF_PIXELS_TARGET("avx2")
+static size_t swapRgba8_avx2(unsigned char * pixels, size_t numPixels){
+	const __m256i shuffle = _mm256_setr_epi8(2,1,0,3,6,5,4,7,10,9,8,11,14,13,12,15,
+	                                         2,1,0,3,6,5,4,7,10,9,8,11,14,13,12,15);
+	size_t i = 0;
+	for(; i+8<=numPixels; i+=8){
+		__m256i v = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+		_mm256_storeu_si256((__m256i*)(pixels + i * 4),_mm256_shuffle_epi8(v,shuffle));
+	}
+	return i;
+}
+
+// 16 rgb pixels are 3 registers, the pixels that straddle two registers
+// take the component that lives in the neighbour register from it
+OF_PIXELS_TARGET("ssse3")
+static size_t swapRgb8_ssse3(unsigned char * pixels, size_t numPixels){
+	const __m128i m0 = _mm_setr_epi8(2,1,0,5,4,3,8,7,6,11,10,9,14,13,12,-1);
+	const __m128i m0Next = _mm_setr_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,1);
+	const __m128i m1 = _mm_setr_epi8(0,-1,4,3,2,7,6,5,10,9,8,13,12,11,-1,15);
+	const __m128i m1Prev = _mm_setr_epi8(-1,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1);
+	const __m128i m1Next = _mm_setr_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,0,-1);
+	const __m128i m2 = _mm_setr_epi8(-1,3,2,1,6,5,4,9,8,7,12,11,10,15,14,13);
+	const __m128i m2Prev = _mm_setr_epi8(14,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1);
+	size_t i = 0;
+	for(; i+16<=numPixels; i+=16){
+		__m128i * p = (__m128i*)(pixels + i * 3);
+		__m128i v0 = _mm_loadu_si128(p);
+		__m128i v1 = _mm_loadu_si128(p + 1);
+		__m128i v2 = _mm_loadu_si128(p + 2);
+		_mm_storeu_si128(p, _mm_or_si128(_mm_shuffle_epi8(v0,m0),_mm_shuffle_epi8(v1,m0Next)));
+		_mm_storeu_si128(p + 1, _mm_or_si128(_mm_shuffle_epi8(v1,m1),_mm_or_si128(_mm_shuffle_epi8(v0,m1Prev),_mm_shuffle_epi8(v2,m1Next))));
+		_mm_storeu_si128(p + 2, _mm_or_si128(_mm_shuffle_epi8(v2,m2),_mm_shuffle_epi8(v1,m2Prev)));
+	}
+	return i;
+}
+#endif
+
+#ifdef OF_PIXELS_NEON
+static size_t swapRgb8_neon(unsigned char * pixels, size_t numPixels, int channels){
+	size_t i = 0;
+	if(channels==3){
+		for(; i+16<=numPixels; i+=16){
+			uint8x16x3_t v = vld3q_u8(pixels + i * 3);
+			uint8x16_t r = v.val[0]; v.val[0] = v.val[2]; v.val[2] = r;
+			vst3q_u8(pixels + i * 3, v);
+		}
+	}else{
+		for(; i+16<=numPixels; i+=16){
+			uint8x16x4_t v = vld4q_u8(pixels + i * 4);
+			uint8x16_t r = v.val[0]; v.val[0] = v.val[2]; v.val[2] = r;
+			vst4q_u8(pixels + i * 4, v);
+		}
+	}
+	return i;
+}
+
+static size_t swapRgb16_neon(unsigned char * pixels, size_t numPixels, int channels){
+	uint16_t * p = (uint16_t*)pixels;
+	size_t i = 0;
+	if(channels==3){
+		for(; i+8<=numPixels; i+=8){
+			uint16x8x3_t v = vld3q_u16(p + i * 3);
+			uint16x8_t r = v.val[0]; v.val[0] = v.val[2]; v.val[2] = r;
+			vst3q_u16(p + i * 3, v);
+		}
+	}else{
+		for(; i+8<=numPixels; i+=8){
+			uint16x8x4_t v = vld4q_u16(p + i * 4);
+			uint16x8_t r = v.val[0]; v.val[0] = v.val[2]; v.val[2] = r;
+			vst4q_u16(p + i * 4, v);
+		}
+	}
+	return i;
+}
+
+static size_t swapRgb32_neon(unsigned char * pixels, size_t numPixels, int channels){
+	uint32_t * p = (uint32_t*)pixels;
+	size_t i = 0;
+	if(channels==3){
+		for(; i+4<=numPixels; i+=4){
+			uint32x4x3_t v = vld3q_u32(p + i * 3);
+			uint32x4_t r = v.val[0]; v.val[0] = v.val[2]; v.val[2] = r;
+			vst3q_u32(p + i * 3, v);
+		}
+	}else{
+		for(; i+4<=numPixels; i+=4){
+			uint32x4x4_t v = vld4q_u32(p + i * 4);
+			uint32x4_t r = v.val[0]; v.val[0] = v.val[2]; v.val[2] = r;
+			vst4q_u32(p + i * 4, v);
+		}
+	}
+	return i;
+}
+#endif
+
+template<typename ComponentType>
+static void swapRgbComponents(ComponentType * pixels, size_t numPixels, int channels){
+	ofPixelsSimd simd = getPixelsSimd();
+	unsigned char * bytes = (unsigned char*)pixels;
+	size_t done = 0;
+	switch(sizeof(ComponentType)){
+	case 1:
+#ifdef OF_PIXELS_RUNTIME_DISPATCH
+		if(channels==4 && simd>=OF_PIXELS_SIMD_AVX2) done = swapRgba8_avx2(bytes,numPixels);
+		else if(channels==3 && simd>=OF_PIXELS_SIMD_SSSE3) done = swapRgb8_ssse3(bytes,numPixels);
+		else
+#endif
+#ifdef OF_PIXELS_SSE2
+		if(channels==4 && simd>=OF_PIXELS_SIMD_SSE2) done = swapRgba8_sse2(bytes,numPixels);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(simd==OF_PIXELS_SIMD_NEON) done = swapRgb8_neon(bytes,numPixels,channels);
+#endif
+		break;
+	case 2:
+#ifdef OF_PIXELS_SSE2
+		if(channels==4 && simd>=OF_PIXELS_SIMD_SSE2) done = swapRgba16_sse2(bytes,numPixels);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(simd==OF_PIXELS_SIMD_NEON) done = swapRgb16_neon(bytes,numPixels,channels);
+#endif
+		break;
+	case 4:
+#ifdef OF_PIXELS_SSE2
+		if(channels==4 && simd>=OF_PIXELS_SIMD_SSE2) done = swapRgba32_sse2(bytes,numPixels);
+#endif
+#ifdef OF_PIXELS_NEON
+		if(simd==OF_PIXELS_SIMD_NEON) done = swapRgb32_neon(bytes,numPixels,channels);
+#endif
+		break;
+	}
+	swapRgbScalar(pixels + done * channels, numPixels - done, channels);
+}
+
+//----------------------------------------------------------------------
+// threads
+//
+// when enabled, bulk operations split the image in bands of rows that are
+// processed by the global thread pool, the calling thread processes bands
+// too. every band writes to different rows so the output is exactly the
+// same as running on a single thread.
+
+class ofPixelsRowJob{
+public:
+	virtual ~ofPixelsRowJob(){}
+	virtual void run(int firstRow, int lastRow) = 0;
+};
+
+static bool & pixelsThreadsEnabled(){
+	static bool enabled = false;
+	return enabled;
+}
+
+static int & pixelsThreadsMinBandSize(){
+	static int minBandSize = 64;
+	return minBandSize;
+}
+
+class ofPixelsBandsJob: public ofParallelJob{
+public:
+	ofPixelsBandsJob(ofPixelsRowJob & job)
+	:job(job){}
+
+	void run(size_t begin, size_t end){
+		job.run(begin, end);
+	}
+
+	ofPixelsRowJob & job;
+};
+
+// runs the job over rows [0, numRows) in parallel bands if threads are
+// enabled and there's enough rows, or in one go on the calling thread
+static void runRowBands(ofPixelsRowJob & job, int numRows){
+	if(pixelsThreadsEnabled()){
+		int numBands = MIN(int(ofGetThreadPool().getNumThreads()) + 1, numRows / MAX(pixelsThreadsMinBandSize(), 1));
+		if(numBands>1){
+			ofPixelsBandsJob bands(job);
+			ofParallelFor(bands, 0, numRows, (numRows + numBands - 1) / numBands);
+			return;
+		}
+	}
+	job.run(0, numRows);
+}
+
+//----------------------------------------------------------------------
+void ofEnablePixelsThreads(){
+	pixelsThreadsEnabled() = true;
+}
+
+//----------------------------------------------------------------------
+void ofDisablePixelsThreads(){
+	pixelsThreadsEnabled() = false;
+}
+
+//----------------------------------------------------------------------
+bool ofGetUsingPixelsThreads(){
+	return pixelsThreadsEnabled();
+}
+
+//----------------------------------------------------------------------
+void ofSetPixelsThreadsMinBandSize(int rows){
+	pixelsThreadsMinBandSize() = MAX(rows, 1);
+}
+
+//----------------------------------------------------------------------
+int ofGetPixelsThreadsMinBandSize(){
+	return pixelsThreadsMinBandSize();
+}
+
 template<typename PixelType>
 ofPixels_<PixelType>::ofPixels_(){
 	bAllocated = false;
 	pixelsOwner = false;
+	pixelsPooled = false;
 	pixelFormat = OF_PIXELS_UNKNOWN;
 	pixels = NULL;
 	pixelsSize = 0;
@@ -201,6 +1077,7 @@ template<typename PixelType>
 ofPixels_<PixelType>::ofPixels_(const ofPixels_<PixelType> & mom){
 	bAllocated = false;
 	pixelsOwner = false;
+	pixelsPooled = false;
 	pixelsSize = 0;
 	pixels = NULL;
 	width = 0;
@@ -340,6 +1217,7 @@ void ofPixels_<PixelType>::swap(ofPixels_<PixelType> & pix){
 	std::swap(pixelFormat,pix.pixelFormat);
 	std::swap(pixelsSize,pix.pixelsSize);
 	std::swap(pixelsOwner, pix.pixelsOwner);
+	std::swap(pixelsPooled, pix.pixelsPooled);
 	std::swap(bAllocated, pix.bAllocated);
 }
 
@@ -402,7 +1280,14 @@ void ofPixels_<PixelType>::allocate(int w, int h, ofPixelFormat format){
 
 	pixelsSize = newSize / sizeof(PixelType);
 
-	pixels = new PixelType[newSize];
+	pixels = NULL;
+	if(ofGetUsingPixelsPool()){
+		pixels = (PixelType*)ofPixelsPool::get().allocate(newSize);
+	}
+	pixelsPooled = pixels != NULL;
+	if(!pixelsPooled){
+		pixels = new PixelType[pixelsSize];
+	}
 	bAllocated = true;
 	pixelsOwner = true;
 }
@@ -414,18 +1299,27 @@ void ofPixels_<PixelType>::allocate(int w, int h, ofImageType type){
 
 template<typename PixelType>
 void ofPixels_<PixelType>::swapRgb(){
+	struct SwapRgbJob: public ofPixelsRowJob{
+		SwapRgbJob(PixelType * pixels, int width, int channels)
+		:pixels(pixels),width(width),channels(channels){}
+
+		void run(int firstRow, int lastRow){
+			swapRgbComponents(pixels + size_t(firstRow) * width * channels, size_t(lastRow - firstRow) * width, channels);
+		}
+
+		PixelType * pixels;
+		int width;
+		int channels;
+	};
+
 	switch(pixelFormat){
 	case OF_PIXELS_RGB:
 	case OF_PIXELS_BGR:
 	case OF_PIXELS_RGBA:
 	case OF_PIXELS_BGRA:{
-		Pixels pixels = getPixelsIter();
-		Pixel _end = pixels.end();
-		for(Pixel pixel=pixels.begin();pixel!=_end;pixel++){
-			std::swap(pixel[0],pixel[2]);
-		}
-	}
-	break;
+		SwapRgbJob job(pixels,width,getNumChannels());
+		runRowBands(job,height);
+	}break;
 	default:
 		ofLogWarning("ofPixels") << "rgb swap not supported for this pixel format";
 		break;
@@ -451,9 +1345,16 @@ void ofPixels_<PixelType>::swapRgb(){
 template<typename PixelType>
 void ofPixels_<PixelType>::clear(){
 	if(pixels){
-		if(pixelsOwner) delete[] pixels;
+		if(pixelsOwner){
+			if(pixelsPooled){
+				ofPixelsPool::get().release(pixels);
+			}else{
+				delete[] pixels;
+			}
+		}
 		pixels = NULL;
 	}
+	pixelsPooled	= false;
 
 	width			= 0;
 	height			= 0;
@@ -751,67 +1652,12 @@ int ofPixels_<PixelType>::getNumPlanes() const{
 
 template<typename PixelType>
 ofPixels_<PixelType> ofPixels_<PixelType>::getPlane(int planeIdx){
-	planeIdx = ofClamp(planeIdx,0,getNumPlanes());
 	ofPixels_<PixelType> plane;
-	switch(pixelFormat){
-		case OF_PIXELS_RGB:
-		case OF_PIXELS_BGR:
-		case OF_PIXELS_RGB565:
-		case OF_PIXELS_RGBA:
-		case OF_PIXELS_BGRA:
-		case OF_PIXELS_GRAY:
-		case OF_PIXELS_YUY2:
-		case OF_PIXELS_UYVY:
-			plane.setFromExternalPixels(pixels,width,height,pixelFormat);
-			break;
-		case OF_PIXELS_NV12:
-			switch(planeIdx){
-			case 0:
-				plane.setFromExternalPixels(pixels,width,height,OF_PIXELS_Y);
-				break;
-			case 1:
-				plane.setFromExternalPixels(pixels+width*height,width/2,height/2,OF_PIXELS_UV);
-				break;
-			}
-			break;
-		case OF_PIXELS_NV21:
-			switch(planeIdx){
-			case 0:
-				plane.setFromExternalPixels(pixels,width,height,OF_PIXELS_Y);
-				break;
-			case 1:
-				plane.setFromExternalPixels(pixels+width*height,width/2,height/2,OF_PIXELS_VU);
-				break;
-			}
-			break;
-		case OF_PIXELS_YV12:
-			switch(planeIdx){
-			case 0:
-				plane.setFromExternalPixels(pixels,width,height,OF_PIXELS_Y);
-				break;
-			case 1:
-				plane.setFromExternalPixels(pixels+width*height,width/2,height/2,OF_PIXELS_V);
-				break;
-			case 2:
-				plane.setFromExternalPixels(pixels+int(width*height+width/2*height/2),width/2,height/2,OF_PIXELS_U);
-				break;
-			}
-			break;
-		case OF_PIXELS_I420:
-			switch(planeIdx){
-			case 0:
-				plane.setFromExternalPixels(pixels,width,height,OF_PIXELS_Y);
-				break;
-			case 1:
-				plane.setFromExternalPixels(pixels+width*height,width/2,height/2,OF_PIXELS_U);
-				break;
-			case 2:
-				plane.setFromExternalPixels(pixels+int(width*height+width/2*height/2),width/2,height/2,OF_PIXELS_V);
-				break;
-			}
-			break;
-		default:
-			break;
+	size_t offset;
+	int planeWidth, planeHeight;
+	ofPixelFormat planeFormat;
+	if(getPlaneLayout(width,height,pixelFormat,planeIdx,offset,planeWidth,planeHeight,planeFormat)){
+		plane.setFromExternalPixels(pixels+offset,planeWidth,planeHeight,planeFormat);
 	}
 	return plane;
 }
@@ -824,27 +1670,43 @@ ofImageType ofPixels_<PixelType>::getImageType() const{
 template<typename PixelType>
 void ofPixels_<PixelType>::setImageType(ofImageType imageType){
 	if(!isAllocated() || imageType==getImageType()) return;
-	ofPixels_<PixelType> dst;
-	dst.allocate(width,height,imageType);
-	PixelType * dstPtr = &dst[0];
-	PixelType * srcPtr = &pixels[0];
-	int diffNumChannels = 0;
-	if(dst.getNumChannels()<getNumChannels()){
-		diffNumChannels = getNumChannels()-dst.getNumChannels();
-	}
-	for(int i=0;i<width*height;i++){
-		const PixelType & gray = *srcPtr;
-		for(int j=0;j<dst.getNumChannels();j++){
-			if(j<getNumChannels()){
-				*dstPtr++ =  *srcPtr++;
-			}else if(j<3){
-				*dstPtr++ = gray;
-			}else{
-				*dstPtr++ = ofColor_<PixelType>::limit();
+	struct ConvertJob: public ofPixelsRowJob{
+		ConvertJob(const ofPixels_<PixelType> & src, ofPixels_<PixelType> & dst)
+		:src(src),dst(dst){}
+
+		void run(int firstRow, int lastRow){
+			int srcChannels = src.getNumChannels();
+			int dstChannels = dst.getNumChannels();
+			int diffNumChannels = 0;
+			if(dstChannels<srcChannels){
+				diffNumChannels = srcChannels-dstChannels;
+			}
+			const PixelType * srcPtr = src.getData() + size_t(firstRow) * src.getWidth() * srcChannels;
+			PixelType * dstPtr = dst.getData() + size_t(firstRow) * dst.getWidth() * dstChannels;
+			size_t numPixels = size_t(lastRow - firstRow) * src.getWidth();
+			for(size_t i=0;i<numPixels;i++){
+				const PixelType & gray = *srcPtr;
+				for(int j=0;j<dstChannels;j++){
+					if(j<srcChannels){
+						*dstPtr++ =  *srcPtr++;
+					}else if(j<3){
+						*dstPtr++ = gray;
+					}else{
+						*dstPtr++ = ofColor_<PixelType>::limit();
+					}
+				}
+				srcPtr+=diffNumChannels;
 			}
 		}
-		srcPtr+=diffNumChannels;
-	}
+
+		const ofPixels_<PixelType> & src;
+		ofPixels_<PixelType> & dst;
+	};
+
+	ofPixels_<PixelType> dst;
+	dst.allocate(width,height,imageType);
+	ConvertJob job(*this,dst);
+	runRowBands(job,height);
 	swap(dst);
 }
 
@@ -870,13 +1732,29 @@ ofPixels_<PixelType> ofPixels_<PixelType>::getChannel(int channel) const{
 	int channels = channelsFromPixelFormat(pixelFormat);
 	if(channels==0) return channelPixels;
 
+	struct GetChannelJob: public ofPixelsRowJob{
+		GetChannelJob(const PixelType * src, PixelType * dst, int width, int channels)
+		:src(src),dst(dst),width(width),channels(channels){}
+
+		void run(int firstRow, int lastRow){
+			const PixelType * srcPixel = src + size_t(firstRow) * width * channels;
+			PixelType * dstPixel = dst + size_t(firstRow) * width;
+			PixelType * dstEnd = dst + size_t(lastRow) * width;
+			for(;dstPixel<dstEnd;srcPixel+=channels,++dstPixel){
+				*dstPixel = *srcPixel;
+			}
+		}
+
+		const PixelType * src;
+		PixelType * dst;
+		int width;
+		int channels;
+	};
+
 	channelPixels.allocate(width,height,1);
 	channel = ofClamp(channel,0,channels-1);
-	iterator channelPixel = channelPixels.begin();
-	const_iterator _end = end();
-	for(const_iterator i=begin()+channel;i<_end;i+=channels,++channelPixel){
-		*channelPixel = *i;
-	}
+	GetChannelJob job(pixels + channel, channelPixels.getData(), width, channels);
+	runRowBands(job,height);
 	return channelPixels;
 }
 
@@ -885,13 +1763,28 @@ void ofPixels_<PixelType>::setChannel(int channel, const ofPixels_<PixelType> ch
 	int channels = channelsFromPixelFormat(pixelFormat);
 	if(channels==0) return;
 
-	channel = ofClamp(channel,0,channels-1);
-	const_iterator channelPixel = channelPixels.begin();
-	iterator _end = end();
-	for(iterator i=begin()+channel;i<_end;i+=channels,++channelPixel){
-		*i = *channelPixel;
-	}
+	struct SetChannelJob: public ofPixelsRowJob{
+		SetChannelJob(const PixelType * src, PixelType * dst, int width, int channels)
+		:src(src),dst(dst),width(width),channels(channels){}
+
+		void run(int firstRow, int lastRow){
+			const PixelType * srcPixel = src + size_t(firstRow) * width;
+			const PixelType * srcEnd = src + size_t(lastRow) * width;
+			PixelType * dstPixel = dst + size_t(firstRow) * width * channels;
+			for(;srcPixel<srcEnd;++srcPixel,dstPixel+=channels){
+				*dstPixel = *srcPixel;
+			}
+		}
+
+		const PixelType * src;
+		PixelType * dst;
+		int width;
+		int channels;
+	};
 
+	channel = ofClamp(channel,0,channels-1);
+	SetChannelJob job(channelPixels.getData(), pixels + channel, width, channels);
+	runRowBands(job,height);
 }
 
 //From ofPixelsUtils
@@ -927,14 +1820,26 @@ void ofPixels_<PixelType>::cropTo(ofPixels_<PixelType> &toPix, int x, int y, int
 		int maxX = MIN(x+_width, width) * getNumChannels();
 		int minY = MAX(y, 0);
 		int maxY = MIN(y+_height, height);
+		if(maxX<=minX || maxY<=minY) return;
 
+		struct CropJob: public ofPixelsRowJob{
+			CropJob(const PixelType * src, PixelType * dst, int srcStride, int rowLength)
+			:src(src),dst(dst),srcStride(srcStride),rowLength(rowLength){}
 
-		iterator newPixel = toPix.begin();
-		for(ConstLine line = getConstLines().begin()+minY; line!=getConstLines().begin()+maxY; ++line ){
-			for(const_iterator pixel = line.begin()+minX; pixel<line.begin()+maxX; ++pixel){
-				*newPixel++ = *pixel;
+			void run(int firstRow, int lastRow){
+				for(int y=firstRow;y<lastRow;y++){
+					memcpy(dst + size_t(y) * rowLength, src + size_t(y) * srcStride, rowLength * sizeof(PixelType));
+				}
 			}
-		}
+
+			const PixelType * src;
+			PixelType * dst;
+			int srcStride;
+			int rowLength;
+		};
+
+		CropJob job(pixels + size_t(minY) * width * getNumChannels() + minX, toPix.getData(), width * getNumChannels(), maxX - minX);
+		runRowBands(job,maxY-minY);
 	}
 }
 
@@ -969,41 +1874,27 @@ void ofPixels_<PixelType>::rotate90To(ofPixels_<PixelType> & dst, int nClockwise
 		return;
 	}
 
-	// otherwise, we will need to do some new allocaiton.
-	dst.allocate(height,width,getImageType());
-    
-	int strideSrc = width * channels;
-	int strideDst = dst.width * channels;
-
-	if(rotation == 1){
-		PixelType * srcPixels = pixels;
-		PixelType * startPixels = dst.getData() + strideDst;
-		for (int i = 0; i < height; ++i){
-			startPixels -= channels;
-			PixelType * dstPixels = startPixels;
-			for (int j = 0; j < width; ++j){
-				for (int k = 0; k < channels; ++k){
-					dstPixels[k] = srcPixels[k];
-				}
-				srcPixels += channels;
-				dstPixels += strideDst;
-			}
-		}
-	} else if(rotation == 3){
-		PixelType * dstPixels = dst.pixels;
-		PixelType * startPixels = pixels + strideSrc;
-		for (int i = 0; i < dst.height; ++i){
-			startPixels -= channels;
-			PixelType * srcPixels = startPixels;
-			for (int j = 0; j < dst.width; ++j){
-				for (int k = 0; k < channels; ++k){
-					dstPixels[k] = srcPixels[k];
-				}
-				srcPixels += strideSrc;
-				dstPixels += channels;
-			}
+	struct RotateJob: public ofPixelsRowJob{
+		RotateJob(unsigned char * dst, const unsigned char * src, int width, int height, bool clockwise, int bytesPerPixel)
+		:dst(dst),src(src),width(width),height(height),clockwise(clockwise),bytesPerPixel(bytesPerPixel){}
+
+		void run(int firstRow, int lastRow){
+			rotatePixels(dst, src, width, height, clockwise, bytesPerPixel, firstRow, lastRow);
 		}
-	}
+
+		unsigned char * dst;
+		const unsigned char * src;
+		int width;
+		int height;
+		bool clockwise;
+		int bytesPerPixel;
+	};
+
+	// otherwise, we will need to do some new allocaiton.
+	dst.allocate(height,width,pixelFormat);
+
+	RotateJob job((unsigned char*)dst.pixels, (const unsigned char*)pixels, width, height, rotation == 1, channels * sizeof(PixelType));
+	runRowBands(job,height);
 }
 
 //----------------------------------------------------------------------
@@ -1033,9 +1924,7 @@ void ofPixels_<PixelType>::rotate90(int nClockwiseRotations){
 
 	ofPixels_<PixelType> newPixels;
 	rotate90To(newPixels,nClockwiseRotations);
-	std::swap(newPixels.pixels,pixels);
-	width = newPixels.width;
-	height = newPixels.height;
+	swap(newPixels);
 
 }
 
@@ -1044,38 +1933,50 @@ template<typename PixelType>
 void ofPixels_<PixelType>::mirror(bool vertically, bool horizontal){
 	int channels = channelsFromPixelFormat(pixelFormat);
 
-	if ((!vertically && !horizontal) || channels==0){
+	if ((!vertically && !horizontal) || channels==0 || !bAllocated){
 		return;
 	}
 
-	int bytesPerPixel = channels;
-	PixelType * oldPixels = pixels;
-	PixelType tempVal;
-
-	if (! (vertically && horizontal)){
-		int wToDo = horizontal ? width/2 : width;
-		int hToDo = vertically ? height/2 : height;
-
-		for (int i = 0; i < wToDo; i++){
-			for (int j = 0; j < hToDo; j++){
-
-				int pixelb = (vertically ? (height - j - 1) : j) * width + (horizontal ? (width - i - 1) : i);
-				int pixela = j*width + i;
-				for (int k = 0; k < bytesPerPixel; k++){
-
-					tempVal = oldPixels[pixela*bytesPerPixel + k];
-					oldPixels[pixela*bytesPerPixel + k] = oldPixels[pixelb*bytesPerPixel + k];
-					oldPixels[pixelb*bytesPerPixel + k] = tempVal;
-
+	// rows are mirrored through a temporary row so the kernels never have
+	// to deal with src and dst overlapping. when mirroring vertically each
+	// row of the top half is swapped with its pair in the bottom half
+	struct MirrorJob: public ofPixelsRowJob{
+		MirrorJob(unsigned char * data, int width, int height, int bytesPerPixel, bool vertically, bool horizontal)
+		:data(data),width(width),height(height),bytesPerPixel(bytesPerPixel),vertically(vertically),horizontal(horizontal){}
+
+		void run(int firstRow, int lastRow){
+			size_t stride = size_t(width) * bytesPerPixel;
+			vector<unsigned char> tmp(stride);
+			for(int y = firstRow; y < lastRow; y++){
+				unsigned char * top = data + y * stride;
+				if(vertically && y < height/2){
+					unsigned char * bottom = data + (height - y - 1) * stride;
+					memcpy(&tmp[0], top, stride);
+					if(horizontal){
+						mirrorRow(top, bottom, width, bytesPerPixel);
+						mirrorRow(bottom, &tmp[0], width, bytesPerPixel);
+					}else{
+						memcpy(top, bottom, stride);
+						memcpy(bottom, &tmp[0], stride);
+					}
+				}else if(horizontal){
+					// if mirroring in both directions only the middle row is left
+					memcpy(&tmp[0], top, stride);
+					mirrorRow(top, &tmp[0], width, bytesPerPixel);
 				}
 			}
 		}
-	} else {
-		// I couldn't think of a good way to do this in place.  I'm sure there is.
-		mirror(true, false);
-		mirror(false, true);
-	}
 
+		unsigned char * data;
+		int width;
+		int height;
+		int bytesPerPixel;
+		bool vertically;
+		bool horizontal;
+	};
+
+	MirrorJob job((unsigned char*)pixels, width, height, channels * sizeof(PixelType), vertically, horizontal);
+	runRowBands(job, vertically ? height - height/2 : height);
 }
 
 //----------------------------------------------------------------------
@@ -1091,36 +1992,40 @@ void ofPixels_<PixelType>::mirrorTo(ofPixels_<PixelType> & dst, bool vertically,
 		return;
 	}
 
-	int bytesPerPixel = getNumChannels();
-
-	if(vertically && !horizontal){
-		ofPixels_<PixelType>::Lines dstLines = dst.getLines();
-		ofPixels_<PixelType>::ConstLine lineSrc = getConstLines().begin();
-		ofPixels_<PixelType>::Line line = --dstLines.end();
-
-		for(; line>=dstLines.begin(); --line, ++lineSrc){
-			memcpy(line.begin(),lineSrc.begin(),line.getStride());
-		}
-	}else if (!vertically && horizontal){
-		int wToDo = width/2;
-		int hToDo = height;
-		for (int i = 0; i < wToDo; i++){
-			for (int j = 0; j < hToDo; j++){
-				int pixelb = i;
-				int pixela = j*width + i;
-				for (int k = 0; k < bytesPerPixel; k++){
-					dst[pixela*bytesPerPixel + k] = pixels[pixelb*bytesPerPixel + k];
-					dst[pixelb*bytesPerPixel + k] = pixels[pixela*bytesPerPixel + k];
+	if (!bAllocated){
+		return;
+	}
 
+	struct MirrorToJob: public ofPixelsRowJob{
+		MirrorToJob(unsigned char * dst, const unsigned char * src, int width, int height, int bytesPerPixel, bool vertically, bool horizontal)
+		:dst(dst),src(src),width(width),height(height),bytesPerPixel(bytesPerPixel),vertically(vertically),horizontal(horizontal){}
+
+		void run(int firstRow, int lastRow){
+			size_t stride = size_t(width) * bytesPerPixel;
+			for(int y = firstRow; y < lastRow; y++){
+				const unsigned char * srcRow = src + (vertically ? height - y - 1 : y) * stride;
+				unsigned char * dstRow = dst + y * stride;
+				if(horizontal){
+					mirrorRow(dstRow, srcRow, width, bytesPerPixel);
+				}else{
+					memcpy(dstRow, srcRow, stride);
 				}
 			}
 		}
-	} else {
-		// I couldn't think of a good way to do this in place.  I'm sure there is.
-		mirrorTo(dst,true, false);
-		dst.mirror(false, true);
-	}
 
+		unsigned char * dst;
+		const unsigned char * src;
+		int width;
+		int height;
+		int bytesPerPixel;
+		bool vertically;
+		bool horizontal;
+	};
+
+	dst.allocate(width, height, pixelFormat);
+
+	MirrorToJob job((unsigned char*)dst.pixels, (const unsigned char*)pixels, width, height, getNumChannels() * sizeof(PixelType), vertically, horizontal);
+	runRowBands(job,height);
 }
 
 //----------------------------------------------------------------------
@@ -1130,15 +2035,11 @@ bool ofPixels_<PixelType>::resize(int dstWidth, int dstHeight, ofInterpolationMe
 	if ((dstWidth<=0) || (dstHeight<=0) || !(isAllocated())) return false;
 
 	ofPixels_<PixelType> dstPixels;
-	dstPixels.allocate(dstWidth, dstHeight,getImageType());
+	dstPixels.allocate(dstWidth, dstHeight, pixelFormat);
 
 	if(!resizeTo(dstPixels,interpMethod)) return false;
 
-	delete [] pixels;
-	pixels = dstPixels.getData();
-	width  = dstWidth;
-	height = dstHeight;
-	dstPixels.pixelsOwner = false;
+	swap(dstPixels);
 	return true;
 }
 
@@ -1146,8 +2047,8 @@ bool ofPixels_<PixelType>::resize(int dstWidth, int dstHeight, ofInterpolationMe
 template<typename PixelType>
 float ofPixels_<PixelType>::bicubicInterpolate (const float *patch, float x,float y, float x2,float y2, float x3,float y3) {
 	// adapted from http://www.paulinternet.nl/?page=bicubic
-	// Note that this code can produce values outside of 0...255, due to cubic overshoot.
-	// The ofClamp() prevents this from happening.
+	// Note that this code can produce values outside of the range of PixelType,
+	// due to cubic overshoot. resizeTo() clamps the result.
 
 	float p00 = patch[ 0];
 	float p10 = patch[ 4];
@@ -1192,7 +2093,7 @@ float ofPixels_<PixelType>::bicubicInterpolate (const float *patch, float x,floa
     a20 * x2 + a21 * x2 * y + a22 * x2 * y2 + a23 * x2 * y3 +
     a30 * x3 + a31 * x3 * y + a32 * x3 * y2 + a33 * x3 * y3;
 
-	return MIN(255, MAX(out, 0));
+	return out;
 }
 
 //----------------------------------------------------------------------
@@ -1202,14 +2103,269 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 		return true;
 	}
 
-	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel()) return false;
+	return getView().resizeTo(dst,interpMethod);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, int xTo, int yTo) const{
+	return getView().pasteInto(dst,xTo,yTo);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixels_<PixelType>::getView() const{
+	return ofPixelsView_<PixelType>(*this);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixels_<PixelType>::getView(int x, int y, int _width, int _height) const{
+	return getView().getView(x,y,_width,_height);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixels_<PixelType>::getPlaneView(int plane) const{
+	size_t offset;
+	int planeWidth, planeHeight;
+	ofPixelFormat planeFormat;
+	if(!bAllocated || !getPlaneLayout(width,height,pixelFormat,plane,offset,planeWidth,planeHeight,planeFormat)){
+		return ofPixelsView_<PixelType>();
+	}
+	return ofPixelsView_<PixelType>(pixels+offset,planeWidth,planeHeight,planeFormat);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixels_<PixelType>::getChannelView(int channel) const{
+	return getView().getChannelView(channel);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+void ofPixels_<PixelType>::setFromPixels(const ofPixelsView_<PixelType> & view){
+	if(!view.isAllocated()){
+		clear();
+		return;
+	}
+
+	// if the view references these pixels allocating could free them
+	if(bAllocated && view.getData()>=pixels && view.getData()<pixels+pixelsSize){
+		ofPixels_<PixelType> copy;
+		copy.setFromPixels(view);
+		swap(copy);
+		return;
+	}
+
+	if(view.isContiguous()){
+		setFromPixels(view.getData(),view.getWidth(),view.getHeight(),view.getPixelFormat());
+		return;
+	}
+
+	allocate(view.getWidth(),view.getHeight(),view.getPixelFormat());
+	int channels = view.getNumChannels();
+	size_t rowLength = size_t(width) * channels;
+	for(int y=0;y<height;y++){
+		const PixelType * src = view.getLine(y);
+		PixelType * dst = pixels + y * rowLength;
+		if(view.getPixelStride()==channels){
+			memcpy(dst,src,rowLength*sizeof(PixelType));
+		}else{
+			for(int x=0;x<width;x++,src+=view.getPixelStride(),dst+=channels){
+				for(int c=0;c<channels;c++){
+					dst[c] = src[c];
+				}
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_()
+:data(NULL)
+,width(0)
+,height(0)
+,stride(0)
+,pixelStride(0)
+,pixelFormat(OF_PIXELS_UNKNOWN){
+
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(const ofPixels_<PixelType> & pixels)
+:data(pixels.isAllocated() ? pixels.getData() : NULL)
+,width(pixels.getWidth())
+,height(pixels.getHeight())
+,stride(pixels.getWidth() * pixels.getNumChannels())
+,pixelStride(pixels.getNumChannels())
+,pixelFormat(pixels.getPixelFormat()){
+
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType>::ofPixelsView_(const PixelType * data, int width, int height, ofPixelFormat pixelFormat, int stride, int pixelStride)
+:data(data)
+,width(width)
+,height(height)
+,stride(stride)
+,pixelStride(pixelStride)
+,pixelFormat(pixelFormat){
+	if(this->pixelStride<=0) this->pixelStride = channelsFromPixelFormat(pixelFormat);
+	if(this->stride<=0) this->stride = width * this->pixelStride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::isAllocated() const{
+	return data!=NULL;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+const PixelType * ofPixelsView_<PixelType>::getData() const{
+	return data;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+const PixelType * ofPixelsView_<PixelType>::getLine(int y) const{
+	return data + ptrdiff_t(y) * stride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getWidth() const{
+	return width;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getHeight() const{
+	return height;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getNumChannels() const{
+	return channelsFromPixelFormat(pixelFormat);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelFormat ofPixelsView_<PixelType>::getPixelFormat() const{
+	return pixelFormat;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofImageType ofPixelsView_<PixelType>::getImageType() const{
+	return ofImageTypeFromPixelFormat(pixelFormat);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getStride() const{
+	return stride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+int ofPixelsView_<PixelType>::getPixelStride() const{
+	return pixelStride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::isContiguous() const{
+	return pixelStride == getNumChannels() && stride == width * pixelStride;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofColor_<PixelType> ofPixelsView_<PixelType>::getColor(int x, int y) const{
+	return typename ofPixels_<PixelType>::ConstPixel(getLine(y) + x * pixelStride, getNumChannels(), pixelFormat).getColor();
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixelsView_<PixelType>::getView(int x, int y, int _width, int _height) const{
+	int x0 = ofClamp(x,0,width);
+	int y0 = ofClamp(y,0,height);
+	int x1 = ofClamp(x+_width,x0,width);
+	int y1 = ofClamp(y+_height,y0,height);
+	if(!isAllocated() || x1==x0 || y1==y0){
+		return ofPixelsView_<PixelType>();
+	}
+	return ofPixelsView_<PixelType>(getLine(y0) + x0 * pixelStride, x1-x0, y1-y0, pixelFormat, stride, pixelStride);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+ofPixelsView_<PixelType> ofPixelsView_<PixelType>::getChannelView(int channel) const{
+	int channels = getNumChannels();
+	if(!isAllocated()){
+		return ofPixelsView_<PixelType>();
+	}
+	channel = ofClamp(channel,0,channels-1);
+	return ofPixelsView_<PixelType>(data + channel, width, height, OF_PIXELS_GRAY, stride, pixelStride);
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, int xTo, int yTo) const{
+	if (!(isAllocated()) || !(dst.isAllocated()) || getNumChannels() != dst.getNumChannels() || xTo>=dst.getWidth() || yTo>=dst.getHeight()) return false;
+
+	struct PasteJob: public ofPixelsRowJob{
+		PasteJob(PixelType * dst, const ofPixelsView_<PixelType> & src, int dstStride, int columnsToCopy)
+		:dst(dst),src(src),dstStride(dstStride),columnsToCopy(columnsToCopy){}
+
+		void run(int firstRow, int lastRow){
+			int channels = src.getNumChannels();
+			for(int y=firstRow;y<lastRow; y++){
+				const PixelType * srcPix = src.getLine(y);
+				PixelType * dstPix = dst + size_t(y) * dstStride;
+				if(src.getPixelStride()==channels){
+					memcpy(dstPix,srcPix,columnsToCopy*channels*sizeof(PixelType));
+				}else{
+					for(int x=0;x<columnsToCopy;x++,srcPix+=src.getPixelStride(),dstPix+=channels){
+						for(int c=0;c<channels;c++){
+							dstPix[c] = srcPix[c];
+						}
+					}
+				}
+			}
+		}
+
+		PixelType * dst;
+		const ofPixelsView_<PixelType> & src;
+		int dstStride;
+		int columnsToCopy;
+	};
+
+	int columnsToCopy = xTo + getWidth()<=dst.getWidth() ? getWidth() : dst.getWidth()-xTo;
+	int rowsToCopy = yTo + getHeight() <= dst.getHeight() ? getHeight() : dst.getHeight()-yTo;
+	PixelType * dstPix = dst.getData() + ((xTo + yTo*dst.getWidth())*dst.getNumChannels());
+	int dstStride = dst.getWidth()*dst.getNumChannels();
+
+	PasteJob job(dstPix,*this,dstStride,columnsToCopy);
+	runRowBands(job,rowsToCopy);
+
+	return true;
+}
+
+//----------------------------------------------------------------------
+template<typename PixelType>
+bool ofPixelsView_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMethod interpMethod) const{
+	if (!(isAllocated()) || !(dst.isAllocated()) || getNumChannels() != dst.getNumChannels()) return false;
 
 	int srcWidth      = getWidth();
 	int srcHeight     = getHeight();
 	int dstWidth	  = dst.getWidth();
 	int dstHeight	  = dst.getHeight();
-	int bytesPerPixel = getBytesPerPixel();
-
 
 	PixelType * dstPixels = dst.getData();
 
@@ -1217,24 +2373,68 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 
 			//----------------------------------------
 		case OF_INTERPOLATE_NEAREST_NEIGHBOR:{
-			int dstIndex = 0;
+			struct NearestJob: public ofPixelsRowJob{
+				NearestJob(PixelType * dst, const ofPixelsView_<PixelType> & src, const float * srcxs, const int * srcRows, int dstWidth)
+				:dst(dst),src(src),srcxs(srcxs),srcRows(srcRows),dstWidth(dstWidth){}
+
+				void run(int firstRow, int lastRow){
+					int srcWidth = src.getWidth();
+					int channels = src.getNumChannels();
+					int pixelStride = src.getPixelStride();
+					size_t dstStride = size_t(dstWidth) * channels;
+					vector<int> srcIndices(dstWidth);
+					PixelType * dstRow = dst + firstRow * dstStride;
+					for (int dsty=firstRow; dsty<lastRow; dsty++, dstRow+=dstStride){
+						const PixelType * srcRow = src.getLine(srcRows[dsty]);
+						if(dsty>firstRow && srcRows[dsty] == srcRows[dsty-1]){
+							memcpy(dstRow, dstRow - dstStride, dstStride * sizeof(PixelType));
+							continue;
+						}
+						nearestIndices(&srcIndices[0], srcxs, srcRows[dsty] * srcWidth, srcWidth, dstWidth);
+						if(pixelStride == channels){
+							gatherRow((unsigned char*)dstRow, (const unsigned char*)srcRow, &srcIndices[0], dstWidth, channels * sizeof(PixelType));
+						}else{
+							PixelType * dstPixel = dstRow;
+							for(int x=0; x<dstWidth; x++, dstPixel+=channels){
+								for(int c=0; c<channels; c++){
+									dstPixel[c] = srcRow[srcIndices[x] * pixelStride + c];
+								}
+							}
+						}
+					}
+				}
+
+				PixelType * dst;
+				const ofPixelsView_<PixelType> & src;
+				const float * srcxs;
+				const int * srcRows;
+				int dstWidth;
+			};
+
 			float srcxFactor = (float)srcWidth/dstWidth;
 			float srcyFactor = (float)srcHeight/dstHeight;
+
+			// the x positions are the same for every row, only the row
+			// offset changes, the source index is int(rowIndex + srcx) as
+			// it always was so the output doesn't change. when upscaling
+			// consecutive rows often sample the same source row so those
+			// are just copied
+			vector<float> srcxs(dstWidth);
+			float srcx = 0.5;
+			for (int dstx=0; dstx<dstWidth; dstx++){
+				srcxs[dstx] = srcx;
+				srcx+=srcxFactor;
+			}
+
+			vector<int> srcRows(dstHeight);
 			float srcy = 0.5;
 			for (int dsty=0; dsty<dstHeight; dsty++){
-				float srcx = 0.5;
-				int srcIndex = int(srcy)*srcWidth;
-				for (int dstx=0; dstx<dstWidth; dstx++){
-					int pixelIndex = int(srcIndex + srcx) * bytesPerPixel;
-					for (int k=0; k<bytesPerPixel; k++){
-						dstPixels[dstIndex] = pixels[pixelIndex];
-						dstIndex++;
-						pixelIndex++;
-					}
-					srcx+=srcxFactor;
-				}
+				srcRows[dsty] = MIN(int(srcy), srcHeight-1);
 				srcy+=srcyFactor;
 			}
+
+			NearestJob job(dstPixels, *this, &srcxs[0], &srcRows[0], dstWidth);
+			runRowBands(job,dstHeight);
 		}break;
 
 			//----------------------------------------
@@ -1244,81 +2444,75 @@ bool ofPixels_<PixelType>::resizeTo(ofPixels_<PixelType>& dst, ofInterpolationMe
 			break;
 
 			//----------------------------------------
-		case OF_INTERPOLATE_BICUBIC:
-			float px1, py1;
-			float px2, py2;
-			float px3, py3;
+		case OF_INTERPOLATE_BICUBIC:{
+			struct BicubicJob: public ofPixelsRowJob{
+				BicubicJob(PixelType * dstPixels, const ofPixelsView_<PixelType> & src, int dstWidth, int dstHeight)
+				:dstPixels(dstPixels),src(src),dstWidth(dstWidth),dstHeight(dstHeight){}
+
+				void run(int firstRow, int lastRow){
+					int srcWidth = src.getWidth();
+					int srcHeight = src.getHeight();
+					int bytesPerPixel = src.getNumChannels();
+
+					float px1, py1;
+					float px2, py2;
+					float px3, py3;
+
+					float interpCol;
+					float patch[16];
+					int patchX[4];
+					const PixelType * patchRows[4];
+
+					for (int dsty=firstRow; dsty<lastRow; dsty++){
+						float srcyf = srcHeight * (float)dsty/(float)dstHeight;
+						int   srcy = (int) MIN(srcHeight-1,  srcyf);
+						py1 = srcyf - srcy;
+						py2 = py1 * py1;
+						py3 = py2 * py1;
+
+						// samples outside of the image are clamped to the edge
+						for (int dy=0; dy<4; dy++) {
+							patchRows[dy] = src.getLine(MAX(0, MIN(srcy+dy-1, srcHeight-1)));
+						}
 
-			float srcColor = 0;
-			float interpCol;
-			int patchRow;
-			int patchIndex;
-			float patch[16];
+						for (int dstx=0; dstx<dstWidth; dstx++){
 
-			int srcRowBytes = srcWidth*bytesPerPixel;
-			int loIndex = (srcRowBytes)+1;
-			int hiIndex = (srcWidth*srcHeight*bytesPerPixel)-(srcRowBytes)-1;
+							int   dstIndex0 = (dsty*dstWidth + dstx) * bytesPerPixel;
+							float srcxf = srcWidth  * (float)dstx/(float)dstWidth;
+							int   srcx = (int) MIN(srcWidth-1,   srcxf);
 
-			for (int dsty=0; dsty<dstHeight; dsty++){
-				for (int dstx=0; dstx<dstWidth; dstx++){
-
-					int   dstIndex0 = (dsty*dstWidth + dstx) * bytesPerPixel;
-					float srcxf = srcWidth  * (float)dstx/(float)dstWidth;
-					float srcyf = srcHeight * (float)dsty/(float)dstHeight;
-					int   srcx = (int) MIN(srcWidth-1,   srcxf);
-					int   srcy = (int) MIN(srcHeight-1,  srcyf);
-					int   srcIndex0 = (srcy*srcWidth + srcx) * bytesPerPixel;
-
-					px1 = srcxf - srcx;
-					py1 = srcyf - srcy;
-					px2 = px1 * px1;
-					px3 = px2 * px1;
-					py2 = py1 * py1;
-					py3 = py2 * py1;
-
-					for (int k=0; k<bytesPerPixel; k++){
-						int   dstIndex = dstIndex0+k;
-						int   srcIndex = srcIndex0+k;
+							px1 = srcxf - srcx;
+							px2 = px1 * px1;
+							px3 = px2 * px1;
 
-						for (int dy=0; dy<4; dy++) {
-							patchRow = srcIndex + ((dy-1)*srcRowBytes);
 							for (int dx=0; dx<4; dx++) {
-								patchIndex = patchRow + (dx-1)*bytesPerPixel;
-								if ((patchIndex >= loIndex) && (patchIndex < hiIndex)) {
-									srcColor = pixels[patchIndex];
+								patchX[dx] = MAX(0, MIN(srcx+dx-1, srcWidth-1)) * src.getPixelStride();
+							}
+
+							for (int k=0; k<bytesPerPixel; k++){
+								for (int dy=0; dy<4; dy++) {
+									for (int dx=0; dx<4; dx++) {
+										patch[dx*4 + dy] = patchRows[dy][patchX[dx] + k];
+									}
 								}
-								patch[dx*4 + dy] = srcColor;
+
+								interpCol = (PixelType)ofClamp(ofPixels_<PixelType>::bicubicInterpolate(patch, px1,py1, px2,py2, px3,py3), 0, ofColor_<PixelType>::limit());
+								dstPixels[dstIndex0+k] = interpCol;
 							}
-						}
 
-						interpCol = (PixelType)bicubicInterpolate(patch, px1,py1, px2,py2, px3,py3);
-						dstPixels[dstIndex] = interpCol;
+						}
 					}
-
 				}
-			}
-			break;
-	}
 
-	return true;
-}
+				PixelType * dstPixels;
+				const ofPixelsView_<PixelType> & src;
+				int dstWidth;
+				int dstHeight;
+			};
 
-//----------------------------------------------------------------------
-template<typename PixelType>
-bool ofPixels_<PixelType>::pasteInto(ofPixels_<PixelType> &dst, int xTo, int yTo) const{
-	if (!(isAllocated()) || !(dst.isAllocated()) || getBytesPerPixel() != dst.getBytesPerPixel() || xTo>=dst.getWidth() || yTo>=dst.getHeight()) return false;
-
-	int bytesToCopyPerRow = (xTo + getWidth()<=dst.getWidth() ? getWidth() : dst.getWidth()-xTo) * getBytesPerPixel();
-	int columnsToCopy = yTo + getHeight() <= dst.getHeight() ? getHeight() : dst.getHeight()-yTo;
-	PixelType * dstPix = dst.getData() + ((xTo + yTo*dst.getWidth())*dst.getBytesPerPixel());
-	const PixelType * srcPix = getData();
-	int srcStride = getWidth()*getBytesPerPixel();
-	int dstStride = dst.getWidth()*dst.getBytesPerPixel();
-
-	for(int y=0;y<columnsToCopy; y++){
-		memcpy(dstPix,srcPix,bytesToCopyPerRow);
-		dstPix += dstStride;
-		srcPix += srcStride;
+			BicubicJob job(dstPixels, *this, dstWidth, dstHeight);
+			runRowBands(job,dstHeight);
+		}break;
 	}
 
 	return true;
@@ -1335,3 +2529,14 @@ template class ofPixels_<long>;
 template class ofPixels_<unsigned long>;
 template class ofPixels_<float>;
 template class ofPixels_<double>;
+
+template class ofPixelsView_<char>;
+template class ofPixelsView_<unsigned char>;
+template class ofPixelsView_<short>;
+template class ofPixelsView_<unsigned short>;
+template class ofPixelsView_<int>;
+template class ofPixelsView_<unsigned int>;
+template class ofPixelsView_<long>;
+template class ofPixelsView_<unsigned long>;
+template class ofPixelsView_<float>;
+template class ofPixelsView_<double>;
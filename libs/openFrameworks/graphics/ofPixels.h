@@ -54,6 +54,54 @@ enum ofInterpolationMethod {
 	OF_INTERPOLATE_BICUBIC			=3
 };
 
+/// \brief Enables the SSE2/SSSE3/AVX2/NEON code paths used by ofPixels_ to
+/// mirror, rotate, resize and swap channels.
+///
+/// They are enabled by default and the best instruction set the cpu
+/// supports is selected at runtime. The results are exactly the same as
+/// with the scalar fallback.
+void ofEnablePixelsSimd();
+
+/// \brief Disables the SIMD code paths in ofPixels_, falling back to
+/// scalar loops. Mostly useful for benchmarking and debugging.
+void ofDisablePixelsSimd();
+
+/// \brief Check whether ofPixels_ is using any SIMD code path
+bool ofGetUsingPixelsSimd();
+
+/// \brief Get the name of the instruction set used by ofPixels_,
+/// one of "AVX2", "SSSE3", "SSE2", "NEON" or "none"
+string ofGetPixelsSimdInstructionSet();
+
+/// \brief Enables running ofPixels_ bulk operations in parallel
+///
+/// Resizing, cropping, mirroring, rotating, pasting, swapping rgb, getting
+/// and setting channels and changing the image type split the image in
+/// bands of rows that are processed by the global ofThreadPool, with as
+/// many threads as cores in the machine.
+/// Disabled by default. The results are exactly the same as when running
+/// on a single thread.
+void ofEnablePixelsThreads();
+
+/// \brief Disables running ofPixels_ bulk operations in parallel
+void ofDisablePixelsThreads();
+
+/// \brief Check whether ofPixels_ bulk operations run in parallel
+bool ofGetUsingPixelsThreads();
+
+/// \brief Sets the minimum number of rows each thread processes
+///
+/// Images with less than twice this number of rows are always processed
+/// on the calling thread, since for small images starting the work on
+/// other threads costs more than it saves. Defaults to 64.
+void ofSetPixelsThreadsMinBandSize(int rows);
+
+/// \brief Get the minimum number of rows each thread processes
+int ofGetPixelsThreadsMinBandSize();
+
+
+template <typename PixelType>
+class ofPixelsView_;
 
 /// \brief A class representing a collection of pixels.
 template <typename PixelType>
@@ -132,6 +180,11 @@ public:
 	void setFromExternalPixels(PixelType * newPixels,int w, int h, ofPixelFormat pixelFormat);
 	void setFromAlignedPixels(const PixelType * newPixels, int width, int height, int channels, int stride);
 	void setFromAlignedPixels(const PixelType * newPixels, int width, int height, ofPixelFormat pixelFormat, int stride);
+
+	/// \brief Copy the pixels referenced by a view, allocating if needed
+	///
+	/// The view can reference these same pixels.
+	void setFromPixels(const ofPixelsView_<PixelType> & view);
 	
 	void swap(ofPixels_<PixelType> & pix);
 
@@ -283,6 +336,26 @@ public:
 	int getNumPlanes() const;
 
 	ofPixels_<PixelType> getPlane(int plane);
+
+	/// \brief Get a view of all the pixels, without copying them
+	ofPixelsView_<PixelType> getView() const;
+
+	/// \brief Get a view of a rectangle of the pixels, without copying them
+	///
+	/// The rectangle is clipped to the size of the pixels. This is the
+	/// equivalent of cropTo() without allocating or copying anything.
+	/// Only valid for formats with one plane.
+	ofPixelsView_<PixelType> getView(int x, int y, int width, int height) const;
+
+	/// \brief Get a view of one plane of planar formats like NV12 or I420
+	///
+	/// For formats with one plane returns a view of all the pixels.
+	ofPixelsView_<PixelType> getPlaneView(int plane) const;
+
+	/// \brief Get a grayscale view of one channel, without copying it
+	///
+	/// \sa getChannel()
+	ofPixelsView_<PixelType> getChannelView(int channel) const;
 	
 	/// \brief Get all values of one channel
 	///
@@ -521,6 +594,7 @@ public:
     /// \endcond
 
 private:
+	friend class ofPixelsView_<PixelType>;
 	static float bicubicInterpolate(const float *patch, float x,float y, float x2,float y2, float x3,float y3);
 
 	void copyFrom( const ofPixels_<PixelType>& mom );
@@ -536,15 +610,105 @@ private:
 	int 	pixelsSize;
 	bool	bAllocated;
 	bool	pixelsOwner;			// if set from external data don't delete it
+	bool	pixelsPooled;			// allocated from ofPixelsPool, return it there
 	ofPixelFormat pixelFormat;
 
 };
 
 
+/// \brief A read only view of pixels owned by someone else.
+///
+/// A view references a rectangle, a plane or a channel of an ofPixels_ or of
+/// any other buffer by a pointer, the distance between rows and the distance
+/// between pixels, so getting one doesn't allocate or copy anything:
+///
+/// ~~~~{.cpp}
+/// ofPixels frame;
+/// // ...
+/// ofPixelsView roi = frame.getView(100, 100, 320, 240);
+/// ofSaveImage(roi, "roi.png");
+/// texture.loadData(frame.getChannelView(1));
+/// ~~~~
+///
+/// The view doesn't keep the pixels alive, it's invalid once they are
+/// reallocated or destroyed.
+template <typename PixelType>
+class ofPixelsView_ {
+public:
+	ofPixelsView_();
+
+	/// \brief View all the pixels of an ofPixels_
+	ofPixelsView_(const ofPixels_<PixelType> & pixels);
+
+	/// \brief View external pixel data
+	/// \param data Pointer to the first component of the first pixel
+	/// \param width Width in pixels
+	/// \param height Height in pixels
+	/// \param pixelFormat Format of each pixel
+	/// \param stride Number of components from the start of one row to the
+	/// next, 0 if rows are tightly packed
+	/// \param pixelStride Number of components from one pixel to the next,
+	/// 0 if pixels are tightly packed
+	ofPixelsView_(const PixelType * data, int width, int height, ofPixelFormat pixelFormat, int stride=0, int pixelStride=0);
+
+	bool isAllocated() const;
+	const PixelType * getData() const;
+
+	/// \brief Get a pointer to the first component of a row
+	const PixelType * getLine(int y) const;
+
+	int getWidth() const;
+	int getHeight() const;
+	int getNumChannels() const;
+	ofPixelFormat getPixelFormat() const;
+	ofImageType getImageType() const;
+
+	/// \brief Number of components from the start of one row to the next
+	int getStride() const;
+
+	/// \brief Number of components from one pixel to the next
+	int getPixelStride() const;
+
+	/// \brief Whether the pixels are tightly packed, like in an ofPixels_
+	bool isContiguous() const;
+
+	ofColor_<PixelType> getColor(int x, int y) const;
+
+	/// \brief Get a view of a rectangle of this view, clipped to its size
+	ofPixelsView_<PixelType> getView(int x, int y, int width, int height) const;
+
+	/// \brief Get a grayscale view of one channel of this view
+	ofPixelsView_<PixelType> getChannelView(int channel) const;
+
+	/// \brief Paste the pixels into dst at x, y cropping them if they
+	/// don't fit.
+	/// \sa ofPixels_::pasteInto()
+	bool pasteInto(ofPixels_<PixelType> & dst, int x, int y) const;
+
+	/// \brief Resize the pixels to the size of dst.
+	///
+	/// dst can't reference the same pixels as the view.
+	/// \sa ofPixels_::resizeTo()
+	bool resizeTo(ofPixels_<PixelType> & dst, ofInterpolationMethod interpMethod=OF_INTERPOLATE_NEAREST_NEIGHBOR) const;
+
+private:
+	const PixelType * data;
+	int width;
+	int height;
+	int stride;
+	int pixelStride;
+	ofPixelFormat pixelFormat;
+};
+
+
 typedef ofPixels_<unsigned char> ofPixels;
 typedef ofPixels_<float> ofFloatPixels;
 typedef ofPixels_<unsigned short> ofShortPixels;
 
+typedef ofPixelsView_<unsigned char> ofPixelsView;
+typedef ofPixelsView_<float> ofFloatPixelsView;
+typedef ofPixelsView_<unsigned short> ofShortPixelsView;
+
 
 typedef ofPixels& ofPixelsRef;
 typedef ofFloatPixels& ofFloatPixelsRef;
@@ -562,6 +726,7 @@ template<typename SrcType>
 ofPixels_<PixelType>::ofPixels_(const ofPixels_<SrcType> & mom){
 	bAllocated = false;
 	pixelsOwner = false;
+	pixelsPooled = false;
 	pixelsSize = 0;
 	pixels = NULL;
 	width = 0;
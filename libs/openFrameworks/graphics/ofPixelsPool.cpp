@@ -0,0 +1,224 @@
+#include "ofPixelsPool.h"
+#include "ofLog.h"
+
+#ifdef TARGET_WIN32
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+static bool & pixelsPoolEnabled(){
+	static bool enabled = false;
+	return enabled;
+}
+
+//----------------------------------------------------------------------
+void ofEnablePixelsPool(){
+	pixelsPoolEnabled() = true;
+}
+
+//----------------------------------------------------------------------
+void ofDisablePixelsPool(){
+	pixelsPoolEnabled() = false;
+}
+
+//----------------------------------------------------------------------
+bool ofGetUsingPixelsPool(){
+	return pixelsPoolEnabled();
+}
+
+//----------------------------------------------------------------------
+static void * allocateAligned(size_t size){
+#ifdef TARGET_WIN32
+	return _aligned_malloc(size, ofPixelsPool::getPageSize());
+#else
+	void * data = NULL;
+	if(posix_memalign(&data, ofPixelsPool::getPageSize(), size) != 0){
+		return NULL;
+	}
+	return data;
+#endif
+}
+
+//----------------------------------------------------------------------
+static void freeAligned(void * data){
+#ifdef TARGET_WIN32
+	_aligned_free(data);
+#else
+	free(data);
+#endif
+}
+
+//----------------------------------------------------------------------
+ofPixelsPool & ofPixelsPool::get(){
+	// never destroyed so pixels in static objects can still be released
+	// to it on exit
+	static ofPixelsPool * pool = new ofPixelsPool;
+	return *pool;
+}
+
+//----------------------------------------------------------------------
+ofPixelsPool::ofPixelsPool()
+:maxFreeBytes(256 * 1024 * 1024)
+,freeBytes(0)
+,usedBytes(0)
+,numFreeBuffers(0)
+,hits(0)
+,misses(0){
+
+}
+
+//----------------------------------------------------------------------
+ofPixelsPool::~ofPixelsPool(){
+	clear();
+}
+
+//----------------------------------------------------------------------
+void * ofPixelsPool::allocate(size_t size){
+	ofScopedLock lock(mutex);
+	void * data = NULL;
+	std::map<size_t, std::vector<void*> >::iterator it = freeBuffers.find(size);
+	if(it != freeBuffers.end()){
+		data = it->second.back();
+		freeBytes -= size;
+		numFreeBuffers--;
+		it->second.pop_back();
+		if(it->second.empty()){
+			freeBuffers.erase(it);
+		}
+		hits++;
+	}else{
+		data = allocateAligned(size);
+		if(data == NULL){
+			ofLogError("ofPixelsPool") << "allocate(): couldn't allocate " << size << " bytes";
+			return NULL;
+		}
+		misses++;
+	}
+
+	usedBuffers[data] = size;
+	usedBytes += size;
+	return data;
+}
+
+//----------------------------------------------------------------------
+bool ofPixelsPool::release(void * data){
+	ofScopedLock lock(mutex);
+	std::map<void*, size_t>::iterator it = usedBuffers.find(data);
+	if(it == usedBuffers.end()){
+		ofLogError("ofPixelsPool") << "release(): buffer wasn't allocated by this pool";
+		return false;
+	}
+
+	size_t size = it->second;
+	usedBuffers.erase(it);
+	usedBytes -= size;
+
+	if(size > maxFreeBytes){
+		freeAligned(data);
+		return true;
+	}
+
+	trim(maxFreeBytes - size);
+	freeBuffers[size].push_back(data);
+	freeBytes += size;
+	numFreeBuffers++;
+	return true;
+}
+
+//----------------------------------------------------------------------
+void ofPixelsPool::trim(size_t bytes){
+	std::map<size_t, std::vector<void*> >::iterator it = freeBuffers.begin();
+	while(freeBytes > bytes && it != freeBuffers.end()){
+		while(freeBytes > bytes && !it->second.empty()){
+			freeAligned(it->second.back());
+			freeBytes -= it->first;
+			numFreeBuffers--;
+			it->second.pop_back();
+		}
+		if(it->second.empty()){
+			freeBuffers.erase(it++);
+		}else{
+			++it;
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+void ofPixelsPool::clear(){
+	ofScopedLock lock(mutex);
+	trim(0);
+}
+
+//----------------------------------------------------------------------
+void ofPixelsPool::setMaxFreeBytes(size_t bytes){
+	ofScopedLock lock(mutex);
+	maxFreeBytes = bytes;
+	trim(maxFreeBytes);
+}
+
+//----------------------------------------------------------------------
+size_t ofPixelsPool::getMaxFreeBytes() const{
+	ofScopedLock lock(mutex);
+	return maxFreeBytes;
+}
+
+//----------------------------------------------------------------------
+uint64_t ofPixelsPool::getHits() const{
+	ofScopedLock lock(mutex);
+	return hits;
+}
+
+//----------------------------------------------------------------------
+uint64_t ofPixelsPool::getMisses() const{
+	ofScopedLock lock(mutex);
+	return misses;
+}
+
+//----------------------------------------------------------------------
+void ofPixelsPool::resetCounters(){
+	ofScopedLock lock(mutex);
+	hits = 0;
+	misses = 0;
+}
+
+//----------------------------------------------------------------------
+size_t ofPixelsPool::getNumFreeBuffers() const{
+	ofScopedLock lock(mutex);
+	return numFreeBuffers;
+}
+
+//----------------------------------------------------------------------
+size_t ofPixelsPool::getFreeBytes() const{
+	ofScopedLock lock(mutex);
+	return freeBytes;
+}
+
+//----------------------------------------------------------------------
+size_t ofPixelsPool::getNumUsedBuffers() const{
+	ofScopedLock lock(mutex);
+	return usedBuffers.size();
+}
+
+//----------------------------------------------------------------------
+size_t ofPixelsPool::getUsedBytes() const{
+	ofScopedLock lock(mutex);
+	return usedBytes;
+}
+
+//----------------------------------------------------------------------
+size_t ofPixelsPool::getPageSize(){
+	static size_t pageSize = 0;
+	if(pageSize == 0){
+#ifdef TARGET_WIN32
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		pageSize = info.dwPageSize;
+#else
+		long size = sysconf(_SC_PAGESIZE);
+		pageSize = size > 0 ? size : 4096;
+#endif
+	}
+	return pageSize;
+}
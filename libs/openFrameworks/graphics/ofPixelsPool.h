@@ -0,0 +1,111 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofTypes.h"
+#include <map>
+
+
+/// \brief Enables drawing the storage of every ofPixels_ from the shared
+/// ofPixelsPool.
+///
+/// Once enabled, allocating an ofPixels_ reuses a buffer previously
+/// released by an ofPixels_ of the same size in bytes, and clearing or destroying it returns the buffer to the pool instead of
+/// deleting it. That avoids the allocations and page faults of code that
+/// reallocates large pixels every frame, like video grabbers and players.
+/// Disabled by default.
+void ofEnablePixelsPool();
+
+/// \brief Disables pooling ofPixels_ storage, pixels allocated while the
+/// pool was enabled are still returned to it when cleared.
+void ofDisablePixelsPool();
+
+/// \brief Check whether ofPixels_ draws its storage from ofPixelsPool
+bool ofGetUsingPixelsPool();
+
+
+/// \brief A thread safe pool of page aligned pixel buffers.
+///
+/// Buffers are keyed on their size in bytes, so pixels that change their
+/// dimensions or format in place, like a rotated ofPixels_, still return
+/// their buffer to the right list. ofPixels_ uses the shared instance
+/// returned by ofPixelsPool::get() when ofEnablePixelsPool() has been
+/// called. Buffers can be allocated in one thread and released in any
+/// other.
+///
+/// ~~~~{.cpp}
+/// ofEnablePixelsPool();
+/// // ...
+/// ofPixelsPool & pool = ofPixelsPool::get();
+/// ofLogNotice() << "pixels pool hits: " << pool.getHits()
+///               << " misses: " << pool.getMisses();
+/// ~~~~
+class ofPixelsPool{
+public:
+	/// \brief Get the pool shared by all ofPixels_
+	static ofPixelsPool & get();
+
+	/// \brief Get a page aligned buffer of size bytes
+	///
+	/// Returns a free buffer of the same size if there's one or allocates
+	/// a new one otherwise. The buffer has to be returned with release().
+	/// \returns The buffer or NULL if it couldn't be allocated.
+	void * allocate(size_t size);
+
+	/// \brief Return a buffer obtained from allocate() to the pool
+	///
+	/// If keeping it would make the free buffers exceed getMaxFreeBytes()
+	/// the buffer is deleted instead.
+	/// \returns false if the buffer wasn't allocated by this pool
+	bool release(void * data);
+
+	/// \brief Delete all the free buffers, buffers in use are not affected
+	void clear();
+
+	/// \brief Set the maximum number of bytes kept in free buffers,
+	/// 256MB by default
+	void setMaxFreeBytes(size_t bytes);
+	size_t getMaxFreeBytes() const;
+
+	/// \brief Number of allocations served with a free buffer
+	uint64_t getHits() const;
+
+	/// \brief Number of allocations that needed a new buffer
+	uint64_t getMisses() const;
+
+	/// \brief Reset the hits and misses counters to 0
+	void resetCounters();
+
+	/// \brief Number of buffers waiting to be reused
+	size_t getNumFreeBuffers() const;
+
+	/// \brief Total size of the buffers waiting to be reused
+	size_t getFreeBytes() const;
+
+	/// \brief Number of buffers allocated from the pool and not released yet
+	size_t getNumUsedBuffers() const;
+
+	/// \brief Total size of the buffers allocated from the pool and not
+	/// released yet
+	size_t getUsedBytes() const;
+
+	/// \brief Size of a memory page, buffers are aligned to it
+	static size_t getPageSize();
+
+private:
+	ofPixelsPool();
+	~ofPixelsPool();
+	ofPixelsPool(const ofPixelsPool &);
+	ofPixelsPool & operator=(const ofPixelsPool &);
+
+	void trim(size_t bytes);
+
+	std::map<size_t, std::vector<void*> > freeBuffers;
+	std::map<void*, size_t> usedBuffers;
+	mutable ofMutex mutex;
+	size_t maxFreeBytes;
+	size_t freeBytes;
+	size_t usedBytes;
+	size_t numFreeBuffers;
+	uint64_t hits;
+	uint64_t misses;
+};
@@ -0,0 +1,147 @@
+#include "ofTextBatch.h"
+#include "ofGraphics.h"
+
+//--------------------------------------------------------------
+ofTextBatch::ofTextBatch(){
+	font = NULL;
+	bUseColors = false;
+	bVFlipped = true;
+	frame = 0;
+	fontEvictions = 0;
+	fontFrameEvictions = 0;
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	mesh.setUsage(GL_DYNAMIC_DRAW);
+}
+
+//--------------------------------------------------------------
+ofTextBatch::ofTextBatch(const ofTrueTypeFont & font){
+	bUseColors = false;
+	bVFlipped = true;
+	frame = 0;
+	fontEvictions = 0;
+	fontFrameEvictions = 0;
+	mesh.setMode(OF_PRIMITIVE_TRIANGLES);
+	mesh.setUsage(GL_DYNAMIC_DRAW);
+	setFont(font);
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::setFont(const ofTrueTypeFont & _font){
+	font = &_font;
+	clear();
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::resetGlyphCacheState(){
+	frame = ofGetFrameNum();
+	bVFlipped = ofIsVFlipped();
+	if(font){
+		fontEvictions = font->glyphCacheEvictions;
+		fontFrameEvictions = font->glyphCacheFrameEvictions;
+	}
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::clear(){
+	strings.clear();
+	mesh.clear();
+	bUseColors = false;
+	resetGlyphCacheState();
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::addString(const string & s, float x, float y){
+	String str;
+	str.text = s;
+	str.x = x;
+	str.y = y;
+	str.hasColor = false;
+	strings.push_back(str);
+	append(strings.back());
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::addString(const string & s, float x, float y, const ofFloatColor & color){
+	String str;
+	str.text = s;
+	str.x = x;
+	str.y = y;
+	str.color = color;
+	str.hasColor = true;
+	strings.push_back(str);
+	append(strings.back());
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::append(const String & str){
+	if(!font || !font->isLoaded()){
+		ofLogError("ofTextBatch") << "addString(): font not allocated";
+		return;
+	}
+	if(strings.size() == 1){
+		resetGlyphCacheState();
+	}
+	size_t numVertices = mesh.getNumVertices();
+	font->appendStringMesh(mesh, str.text, str.x, str.y, bVFlipped);
+	if(str.hasColor && !bUseColors){
+		mesh.getColors().assign(numVertices, ofFloatColor::white);
+		bUseColors = true;
+	}
+	if(bUseColors){
+		mesh.getColors().resize(mesh.getNumVertices(), str.hasColor ? str.color : ofFloatColor::white);
+	}
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::update(){
+	if(!font || !font->isLoaded()){
+		return;
+	}
+	bool rebuild = bVFlipped != ofIsVFlipped();
+	if(font->isUsingGlyphCache()){
+		// glyphs used in the frame the batch was created are only evicted
+		// when the font has no other option, in later frames any eviction
+		// could have removed one of them
+		if(font->glyphCacheFrameEvictions != fontFrameEvictions){
+			rebuild = true;
+		}else if(ofGetFrameNum() == frame){
+			fontEvictions = font->glyphCacheEvictions;
+		}else if(font->glyphCacheEvictions != fontEvictions){
+			rebuild = true;
+		}
+	}
+	if(rebuild){
+		mesh.clear();
+		bUseColors = false;
+		resetGlyphCacheState();
+		for(size_t i = 0; i < strings.size(); i++){
+			append(strings[i]);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+size_t ofTextBatch::getNumStrings() const{
+	return strings.size();
+}
+
+//--------------------------------------------------------------
+const ofMesh & ofTextBatch::getMesh(){
+	update();
+	return mesh;
+}
+
+//--------------------------------------------------------------
+void ofTextBatch::draw(){
+	update();
+	if(mesh.getNumVertices() == 0){
+		return;
+	}
+	ofPushStyle();
+	ofEnableAlphaBlending();
+	const ofTexture & texture = font->getFontTexture();
+	texture.bind();
+	mesh.draw();
+	texture.unbind();
+	ofPopStyle();
+}
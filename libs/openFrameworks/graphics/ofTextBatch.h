@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ofConstants.h"
+#include "ofColor.h"
+#include "ofTrueTypeFont.h"
+#include "ofVboMesh.h"
+
+
+/// \brief Draws many strings of the same ofTrueTypeFont with a single draw
+/// call.
+///
+/// Every string added to the batch is appended to one mesh that is uploaded
+/// to a reusable vbo. Clearing the batch keeps the memory of the mesh and
+/// the vbo, so building the batch again every frame doesn't allocate once
+/// it has grown to its usual size. Kerning and the encoding of the font are
+/// applied as in ofTrueTypeFont::drawString().
+///
+/// Fonts loaded with ofTrueTypeFont::loadWithGlyphCache() may evict glyphs
+/// that the batch uses to make space for other text. The batch keeps its
+/// strings and creates the mesh again before drawing when that might have
+/// happened.
+///
+/// ~~~~{.cpp}
+/// batch.setFont(font);
+///
+/// // every frame
+/// batch.clear();
+/// for(size_t i = 0; i < labels.size(); i++){
+///     batch.addString(labels[i].text, labels[i].x, labels[i].y);
+/// }
+/// batch.draw();
+/// ~~~~
+class ofTextBatch{
+public:
+	ofTextBatch();
+	ofTextBatch(const ofTrueTypeFont & font);
+
+	/// \brief Set the font used to draw the strings, clears the batch.
+	/// The font has to outlive the batch or be set again.
+	void setFont(const ofTrueTypeFont & font);
+
+	/// \brief Append a string at x, y drawn with the current color.
+	void addString(const string & s, float x, float y);
+
+	/// \brief Append a string at x, y drawn with color.
+	///
+	/// Once a string with a color has been added, strings added without a
+	/// color are drawn in white until the batch is cleared.
+	void addString(const string & s, float x, float y, const ofFloatColor & color);
+
+	/// \brief Remove every string keeping the allocated memory.
+	void clear();
+
+	/// \returns the number of strings added since the last clear().
+	size_t getNumStrings() const;
+
+	/// \returns the mesh with the quads of every string, in the
+	/// coordinates of the font texture.
+	const ofMesh & getMesh();
+
+	/// \brief Draw every string with the font texture in one call.
+	void draw();
+
+private:
+	struct String{
+		string text;
+		float x, y;
+		ofFloatColor color;
+		bool hasColor;
+	};
+
+	void append(const String & str);
+	void update();
+	void resetGlyphCacheState();
+
+	const ofTrueTypeFont * font;
+	vector<String> strings;
+	ofVboMesh mesh;
+	bool bUseColors;
+	bool bVFlipped;
+	int frame;
+	unsigned int fontEvictions;
+	unsigned int fontFrameEvictions;
+};
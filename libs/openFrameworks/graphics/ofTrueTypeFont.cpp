@@ -17,6 +17,7 @@
 #include "ofUtils.h"
 #include "ofGraphics.h"
 #include "ofAppRunner.h"
+#include "ofGLUtils.h"
 #include "Poco/TextConverter.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/Latin1Encoding.h"
@@ -26,6 +27,9 @@ static bool printVectorInfo = false;
 static int ttfGlobalDpi = 96;
 static bool librariesInitialized = false;
 static FT_Library library;
+static const int lineBreak = -2;
+static const Poco::UTF8Encoding utf8Encoding;
+static const Poco::Latin9Encoding latin9Encoding;
 
 //--------------------------------------------------------
 void ofTrueTypeFont::setGlobalDpi(int newDpi){
@@ -358,6 +362,20 @@ ofTrueTypeFont::ofTrueTypeFont(){
 	lineHeight = 0;
 	nCharacters = 0;
 	simplifyAmt = 0;
+
+	bGlyphCache = false;
+	glyphCacheSize = 0;
+	glyphCellWidth = 0;
+	glyphCellHeight = 0;
+	glyphCacheLeastUsed = -1;
+	glyphCacheMostUsed = -1;
+	glyphCacheDirtyBegin = 0;
+	glyphCacheDirtyEnd = 0;
+	glyphCacheString = 0;
+	glyphCacheFrame = 0;
+	glyphCacheRendered = -1;
+	glyphCacheEvictions = 0;
+	glyphCacheFrameEvictions = 0;
 }
 
 //------------------------------------------------------------------
@@ -376,7 +394,12 @@ void ofTrueTypeFont::unloadTextures(){
 }
 
 void ofTrueTypeFont::reloadTextures(){
-	if(bLoadedOk) load(filename, fontSize, bAntiAliased, bFullCharacterSet, bMakeContours, simplifyAmt, dpi);
+	if(!bLoadedOk) return;
+	if(bGlyphCache){
+		loadWithGlyphCache(filename, fontSize, bAntiAliased, glyphCacheSize, dpi);
+	}else{
+		load(filename, fontSize, bAntiAliased, bFullCharacterSet, bMakeContours, simplifyAmt, dpi);
+	}
 }
 
 static bool loadFontFace(string fontname, int _fontSize, FT_Face & face, string & filename){
@@ -430,16 +453,79 @@ bool ofTrueTypeFont::loadFont(string _filename, int _fontSize, bool _bAntiAliase
 }
 
 //-----------------------------------------------------------
-bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, bool _bFullCharacterSet, bool _makeContours, float _simplifyAmt, int _dpi) {
+static void setCharacterProps(FT_Face face, int glyph, int index, charProps & props){
+	props.characterIndex	= index;
+	props.glyph				= glyph;
+	props.height 			= face->glyph->metrics.height>>6;
+	props.width 			= face->glyph->metrics.width>>6;
+	props.bearingX			= face->glyph->metrics.horiBearingX>>6;
+	props.bearingY			= face->glyph->metrics.horiBearingY>>6;
+	props.xmin				= face->glyph->bitmap_left;
+	props.xmax				= props.xmin + props.width;
+	props.ymin				= -face->glyph->bitmap_top;
+	props.ymax				= props.ymin + props.height;
+	props.advance			= face->glyph->metrics.horiAdvance>>6;
+
+	props.tW				= props.width;
+	props.tH				= props.height;
+	props.t1 = props.t2 = props.v1 = props.v2 = 0;
+}
+
+//-----------------------------------------------------------
+static void getGlyphPixels(FT_Bitmap & bitmap, bool bAntiAliased, ofPixels & pixels){
+	int width  = bitmap.width;
+	int height = bitmap.rows;
+
+	// Allocate Memory For The Texture Data.
+	pixels.allocate(width, height, OF_PIXELS_GRAY_ALPHA);
+	//-------------------------------- clear data:
+	pixels.set(0,255); // every luminance pixel = 255
+	pixels.set(1,0);
+
+
+	if (bAntiAliased == true){
+		ofPixels bitmapPixels;
+		bitmapPixels.setFromExternalPixels(bitmap.buffer,bitmap.width,bitmap.rows,OF_PIXELS_GRAY);
+		pixels.setChannel(1,bitmapPixels);
+	} else {
+		//-----------------------------------
+		// true type packs monochrome info in a
+		// 1-bit format, hella funky
+		// here we unpack it:
+		unsigned char *src =  bitmap.buffer;
+		for(int j=0; j <bitmap.rows;j++) {
+			unsigned char b=0;
+			unsigned char *bptr =  src;
+			for(int k=0; k < bitmap.width ; k++){
+				pixels[2*(k+j*width)] = 255;
+
+				if (k%8==0){
+					b = (*bptr++);
+				}
+
+				pixels[2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
+				b <<= 1;
+			}
+			src += bitmap.pitch;
+		}
+		//-----------------------------------
+	}
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadFace(string _filename, int _fontSize, bool _bAntiAliased, int _dpi){
 	#if defined(TARGET_ANDROID)
 	ofAddListener(ofxAndroidEvents().unloadGL,this,&ofTrueTypeFont::unloadTextures);
 	ofAddListener(ofxAndroidEvents().reloadGL,this,&ofTrueTypeFont::reloadTextures);
 	#endif
-	int border = 1;
 	initLibraries();
 
 	// if we've already been loaded, try to clean up :
 	unloadTextures();
+	if(face){
+		FT_Done_Face(face);
+		face = NULL;
+	}
 
 	if( _dpi == 0 ){
 		_dpi = ttfGlobalDpi;
@@ -449,12 +535,16 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 
 	bLoadedOk 			= false;
 	bAntiAliased 		= _bAntiAliased;
-	bFullCharacterSet 	= _bFullCharacterSet;
 	fontSize			= _fontSize;
-	bMakeContours 		= _makeContours;
-	simplifyAmt			= _simplifyAmt;
 	dpi 				= _dpi;
 
+	bGlyphCache = false;
+	glyphCacheCells.clear();
+	glyphCacheCharacterCells.clear();
+	glyphCacheCodePoints.clear();
+	glyphCacheLatinCharacters.clear();
+	glyphCacheRendered = -1;
+
 	//--------------- load the library and typeface
 
 
@@ -477,6 +567,20 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 	//kerning would be great to support:
 	//ofLogNotice("ofTrueTypeFont") << "FT_HAS_KERNING ? " <<  FT_HAS_KERNING(face);
 	//------------------------------------------------------
+	return true;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, bool _bFullCharacterSet, bool _makeContours, float _simplifyAmt, int _dpi) {
+	int border = 1;
+
+	bFullCharacterSet 	= _bFullCharacterSet;
+	bMakeContours 		= _makeContours;
+	simplifyAmt			= _simplifyAmt;
+
+	if(!loadFace(_filename,_fontSize,_bAntiAliased,_dpi)){
+		return false;
+	}
 
 	nCharacters = (bFullCharacterSet ? 256 : 128) - NUM_CHARACTER_TO_START;
 
@@ -547,64 +651,13 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 		// -------------------------
 		// info about the character:
 		FT_Bitmap& bitmap= face->glyph->bitmap;
-		int width  = bitmap.width;
-		int height = bitmap.rows;
-
-		cps[i].characterIndex	= i;
-		cps[i].glyph			= glyph;
-		cps[i].height 			= face->glyph->metrics.height>>6;
-		cps[i].width 			= face->glyph->metrics.width>>6;
-		cps[i].bearingX			= face->glyph->metrics.horiBearingX>>6;
-		cps[i].bearingY			= face->glyph->metrics.horiBearingY>>6;
-		cps[i].xmin				= face->glyph->bitmap_left;
-		cps[i].xmax				= cps[i].xmin + cps[i].width;
-		cps[i].ymin				= -face->glyph->bitmap_top;
-		cps[i].ymax				= cps[i].ymin + cps[i].height;
-		cps[i].advance			= face->glyph->metrics.horiAdvance>>6;
-
-
-		cps[i].tW				= cps[i].width;
-		cps[i].tH				= cps[i].height;
-
+		setCharacterProps(face, glyph, i, cps[i]);
 
 		areaSum += (cps[i].tW+border*2)*(cps[i].tH+border*2);
 
-		if(width==0 || height==0) continue;
-
-		// Allocate Memory For The Texture Data.
-		expanded_data[i].allocate(width, height, OF_PIXELS_GRAY_ALPHA);
-		//-------------------------------- clear data:
-		expanded_data[i].set(0,255); // every luminance pixel = 255
-		expanded_data[i].set(1,0);
-
-
-		if (bAntiAliased == true){
-			ofPixels bitmapPixels;
-			bitmapPixels.setFromExternalPixels(bitmap.buffer,bitmap.width,bitmap.rows,OF_PIXELS_GRAY);
-			expanded_data[i].setChannel(1,bitmapPixels);
-		} else {
-			//-----------------------------------
-			// true type packs monochrome info in a
-			// 1-bit format, hella funky
-			// here we unpack it:
-			unsigned char *src =  bitmap.buffer;
-			for(int j=0; j <bitmap.rows;j++) {
-				unsigned char b=0;
-				unsigned char *bptr =  src;
-				for(int k=0; k < bitmap.width ; k++){
-					expanded_data[i][2*(k+j*width)] = 255;
-
-					if (k%8==0){
-						b = (*bptr++);
-					}
+		if(bitmap.width==0 || bitmap.rows==0) continue;
 
-					expanded_data[i][2*(k+j*width) + 1] = b&0x80 ? 255 : 0;
-					b <<= 1;
-				}
-				src += bitmap.pitch;
-			}
-			//-----------------------------------
-		}
+		getGlyphPixels(bitmap, bAntiAliased, expanded_data[i]);
 	}
 
 	vector<charProps> sortedCopy = cps;
@@ -684,6 +737,220 @@ bool ofTrueTypeFont::load(string _filename, int _fontSize, bool _bAntiAliased, b
 	return true;
 }
 
+//-----------------------------------------------------------
+bool ofTrueTypeFont::loadWithGlyphCache(string _filename, int _fontSize, bool _bAntiAliased, int atlasSize, int _dpi){
+	int border = 1;
+
+	bFullCharacterSet 	= true;
+	bMakeContours 		= false;
+	simplifyAmt			= 0;
+
+	if(!loadFace(_filename,_fontSize,_bAntiAliased,_dpi)){
+		return false;
+	}
+
+	// every glyph fits in the global bounding box of the font so the atlas
+	// is divided in cells of that size, which makes evicting a glyph to
+	// place another one trivial
+	glyphCellWidth = ceil(glyphBBox.width) + 1 + border*2;
+	glyphCellHeight = ceil(glyphBBox.height) + 1 + border*2;
+	int columns = atlasSize / glyphCellWidth;
+	int rows = atlasSize / glyphCellHeight;
+	if(columns==0 || rows==0){
+		ofLogError("ofTrueTypeFont") << "loadWithGlyphCache(): glyphs of " << glyphCellWidth << "x" << glyphCellHeight
+				<< " pixels don't fit in an atlas of " << atlasSize << "x" << atlasSize;
+		return false;
+	}
+
+	bGlyphCache = true;
+	glyphCacheSize = atlasSize;
+	glyphCacheCells.resize(columns * rows);
+	for(int i=0;i<(int)glyphCacheCells.size();i++){
+		glyphCacheCells[i].character = -1;
+		glyphCacheCells[i].prev = i-1;
+		glyphCacheCells[i].next = i+1;
+		glyphCacheCells[i].lastString = 0;
+		glyphCacheCells[i].lastFrame = -1;
+	}
+	glyphCacheCells.back().next = -1;
+	glyphCacheLeastUsed = 0;
+	glyphCacheMostUsed = glyphCacheCells.size()-1;
+	glyphCacheString = 0;
+	glyphCacheEvictions = 0;
+	glyphCacheFrameEvictions = 0;
+
+	glyphCachePixels.allocate(atlasSize,atlasSize,OF_PIXELS_GRAY_ALPHA);
+	glyphCachePixels.set(0,255);
+	glyphCachePixels.set(1,0);
+	glyphCacheDirtyBegin = atlasSize;
+	glyphCacheDirtyEnd = 0;
+
+	// the space goes first so the character indices are > 0 for every
+	// glyph that can be kerned, like in the fixed character sets
+	cps.clear();
+	glyphCacheLatinCharacters.assign(256, -1);
+	getGlyphCacheCharacter(' ');
+
+	texAtlas.allocate(glyphCachePixels,false);
+	texAtlas.setRGToRGBASwizzles(true);
+
+	if(bAntiAliased && fontSize>20){
+		texAtlas.setTextureMinMagFilter(GL_LINEAR,GL_LINEAR);
+	}else{
+		texAtlas.setTextureMinMagFilter(GL_NEAREST,GL_NEAREST);
+	}
+	texAtlas.loadData(glyphCachePixels);
+
+	bLoadedOk = true;
+	return true;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::isUsingGlyphCache() const{
+	return bGlyphCache;
+}
+
+//-----------------------------------------------------------
+int ofTrueTypeFont::getGlyphCacheCharacter(int codePoint) const{
+	if(codePoint < NUM_CHARACTER_TO_START){
+		return -1;
+	}
+	if(codePoint < (int)glyphCacheLatinCharacters.size()){
+		if(glyphCacheLatinCharacters[codePoint] != -1){
+			return glyphCacheLatinCharacters[codePoint];
+		}
+	}else{
+		map<int,int>::iterator it = glyphCacheCodePoints.find(codePoint);
+		if(it != glyphCacheCodePoints.end()){
+			return it->second;
+		}
+	}
+
+	int c = cps.size();
+	cps.push_back(charProps());
+	FT_Error err = FT_Load_Glyph( face, FT_Get_Char_Index( face, codePoint ), bAntiAliased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
+	if(err){
+		// cached as an empty glyph so it isn't loaded again on every draw
+		ofLogError("ofTrueTypeFont") << "getGlyphCacheCharacter(): FT_Load_Glyph failed for code point " << codePoint << ": FT_Error " << err;
+		cps.back().characterIndex = c;
+		cps.back().glyph = codePoint;
+	}else{
+		if (bAntiAliased == true) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
+		else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
+		setCharacterProps(face, codePoint, c, cps.back());
+		glyphCacheRendered = c;
+	}
+	glyphCacheCharacterCells.push_back(-1);
+	if(codePoint < (int)glyphCacheLatinCharacters.size()){
+		glyphCacheLatinCharacters[codePoint] = c;
+	}else{
+		glyphCacheCodePoints[codePoint] = c;
+	}
+	nCharacters = cps.size();
+	return c;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::useGlyphCacheCell(int cell) const{
+	GlyphCacheCell & slot = glyphCacheCells[cell];
+	slot.lastString = glyphCacheString;
+	slot.lastFrame = glyphCacheFrame;
+	if(cell == glyphCacheMostUsed){
+		return;
+	}
+
+	// move the cell to the most recently used end of the list
+	if(slot.prev != -1){
+		glyphCacheCells[slot.prev].next = slot.next;
+	}else{
+		glyphCacheLeastUsed = slot.next;
+	}
+	glyphCacheCells[slot.next].prev = slot.prev;
+	slot.prev = glyphCacheMostUsed;
+	slot.next = -1;
+	glyphCacheCells[glyphCacheMostUsed].next = cell;
+	glyphCacheMostUsed = cell;
+}
+
+//-----------------------------------------------------------
+bool ofTrueTypeFont::updateGlyphCacheCell(int c) const{
+	int border = 1;
+
+	if(cps[c].tW==0 || cps[c].tH==0){
+		return false;
+	}
+
+	int cell = glyphCacheCharacterCells[c];
+	if(cell == -1){
+		cell = glyphCacheLeastUsed;
+		GlyphCacheCell & slot = glyphCacheCells[cell];
+		if(slot.character != -1){
+			if(slot.lastString == glyphCacheString){
+				ofLogWarning("ofTrueTypeFont") << "updateGlyphCacheCell(): string uses more glyphs than fit in the atlas, "
+						<< "load the font with a bigger atlasSize";
+				return false;
+			}
+			if(slot.lastFrame == glyphCacheFrame){
+				ofLogVerbose("ofTrueTypeFont") << "updateGlyphCacheCell(): evicting a glyph used during this frame, "
+						<< "load the font with a bigger atlasSize";
+				glyphCacheFrameEvictions++;
+			}
+			glyphCacheCharacterCells[slot.character] = -1;
+			glyphCacheEvictions++;
+		}
+		slot.character = c;
+		glyphCacheCharacterCells[c] = cell;
+
+		if(glyphCacheRendered != c){
+			FT_Load_Glyph( face, FT_Get_Char_Index( face, cps[c].glyph ), bAntiAliased ?  FT_LOAD_FORCE_AUTOHINT : FT_LOAD_DEFAULT );
+			if (bAntiAliased == true) FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
+			else FT_Render_Glyph(face->glyph, FT_RENDER_MODE_MONO);
+			glyphCacheRendered = c;
+		}
+		getGlyphPixels(face->glyph->bitmap, bAntiAliased, glyphPixels);
+		glyphPixels.crop(0, 0, MIN(glyphPixels.getWidth(), glyphCellWidth - border*2), MIN(glyphPixels.getHeight(), glyphCellHeight - border*2));
+
+		int columns = glyphCacheSize / glyphCellWidth;
+		int x = (cell % columns) * glyphCellWidth;
+		int y = (cell / columns) * glyphCellHeight;
+		for(int j=0;j<glyphCellHeight;j++){
+			unsigned char * row = glyphCachePixels.getData() + ((y + j) * glyphCacheSize + x) * 2;
+			for(int i=0;i<glyphCellWidth;i++){
+				row[i*2] = 255;
+				row[i*2+1] = 0;
+			}
+		}
+		glyphPixels.pasteInto(glyphCachePixels,x+border,y+border);
+		glyphCacheDirtyBegin = MIN(glyphCacheDirtyBegin, y);
+		glyphCacheDirtyEnd = MAX(glyphCacheDirtyEnd, y + glyphCellHeight);
+
+		cps[c].t1		= float(x + border)/float(glyphCacheSize);
+		cps[c].v1		= float(y + border)/float(glyphCacheSize);
+		cps[c].t2		= float(cps[c].tW + x + border)/float(glyphCacheSize);
+		cps[c].v2		= float(cps[c].tH + y + border)/float(glyphCacheSize);
+	}
+	useGlyphCacheCell(cell);
+	return true;
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::uploadGlyphCache() const{
+	if(glyphCacheDirtyBegin >= glyphCacheDirtyEnd){
+		return;
+	}
+	// only the rows that contain new glyphs are uploaded, they are
+	// contiguous in the pixels so no unpack row length is needed
+	const ofTextureData & texData = texAtlas.getTextureData();
+	int width = glyphCachePixels.getWidth();
+	ofSetPixelStoreiAlignment(GL_UNPACK_ALIGNMENT,width,1,2);
+	glBindTexture(texData.textureTarget, (GLuint) texData.textureID);
+	glTexSubImage2D(texData.textureTarget, 0, 0, glyphCacheDirtyBegin, width, glyphCacheDirtyEnd - glyphCacheDirtyBegin,
+			ofGetGlFormat(glyphCachePixels), GL_UNSIGNED_BYTE, glyphCachePixels.getData() + glyphCacheDirtyBegin * width * 2);
+	glBindTexture(texData.textureTarget, 0);
+	glyphCacheDirtyBegin = glyphCachePixels.getHeight();
+	glyphCacheDirtyEnd = 0;
+}
+
 ofTextEncoding ofTrueTypeFont::getEncoding() const {
 	return encoding;
 }
@@ -786,6 +1053,11 @@ ofTTFCharacter ofTrueTypeFont::getCharacterAsPoints(int character, bool vflip, b
 
 //-----------------------------------------------------------
 void ofTrueTypeFont::drawChar(int c, float x, float y, bool vFlipped) const{
+	appendCharQuad(stringQuads, c, x, y, vFlipped);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::appendCharQuad(ofMesh & mesh, int c, float x, float y, bool vFlipped) const{
 
 	if (c >= nCharacters){
 		//ofLogError("ofTrueTypeFont") << "drawChar(): char " << c + NUM_CHARACTER_TO_START << " not allocated: line " << __LINE__ << " in " << __FILE__;
@@ -813,24 +1085,24 @@ void ofTrueTypeFont::drawChar(int c, float x, float y, bool vFlipped) const{
     ymin += y;
     ymax += y;
 
-	int firstIndex = stringQuads.getVertices().size();
+	int firstIndex = mesh.getVertices().size();
 
-	stringQuads.addVertex(ofVec3f(xmin,ymin));
-	stringQuads.addVertex(ofVec3f(xmax,ymin));
-	stringQuads.addVertex(ofVec3f(xmax,ymax));
-	stringQuads.addVertex(ofVec3f(xmin,ymax));
+	mesh.addVertex(ofVec3f(xmin,ymin));
+	mesh.addVertex(ofVec3f(xmax,ymin));
+	mesh.addVertex(ofVec3f(xmax,ymax));
+	mesh.addVertex(ofVec3f(xmin,ymax));
 
-	stringQuads.addTexCoord(ofVec2f(t1,v1));
-	stringQuads.addTexCoord(ofVec2f(t2,v1));
-	stringQuads.addTexCoord(ofVec2f(t2,v2));
-	stringQuads.addTexCoord(ofVec2f(t1,v2));
+	mesh.addTexCoord(ofVec2f(t1,v1));
+	mesh.addTexCoord(ofVec2f(t2,v1));
+	mesh.addTexCoord(ofVec2f(t2,v2));
+	mesh.addTexCoord(ofVec2f(t1,v2));
 
-	stringQuads.addIndex(firstIndex);
-	stringQuads.addIndex(firstIndex+1);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+2);
-	stringQuads.addIndex(firstIndex+3);
-	stringQuads.addIndex(firstIndex);
+	mesh.addIndex(firstIndex);
+	mesh.addIndex(firstIndex+1);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+2);
+	mesh.addIndex(firstIndex+3);
+	mesh.addIndex(firstIndex);
 }
 
 int ofTrueTypeFont::getKerning(int c, int prevC) const{
@@ -934,16 +1206,14 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y) con
     	return myRect;
     }
 
-	int		index	= 0;
 	int		xoffset	= 0;
 	int		yoffset	= 0;
-    int     len     = (int)c.length();
     int     xmin    = -1;
     int     ymin    = -1;
     int     xmax    = -1;
     int     ymax    = -1;
 
-    if ( len < 1 || cps.empty() ){
+    if ( c.empty() || cps.empty() ){
         myRect.x        = x;
         myRect.y        = y;
         myRect.width    = 0;
@@ -951,45 +1221,44 @@ ofRectangle ofTrueTypeFont::getStringBoundingBox(string c, float x, float y) con
         return myRect;
     }
 
+    vector<int> characters;
+    getCharacters(c, characters);
+
     bool bFirstCharacter = true;
     int prevCy=-1;
-	while(index < len){
-		int cy = ((unsigned char)c[index]) - NUM_CHARACTER_TO_START;
- 	    if (cy < nCharacters){ 			// full char set or not?
-	       if (c[index] == '\n') {
-               yoffset += lineHeight;
-               xoffset = 0 ; //reset X Pos back to zero
-               prevCy = -1;
-               index++;
-               continue;
-	       }
-
-	       if(cy > -1){
-				if (bFirstCharacter){
-					xmin = cps[cy].xmin+x;
-					ymin = cps[cy].ymin+y;
-					xmax = cps[cy].xmax+x;
-					ymax = cps[cy].ymax+y;
-					bFirstCharacter = false;
-				} else {
-				   	xoffset += getKerning(cy,prevCy);
-				   	
-					int charxmin = cps[cy].xmin+xoffset+x;
-					int charymin = cps[cy].ymin+yoffset+y;
-					int charxmax = cps[cy].xmax+xoffset+x;
-					int charymax = cps[cy].ymax+yoffset+y;
-
-					if (charxmin < xmin) xmin = charxmin;
-					if (charymin < ymin) ymin = charymin;
-					if (charxmax > xmax) xmax = charxmax;
-					if (charymax > ymax) ymax = charymax;
-				}
-				xoffset += cps[cy].advance * letterSpacing;
+	for(int index = 0; index < (int)characters.size(); index++){
+		int cy = characters[index];
+		if (cy == lineBreak) {
+			yoffset += lineHeight;
+			xoffset = 0 ; //reset X Pos back to zero
+			prevCy = -1;
+			continue;
+		}
+
+		if(cy > -1){
+			if (bFirstCharacter){
+				xmin = cps[cy].xmin+x;
+				ymin = cps[cy].ymin+y;
+				xmax = cps[cy].xmax+x;
+				ymax = cps[cy].ymax+y;
+				bFirstCharacter = false;
+			} else {
+			   	xoffset += getKerning(cy,prevCy);
+
+				int charxmin = cps[cy].xmin+xoffset+x;
+				int charymin = cps[cy].ymin+yoffset+y;
+				int charxmax = cps[cy].xmax+xoffset+x;
+				int charymax = cps[cy].ymax+yoffset+y;
+
+				if (charxmin < xmin) xmin = charxmin;
+				if (charymin < ymin) ymin = charymin;
+				if (charxmax > xmax) xmax = charxmax;
+				if (charymax > ymax) ymax = charymax;
 			}
-	  	}
-    	index++;
-    	prevCy = cy;
-    }
+			xoffset += cps[cy].advance * letterSpacing;
+		}
+		prevCy = cy;
+	}
 
     myRect.x        = min((int)x,xmin);
     myRect.y        = min((int)y,ymin);
@@ -1004,15 +1273,68 @@ float ofTrueTypeFont::stringHeight(string c) const{
     return rect.height;
 }
 
-void ofTrueTypeFont::createStringMesh(string c, float x, float y, bool vFlipped) const{
-	
+//-----------------------------------------------------------
+// converts a string to indices in cps, -1 for characters that can't be drawn
+// and lineBreak for '\n'. with the glyph cache every code point gets an index
+// the first time it's seen
+void ofTrueTypeFont::getCharacters(const string & c, vector<int> & characters) const{
+	characters.clear();
+	if(bGlyphCache){
+		const unsigned char * bytes = (const unsigned char*)c.data();
+		int len = c.size();
+		int index = 0;
+		while(index < len){
+			int codePoint = bytes[index];
+			int length = 1;
+			if(codePoint >= 0x80){
+				if(encoding==OF_ENCODING_UTF8){
+					length = utf8Encoding.sequenceLength(bytes + index, len - index);
+					if(length > 0){
+						codePoint = utf8Encoding.queryConvert(bytes + index, length);
+					}else{
+						codePoint = -1;
+						length = 1;
+					}
+				}else{
+					codePoint = latin9Encoding.characterMap()[codePoint];
+				}
+			}
+			if(codePoint == '\n'){
+				characters.push_back(lineBreak);
+			}else{
+				characters.push_back(getGlyphCacheCharacter(codePoint));
+			}
+			index += length;
+		}
+		return;
+	}
+
+	const string * str = &c;
+	string o;
 	if(bFullCharacterSet && encoding==OF_ENCODING_UTF8){
-		string o;
 		Poco::TextConverter(Poco::UTF8Encoding(),Poco::Latin9Encoding()).convert(c,o);
-		c=o;
+		str = &o;
 	}
-	
-	GLint		index	= 0;
+	characters.resize(str->size());
+	for(int index = 0; index < (int)str->size(); index++){
+		int cy = (unsigned char)(*str)[index] - NUM_CHARACTER_TO_START;
+		if ((*str)[index] == '\n') {
+			characters[index] = lineBreak;
+		}else if(cy < 0 || cy >= nCharacters){ 			// full char set or not?
+			characters[index] = -1;
+		}else{
+			characters[index] = cy;
+		}
+	}
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::createStringMesh(string c, float x, float y, bool vFlipped) const{
+	appendStringMesh(stringQuads, c, x, y, vFlipped);
+}
+
+//-----------------------------------------------------------
+void ofTrueTypeFont::appendStringMesh(ofMesh & mesh, const string & c, float x, float y, bool vFlipped) const{
 	GLfloat		X		= x;
 	GLfloat		Y		= y;
 	int newLineDirection		= 1;
@@ -1024,34 +1346,47 @@ void ofTrueTypeFont::createStringMesh(string c, float x, float y, bool vFlipped)
 		newLineDirection = -1;
 	}
 
-	int len = (int)c.length();
+	if(bGlyphCache){
+		// glyphs used by this string can't be evicted while it's being
+		// created, the ones used during this frame only if there's no
+		// other option
+		glyphCacheString++;
+		glyphCacheFrame = ofGetFrameNum();
+	}
+
+	getCharacters(c, stringCharacters);
 
 	int prevCy = -1;
-	while(index < len){
-		int cy = (unsigned char)c[index] - NUM_CHARACTER_TO_START;
-		if (cy < nCharacters){ 			// full char set or not?
-			if (c[index] == '\n') {
-				Y += lineHeight*newLineDirection;
-				X = x ; //reset X Pos back to zero
-				prevCy = -1;
-			} else if(cy > -1){
-	            X += getKerning(cy,prevCy);
-				drawChar(cy, X, Y, vFlipped);
-				X += cps[cy].advance * letterSpacing;
+	for(int index = 0; index < (int)stringCharacters.size(); index++){
+		int cy = stringCharacters[index];
+		if (cy == lineBreak) {
+			Y += lineHeight*newLineDirection;
+			X = x ; //reset X Pos back to zero
+			prevCy = -1;
+			continue;
+		} else if(cy > -1){
+            X += getKerning(cy,prevCy);
+			if(!bGlyphCache || updateGlyphCacheCell(cy)){
+				appendCharQuad(mesh, cy, X, Y, vFlipped);
 			}
+			X += cps[cy].advance * letterSpacing;
 		}
-		index++;
 		prevCy = cy;
 	}
 }
 
+//-----------------------------------------------------------
 const ofMesh & ofTrueTypeFont::getStringMesh(string c, float x, float y, bool vFlipped) const{
 	stringQuads.clear();
 	createStringMesh(c,x,y,vFlipped);
 	return stringQuads;
 }
 
+//-----------------------------------------------------------
 const ofTexture & ofTrueTypeFont::getFontTexture() const{
+	if(bGlyphCache){
+		uploadGlyphCache();
+	}
 	return texAtlas;
 }
 
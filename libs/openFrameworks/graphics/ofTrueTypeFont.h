@@ -101,7 +101,36 @@ public:
                   bool makeContours=false,
                   float simplifyAmt=0.3,
                   int dpi=0));
-	
+
+	/// \brief Loads a font that renders its glyphs on demand.
+	///
+	/// Instead of rendering a fixed character set when loading, the glyph for
+	/// any unicode code point is rendered the first time a string uses it into
+	/// a texture of atlasSize x atlasSize pixels. When the texture is full the
+	/// least recently used glyphs are evicted to make space for new ones, so a
+	/// mesh returned by getStringMesh() should be drawn before other text is
+	/// created, ofTextBatch takes care of rebuilding itself when that happens.
+	///
+	/// Strings are decoded as utf8 or iso 8859-15 depending on the encoding
+	/// set with setEncoding(). Vector contours aren't available for fonts
+	/// loaded this way.
+	///
+	/// \param filename The name of the font file to load.
+	/// \param fontsize The size in pixels to load the font.
+	/// \param _bAntiAliased true if the font should be anti-aliased.
+	/// \param atlasSize width and height in pixels of the glyph texture.
+	/// \param dpi the dots per inch used to specify rendering size.
+	/// \returns true if the font was loaded correctly.
+	bool loadWithGlyphCache(string filename,
+                  int fontsize,
+                  bool _bAntiAliased=true,
+                  int atlasSize=1024,
+                  int dpi=0);
+
+	/// \brief Does the font render its glyphs on demand?
+	/// \returns true if the font was loaded with loadWithGlyphCache().
+	bool isUsingGlyphCache() const;
+
 	/// \brief Has the font been loaded successfully?
 	/// \returns true if the font was loaded.
 	bool isLoaded() const;
@@ -293,7 +322,7 @@ protected:
 	bool bLoadedOk;
 	bool bAntiAliased;
 	bool bFullCharacterSet;
-	int nCharacters;
+	mutable int nCharacters;
 	
 	vector <ofTTFCharacter> charOutlines;
 	vector <ofTTFCharacter> charOutlinesNonVFlipped;
@@ -307,7 +336,7 @@ protected:
 	float letterSpacing;
 	float spaceSize;
 
-	vector<charProps> cps; // properties for each character
+	mutable vector<charProps> cps; // properties for each character
 
 	int fontSize;
 	bool bMakeContours;
@@ -333,6 +362,42 @@ private:
 	friend void ofReloadAllFontTextures();
 #endif
 
+	friend class ofTextBatch;
+
+	struct GlyphCacheCell{
+		int character;
+		int prev, next;
+		unsigned long long lastString;
+		int lastFrame;
+	};
+
+	bool loadFace(string filename, int fontsize, bool _bAntiAliased, int dpi);
+	void getCharacters(const string & s, vector<int> & characters) const;
+	void appendStringMesh(ofMesh & mesh, const string & s, float x, float y, bool vFlipped) const;
+	void appendCharQuad(ofMesh & mesh, int c, float x, float y, bool vFlipped) const;
+	int getGlyphCacheCharacter(int codePoint) const;
+	bool updateGlyphCacheCell(int c) const;
+	void useGlyphCacheCell(int cell) const;
+	void uploadGlyphCache() const;
+
+	bool bGlyphCache;
+	int glyphCacheSize;
+	int glyphCellWidth, glyphCellHeight;
+	mutable vector<GlyphCacheCell> glyphCacheCells;
+	mutable int glyphCacheLeastUsed, glyphCacheMostUsed;
+	mutable vector<int> glyphCacheCharacterCells; // cell for each character or -1
+	mutable vector<int> glyphCacheLatinCharacters; // character for code points < 256 or -1
+	mutable map<int,int> glyphCacheCodePoints; // code point -> character for the rest
+	mutable ofPixels glyphCachePixels;
+	mutable ofPixels glyphPixels;
+	mutable int glyphCacheDirtyBegin, glyphCacheDirtyEnd;
+	mutable unsigned long long glyphCacheString;
+	mutable int glyphCacheFrame;
+	mutable int glyphCacheRendered;
+	mutable unsigned int glyphCacheEvictions;
+	mutable unsigned int glyphCacheFrameEvictions; // evictions of glyphs used in the same frame
+	mutable vector<int> stringCharacters;
+
 	ofTextEncoding encoding;
 	FT_Face		face;
 	void		unloadTextures();
@@ -8,6 +8,7 @@
 #include "ofSystemUtils.h"
 #include "ofThread.h"
 #include "ofThreadChannel.h"
+#include "ofThreadPool.h"
 #include "ofURLFileLoader.h"
 #include "ofUtils.h"
 #include "ofThreadChannel.h"
@@ -61,10 +62,13 @@
 #include "ofImage.h"
 #include "ofPath.h"
 #include "ofPixels.h"
+#include "ofPixelsPool.h"
+#include "ofImageSequenceWriter.h"
 #include "ofPolyline.h"
 #include "ofRendererCollection.h"
 #include "ofTessellator.h"
 #include "ofTrueTypeFont.h"
+#include "ofTextBatch.h"
 
 //--------------------------
 // app
@@ -103,5 +107,6 @@
 #include "ofCamera.h"
 #include "ofEasyCam.h"
 #include "ofMesh.h"
+#include "ofPackedMesh.h"
 #include "ofNode.h"
 
@@ -1,9 +1,15 @@
 #include "ofFileUtils.h"
 #ifndef TARGET_WIN32
  #include <pwd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <fcntl.h>
+ #include <unistd.h>
 #endif
 
 #include "ofUtils.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
 
 
 #ifdef TARGET_OSX
@@ -20,6 +26,8 @@
 
 
 size_t ofBuffer::ioSize = 1024;
+size_t ofBuffer::mapMinSize = 1024 * 1024;
+static bool bufferMappingEnabled = false;
 
 //--------------------------------------------------
 ofBuffer::ofBuffer()
@@ -47,6 +55,51 @@ ofBuffer::ofBuffer(istream & stream)
 	set(stream);
 }
 
+//--------------------------------------------------
+ofBuffer::ofBuffer(const ofBuffer & mom)
+:buffer(mom.begin(),mom.end())
+,currentLine(end(),end()){
+	if(buffer.empty()){
+		buffer.resize(1,0);
+	}
+}
+
+//--------------------------------------------------
+ofBuffer::ofBuffer(ofBuffer && mom)
+:buffer(std::move(mom.buffer))
+,mappedFile(std::move(mom.mappedFile))
+,currentLine(end(),end()){
+	mom.clear();
+}
+
+//--------------------------------------------------
+ofBuffer::~ofBuffer(){
+}
+
+//--------------------------------------------------
+ofBuffer & ofBuffer::operator=(const ofBuffer & mom){
+	if(&mom != this){
+		buffer.assign(mom.begin(),mom.end());
+		if(buffer.empty()){
+			buffer.resize(1,0);
+		}
+		mappedFile.reset();
+		currentLine = Line(end(),end());
+	}
+	return *this;
+}
+
+//--------------------------------------------------
+ofBuffer & ofBuffer::operator=(ofBuffer && mom){
+	if(&mom != this){
+		buffer = std::move(mom.buffer);
+		mappedFile = std::move(mom.mappedFile);
+		currentLine = Line(end(),end());
+		mom.clear();
+	}
+	return *this;
+}
+
 //--------------------------------------------------
 bool ofBuffer::set(istream & stream){
 	if(stream.bad()){
@@ -54,6 +107,7 @@ bool ofBuffer::set(istream & stream){
 		return false;
 	}else{
 		buffer.clear();
+		mappedFile.reset();
 	}
 
 	vector<char> aux_buffer(ioSize);
@@ -70,14 +124,16 @@ bool ofBuffer::writeTo(ostream & stream) const {
 	if(stream.bad()){
 		return false;
 	}
-	stream.write(&(buffer[0]), buffer.size() - 1);
+	stream.write(getData(), size());
 	return true;
 }
 
 //--------------------------------------------------
 void ofBuffer::set(const char * _buffer, unsigned int _size){
+	// _buffer could point to the mapped data, copy it before unmapping
 	buffer.assign(_buffer,_buffer+_size);
 	buffer.resize(buffer.size()+1,0);
+	mappedFile.reset();
 }
 
 //--------------------------------------------------
@@ -92,12 +148,45 @@ void ofBuffer::append(const string& _buffer){
 
 //--------------------------------------------------
 void ofBuffer::append(const char * _buffer, unsigned int _size){
+	unmap();
 	buffer.insert(buffer.end()-1,_buffer,_buffer+_size);
 	buffer.back() = 0;
 }
 
+//--------------------------------------------------
+bool ofBuffer::mapFile(const string & path, MapAccess access){
+	clear();
+	shared_ptr<ofMappedFile> file(new ofMappedFile);
+	if(!file->open(ofToDataPath(path, true), access)){
+		return false;
+	}
+	if(file->getData()){
+		buffer.clear();
+		mappedFile = file;
+		currentLine = Line(end(),end());
+		return true;
+	}
+	file.reset();
+	ifstream istr(ofToDataPath(path, true).c_str(), ifstream::binary);
+	return set(istr);
+}
+
+//--------------------------------------------------
+bool ofBuffer::isMapped() const{
+	return mappedFile != NULL;
+}
+
+//--------------------------------------------------
+void ofBuffer::unmap(){
+	if(mappedFile){
+		buffer.assign(mappedFile->getData(), mappedFile->getData() + mappedFile->size() + 1);
+		mappedFile.reset();
+	}
+}
+
 //--------------------------------------------------
 void ofBuffer::clear(){
+	mappedFile.reset();
 	buffer.resize(1,0);
 }
 
@@ -110,6 +199,9 @@ void ofBuffer::allocate(long _size){
 
 //--------------------------------------------------
 char * ofBuffer::getData(){
+	if(mappedFile){
+		return mappedFile->getData();
+	}
 	if(buffer.empty()){
 		return NULL;
 	}
@@ -118,6 +210,9 @@ char * ofBuffer::getData(){
 
 //--------------------------------------------------
 const char * ofBuffer::getData() const{
+	if(mappedFile){
+		return mappedFile->getData();
+	}
 	if(buffer.empty()){
 		return NULL;
 	}
@@ -136,10 +231,11 @@ const char *ofBuffer::getBinaryBuffer() const {
 
 //--------------------------------------------------
 string ofBuffer::getText() const {
-	if(buffer.empty()){
+	const char * data = getData();
+	if(data == NULL){
 		return "";
 	}
-	return &buffer[0];
+	return data;
 }
 
 //--------------------------------------------------
@@ -155,6 +251,9 @@ ofBuffer & ofBuffer::operator=(const string & text){
 
 //--------------------------------------------------
 long ofBuffer::size() const {
+	if(mappedFile){
+		return mappedFile->size();
+	}
 	if(buffer.empty()){
 		return 0;
 	}
@@ -167,6 +266,16 @@ void ofBuffer::setIOBufferSize(size_t _ioSize){
 	ioSize = _ioSize;
 }
 
+//--------------------------------------------------
+void ofBuffer::setMapMinSize(size_t minSize){
+	mapMinSize = minSize;
+}
+
+//--------------------------------------------------
+size_t ofBuffer::getMapMinSize(){
+	return mapMinSize;
+}
+
 //--------------------------------------------------
 string ofBuffer::getNextLine(){
 	if(currentLine.empty()){
@@ -193,48 +302,53 @@ void ofBuffer::resetLineReader(){
 	currentLine = getLines().begin();
 }
 
+// begin() to end() includes the 0 after the data, mapped files have it
+// in the zeroed rest of their last page
+
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::begin(){
-	return buffer.begin();
+char * ofBuffer::begin(){
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::iterator ofBuffer::end(){
-	return buffer.end();
+char * ofBuffer::end(){
+	char * data = getData();
+	return data ? data + size() + 1 : NULL;
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::begin() const{
-	return buffer.begin();
+const char * ofBuffer::begin() const{
+	return getData();
 }
 
 //--------------------------------------------------
-vector<char>::const_iterator ofBuffer::end() const{
-	return buffer.end();
+const char * ofBuffer::end() const{
+	const char * data = getData();
+	return data ? data + size() + 1 : NULL;
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rbegin(){
-	return buffer.rbegin();
+std::reverse_iterator<char*> ofBuffer::rbegin(){
+	return std::reverse_iterator<char*>(end());
 }
 
 //--------------------------------------------------
-vector<char>::reverse_iterator ofBuffer::rend(){
-	return buffer.rend();
+std::reverse_iterator<char*> ofBuffer::rend(){
+	return std::reverse_iterator<char*>(begin());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rbegin() const{
-	return buffer.rbegin();
+std::reverse_iterator<const char*> ofBuffer::rbegin() const{
+	return std::reverse_iterator<const char*>(end());
 }
 
 //--------------------------------------------------
-vector<char>::const_reverse_iterator ofBuffer::rend() const{
-	return buffer.rend();
+std::reverse_iterator<const char*> ofBuffer::rend() const{
+	return std::reverse_iterator<const char*>(begin());
 }
 
 //--------------------------------------------------
-ofBuffer::Line::Line(vector<char>::iterator _begin, vector<char>::iterator _end)
+ofBuffer::Line::Line(char * _begin, char * _end)
 	:_current(_begin)
 	,_begin(_begin)
 	,_end(_end){
@@ -307,9 +421,9 @@ bool ofBuffer::Line::empty() const{
 }
 
 //--------------------------------------------------
-ofBuffer::Lines::Lines(vector<char> & buffer)
-:_begin(buffer.begin())
-,_end(buffer.end()){}
+ofBuffer::Lines::Lines(char * _begin, char * _end)
+:_begin(_begin)
+,_end(_end){}
 
 //--------------------------------------------------
 ofBuffer::Line ofBuffer::Lines::begin(){
@@ -323,7 +437,7 @@ ofBuffer::Line ofBuffer::Lines::end(){
 
 //--------------------------------------------------
 ofBuffer::Lines ofBuffer::getLines(){
-	return ofBuffer::Lines(buffer);
+	return ofBuffer::Lines(begin(),end());
 }
 
 //--------------------------------------------------
@@ -338,8 +452,33 @@ istream & operator>>(istream & istr, ofBuffer & buf){
 	return istr;
 }
 
+//--------------------------------------------------
+// text mode only converts line endings on windows, everywhere else the
+// mapped file is what reading it would return
+static bool shouldMapFile(const string & absolutePath, bool binary){
+#ifdef TARGET_WIN32
+	if(!binary){
+		return false;
+	}
+#endif
+	if(!bufferMappingEnabled){
+		return false;
+	}
+	try{
+		Poco::File file(absolutePath);
+		return file.exists() && file.isFile() && file.getSize() >= ofBuffer::getMapMinSize();
+	}catch(Poco::Exception &){
+		return false;
+	}
+}
+
 //--------------------------------------------------
 ofBuffer ofBufferFromFile(const string & path, bool binary){
+	if(shouldMapFile(ofToDataPath(path, true), binary)){
+		ofBuffer buffer;
+		buffer.mapFile(path);
+		return buffer;
+	}
 	ios_base::openmode mode = binary ? ifstream::binary : ios_base::in;
 	ifstream istr(ofToDataPath(path, true).c_str(), mode);
 	ofBuffer buffer(istr);
@@ -349,6 +488,9 @@ ofBuffer ofBufferFromFile(const string & path, bool binary){
 
 //--------------------------------------------------
 bool ofBufferToFile(const string & path, ofBuffer & buffer, bool binary){
+	// opening the file truncates it, if it's the file the buffer maps
+	// reading the buffer would crash
+	buffer.unmap();
 	ios_base::openmode mode = binary ? ofstream::binary : ios_base::out;
 	ofstream ostr(ofToDataPath(path, true).c_str(), mode);
 	bool ret = buffer.writeTo(ostr);
@@ -356,6 +498,173 @@ bool ofBufferToFile(const string & path, ofBuffer & buffer, bool binary){
 	return ret;
 }
 
+//--------------------------------------------------
+void ofEnableBufferMapping(){
+	bufferMappingEnabled = true;
+}
+
+//--------------------------------------------------
+void ofDisableBufferMapping(){
+	bufferMappingEnabled = false;
+}
+
+//--------------------------------------------------
+bool ofGetUsingBufferMapping(){
+	return bufferMappingEnabled;
+}
+
+//--------------------------------------------------
+ofMappedFile::ofMappedFile()
+:data(NULL)
+,fileSize(0)
+#ifdef TARGET_WIN32
+,file(INVALID_HANDLE_VALUE)
+,mapping(NULL)
+#endif
+{}
+
+//--------------------------------------------------
+ofMappedFile::~ofMappedFile(){
+	close();
+}
+
+//--------------------------------------------------
+bool ofMappedFile::open(const string & path, ofBuffer::MapAccess access){
+	close();
+#ifdef TARGET_WIN32
+	DWORD flags = FILE_ATTRIBUTE_NORMAL;
+	if(access == ofBuffer::Sequential){
+		flags = FILE_FLAG_SEQUENTIAL_SCAN;
+	}else if(access == ofBuffer::Random){
+		flags = FILE_FLAG_RANDOM_ACCESS;
+	}
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+	if(file == INVALID_HANDLE_VALUE){
+		return false;
+	}
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(file, &size) || uint64_t(size.QuadPart) > numeric_limits<size_t>::max()){
+		close();
+		return false;
+	}
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	fileSize = size.QuadPart;
+	if(fileSize == 0 || fileSize % info.dwPageSize == 0){
+		return true;
+	}
+	mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	if(mapping != NULL){
+		data = (char*)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	}
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd == -1){
+		return false;
+	}
+	struct stat info;
+	if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)){
+		::close(fd);
+		return false;
+	}
+	fileSize = info.st_size;
+	if(fileSize != 0 && fileSize % sysconf(_SC_PAGESIZE) != 0){
+		void * mapped = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if(mapped != MAP_FAILED){
+			data = (char*)mapped;
+			if(access == ofBuffer::Sequential){
+				madvise(mapped, fileSize, MADV_SEQUENTIAL);
+			}else if(access == ofBuffer::Random){
+				madvise(mapped, fileSize, MADV_RANDOM);
+			}
+		}
+	}
+	// the mapping keeps its own reference to the file
+	::close(fd);
+#endif
+	return true;
+}
+
+//--------------------------------------------------
+bool ofMappedFile::create(const string & path, size_t size, bool keepData){
+	close();
+#ifdef TARGET_WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, keepData ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(file == INVALID_HANDLE_VALUE){
+		return false;
+	}
+	LARGE_INTEGER newSize;
+	newSize.QuadPart = size;
+	if(!SetFilePointerEx(file, newSize, NULL, FILE_BEGIN) || !SetEndOfFile(file)){
+		close();
+		return false;
+	}
+	fileSize = size;
+	if(fileSize == 0){
+		return true;
+	}
+	mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(size & 0xffffffff), NULL);
+	if(mapping != NULL){
+		data = (char*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+	}
+#else
+	int fd = ::open(path.c_str(), O_RDWR | O_CREAT | (keepData ? 0 : O_TRUNC), 0644);
+	if(fd == -1){
+		return false;
+	}
+	struct stat info;
+	if(fstat(fd, &info) != 0 || (uint64_t(info.st_size) != size && ftruncate(fd, size) != 0)){
+		::close(fd);
+		return false;
+	}
+	fileSize = size;
+	if(fileSize == 0){
+		::close(fd);
+		return true;
+	}
+	void * mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(mapped != MAP_FAILED){
+		data = (char*)mapped;
+	}
+	::close(fd);
+#endif
+	if(data == NULL){
+		close();
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------
+void ofMappedFile::close(){
+#ifdef TARGET_WIN32
+	if(data) UnmapViewOfFile(data);
+	if(mapping) CloseHandle(mapping);
+	if(file != INVALID_HANDLE_VALUE) CloseHandle(file);
+	mapping = NULL;
+	file = INVALID_HANDLE_VALUE;
+#else
+	if(data) munmap(data, fileSize);
+#endif
+	data = NULL;
+	fileSize = 0;
+}
+
+//--------------------------------------------------
+char * ofMappedFile::getData(){
+	return data;
+}
+
+//--------------------------------------------------
+const char * ofMappedFile::getData() const{
+	return data;
+}
+
+//--------------------------------------------------
+size_t ofMappedFile::size() const{
+	return fileSize;
+}
+
 //------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------
 // -- ofFile
@@ -512,6 +821,13 @@ ofBuffer ofFile::readToBuffer(){
 		return ofBuffer();
 	}
 
+	// only map when nothing has been read yet, the buffer holds the rest
+	// of the file from the current position
+	if(mode == ReadOnly && tellg() == streampos(0) && shouldMapFile(path(), binary)){
+		ofBuffer buffer;
+		buffer.mapFile(path());
+		return buffer;
+	}
 	return ofBuffer(*this);
 }
 
@@ -7,13 +7,29 @@
 // ofBuffer
 //----------------------------------------------------------
 
+class ofMappedFile;
+
 class ofBuffer{
 	
 public:
+	/// \brief How the data of a memory mapped file is going to be read,
+	/// passed to the OS as a hint for how to read ahead.
+	enum MapAccess{
+		Normal,
+		Sequential,
+		Random
+	};
+
 	ofBuffer();
 	ofBuffer(const char * buffer, unsigned int size);
 	ofBuffer(const string & text);
 	ofBuffer(istream & stream);
+	ofBuffer(const ofBuffer & mom);
+	ofBuffer(ofBuffer && mom);
+	~ofBuffer();
+
+	ofBuffer & operator=(const ofBuffer & mom);
+	ofBuffer & operator=(ofBuffer && mom);
 
 	void set(const char * _buffer, unsigned int _size);
 	void set(const string & text);
@@ -21,6 +37,30 @@ public:
 	void append(const string& _buffer);
 	void append(const char * _buffer, unsigned int _size);
 
+	/// \brief Maps a file in memory instead of copying it in the buffer.
+	///
+	/// The OS reads the pages of the file when they are first accessed, so
+	/// the file doesn't need to fit in memory and isn't copied. Writing
+	/// through getData() only changes the memory, never the file, and any
+	/// operation that changes the size of the buffer or copying it copies
+	/// the data. The file shouldn't be truncated while it's mapped, reading
+	/// the buffer would crash. ofBufferToFile copies the data first, but
+	/// opening the file for writing in any other way truncates it.
+	///
+	/// If the file can't be mapped it's read as ofBufferFromFile() would.
+	///
+	/// \param path the file to map, relative to the data folder.
+	/// \param access how the data is going to be read.
+	/// \returns false if the file couldn't be opened.
+	bool mapFile(const string & path, MapAccess access=Sequential);
+
+	/// \returns true if the data of the buffer is a memory mapped file.
+	bool isMapped() const;
+
+	/// \brief Copies the data of a mapped file into the buffer and unmaps
+	/// the file, does nothing if the buffer isn't mapped.
+	void unmap();
+
 	bool writeTo(ostream & stream) const;
 
 	void clear();
@@ -39,6 +79,11 @@ public:
 	long size() const;
 	static void setIOBufferSize(size_t ioSize);
 
+	/// \brief Files smaller than this are copied instead of mapped by
+	/// ofBufferFromFile and ofFile::readToBuffer, 1MB by default.
+	static void setMapMinSize(size_t minSize);
+	static size_t getMapMinSize();
+
 	OF_DEPRECATED_MSG("use a lines iterator instead",string getNextLine());
 	OF_DEPRECATED_MSG("use a lines iterator instead",string getFirstLine());
 	OF_DEPRECATED_MSG("use a lines iterator instead",bool isLastLine());
@@ -47,17 +92,17 @@ public:
 	friend ostream & operator<<(ostream & ostr, const ofBuffer & buf);
 	friend istream & operator>>(istream & istr, ofBuffer & buf);
 
-	vector<char>::iterator begin();
-	vector<char>::iterator end();
-	vector<char>::const_iterator begin() const;
-	vector<char>::const_iterator end() const;
-	vector<char>::reverse_iterator rbegin();
-	vector<char>::reverse_iterator rend();
-	vector<char>::const_reverse_iterator rbegin() const;
-	vector<char>::const_reverse_iterator rend() const;
+	char * begin();
+	char * end();
+	const char * begin() const;
+	const char * end() const;
+	std::reverse_iterator<char*> rbegin();
+	std::reverse_iterator<char*> rend();
+	std::reverse_iterator<const char*> rbegin() const;
+	std::reverse_iterator<const char*> rend() const;
 
 	struct Line: public std::iterator<std::forward_iterator_tag,Line>{
-		Line(vector<char>::iterator _begin, vector<char>::iterator _end);
+		Line(char * _begin, char * _end);
         const string & operator*() const;
         const string * operator->() const;
         const string & asString() const;
@@ -69,24 +114,26 @@ public:
 
 	private:
         string line;
-        vector<char>::iterator _current, _begin, _end;
+        char * _current, * _begin, * _end;
 	};
 
 	struct Lines{
-		Lines(vector<char> & buffer);
+		Lines(char * _begin, char * _end);
         Line begin();
         Line end();
 
 	private:
-        vector<char>::iterator _begin, _end;
+        char * _begin, * _end;
 	};
 
 	Lines getLines();
 
 private:
 	vector<char> 	buffer;
+	shared_ptr<ofMappedFile> mappedFile;
 	Line			currentLine;
 	static size_t	ioSize;
+	static size_t	mapMinSize;
 };
 
 //--------------------------------------------------
@@ -95,6 +142,67 @@ ofBuffer ofBufferFromFile(const string & path, bool binary=false);
 //--------------------------------------------------
 bool ofBufferToFile(const string & path, ofBuffer & buffer, bool binary=false);
 
+//--------------------------------------------------
+/// \brief Makes ofBufferFromFile and ofFile::readToBuffer map files in
+/// memory instead of copying them, see ofBuffer::mapFile. Disabled by
+/// default since a mapped file can't be truncated while the buffer is
+/// alive, files opened in text mode are always copied on windows.
+void ofEnableBufferMapping();
+
+/// \brief Makes ofBufferFromFile and ofFile::readToBuffer copy files
+/// into the buffer.
+void ofDisableBufferMapping();
+
+/// \brief Check whether ofBufferFromFile maps files in memory.
+bool ofGetUsingBufferMapping();
+
+//--------------------------------------------------
+/// \brief A file mapped in memory, used by ofBuffer::mapFile and by the
+/// classes that write big files in place, like ofMesh::save and
+/// ofBinaryLoggerChannel.
+///
+/// Paths are used as they are, pass them through ofToDataPath first.
+class ofMappedFile{
+public:
+	ofMappedFile();
+	~ofMappedFile();
+
+	/// \brief Maps an existing file copy on write, writes through getData()
+	/// only change the memory.
+	///
+	/// Empty files and files whose size is a multiple of the page size
+	/// are opened but not mapped, getData() returns NULL for them. Any
+	/// other mapped file has zeroed bytes after its data.
+	/// \returns false if the file couldn't be opened.
+	bool open(const string & path, ofBuffer::MapAccess access=ofBuffer::Normal);
+
+	/// \brief Creates a file of size bytes, or resizes an existing one, and
+	/// maps it for writing, writes through getData() go to the file.
+	/// \param keepData false to discard what the file contained.
+	/// \returns false if the file couldn't be created or mapped.
+	bool create(const string & path, size_t size, bool keepData=false);
+
+	/// \brief Unmaps and closes the file.
+	void close();
+
+	char * getData();
+	const char * getData() const;
+
+	/// \returns the size of the file.
+	size_t size() const;
+
+private:
+	ofMappedFile(const ofMappedFile &);
+	ofMappedFile & operator=(const ofMappedFile &);
+
+	char * data;
+	size_t fileSize;
+#ifdef TARGET_WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+};
+
 
 //--------------------------------------------------
 class ofFilePath{
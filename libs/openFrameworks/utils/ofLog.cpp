@@ -2,6 +2,17 @@
 #include "ofConstants.h"
 #include <ofUtils.h>
 #include <map>
+#include <atomic>
+
+#ifndef TARGET_NO_THREADS
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#endif
+#include "Poco/Timestamp.h"
+
+#ifndef TARGET_WIN32
+#include <pthread.h>
+#endif
 
 static ofLogLevel currentLogLevel =  OF_LOG_NOTICE;
 
@@ -51,6 +62,7 @@ ofLog::ofLog(){
 	level = OF_LOG_NOTICE;
 	module = "";
 	bPrinted = false;
+	bStarted = false;
 }
 		
 //--------------------------------------------------
@@ -58,12 +70,14 @@ ofLog::ofLog(ofLogLevel _level){
 	level = _level;
 	module = "";
 	bPrinted = false;
+	bStarted = false;
 }
 
 //--------------------------------------------------
 ofLog::ofLog(ofLogLevel level, const string & message){
 	_log(level,"",message);
 	bPrinted = true;
+	bStarted = true;
 }
 
 //--------------------------------------------------
@@ -75,6 +89,7 @@ ofLog::ofLog(ofLogLevel level, const char* format, ...){
 		va_end( args );
 	}
 	bPrinted = true;
+	bStarted = true;
 }
 
 //--------------------------------------------------
@@ -92,17 +107,36 @@ void ofLog::setAutoSpace(bool autoSpace){
 ofLog::~ofLog(){
 	// don't log if we printed in the constructor already
 	if(!bPrinted){
-		_log(level,module,message.str());
+		if(!bStarted){
+			startMessage();
+		}
+		if(message){
+			channel->log(level,module,message->str());
+		}
+	}
+}
+
+//-------------------------------------------------------
+void ofLog::startMessage(){
+	// the stream is only created if the message is going to be logged
+	bStarted = true;
+	if(checkLog(level,module)){
+		message.reset(new std::ostringstream);
 	}
 }
 
+//-------------------------------------------------------
 bool ofLog::checkLog(ofLogLevel level, const string & module){
-	if(getModules().find(module)==getModules().end()){
-		if(level >= currentLogLevel) return true;
+	map<string,ofLogLevel> & modules = getModules();
+	if(modules.empty()){
+		return level >= currentLogLevel;
+	}
+	map<string,ofLogLevel>::iterator it = modules.find(module);
+	if(it==modules.end()){
+		return level >= currentLogLevel;
 	}else{
-		if(level >= getModules()[module]) return true;
+		return level >= it->second;
 	}
-	return false;
 }
 
 //-------------------------------------------------------
@@ -117,6 +151,7 @@ ofLogVerbose::ofLogVerbose(const string & _module){
 	level = OF_LOG_VERBOSE;
 	module = _module;
 	bPrinted=false;
+	bStarted = false;
 }
 
 ofLogVerbose::ofLogVerbose(const string & _module, const string & _message){
@@ -139,6 +174,7 @@ ofLogNotice::ofLogNotice(const string & _module){
 	level = OF_LOG_NOTICE;
 	module = _module;
 	bPrinted=false;
+	bStarted = false;
 }
 
 ofLogNotice::ofLogNotice(const string & _module, const string & _message){
@@ -161,6 +197,7 @@ ofLogWarning::ofLogWarning(const string & _module){
 	level = OF_LOG_WARNING;
 	module = _module;
 	bPrinted=false;
+	bStarted = false;
 }
 
 ofLogWarning::ofLogWarning(const string & _module, const string & _message){
@@ -183,6 +220,7 @@ ofLogError::ofLogError(const string & _module){
 	level = OF_LOG_ERROR;
 	module = _module;
 	bPrinted=false;
+	bStarted = false;
 }
 
 ofLogError::ofLogError(const string & _module, const string & _message){
@@ -205,6 +243,7 @@ ofLogFatalError::ofLogFatalError(const string &  _module){
 	level = OF_LOG_FATAL_ERROR;
 	module = _module;
 	bPrinted=false;
+	bStarted = false;
 }
 
 ofLogFatalError::ofLogFatalError(const string & _module, const string & _message){
@@ -251,6 +290,10 @@ string ofGetLogLevelName(ofLogLevel level, bool pad){
 }
 
 //--------------------------------------------------
+ofConsoleLoggerChannel::ofConsoleLoggerChannel()
+:bBatch(false){
+}
+
 void ofConsoleLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
 	// print to cerr for OF_LOG_ERROR and OF_LOG_FATAL_ERROR, everything else to cout 
 	ostream& out = level < OF_LOG_ERROR ? cout : cerr;
@@ -259,7 +302,19 @@ void ofConsoleLoggerChannel::log(ofLogLevel level, const string & module, const
 	if(module != ""){
 		out << module << ": ";
 	}
-	out << message << endl;
+	out << message << '\n';
+	if(!bBatch){
+		out.flush();
+	}
+}
+
+void ofConsoleLoggerChannel::beginBatch(){
+	bBatch = true;
+}
+
+void ofConsoleLoggerChannel::endBatch(){
+	bBatch = false;
+	cout.flush();
 }
 
 void ofConsoleLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
@@ -282,10 +337,12 @@ void ofConsoleLoggerChannel::log(ofLogLevel level, const string & module, const
 }
 
 //--------------------------------------------------
-ofFileLoggerChannel::ofFileLoggerChannel(){
+ofFileLoggerChannel::ofFileLoggerChannel()
+:bBatch(false){
 }
 
-ofFileLoggerChannel::ofFileLoggerChannel(const string & path, bool append){
+ofFileLoggerChannel::ofFileLoggerChannel(const string & path, bool append)
+:bBatch(false){
 	setFile(path,append);
 }
 
@@ -309,7 +366,19 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const str
 	if(module != ""){
 		file << module << ": ";
 	}
-	file << message << endl;
+	file << message << '\n';
+	if(!bBatch){
+		file.flush();
+	}
+}
+
+void ofFileLoggerChannel::beginBatch(){
+	bBatch = true;
+}
+
+void ofFileLoggerChannel::endBatch(){
+	bBatch = false;
+	file.flush();
 }
 
 void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
@@ -326,3 +395,494 @@ void ofFileLoggerChannel::log(ofLogLevel level, const string & module, const cha
 	}
 	file << ofVAArgsToString(format,args) << endl;
 }
+
+//--------------------------------------------------
+// a bounded queue of log messages for many producers and one consumer.
+// every slot has a sequence number that tells the producers when it's free
+// to write and the consumer when it's ready to read, so neither has to lock:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+class ofAsyncLoggerQueue
+#ifndef TARGET_NO_THREADS
+: public Poco::Runnable
+#endif
+{
+public:
+	ofAsyncLoggerQueue(shared_ptr<ofBaseLoggerChannel> channel, size_t _capacity, ofAsyncLoggerChannel::OverflowPolicy policy)
+	:channel(channel)
+	,policy(policy)
+	,flushInterval(100)
+	,pushed(0)
+	,popped(0)
+	,dropped(0)
+	,reportedDropped(0)
+	,exiting(false){
+		capacity = 2;
+		while(capacity < _capacity){
+			capacity *= 2;
+		}
+		records.reset(new Record[capacity]);
+		for(size_t i = 0; i < capacity; i++){
+			records[i].sequence.store(i, std::memory_order_relaxed);
+		}
+#ifndef TARGET_NO_THREADS
+		thread.setName("ofAsyncLoggerChannel");
+		thread.start(*this);
+#endif
+	}
+
+	~ofAsyncLoggerQueue(){
+#ifndef TARGET_NO_THREADS
+		exiting.store(true);
+		wakeUp.set();
+		thread.join();
+#endif
+	}
+
+	void push(ofLogLevel level, const string & module, const string & message){
+#ifdef TARGET_NO_THREADS
+		channel->log(level, module, message);
+#else
+		size_t pos = pushed.load(std::memory_order_relaxed);
+		while(true){
+			Record & record = records[pos & (capacity - 1)];
+			size_t sequence = record.sequence.load(std::memory_order_acquire);
+			intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+			if(diff == 0){
+				if(pushed.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					record.level = level;
+					record.module.assign(module);
+					record.message.assign(message);
+					record.sequence.store(pos + 1, std::memory_order_release);
+					break;
+				}
+			}else if(diff < 0){
+				// full
+				if(policy.load(std::memory_order_relaxed) != ofAsyncLoggerChannel::Block){
+					dropped.fetch_add(1, std::memory_order_relaxed);
+					wakeUp.set();
+					return;
+				}
+				wakeUp.set();
+				drained.tryWait(1);
+				pos = pushed.load(std::memory_order_relaxed);
+			}else{
+				pos = pushed.load(std::memory_order_relaxed);
+			}
+		}
+		// setting the event locks a mutex, only do it when the messages
+		// shouldn't wait for the next interval
+		if(level >= OF_LOG_FATAL_ERROR || pos + 1 - popped.load(std::memory_order_relaxed) >= capacity / 2){
+			wakeUp.set();
+		}
+#endif
+	}
+
+	void flush(){
+#ifndef TARGET_NO_THREADS
+		size_t target = pushed.load();
+		while(popped.load() < target && !exiting.load()){
+			wakeUp.set();
+			drained.tryWait(10);
+		}
+#endif
+	}
+
+#ifndef TARGET_NO_THREADS
+	void run(){
+		while(true){
+			wakeUp.tryWait(flushInterval.load(std::memory_order_relaxed));
+			bool exit = exiting.load();
+			logQueued();
+			drained.set();
+			if(exit){
+				break;
+			}
+		}
+	}
+#endif
+
+	// logs every message in the queue, only called from the thread
+	void logQueued(){
+		size_t pos = popped.load(std::memory_order_relaxed);
+		uint64_t numDropped = dropped.load(std::memory_order_relaxed);
+		bool report = policy.load(std::memory_order_relaxed) == ofAsyncLoggerChannel::ReportDropped && numDropped != reportedDropped;
+		Record * record = &records[pos & (capacity - 1)];
+		if(!report && record->sequence.load(std::memory_order_acquire) != pos + 1){
+			return;
+		}
+		channel->beginBatch();
+		while(record->sequence.load(std::memory_order_acquire) == pos + 1){
+			channel->log(record->level, record->module, record->message);
+			record->sequence.store(pos + capacity, std::memory_order_release);
+			pos++;
+			popped.store(pos, std::memory_order_release);
+			record = &records[pos & (capacity - 1)];
+		}
+		if(report){
+			channel->log(OF_LOG_WARNING, "ofAsyncLoggerChannel", "queue full, dropped " + ofToString(numDropped - reportedDropped) + " messages");
+			reportedDropped = numDropped;
+		}
+		channel->endBatch();
+	}
+
+	struct Record{
+		std::atomic<size_t> sequence;
+		ofLogLevel level;
+		string module;
+		string message;
+	};
+
+	shared_ptr<ofBaseLoggerChannel> channel;
+	std::atomic<int> policy;
+	std::atomic<long> flushInterval;
+	std::unique_ptr<Record[]> records;
+	size_t capacity;
+	std::atomic<size_t> pushed;
+	std::atomic<size_t> popped;
+	std::atomic<uint64_t> dropped;
+	uint64_t reportedDropped;
+	std::atomic<bool> exiting;
+#ifndef TARGET_NO_THREADS
+	Poco::Thread thread;
+	Poco::Event wakeUp;
+	Poco::Event drained;
+#endif
+};
+
+//--------------------------------------------------
+ofAsyncLoggerChannel::ofAsyncLoggerChannel(shared_ptr<ofBaseLoggerChannel> channel, size_t capacity, OverflowPolicy policy)
+:queue(new ofAsyncLoggerQueue(channel, capacity, policy)){
+}
+
+ofAsyncLoggerChannel::~ofAsyncLoggerChannel(){
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
+	queue->push(level, module, message);
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
+	va_list args;
+	va_start(args, format);
+	log(level, module, format, args);
+	va_end(args);
+}
+
+void ofAsyncLoggerChannel::log(ofLogLevel level, const string & module, const char* format, va_list args){
+	queue->push(level, module, ofVAArgsToString(format, args));
+}
+
+void ofAsyncLoggerChannel::flush(){
+	queue->flush();
+}
+
+void ofAsyncLoggerChannel::setOverflowPolicy(OverflowPolicy policy){
+	queue->policy.store(policy);
+}
+
+ofAsyncLoggerChannel::OverflowPolicy ofAsyncLoggerChannel::getOverflowPolicy() const{
+	return OverflowPolicy(queue->policy.load());
+}
+
+void ofAsyncLoggerChannel::setFlushInterval(int milliseconds){
+	queue->flushInterval.store(MAX(milliseconds, 1));
+}
+
+uint64_t ofAsyncLoggerChannel::getNumDropped() const{
+	return queue->dropped.load();
+}
+
+size_t ofAsyncLoggerChannel::getCapacity() const{
+	return queue->capacity;
+}
+
+shared_ptr<ofBaseLoggerChannel> ofAsyncLoggerChannel::getChannel() const{
+	return queue->channel;
+}
+
+//--------------------------------------------------
+// binary log file layout, in the byte order of the machine that wrote it:
+// a header, a table of module names and a ring of records. head and tail
+// count every byte ever written so the ring holds [tail, head). records are
+// aligned to 8 bytes and a record that doesn't fit at the end of the ring
+// is preceded by a padding record filling it
+static const char binaryLogMagic[8] = {'o','f','L','o','g','R','n','g'};
+static const uint32_t binaryLogVersion = 1;
+static const uint32_t binaryLogMaxModules = 1024;
+static const uint32_t binaryLogModuleNameSize = 64;
+static const uint8_t binaryLogPadding = 0xff;
+// modules that don't fit in the table are logged as part of the message
+static const unsigned short binaryLogNoModule = 0xffff;
+
+struct ofBinaryLogHeader{
+	char magic[8];
+	uint32_t version;
+	uint32_t dataOffset;
+	uint64_t capacity;
+	uint64_t head;
+	uint64_t tail;
+	uint32_t numModules;
+	uint32_t maxModules;
+	char reserved[16];
+};
+
+struct ofBinaryLogRecord{
+	uint32_t size;
+	uint8_t level;
+	uint8_t reserved;
+	uint16_t module;
+	uint32_t length;
+	uint32_t reserved2;
+	uint64_t thread;
+	uint64_t time;
+};
+
+static uint64_t binaryLogThreadId(){
+#ifdef TARGET_WIN32
+	return GetCurrentThreadId();
+#else
+	return (uint64_t)(uintptr_t)pthread_self();
+#endif
+}
+
+//--------------------------------------------------
+// the whole log file mapped in memory for writing
+class ofBinaryLoggerFile{
+public:
+	ofBinaryLoggerFile()
+	:data(NULL){}
+
+	// opens or creates the file with fileSize bytes, existing files of a
+	// different size are resized
+	bool open(const string & path, size_t fileSize){
+		if(!file.create(path, fileSize, true)){
+			return false;
+		}
+		data = file.getData();
+		return true;
+	}
+
+	ofBinaryLogHeader & header(){
+		return *(ofBinaryLogHeader*)data;
+	}
+
+	char * moduleName(unsigned short id){
+		return data + sizeof(ofBinaryLogHeader) + id * binaryLogModuleNameSize;
+	}
+
+	ofBinaryLogRecord & record(uint64_t position){
+		ofBinaryLogHeader & h = header();
+		return *(ofBinaryLogRecord*)(data + h.dataOffset + position % h.capacity);
+	}
+
+	// drops the oldest records until there's size bytes free after the head
+	void makeRoom(uint64_t size){
+		ofBinaryLogHeader & h = header();
+		while(h.head + size - h.tail > h.capacity){
+			uint32_t recordSize = record(h.tail).size;
+			if(recordSize == 0 || recordSize % 8 != 0){
+				// a corrupt record, there's no way to know where the next one is
+				h.tail = h.head;
+				break;
+			}
+			h.tail += recordSize;
+		}
+	}
+
+	char * data;
+
+private:
+	ofBinaryLoggerFile(const ofBinaryLoggerFile &);
+	ofBinaryLoggerFile & operator=(const ofBinaryLoggerFile &);
+
+	ofMappedFile file;
+};
+
+//--------------------------------------------------
+ofBinaryLoggerChannel::ofBinaryLoggerChannel(){
+}
+
+ofBinaryLoggerChannel::ofBinaryLoggerChannel(const string & path, size_t size, bool append){
+	setFile(path, size, append);
+}
+
+ofBinaryLoggerChannel::~ofBinaryLoggerChannel(){
+	close();
+}
+
+void ofBinaryLoggerChannel::close(){
+	ofScopedLock lock(mutex);
+	file.reset();
+	modules.clear();
+}
+
+bool ofBinaryLoggerChannel::setFile(const string & path, size_t size, bool append){
+	ofScopedLock lock(mutex);
+	file.reset();
+	modules.clear();
+
+	uint64_t capacity = MAX(size, size_t(4096)) / 8 * 8;
+	uint32_t dataOffset = sizeof(ofBinaryLogHeader) + binaryLogMaxModules * binaryLogModuleNameSize;
+	shared_ptr<ofBinaryLoggerFile> newFile(new ofBinaryLoggerFile);
+	if(!newFile->open(ofToDataPath(path, true), dataOffset + capacity)){
+		// ofLog would call this channel again
+		cerr << "[ error ] ofBinaryLoggerChannel: couldn't open \"" << path << "\"" << endl;
+		return false;
+	}
+
+	ofBinaryLogHeader & header = newFile->header();
+	bool valid = memcmp(header.magic, binaryLogMagic, sizeof(binaryLogMagic)) == 0
+			&& header.version == binaryLogVersion
+			&& header.dataOffset == dataOffset
+			&& header.capacity == capacity
+			&& header.maxModules == binaryLogMaxModules
+			&& header.numModules <= binaryLogMaxModules
+			&& header.tail <= header.head
+			&& header.head - header.tail <= capacity;
+	if(append && valid){
+		for(unsigned short i = 0; i < header.numModules; i++){
+			modules[newFile->moduleName(i)] = i;
+		}
+	}else{
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, binaryLogMagic, sizeof(binaryLogMagic));
+		header.version = binaryLogVersion;
+		header.dataOffset = dataOffset;
+		header.capacity = capacity;
+		header.maxModules = binaryLogMaxModules;
+	}
+	file = newFile;
+	return true;
+}
+
+// called with the mutex locked
+unsigned short ofBinaryLoggerChannel::getModuleId(const string & module){
+	map<string,unsigned short>::iterator it = modules.find(module);
+	if(it != modules.end()){
+		return it->second;
+	}
+	ofBinaryLogHeader & header = file->header();
+	if(header.numModules == binaryLogMaxModules || module.size() >= binaryLogModuleNameSize){
+		return binaryLogNoModule;
+	}
+	unsigned short id = header.numModules;
+	memcpy(file->moduleName(id), module.c_str(), module.size() + 1);
+	header.numModules++;
+	modules[module] = id;
+	return id;
+}
+
+void ofBinaryLoggerChannel::log(ofLogLevel level, const string & module, const string & message){
+	uint64_t time = Poco::Timestamp().epochMicroseconds();
+	uint64_t thread = binaryLogThreadId();
+
+	ofScopedLock lock(mutex);
+	if(!file){
+		return;
+	}
+	unsigned short moduleId = getModuleId(module);
+	ofBinaryLogHeader & header = file->header();
+
+	// a message can take at most half of the ring
+	const string * text = &message;
+	string withModule;
+	if(moduleId == binaryLogNoModule){
+		withModule = module + ": " + message;
+		text = &withModule;
+	}
+	uint32_t length = MIN(text->size(), header.capacity / 2 - sizeof(ofBinaryLogRecord));
+	uint32_t size = (sizeof(ofBinaryLogRecord) + length + 7) / 8 * 8;
+
+	uint64_t remaining = header.capacity - header.head % header.capacity;
+	if(remaining < size){
+		file->makeRoom(remaining);
+		ofBinaryLogRecord & padding = file->record(header.head);
+		padding.size = remaining;
+		padding.level = binaryLogPadding;
+		header.head += remaining;
+	}
+	file->makeRoom(size);
+
+	ofBinaryLogRecord & record = file->record(header.head);
+	record.size = size;
+	record.level = level;
+	record.reserved = 0;
+	record.module = moduleId;
+	record.length = length;
+	record.reserved2 = 0;
+	record.thread = thread;
+	record.time = time;
+	memcpy(&record + 1, text->c_str(), length);
+	// the head moves after the record is complete, a crash while writing
+	// it leaves the log as it was before
+	header.head += size;
+}
+
+void ofBinaryLoggerChannel::log(ofLogLevel level, const string & module, const char* format, ...){
+	va_list args;
+	va_start(args, format);
+	log(level, module, format, args);
+	va_end(args);
+}
+
+void ofBinaryLoggerChannel::log(ofLogLevel level, const string & module, const char* format, va_list args){
+	log(level, module, ofVAArgsToString(format, args));
+}
+
+bool ofBinaryLoggerChannel::read(const string & path, vector<Message> & messages){
+	messages.clear();
+	ofBuffer buffer;
+	if(!buffer.mapFile(path, ofBuffer::Sequential) || size_t(buffer.size()) < sizeof(ofBinaryLogHeader)){
+		return false;
+	}
+	const char * data = buffer.getData();
+	ofBinaryLogHeader header;
+	memcpy(&header, data, sizeof(header));
+	if(memcmp(header.magic, binaryLogMagic, sizeof(binaryLogMagic)) != 0
+			|| header.version != binaryLogVersion
+			|| header.numModules > header.maxModules
+			|| header.dataOffset < sizeof(ofBinaryLogHeader) + uint64_t(header.maxModules) * binaryLogModuleNameSize
+			|| header.capacity % 8 != 0
+			|| header.dataOffset + header.capacity > uint64_t(buffer.size())
+			|| header.tail > header.head
+			|| header.head - header.tail > header.capacity){
+		return false;
+	}
+
+	vector<string> moduleNames(header.numModules);
+	for(size_t i = 0; i < moduleNames.size(); i++){
+		const char * name = data + sizeof(ofBinaryLogHeader) + i * binaryLogModuleNameSize;
+		moduleNames[i] = string(name, strnlen(name, binaryLogModuleNameSize));
+	}
+
+	const char * ring = data + header.dataOffset;
+	uint64_t position = header.tail;
+	while(position < header.head){
+		uint64_t offset = position % header.capacity;
+		if(header.capacity - offset < 8){
+			return false;
+		}
+		ofBinaryLogRecord record;
+		memcpy(&record, ring + offset, MIN(sizeof(record), size_t(header.capacity - offset)));
+		if(record.size < 8 || record.size % 8 != 0 || record.size > header.capacity - offset || record.size > header.head - position){
+			return false;
+		}
+		position += record.size;
+		if(record.level == binaryLogPadding){
+			continue;
+		}
+		if(record.size < sizeof(record) || record.length > record.size - sizeof(record)){
+			return false;
+		}
+		Message message;
+		message.time = record.time;
+		message.thread = record.thread;
+		message.level = ofLogLevel(record.level);
+		if(record.module < moduleNames.size()){
+			message.module = moduleNames[record.module];
+		}
+		message.message.assign(ring + offset + sizeof(record), record.length);
+		messages.push_back(message);
+	}
+	return true;
+}
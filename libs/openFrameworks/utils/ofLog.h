@@ -430,7 +430,13 @@ class ofLog{
 		/// \returns A reference to itself.
 		template <class T> 
 			ofLog& operator<<(const T& value){
-			message << value << padding;
+			// messages filtered by their level are never formatted
+			if(!bStarted){
+				startMessage();
+			}
+			if(message){
+				*message << value << padding;
+			}
 			return *this;
 		}
 	
@@ -442,7 +448,12 @@ class ofLog{
 		/// \param A function pointer that takes a std::ostream as an argument.
 		/// \returns A reference to itself.
 		ofLog& operator<<(std::ostream& (*func)(std::ostream&)){
-			func(message);
+			if(!bStarted){
+				startMessage();
+			}
+			if(message){
+				func(*message);
+			}
 			return *this;
 		}
 	
@@ -456,6 +467,7 @@ class ofLog{
 
 		ofLogLevel level; ///< Log level.
 		bool bPrinted;	  ///< Has the message been printed in the constructor?
+		bool bStarted;	  ///< Has the level of the streamed message been checked?
 		string module;    ///< The destination module for this message.
 		
 		/// \brief Print a log line.
@@ -469,13 +481,17 @@ class ofLog{
 		/// \param module The target module.
 		/// \returns true if the given module is active at the given log level.
 		bool checkLog(ofLogLevel level, const string & module);
+
+		/// \brief Start a streamed message once its level and module are set.
+		/// Messages that are filtered by checkLog() are never formatted.
+		void startMessage();
 	
 		static shared_ptr<ofBaseLoggerChannel> channel;	///< The target channel.
 	
 		/// \endcond
 	
 	private:
-		std::ostringstream message;	///< Temporary buffer.
+		unique_ptr<std::ostringstream> message;	///< Temporary buffer, NULL if the level is filtered.
 		
 		static bool bAutoSpace; ///< Should space be added between messages?
 		
@@ -618,16 +634,33 @@ public:
 	/// \param format The printf-style format string.
 	/// \param args the list of printf-style arguments.
 	virtual void log(ofLogLevel level, const string & module, const char* format, va_list args)=0;
+
+	/// \brief Called before logging a group of messages in a row.
+	/// Channels that flush their output after every message, can wait
+	/// until endBatch() while in a batch. ofAsyncLoggerChannel logs every
+	/// message it has queued as a batch.
+	virtual void beginBatch(){}
+
+	/// \brief Called after the last message of a batch.
+	virtual void endBatch(){}
 };
 
 /// \brief A logger channel that logs its messages to the console.
 class ofConsoleLoggerChannel: public ofBaseLoggerChannel{
 public:
+	/// \brief Create an ofConsoleLoggerChannel.
+	ofConsoleLoggerChannel();
+
 	/// \brief Destroy the console logger channel.
 	virtual ~ofConsoleLoggerChannel(){};
 	void log(ofLogLevel level, const string & module, const string & message);
 	void log(ofLogLevel level, const string & module, const char* format, ...) OF_PRINTF_ATTR(4, 5);
 	void log(ofLogLevel level, const string & module, const char* format, va_list args);
+	void beginBatch();
+	void endBatch();
+
+private:
+	bool bBatch; ///< Are we in a batch? the output is flushed at its end.
 };
 
 /// \brief A logger channel that logs its messages to a log file.
@@ -653,14 +686,167 @@ public:
 	void log(ofLogLevel level, const string & module, const char* format, ...) OF_PRINTF_ATTR(4, 5);
 	void log(ofLogLevel level, const string & module, const char* format, va_list args);
 
+	void beginBatch();
+	void endBatch();
+
 	/// \brief CLose the log file.
 	void close();
 
 private:
 	ofFile file; ///< The location of the log file.
+	bool bBatch; ///< Are we in a batch? the file is flushed at its end.
 	
 };
 
+class ofAsyncLoggerQueue;
+
+/// \brief A logger channel that logs its messages from a background thread.
+///
+/// The messages are copied to a fixed size queue that doesn't lock or
+/// allocate once its strings have grown to the usual size of the messages.
+/// A thread takes them from the queue and logs them as a batch to another
+/// channel, so slow channels like files or the network don't stall the
+/// threads that log, like the main or the audio thread.
+///
+/// Fatal errors and a queue getting full wake the thread up right away,
+/// otherwise it logs what's in the queue a few times per second. Messages
+/// logged from different threads are logged in the order they got into
+/// the queue.
+///
+/// ~~~~{.cpp}
+/// auto file = make_shared<ofFileLoggerChannel>("log.txt", true);
+/// ofSetLoggerChannel(make_shared<ofAsyncLoggerChannel>(file));
+/// ~~~~
+class ofAsyncLoggerChannel: public ofBaseLoggerChannel{
+public:
+	/// \brief What to do with a message when the queue is full.
+	enum OverflowPolicy{
+		/// Drop the message, getNumDropped() counts them.
+		Drop,
+		/// Wait until the thread makes space in the queue.
+		Block,
+		/// Drop the message and log a warning with the number of dropped
+		/// messages once there's space.
+		ReportDropped
+	};
+
+	/// \brief Create an ofAsyncLoggerChannel.
+	/// \param channel The channel the messages are logged to.
+	/// \param capacity The size of the queue, rounded up to a power of 2.
+	/// \param policy What to do with messages when the queue is full.
+	ofAsyncLoggerChannel(shared_ptr<ofBaseLoggerChannel> channel, size_t capacity=4096, OverflowPolicy policy=ReportDropped);
+
+	/// \brief Log every queued message and stop the thread.
+	virtual ~ofAsyncLoggerChannel();
+
+	void log(ofLogLevel level, const string & module, const string & message);
+	void log(ofLogLevel level, const string & module, const char* format, ...) OF_PRINTF_ATTR(4, 5);
+	void log(ofLogLevel level, const string & module, const char* format, va_list args);
+
+	/// \brief Wait until every message logged so far has been logged to
+	/// the wrapped channel.
+	void flush();
+
+	/// \brief Set what to do with messages when the queue is full.
+	void setOverflowPolicy(OverflowPolicy policy);
+	OverflowPolicy getOverflowPolicy() const;
+
+	/// \brief Set how often the thread logs the queued messages when
+	/// nothing wakes it up, 100ms by default.
+	void setFlushInterval(int milliseconds);
+
+	/// \returns the number of messages dropped because the queue was full.
+	uint64_t getNumDropped() const;
+
+	/// \returns the number of messages the queue can hold.
+	size_t getCapacity() const;
+
+	/// \returns the channel the messages are logged to.
+	shared_ptr<ofBaseLoggerChannel> getChannel() const;
+
+private:
+	ofAsyncLoggerChannel(const ofAsyncLoggerChannel &);
+	ofAsyncLoggerChannel & operator=(const ofAsyncLoggerChannel &);
+
+	shared_ptr<ofAsyncLoggerQueue> queue;
+};
+
+class ofBinaryLoggerFile;
+
+/// \brief A logger channel that writes binary records to a memory mapped
+/// ring file.
+///
+/// The file has a fixed size, once it's full the newest messages overwrite
+/// the oldest ones, so it can record verbose logs of an app running for
+/// weeks. Every record holds the time, the id of the thread that logged it,
+/// the level, the module and the message. Logging a message copies it to
+/// the mapped memory, the OS writes it to the file and it's not lost if the
+/// app crashes.
+///
+/// The file can be read with ofBinaryLoggerChannel::read() or converted to
+/// text with the binaryLogDecoder in apps/devApps.
+///
+/// ~~~~{.cpp}
+/// ofSetLoggerChannel(make_shared<ofBinaryLoggerChannel>("log.bin", 64 * 1024 * 1024));
+/// ofSetLogLevel(OF_LOG_VERBOSE);
+/// ~~~~
+class ofBinaryLoggerChannel: public ofBaseLoggerChannel{
+public:
+	/// \brief A message read from a binary log file.
+	struct Message{
+		uint64_t time; ///< Microseconds since the unix epoch.
+		uint64_t thread; ///< The id of the thread that logged the message.
+		ofLogLevel level;
+		string module;
+		string message;
+	};
+
+	/// \brief Create an ofBinaryLoggerChannel.
+	ofBinaryLoggerChannel();
+
+	/// \brief Create an ofBinaryLoggerChannel with parameters.
+	/// \param path The file path for the log file.
+	/// \param size The size in bytes of the ring of messages.
+	/// \param append True to keep the messages of a file with the same
+	/// size, false to start an empty log.
+	ofBinaryLoggerChannel(const string & path, size_t size=16*1024*1024, bool append=true);
+
+	/// \brief Destroy the binary logger channel.
+	virtual ~ofBinaryLoggerChannel();
+
+	/// \brief Set the log file.
+	/// \param path The file path for the log file.
+	/// \param size The size in bytes of the ring of messages.
+	/// \param append True to keep the messages of a file with the same
+	/// size, false to start an empty log.
+	/// \returns false if the file couldn't be created.
+	bool setFile(const string & path, size_t size=16*1024*1024, bool append=true);
+
+	void log(ofLogLevel level, const string & module, const string & message);
+	void log(ofLogLevel level, const string & module, const char* format, ...) OF_PRINTF_ATTR(4, 5);
+	void log(ofLogLevel level, const string & module, const char* format, va_list args);
+
+	/// \brief Close the log file.
+	void close();
+
+	/// \brief Read the messages of a binary log file, from the oldest to
+	/// the newest.
+	/// \param path The file path for the log file.
+	/// \param messages The messages in the file.
+	/// \returns false if the file isn't a binary log.
+	static bool read(const string & path, vector<Message> & messages);
+
+private:
+	ofBinaryLoggerChannel(const ofBinaryLoggerChannel &);
+	ofBinaryLoggerChannel & operator=(const ofBinaryLoggerChannel &);
+
+	unsigned short getModuleId(const string & module);
+
+	shared_ptr<ofBinaryLoggerFile> file;
+	map<string,unsigned short> modules;
+	ofMutex mutex;
+};
+
 
 /// \brief An error logger class used to catch exceptions inside of threads.
 class ofThreadErrorLogger: public Poco::ErrorHandler{
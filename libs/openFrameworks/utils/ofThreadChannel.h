@@ -1,6 +1,8 @@
 #pragma once
 #include "ofConstants.h"
 #include <queue>
+#include <vector>
+#include <atomic>
 #include "Poco/Condition.h"
 
 /// Communication channel between different threads
@@ -26,7 +28,7 @@ public:
 		if(closed){
 			return false;
 		}
-		if(queue.empty()){
+		while(queue.empty() && !closed){
 			condition.wait(mutex);
 		}
 		if(!closed){
@@ -65,14 +67,12 @@ public:
 			return false;
 		}
 		if(queue.empty()){
-			try {
-				condition.wait(mutex,timeoutMs);
-			}catch (Poco::TimeoutException & e) {
+			if(!condition.tryWait(mutex,timeoutMs)){
 				return false;
 			}
 		}
 
-		if(!closed){
+		if(!closed && !queue.empty()){
 			swap(ret,queue.front());
 			queue.pop();
 			return true;
@@ -106,7 +106,7 @@ public:
 		if(closed){
 			return false;
 		}
-		queue.push(val);
+		queue.push(std::move(val));
 		condition.signal();
 		return true;
 	}
@@ -119,7 +119,7 @@ public:
 	void close(){
 		ofScopedLock lock(mutex);
 		closed = true;
-		condition.signal();
+		condition.broadcast();
 	}
 
 private:
@@ -128,3 +128,312 @@ private:
 	Poco::Condition condition;
 	bool closed;
 };
+
+
+/// What a bounded channel does when a value is sent while it's full
+enum ofThreadChannelPolicy{
+	/// wait until a receiver makes space or the channel is closed
+	OF_THREAD_CHANNEL_BLOCK,
+	/// discard the oldest value in the channel to make space
+	OF_THREAD_CHANNEL_DROP_OLDEST,
+	/// return false without sending the value
+	OF_THREAD_CHANNEL_FAIL
+};
+
+/// Ring buffer of a fixed capacity shared by ofBoundedThreadChannel
+/// and ofSPSCThreadChannel. Values are moved in and out of slots that
+/// carry a sequence number telling if they are free or full, so sending
+/// and receiving only lock a mutex to sleep when the channel is full or
+/// empty, or to wake up a thread that is sleeping.
+template<typename T, bool MultiProducer>
+class ofBaseBoundedThreadChannel{
+public:
+	ofBaseBoundedThreadChannel(size_t capacity, ofThreadChannelPolicy policy)
+	:policy(policy)
+	,head(0)
+	,tail(0)
+	,closed(false)
+	,numDropped(0)
+	,waitingReceivers(0)
+	,waitingSenders(0){
+		size_t size = 2;
+		while(size < capacity){
+			size *= 2;
+		}
+		slots = std::vector<Slot>(size);
+		mask = size - 1;
+		for(size_t i = 0; i < size; i++){
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	/// block until a new value is available
+	/// and receive it in the passed parameter.
+	/// returns true if there was a new value
+	/// or false if the channel was closed
+	bool receive(T & ret){
+		if(closed){
+			return false;
+		}
+		if(pop(ret)){
+			wakeSender();
+			return true;
+		}
+		ofScopedLock lock(mutex);
+		waitingReceivers++;
+		bool received = false;
+		while(!closed && !(received = pop(ret))){
+			notEmpty.wait(mutex);
+		}
+		waitingReceivers--;
+		if(received){
+			wakeSenderLocked();
+		}
+		return received;
+	}
+
+	/// receives a new value in the passed parameter
+	/// and returns true or returns false if there
+	/// is no data available or the channel was closed
+	bool tryReceive(T & ret){
+		if(closed || !pop(ret)){
+			return false;
+		}
+		wakeSender();
+		return true;
+	}
+
+	/// receives a new value in the passed parameter
+	/// and returns true or returns false if there
+	/// after the specified timeout in ms there is
+	/// no data available or the channel was closed
+	bool tryReceive(T & ret, int64_t timeoutMs){
+		if(closed){
+			return false;
+		}
+		if(pop(ret)){
+			wakeSender();
+			return true;
+		}
+		ofScopedLock lock(mutex);
+		waitingReceivers++;
+		bool received = false;
+		if(!closed && !(received = pop(ret)) && notEmpty.tryWait(mutex, timeoutMs)){
+			received = !closed && pop(ret);
+		}
+		waitingReceivers--;
+		if(received){
+			wakeSenderLocked();
+		}
+		return received;
+	}
+
+	/// sends a copy of the passed value, when the
+	/// channel is full the policy decides what to do.
+	/// returns true if it was sent successfully or false
+	/// if the channel was closed or, with OF_THREAD_CHANNEL_FAIL,
+	/// full
+	bool send(const T & val){
+		return push(val);
+	}
+
+	/// sends a value by moving it to avoid a copy.
+	/// the original is invalidated. use like:
+	///
+	/// channel.send(std::move(value))
+	bool send(T && val){
+		return push(std::move(val));
+	}
+
+	/// closes the channel, from here on
+	/// no new messages can be sent or received
+	/// and any threads waiting to send or receive
+	/// a value are awaken and return false
+	void close(){
+		ofScopedLock lock(mutex);
+		closed = true;
+		notEmpty.broadcast();
+		notFull.broadcast();
+	}
+
+	/// the number of values the channel can hold,
+	/// the requested capacity rounded up to a power of 2
+	size_t capacity() const{
+		return slots.size();
+	}
+
+	/// approximate number of values waiting to be received
+	size_t size() const{
+		size_t sent = head.load();
+		size_t received = tail.load();
+		return sent > received ? sent - received : 0;
+	}
+
+	/// number of values discarded by OF_THREAD_CHANNEL_DROP_OLDEST
+	uint64_t getNumDropped() const{
+		return numDropped.load();
+	}
+
+	ofThreadChannelPolicy getPolicy() const{
+		return policy;
+	}
+
+private:
+	struct Slot{
+		Slot(){}
+		Slot(const Slot &){}
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	template<typename U>
+	bool push(U && val){
+		if(closed){
+			return false;
+		}
+		while(!tryPush(std::forward<U>(val))){
+			if(policy == OF_THREAD_CHANNEL_FAIL){
+				return false;
+			}else if(policy == OF_THREAD_CHANNEL_DROP_OLDEST){
+				T oldest;
+				if(pop(oldest)){
+					numDropped++;
+				}
+			}else{
+				ofScopedLock lock(mutex);
+				waitingSenders++;
+				bool sent = false;
+				while(!closed && !(sent = tryPush(std::forward<U>(val)))){
+					notFull.wait(mutex);
+				}
+				waitingSenders--;
+				if(sent){
+					wakeReceiverLocked();
+				}
+				return sent;
+			}
+		}
+		wakeReceiver();
+		return true;
+	}
+
+	template<typename U>
+	bool tryPush(U && val){
+		size_t pos = head.load(std::memory_order_relaxed);
+		Slot * slot;
+		while(true){
+			slot = &slots[pos & mask];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+			if(diff == 0){
+				if(!MultiProducer){
+					head.store(pos + 1, std::memory_order_relaxed);
+					break;
+				}else if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					break;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = head.load(std::memory_order_relaxed);
+			}
+		}
+		slot->value = std::forward<U>(val);
+		// sequentially consistent so it's ordered with reading the
+		// number of waiting receivers
+		slot->sequence.store(pos + 1);
+		return true;
+	}
+
+	// always claims the slot with a CAS, even with one receiver,
+	// since OF_THREAD_CHANNEL_DROP_OLDEST pops from the sender
+	bool pop(T & ret){
+		size_t pos = tail.load(std::memory_order_relaxed);
+		Slot * slot;
+		while(true){
+			slot = &slots[pos & mask];
+			size_t sequence = slot->sequence.load(std::memory_order_acquire);
+			intptr_t diff = intptr_t(sequence) - intptr_t(pos + 1);
+			if(diff == 0){
+				if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+					break;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = tail.load(std::memory_order_relaxed);
+			}
+		}
+		ret = std::move(slot->value);
+		slot->sequence.store(pos + mask + 1);
+		return true;
+	}
+
+	void wakeReceiver(){
+		if(waitingReceivers.load() > 0){
+			ofScopedLock lock(mutex);
+			notEmpty.signal();
+		}
+	}
+
+	void wakeReceiverLocked(){
+		if(waitingReceivers.load() > 0){
+			notEmpty.signal();
+		}
+	}
+
+	void wakeSender(){
+		if(waitingSenders.load() > 0){
+			ofScopedLock lock(mutex);
+			notFull.signal();
+		}
+	}
+
+	void wakeSenderLocked(){
+		if(waitingSenders.load() > 0){
+			notFull.signal();
+		}
+	}
+
+	std::vector<Slot> slots;
+	size_t mask;
+	ofThreadChannelPolicy policy;
+	char padHead[64];
+	std::atomic<size_t> head;
+	char padTail[64];
+	std::atomic<size_t> tail;
+	char padTail2[64];
+	std::atomic<bool> closed;
+	std::atomic<uint64_t> numDropped;
+	std::atomic<int> waitingReceivers;
+	std::atomic<int> waitingSenders;
+	ofMutex mutex;
+	Poco::Condition notEmpty;
+	Poco::Condition notFull;
+};
+
+/// Channel with the same interface as ofThreadChannel
+/// that holds at most a fixed number of values, for
+/// pipelines where a slow stage should make the previous
+/// ones wait or drop work instead of growing the queue
+/// without limit. Any number of threads can send and
+/// receive values at the same time.
+///
+///     ofBoundedThreadChannel<ofPixels> toProcess(4, OF_THREAD_CHANNEL_DROP_OLDEST);
+///     toProcess.send(std::move(pixels));
+template<typename T>
+class ofBoundedThreadChannel: public ofBaseBoundedThreadChannel<T, true>{
+public:
+	ofBoundedThreadChannel(size_t capacity, ofThreadChannelPolicy policy = OF_THREAD_CHANNEL_BLOCK)
+	:ofBaseBoundedThreadChannel<T, true>(capacity, policy){}
+};
+
+/// Bounded channel for exactly one sending thread and one
+/// receiving thread, sending doesn't need to claim a slot
+/// against other senders.
+template<typename T>
+class ofSPSCThreadChannel: public ofBaseBoundedThreadChannel<T, false>{
+public:
+	ofSPSCThreadChannel(size_t capacity, ofThreadChannelPolicy policy = OF_THREAD_CHANNEL_BLOCK)
+	:ofBaseBoundedThreadChannel<T, false>(capacity, policy){}
+};
@@ -0,0 +1,286 @@
+#include "ofThreadPool.h"
+#ifndef TARGET_NO_THREADS
+#include "Poco/Environment.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#endif
+
+// pool and worker running in the current thread, if any
+#if defined(TARGET_NO_THREADS)
+static const ofThreadPool * currentPool = NULL;
+static size_t currentWorker = 0;
+#elif defined(_MSC_VER)
+static __declspec(thread) const ofThreadPool * currentPool = NULL;
+static __declspec(thread) size_t currentWorker = 0;
+#else
+static __thread const ofThreadPool * currentPool = NULL;
+static __thread size_t currentWorker = 0;
+#endif
+
+#ifndef TARGET_NO_THREADS
+struct ofThreadPool::Worker: public Poco::Runnable{
+	Worker(ofThreadPool & pool, size_t index)
+	:pool(pool)
+	,index(index)
+	,thread("ofThreadPool worker"){}
+
+	void run(){
+		currentPool = &pool;
+		currentWorker = index;
+		pool.workerLoop(index);
+	}
+
+	ofThreadPool & pool;
+	size_t index;
+	ofMutex mutex;
+	std::deque<shared_ptr<ofTask> > tasks;
+	Poco::Thread thread;
+};
+#else
+struct ofThreadPool::Worker{};
+#endif
+
+//--------------------------------------------------------------
+ofThreadPool & ofGetThreadPool(){
+	static ofThreadPool pool;
+	return pool;
+}
+
+//--------------------------------------------------------------
+ofThreadPool::ofThreadPool(size_t numThreads)
+:numPending(0)
+,numSleeping(0)
+,exiting(false){
+#ifndef TARGET_NO_THREADS
+	if(numThreads == 0){
+		numThreads = MAX(Poco::Environment::processorCount(), 1);
+	}
+	for(size_t i = 0; i < numThreads; i++){
+		workers.push_back(new Worker(*this, i));
+	}
+	for(size_t i = 0; i < numThreads; i++){
+		workers[i]->thread.start(*workers[i]);
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+ofThreadPool::~ofThreadPool(){
+#ifndef TARGET_NO_THREADS
+	{
+		ofScopedLock lock(sleepMutex);
+		exiting = true;
+		wakeUp.broadcast();
+	}
+	for(size_t i = 0; i < workers.size(); i++){
+		workers[i]->thread.join();
+	}
+	for(size_t i = 0; i < workers.size(); i++){
+		delete workers[i];
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+void ofThreadPool::submit(shared_ptr<ofTask> task){
+#ifdef TARGET_NO_THREADS
+	task->run();
+#else
+	// counted before queueing so a worker taking the task right away
+	// can't decrement numPending below 0
+	numPending++;
+	if(isWorkerThread()){
+		Worker & worker = *workers[currentWorker];
+		ofScopedLock lock(worker.mutex);
+		worker.tasks.push_back(task);
+	}else{
+		ofScopedLock lock(sharedMutex);
+		sharedTasks.push_back(task);
+	}
+	// a worker going to sleep counts itself before checking numPending
+	if(numSleeping.load() > 0){
+		ofScopedLock lock(sleepMutex);
+		wakeUp.signal();
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+shared_ptr<ofTask> ofThreadPool::findTask(size_t index){
+	shared_ptr<ofTask> task;
+#ifndef TARGET_NO_THREADS
+	if(numPending.load() == 0){
+		return task;
+	}
+	// newest task of our own queue, it's probably still in the cache
+	if(index < workers.size()){
+		Worker & worker = *workers[index];
+		ofScopedLock lock(worker.mutex);
+		if(!worker.tasks.empty()){
+			task = worker.tasks.back();
+			worker.tasks.pop_back();
+		}
+	}
+	if(!task){
+		ofScopedLock lock(sharedMutex);
+		if(!sharedTasks.empty()){
+			task = sharedTasks.front();
+			sharedTasks.pop_front();
+		}
+	}
+	// oldest task of other workers, usually the biggest part of what's
+	// left of a job that was split recursively
+	for(size_t i = 1; !task && i <= workers.size(); i++){
+		Worker & victim = *workers[(index + i) % workers.size()];
+		ofScopedLock lock(victim.mutex);
+		if(!victim.tasks.empty()){
+			task = victim.tasks.front();
+			victim.tasks.pop_front();
+		}
+	}
+	if(task){
+		numPending--;
+	}
+#endif
+	return task;
+}
+
+//--------------------------------------------------------------
+bool ofThreadPool::runPendingTask(){
+	shared_ptr<ofTask> task = findTask(isWorkerThread() ? currentWorker : workers.size());
+	if(task){
+		task->run();
+		return true;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void ofThreadPool::workerLoop(size_t index){
+	while(!exiting){
+		shared_ptr<ofTask> task = findTask(index);
+		if(task){
+			task->run();
+			continue;
+		}
+		ofScopedLock lock(sleepMutex);
+		numSleeping++;
+		while(numPending.load() == 0 && !exiting){
+			wakeUp.wait(sleepMutex);
+		}
+		numSleeping--;
+	}
+}
+
+//--------------------------------------------------------------
+bool ofThreadPool::isWorkerThread() const{
+	return currentPool == this;
+}
+
+//--------------------------------------------------------------
+size_t ofThreadPool::getNumThreads() const{
+	return workers.size();
+}
+
+//--------------------------------------------------------------
+size_t ofThreadPool::getNumPendingTasks() const{
+	return numPending.load();
+}
+
+//--------------------------------------------------------------
+// chunks are claimed from a shared counter by the calling thread and by
+// helper tasks, helpers that start after every chunk was claimed return
+// without touching the job, so only the state has to outlive the call
+
+namespace{
+class ofParallelForState{
+public:
+	ofParallelForState(ofParallelJob & job, size_t begin, size_t end, size_t grainSize)
+	:job(job)
+	,begin(begin)
+	,end(end)
+	,grainSize(grainSize)
+	,numChunks((end - begin + grainSize - 1) / grainSize)
+	,nextChunk(0)
+	,doneChunks(0){}
+
+	void runChunks(){
+		size_t chunk;
+		while((chunk = nextChunk++) < numChunks){
+			size_t first = begin + chunk * grainSize;
+			size_t last = MIN(first + grainSize, end);
+			try{
+				job.run(first, last);
+			}catch(...){
+				ofScopedLock lock(mutex);
+				if(!exception){
+					exception = std::current_exception();
+				}
+			}
+			if(++doneChunks == numChunks){
+				ofScopedLock lock(mutex);
+				finished.broadcast();
+			}
+		}
+	}
+
+	void wait(){
+		ofScopedLock lock(mutex);
+		while(doneChunks.load() < numChunks){
+			finished.wait(mutex);
+		}
+		if(exception){
+			std::rethrow_exception(exception);
+		}
+	}
+
+private:
+	ofParallelJob & job;
+	size_t begin;
+	size_t end;
+	size_t grainSize;
+	size_t numChunks;
+	std::atomic<size_t> nextChunk;
+	std::atomic<size_t> doneChunks;
+	ofMutex mutex;
+	Poco::Condition finished;
+	std::exception_ptr exception;
+};
+
+class ofParallelForTask: public ofTask{
+public:
+	ofParallelForTask(shared_ptr<ofParallelForState> state)
+	:state(state){}
+
+	void run(){
+		state->runChunks();
+	}
+
+	shared_ptr<ofParallelForState> state;
+};
+}
+
+//--------------------------------------------------------------
+void ofParallelFor(ofParallelJob & job, size_t begin, size_t end, size_t grainSize){
+	if(end <= begin){
+		return;
+	}
+	ofThreadPool & pool = ofGetThreadPool();
+	size_t numThreads = pool.getNumThreads() + 1;
+	size_t size = end - begin;
+	if(grainSize == 0){
+		grainSize = MAX(size / (numThreads * 4), size_t(1));
+	}
+	size_t numChunks = (size + grainSize - 1) / grainSize;
+	if(numChunks < 2 || pool.getNumThreads() == 0){
+		job.run(begin, end);
+		return;
+	}
+	shared_ptr<ofParallelForState> state(new ofParallelForState(job, begin, end, grainSize));
+	size_t numHelpers = MIN(numChunks, numThreads) - 1;
+	for(size_t i = 0; i < numHelpers; i++){
+		pool.submit(shared_ptr<ofTask>(new ofParallelForTask(state)));
+	}
+	state->runChunks();
+	state->wait();
+}
@@ -0,0 +1,409 @@
+#pragma once
+#include "ofConstants.h"
+#include "ofTypes.h"
+#include "Poco/Condition.h"
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <type_traits>
+
+/// \brief A unit of work run by ofThreadPool.
+class ofTask{
+public:
+	virtual ~ofTask(){}
+	virtual void run() = 0;
+};
+
+/// \brief Work over a range of indices split by ofParallelFor in chunks
+/// that run on different threads.
+class ofParallelJob{
+public:
+	virtual ~ofParallelJob(){}
+
+	/// \brief Processes the indices in [begin, end).
+	virtual void run(size_t begin, size_t end) = 0;
+};
+
+template<typename T>
+class ofFuture;
+
+/// \brief Pool of worker threads shared by the whole application.
+///
+/// Every worker has its own queue of tasks, tasks submitted from a worker
+/// go to its queue and are run newest first, tasks submitted from any other
+/// thread go to a shared queue. A worker that runs out of tasks takes the
+/// oldest task of the shared queue or of another worker's queue, so long
+/// jobs split in many tasks spread over every core.
+///
+/// Submitting a task never blocks, so it's safe to do from update(). Check
+/// ofFuture::isReady() every frame instead of calling ofFuture::get() if
+/// the main thread shouldn't wait for the result.
+///
+/// Usually there's no need to create a pool, ofGetThreadPool() returns one
+/// with a worker per core that ofAsync and ofParallelFor use.
+class ofThreadPool{
+public:
+	/// \brief Starts numThreads workers, or one per core when 0.
+	ofThreadPool(size_t numThreads = 0);
+
+	/// \brief Stops the workers after the tasks they are running, tasks
+	/// still in the queues are discarded.
+	~ofThreadPool();
+
+	/// \brief Queues a task to run in one of the workers.
+	///
+	/// With TARGET_NO_THREADS the task runs immediately in the calling
+	/// thread.
+	void submit(shared_ptr<ofTask> task);
+
+	/// \brief Runs one queued task in the calling thread.
+	/// \returns false if there was no task to run.
+	bool runPendingTask();
+
+	/// \returns true if called from one of the workers of this pool.
+	bool isWorkerThread() const;
+
+	/// \returns the number of workers.
+	size_t getNumThreads() const;
+
+	/// \returns the number of tasks waiting in the queues.
+	size_t getNumPendingTasks() const;
+
+	/// \brief Runs function() in a worker, see ofAsync.
+	template<typename Function>
+	ofFuture<typename std::result_of<Function()>::type> async(Function function);
+
+private:
+	struct Worker;
+	void workerLoop(size_t index);
+	shared_ptr<ofTask> findTask(size_t index);
+
+	vector<Worker*> workers;
+	ofMutex sharedMutex;
+	std::deque<shared_ptr<ofTask> > sharedTasks;
+	ofMutex sleepMutex;
+	Poco::Condition wakeUp;
+	std::atomic<size_t> numPending;
+	std::atomic<int> numSleeping;
+	std::atomic<bool> exiting;
+};
+
+/// \returns the pool used by ofAsync, ofParallelFor and the parallel
+/// operations of ofPixels, ofMesh and ofPath.
+ofThreadPool & ofGetThreadPool();
+
+//--------------------------------------------------------------
+// state shared by a task and its futures
+
+class ofBaseTaskState{
+public:
+	ofBaseTaskState()
+	:done(false){}
+
+	virtual ~ofBaseTaskState(){}
+
+	bool isDone() const{
+		return done.load();
+	}
+
+	/// waits until the task is done, helping the pool meanwhile when
+	/// called from a worker so tasks waiting for others can't exhaust
+	/// the workers
+	void wait(){
+		ofThreadPool & pool = ofGetThreadPool();
+		if(pool.isWorkerThread()){
+			while(!isDone()){
+				if(!pool.runPendingTask()){
+					ofScopedLock lock(mutex);
+					if(!isDone()){
+						condition.tryWait(mutex, 1);
+					}
+				}
+			}
+		}else{
+			ofScopedLock lock(mutex);
+			while(!isDone()){
+				condition.wait(mutex);
+			}
+		}
+	}
+
+	void setException(std::exception_ptr e){
+		exception = e;
+		finish();
+	}
+
+	void rethrow(){
+		if(exception){
+			std::rethrow_exception(exception);
+		}
+	}
+
+	void addContinuation(shared_ptr<ofTask> continuation){
+		{
+			ofScopedLock lock(mutex);
+			if(!isDone()){
+				continuations.push_back(continuation);
+				return;
+			}
+		}
+		ofGetThreadPool().submit(continuation);
+	}
+
+protected:
+	void finish(){
+		vector<shared_ptr<ofTask> > next;
+		{
+			ofScopedLock lock(mutex);
+			done = true;
+			condition.broadcast();
+			next.swap(continuations);
+		}
+		for(size_t i = 0; i < next.size(); i++){
+			ofGetThreadPool().submit(next[i]);
+		}
+	}
+
+private:
+	std::atomic<bool> done;
+	std::exception_ptr exception;
+	ofMutex mutex;
+	Poco::Condition condition;
+	vector<shared_ptr<ofTask> > continuations;
+};
+
+template<typename T>
+class ofTaskState: public ofBaseTaskState{
+public:
+	void set(const T & v){
+		value = unique_ptr<T>(new T(v));
+		finish();
+	}
+
+	T get(){
+		rethrow();
+		return *value;
+	}
+
+private:
+	unique_ptr<T> value;
+};
+
+template<>
+class ofTaskState<void>: public ofBaseTaskState{
+public:
+	void set(){
+		finish();
+	}
+
+	void get(){
+		rethrow();
+	}
+};
+
+// calls the function and stores its result, if any, in the state
+template<typename Result>
+struct ofTaskCall{
+	template<typename Function>
+	static void run(Function & function, ofTaskState<Result> & state){
+		state.set(function());
+	}
+
+	template<typename Function, typename Argument>
+	static void run(Function & function, const Argument & argument, ofTaskState<Result> & state){
+		state.set(function(argument));
+	}
+};
+
+template<>
+struct ofTaskCall<void>{
+	template<typename Function>
+	static void run(Function & function, ofTaskState<void> & state){
+		function();
+		state.set();
+	}
+
+	template<typename Function, typename Argument>
+	static void run(Function & function, const Argument & argument, ofTaskState<void> & state){
+		function(argument);
+		state.set();
+	}
+};
+
+template<typename Function, typename Result>
+class ofFunctionTask: public ofTask{
+public:
+	ofFunctionTask(Function function, shared_ptr<ofTaskState<Result> > state)
+	:function(function)
+	,state(state){}
+
+	void run(){
+		try{
+			ofTaskCall<Result>::run(function, *state);
+		}catch(...){
+			state->setException(std::current_exception());
+		}
+	}
+
+private:
+	Function function;
+	shared_ptr<ofTaskState<Result> > state;
+};
+
+//--------------------------------------------------------------
+/// \brief The result of a task run by ofThreadPool.
+///
+/// Copies of a future share the same result.
+template<typename T>
+class ofFuture{
+public:
+	ofFuture(){}
+
+	ofFuture(shared_ptr<ofTaskState<T> > state)
+	:state(state){}
+
+	/// \returns true if the future belongs to a task.
+	bool isValid() const{
+		return state != NULL;
+	}
+
+	/// \returns true if the task has finished, never blocks.
+	bool isReady() const{
+		return state && state->isDone();
+	}
+
+	/// \brief Blocks until the task has finished.
+	void wait() const{
+		state->wait();
+	}
+
+	/// \brief Blocks until the task has finished.
+	/// \returns the result of the task or throws the exception it threw.
+	T get() const{
+		state->wait();
+		return state->get();
+	}
+
+	/// \brief Runs continuation(future) in the pool once this task has
+	/// finished, the future passed to it is ready.
+	/// \returns the future of the continuation.
+	template<typename Function>
+	ofFuture<typename std::result_of<Function(ofFuture<T>)>::type> then(Function continuation) const;
+
+private:
+	shared_ptr<ofTaskState<T> > state;
+};
+
+template<typename Function, typename T, typename Result>
+class ofContinuationTask: public ofTask{
+public:
+	ofContinuationTask(Function function, ofFuture<T> previous, shared_ptr<ofTaskState<Result> > state)
+	:function(function)
+	,previous(previous)
+	,state(state){}
+
+	void run(){
+		try{
+			ofTaskCall<Result>::run(function, previous, *state);
+		}catch(...){
+			state->setException(std::current_exception());
+		}
+	}
+
+private:
+	Function function;
+	ofFuture<T> previous;
+	shared_ptr<ofTaskState<Result> > state;
+};
+
+template<typename T>
+template<typename Function>
+ofFuture<typename std::result_of<Function(ofFuture<T>)>::type> ofFuture<T>::then(Function continuation) const{
+	typedef typename std::result_of<Function(ofFuture<T>)>::type Result;
+	shared_ptr<ofTaskState<Result> > next(new ofTaskState<Result>);
+	state->addContinuation(shared_ptr<ofTask>(new ofContinuationTask<Function, T, Result>(continuation, *this, next)));
+	return ofFuture<Result>(next);
+}
+
+template<typename Function>
+ofFuture<typename std::result_of<Function()>::type> ofThreadPool::async(Function function){
+	typedef typename std::result_of<Function()>::type Result;
+	shared_ptr<ofTaskState<Result> > state(new ofTaskState<Result>);
+	submit(shared_ptr<ofTask>(new ofFunctionTask<Function, Result>(function, state)));
+	return ofFuture<Result>(state);
+}
+
+/// \brief Runs function() in the global thread pool.
+///
+/// function can be any copyable object that can be called without
+/// arguments, its result is returned by the future:
+///
+/// ~~~~{.cpp}
+/// ofFuture<ofPixels> pixels = ofAsync(LoadJob(path));
+/// ...
+/// if(pixels.isReady()){
+///     image.setFromPixels(pixels.get());
+/// }
+/// ~~~~
+template<typename Function>
+ofFuture<typename std::result_of<Function()>::type> ofAsync(Function function){
+	return ofGetThreadPool().async(function);
+}
+
+//--------------------------------------------------------------
+/// \brief Runs job over [begin, end) in chunks of grainSize indices
+/// spread over the global thread pool and the calling thread.
+///
+/// Returns once every chunk has run. The calling thread only runs chunks
+/// of this job, never unrelated tasks, so it's fine to call from the main
+/// thread. A grainSize of 0 splits the range in a few chunks per thread.
+void ofParallelFor(ofParallelJob & job, size_t begin, size_t end, size_t grainSize = 0);
+
+template<typename Function>
+class ofParallelForJob: public ofParallelJob{
+public:
+	ofParallelForJob(Function & function)
+	:function(function){}
+
+	void run(size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			function(i);
+		}
+	}
+
+private:
+	Function & function;
+};
+
+/// \brief Calls function(i) for every i in [begin, end) in parallel.
+template<typename Function>
+void ofParallelFor(size_t begin, size_t end, Function function, size_t grainSize = 0){
+	ofParallelForJob<Function> job(function);
+	ofParallelFor(job, begin, end, grainSize);
+}
+
+template<typename Container, typename Function>
+class ofParallelForEachJob: public ofParallelJob{
+public:
+	ofParallelForEachJob(Container & container, Function & function)
+	:container(container)
+	,function(function){}
+
+	void run(size_t begin, size_t end){
+		for(size_t i = begin; i < end; i++){
+			function(container[i]);
+		}
+	}
+
+private:
+	Container & container;
+	Function & function;
+};
+
+/// \brief Calls function(element) for every element of a container with
+/// random access, like vector or ofPixels, in parallel.
+template<typename Container, typename Function>
+void ofParallelForEach(Container & container, Function function, size_t grainSize = 0){
+	ofParallelForEachJob<Container, Function> job(container, function);
+	ofParallelFor(job, 0, container.size(), grainSize);
+}
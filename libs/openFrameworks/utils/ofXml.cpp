@@ -41,8 +41,7 @@ bool ofXml::load(const string & path){
 		ofLogError("ofXml") << "couldn't load, \"" << file.getFileName() << "\" not found";
 		return false;
 	}
-	ofBuffer xmlBuffer(file);
-	return loadFromBuffer(xmlBuffer);
+	return loadFromBuffer(file.readToBuffer());
 }
 
 bool ofXml::save(const string & path){
@@ -766,6 +765,17 @@ bool ofXml::setAttribute(const string& path, const string& value)
 
 //---------------------------------------------------------
 bool ofXml::loadFromBuffer( const string& buffer )
+{
+    return parse(buffer.c_str(), buffer.size());
+}
+
+bool ofXml::loadFromBuffer( const ofBuffer& buffer )
+{
+    // parses the buffer in place, without copying it to a string
+    return parse(buffer.getData(), buffer.size());
+}
+
+bool ofXml::parse(const char * data, size_t size)
 {
     Poco::XML::DOMParser parser;
     
@@ -775,7 +785,7 @@ bool ofXml::loadFromBuffer( const string& buffer )
     }
     
     try {
-        document = parser.parseString(buffer);
+        document = parser.parseMemory(data, size);
     	element = (Poco::XML::Element*) document->firstChild();
     	document->normalize();
     	return true;
@@ -87,6 +87,7 @@ public:
     bool            setToPrevSibling();
     
     bool            loadFromBuffer( const string& buffer );
+    bool            loadFromBuffer( const ofBuffer& buffer );
     
     string          toString() const;
     
@@ -238,6 +239,7 @@ public:
 protected:
     void releaseAll();
     string DOMErrorMessage(short msg);
+    bool parse(const char * data, size_t size);
 
     Poco::XML::Document *document;
     Poco::XML::Element *element;